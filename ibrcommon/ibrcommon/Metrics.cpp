@@ -0,0 +1,509 @@
+/*
+ * Metrics.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "ibrcommon/config.h"
+#include "ibrcommon/Metrics.h"
+#include "ibrcommon/MonotonicClock.h"
+#include "ibrcommon/Exceptions.h"
+#include "ibrcommon/thread/MutexLock.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <math.h>
+
+namespace ibrcommon
+{
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
+	static inline void __metric_add(volatile uint64_t &v, uint64_t d)
+	{
+		__sync_fetch_and_add(&v, d);
+	}
+
+	static inline uint64_t __metric_load(const volatile uint64_t &v)
+	{
+		return __sync_fetch_and_add(const_cast<volatile uint64_t*>(&v), 0);
+	}
+
+	static inline void __metric_store(volatile uint64_t &v, uint64_t x)
+	{
+		uint64_t old = v;
+		while (!__sync_bool_compare_and_swap(&v, old, x)) old = v;
+	}
+
+	static inline void __metric_max(volatile uint64_t &v, uint64_t x)
+	{
+		uint64_t old = v;
+		while (x > old)
+		{
+			if (__sync_bool_compare_and_swap(&v, old, x)) break;
+			old = v;
+		}
+	}
+#else
+	// no 64-bit atomic operations available on this platform
+	static ibrcommon::Mutex __metric_lock;
+
+	static inline void __metric_add(volatile uint64_t &v, uint64_t d)
+	{
+		ibrcommon::MutexLock l(__metric_lock);
+		v += d;
+	}
+
+	static inline uint64_t __metric_load(const volatile uint64_t &v)
+	{
+		ibrcommon::MutexLock l(__metric_lock);
+		return v;
+	}
+
+	static inline void __metric_store(volatile uint64_t &v, uint64_t x)
+	{
+		ibrcommon::MutexLock l(__metric_lock);
+		v = x;
+	}
+
+	static inline void __metric_max(volatile uint64_t &v, uint64_t x)
+	{
+		ibrcommon::MutexLock l(__metric_lock);
+		if (x > v) v = x;
+	}
+#endif
+
+	static std::string __metric_labels(const std::string &labels, const std::string &extra)
+	{
+		if (labels.empty() && extra.empty()) return "";
+		if (labels.empty()) return "{" + extra + "}";
+		if (extra.empty()) return "{" + labels + "}";
+		return "{" + labels + "," + extra + "}";
+	}
+
+	const size_t Histogram::SUB_BUCKET_BITS;
+	const size_t Histogram::SUB_BUCKETS;
+	const size_t Histogram::MAX_EXPONENT;
+	const size_t Histogram::BUCKETS;
+	const size_t Histogram::SHARDS;
+
+	Metric::~Metric()
+	{
+	}
+
+	Counter::Counter()
+	 : _value(0)
+	{
+	}
+
+	Counter::~Counter()
+	{
+	}
+
+	void Counter::inc(uint64_t value)
+	{
+		__metric_add(_value, value);
+	}
+
+	uint64_t Counter::get() const
+	{
+		return __metric_load(_value);
+	}
+
+	Metric::TYPE Counter::getType() const
+	{
+		return METRIC_COUNTER;
+	}
+
+	void Counter::print(std::ostream &stream, const std::string &name, const std::string &labels) const
+	{
+		stream << name << __metric_labels(labels, "") << " " << get() << "\n";
+	}
+
+	Gauge::Gauge()
+	 : _value(0)
+	{
+	}
+
+	Gauge::~Gauge()
+	{
+	}
+
+	void Gauge::set(int64_t value)
+	{
+		__metric_store(_value, static_cast<uint64_t>(value));
+	}
+
+	void Gauge::add(int64_t value)
+	{
+		// two's complement addition covers negative values
+		__metric_add(_value, static_cast<uint64_t>(value));
+	}
+
+	int64_t Gauge::get() const
+	{
+		return static_cast<int64_t>(__metric_load(_value));
+	}
+
+	Metric::TYPE Gauge::getType() const
+	{
+		return METRIC_GAUGE;
+	}
+
+	void Gauge::print(std::ostream &stream, const std::string &name, const std::string &labels) const
+	{
+		stream << name << __metric_labels(labels, "") << " " << get() << "\n";
+	}
+
+	Histogram::Snapshot::Snapshot()
+	 : count(0), sum(0), max(0), buckets(Histogram::BUCKETS, 0)
+	{
+	}
+
+	Histogram::Snapshot::~Snapshot()
+	{
+	}
+
+	uint64_t Histogram::Snapshot::quantile(double q) const
+	{
+		if (count == 0) return 0;
+
+		if (q < 0.0) q = 0.0;
+		if (q > 1.0) q = 1.0;
+
+		uint64_t rank = static_cast<uint64_t>(ceil(q * static_cast<double>(count)));
+		if (rank == 0) rank = 1;
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < buckets.size(); ++i)
+		{
+			seen += buckets[i];
+			if (seen >= rank)
+			{
+				const uint64_t value = Histogram::upper(i);
+				return (value < max) ? value : max;
+			}
+		}
+
+		return max;
+	}
+
+	Histogram::Timer::Timer(Histogram &h)
+	 : _histogram(h), _start(Histogram::now())
+	{
+	}
+
+	Histogram::Timer::~Timer()
+	{
+		_histogram.record(Histogram::now() - _start);
+	}
+
+	Histogram::Histogram(double scale)
+	 : _scale(scale), _shards(new Shard[SHARDS])
+	{
+		::memset((void*)_shards, 0, sizeof(Shard) * SHARDS);
+	}
+
+	Histogram::~Histogram()
+	{
+		delete [] _shards;
+	}
+
+	static pthread_key_t __shard_key;
+	static pthread_once_t __shard_once = PTHREAD_ONCE_INIT;
+	static volatile size_t __shard_next = 0;
+
+	static void __shard_key_create()
+	{
+		pthread_key_create(&__shard_key, NULL);
+	}
+
+	size_t Histogram::__shard()
+	{
+		pthread_once(&__shard_once, __shard_key_create);
+
+		// the shard of a thread is assigned round-robin on its first record
+		size_t shard = reinterpret_cast<size_t>(pthread_getspecific(__shard_key));
+
+		if (shard == 0)
+		{
+			shard = (__sync_fetch_and_add(&__shard_next, 1) % SHARDS) + 1;
+			pthread_setspecific(__shard_key, reinterpret_cast<void*>(shard));
+		}
+
+		return shard - 1;
+	}
+
+	void Histogram::record(uint64_t value)
+	{
+		Shard &s = _shards[__shard()];
+
+		__metric_add(s.buckets[index(value)], 1);
+		__metric_add(s.count, 1);
+		__metric_add(s.sum, value);
+		__metric_max(s.max, value);
+	}
+
+	Histogram::Snapshot Histogram::snapshot() const
+	{
+		Snapshot ret;
+
+		for (size_t i = 0; i < SHARDS; ++i)
+		{
+			const Shard &s = _shards[i];
+
+			ret.count += __metric_load(s.count);
+			ret.sum += __metric_load(s.sum);
+
+			const uint64_t max = __metric_load(s.max);
+			if (max > ret.max) ret.max = max;
+
+			for (size_t j = 0; j < BUCKETS; ++j)
+			{
+				ret.buckets[j] += __metric_load(s.buckets[j]);
+			}
+		}
+
+		return ret;
+	}
+
+	Metric::TYPE Histogram::getType() const
+	{
+		return METRIC_HISTOGRAM;
+	}
+
+	void Histogram::print(std::ostream &stream, const std::string &name, const std::string &labels) const
+	{
+		static const char *quantiles[] = { "0.5", "0.9", "0.99", "0.999" };
+		static const double values[] = { 0.5, 0.9, 0.99, 0.999 };
+
+		const Snapshot s = snapshot();
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			stream << name << __metric_labels(labels, std::string("quantile=\"") + quantiles[i] + "\"") << " "
+					<< (static_cast<double>(s.quantile(values[i])) * _scale) << "\n";
+		}
+
+		stream << name << "_sum" << __metric_labels(labels, "") << " " << (static_cast<double>(s.sum) * _scale) << "\n";
+		stream << name << "_count" << __metric_labels(labels, "") << " " << s.count << "\n";
+	}
+
+	uint64_t Histogram::now()
+	{
+		struct timespec ts;
+		MonotonicClock::gettime(ts);
+		return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + static_cast<uint64_t>(ts.tv_nsec / 1000);
+	}
+
+	size_t Histogram::index(uint64_t value)
+	{
+		if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+
+		// position of the highest bit set
+		const size_t e = 63 - __builtin_clzll(value);
+		if (e > MAX_EXPONENT) return BUCKETS - 1;
+
+		const size_t m = static_cast<size_t>(value >> (e - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+		return (e - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + m;
+	}
+
+	uint64_t Histogram::lower(size_t index)
+	{
+		if (index < SUB_BUCKETS) return index;
+
+		const size_t e = (index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+		const uint64_t m = index % SUB_BUCKETS;
+		return (SUB_BUCKETS + m) << (e - SUB_BUCKET_BITS);
+	}
+
+	uint64_t Histogram::upper(size_t index)
+	{
+		// the last bucket also takes all values beyond the range
+		if (index >= (BUCKETS - 1)) return ~static_cast<uint64_t>(0);
+		return lower(index + 1) - 1;
+	}
+
+	MetricsRegistry::Family::Family()
+	 : type(Metric::METRIC_COUNTER)
+	{
+	}
+
+	MetricsRegistry::Family::~Family()
+	{
+	}
+
+	MetricsRegistry::MetricsRegistry()
+	{
+	}
+
+	MetricsRegistry::~MetricsRegistry()
+	{
+		for (std::map<std::string, Family>::iterator it = _families.begin(); it != _families.end(); ++it)
+		{
+			std::map<std::string, Metric*> &instances = (*it).second.instances;
+			for (std::map<std::string, Metric*>::iterator m = instances.begin(); m != instances.end(); ++m)
+			{
+				delete (*m).second;
+			}
+		}
+	}
+
+	MetricsRegistry& MetricsRegistry::getInstance()
+	{
+		// never destroyed, detached threads may still record on exit
+		static MetricsRegistry *instance = new MetricsRegistry();
+		return *instance;
+	}
+
+	MetricsRegistry::Family& MetricsRegistry::__family(const std::string &name, const std::string &help, Metric::TYPE type)
+	{
+		std::map<std::string, Family>::iterator it = _families.find(name);
+
+		if (it == _families.end())
+		{
+			Family &f = _families[name];
+			f.type = type;
+			f.help = help;
+			return f;
+		}
+
+		if ((*it).second.type != type)
+			throw ibrcommon::Exception("metric " + name + " already registered with a different type");
+
+		return (*it).second;
+	}
+
+	Metric* MetricsRegistry::__acquire(Family &f, const std::string &labels)
+	{
+		f.references[labels]++;
+
+		std::map<std::string, Metric*>::const_iterator it = f.instances.find(labels);
+		if (it == f.instances.end()) return NULL;
+
+		return (*it).second;
+	}
+
+	Counter& MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels)
+	{
+		ibrcommon::MutexLock l(_lock);
+		Family &f = __family(name, help, Metric::METRIC_COUNTER);
+
+		Metric *m = __acquire(f, labels);
+		if (m == NULL) m = f.instances[labels] = new Counter();
+
+		return static_cast<Counter&>(*m);
+	}
+
+	Gauge& MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels)
+	{
+		ibrcommon::MutexLock l(_lock);
+		Family &f = __family(name, help, Metric::METRIC_GAUGE);
+
+		Metric *m = __acquire(f, labels);
+		if (m == NULL) m = f.instances[labels] = new Gauge();
+
+		return static_cast<Gauge&>(*m);
+	}
+
+	Histogram& MetricsRegistry::histogram(const std::string &name, const std::string &help, const std::string &labels, double scale)
+	{
+		ibrcommon::MutexLock l(_lock);
+		Family &f = __family(name, help, Metric::METRIC_HISTOGRAM);
+
+		Metric *m = __acquire(f, labels);
+		if (m == NULL) m = f.instances[labels] = new Histogram(scale);
+
+		return static_cast<Histogram&>(*m);
+	}
+
+	void MetricsRegistry::release(const std::string &name, const std::string &labels)
+	{
+		ibrcommon::MutexLock l(_lock);
+
+		std::map<std::string, Family>::iterator fit = _families.find(name);
+		if (fit == _families.end()) return;
+
+		Family &f = (*fit).second;
+
+		std::map<std::string, size_t>::iterator rit = f.references.find(labels);
+		if (rit == f.references.end()) return;
+
+		if (--(*rit).second > 0) return;
+		f.references.erase(rit);
+
+		std::map<std::string, Metric*>::iterator it = f.instances.find(labels);
+		if (it != f.instances.end())
+		{
+			delete (*it).second;
+			f.instances.erase(it);
+		}
+
+		// drop the family with its last instance
+		if (f.instances.empty()) _families.erase(fit);
+	}
+
+	void MetricsRegistry::print(std::ostream &stream) const
+	{
+		ibrcommon::MutexLock l(const_cast<ibrcommon::Mutex&>(_lock));
+
+		for (std::map<std::string, Family>::const_iterator it = _families.begin(); it != _families.end(); ++it)
+		{
+			const std::string &name = (*it).first;
+			const Family &f = (*it).second;
+
+			stream << "# HELP " << name << " " << f.help << "\n";
+
+			switch (f.type)
+			{
+			case Metric::METRIC_COUNTER:
+				stream << "# TYPE " << name << " counter\n";
+				break;
+
+			case Metric::METRIC_GAUGE:
+				stream << "# TYPE " << name << " gauge\n";
+				break;
+
+			case Metric::METRIC_HISTOGRAM:
+				stream << "# TYPE " << name << " summary\n";
+				break;
+			}
+
+			for (std::map<std::string, Metric*>::const_iterator m = f.instances.begin(); m != f.instances.end(); ++m)
+			{
+				(*m).second->print(stream, name, (*m).first);
+			}
+		}
+	}
+
+	std::string MetricsRegistry::label(const std::string &key, const std::string &value)
+	{
+		std::string ret = key + "=\"";
+
+		for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+		{
+			switch (*it)
+			{
+			case '\\': ret += "\\\\"; break;
+			case '"': ret += "\\\""; break;
+			case '\n': ret += "\\n"; break;
+			default: ret += *it; break;
+			}
+		}
+
+		return ret + "\"";
+	}
+} /* namespace ibrcommon */
@@ -0,0 +1,256 @@
+/*
+ * Metrics.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef IBRCOMMON_METRICS_H_
+#define IBRCOMMON_METRICS_H_
+
+#include "ibrcommon/thread/Mutex.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+
+namespace ibrcommon
+{
+	/**
+	 * Base class of all metrics. Updating a metric does not take any lock,
+	 * only the creation of metrics in the registry is serialized.
+	 */
+	class Metric
+	{
+	public:
+		enum TYPE
+		{
+			METRIC_COUNTER = 0,
+			METRIC_GAUGE = 1,
+			METRIC_HISTOGRAM = 2
+		};
+
+		virtual ~Metric() = 0;
+
+		/**
+		 * @return The type of this metric
+		 */
+		virtual TYPE getType() const = 0;
+
+		/**
+		 * Write the samples of this metric in the text exposition format
+		 * @param stream The output stream
+		 * @param name The name of the metric
+		 * @param labels Formatted labels of this instance, may be empty
+		 */
+		virtual void print(std::ostream &stream, const std::string &name, const std::string &labels) const = 0;
+	};
+
+	/**
+	 * A monotonically increasing value
+	 */
+	class Counter : public Metric
+	{
+	public:
+		Counter();
+		virtual ~Counter();
+
+		void inc(uint64_t value = 1);
+		uint64_t get() const;
+
+		virtual TYPE getType() const;
+		virtual void print(std::ostream &stream, const std::string &name, const std::string &labels) const;
+
+	private:
+		volatile uint64_t _value;
+	};
+
+	/**
+	 * A value which may go up and down, e.g. the length of a queue
+	 */
+	class Gauge : public Metric
+	{
+	public:
+		Gauge();
+		virtual ~Gauge();
+
+		void set(int64_t value);
+		void add(int64_t value);
+		int64_t get() const;
+
+		virtual TYPE getType() const;
+		virtual void print(std::ostream &stream, const std::string &name, const std::string &labels) const;
+
+	private:
+		volatile uint64_t _value;
+	};
+
+	/**
+	 * A histogram with logarithmic buckets, each divided into linear
+	 * sub-buckets. The relative error of a quantile is below 1 / SUB_BUCKETS.
+	 * Every thread records into one of several shards to avoid contention,
+	 * the shards are merged when a snapshot is taken.
+	 */
+	class Histogram : public Metric
+	{
+	public:
+		static const size_t SUB_BUCKET_BITS = 3;
+		static const size_t SUB_BUCKETS = (1 << SUB_BUCKET_BITS);
+		static const size_t MAX_EXPONENT = 47;
+		static const size_t BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+		static const size_t SHARDS = 8;
+
+		/**
+		 * Merged state of all shards
+		 */
+		class Snapshot
+		{
+		public:
+			Snapshot();
+			virtual ~Snapshot();
+
+			/**
+			 * Returns the value at the given quantile
+			 * @param q Quantile between 0.0 and 1.0
+			 */
+			uint64_t quantile(double q) const;
+
+			uint64_t count;
+			uint64_t sum;
+			uint64_t max;
+			std::vector<uint64_t> buckets;
+		};
+
+		/**
+		 * Records the time in microseconds from its creation
+		 * until its destruction
+		 */
+		class Timer
+		{
+		public:
+			Timer(Histogram &h);
+			virtual ~Timer();
+
+		private:
+			Histogram &_histogram;
+			const uint64_t _start;
+		};
+
+		/**
+		 * @param scale Factor applied to recorded values on output, e.g. 0.000001
+		 *   to print microseconds as seconds
+		 */
+		Histogram(double scale = 1.0);
+		virtual ~Histogram();
+
+		void record(uint64_t value);
+
+		Snapshot snapshot() const;
+
+		virtual TYPE getType() const;
+		virtual void print(std::ostream &stream, const std::string &name, const std::string &labels) const;
+
+		/**
+		 * @return Monotonic time in microseconds
+		 */
+		static uint64_t now();
+
+		static size_t index(uint64_t value);
+		static uint64_t lower(size_t index);
+		static uint64_t upper(size_t index);
+
+	private:
+		struct Shard
+		{
+			volatile uint64_t count;
+			volatile uint64_t sum;
+			volatile uint64_t max;
+			volatile uint64_t buckets[BUCKETS];
+		};
+
+		static size_t __shard();
+
+		const double _scale;
+		Shard *_shards;
+	};
+
+	/**
+	 * The registry owns all metrics of the process. Metrics are identified
+	 * by their name and labels. Each request of a metric counts as one
+	 * reference, a metric lives until it has been released as often as it
+	 * has been requested, so the returned references may be kept by the
+	 * caller until then. Metrics never released live as long as the registry.
+	 */
+	class MetricsRegistry
+	{
+	public:
+		static MetricsRegistry& getInstance();
+
+		Counter& counter(const std::string &name, const std::string &help, const std::string &labels = "");
+		Gauge& gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+		Histogram& histogram(const std::string &name, const std::string &help, const std::string &labels = "", double scale = 1.0);
+
+		/**
+		 * Drop one reference to a metric, e.g. labelled with a peer which
+		 * has gone away. The metric is deleted with its last reference.
+		 */
+		void release(const std::string &name, const std::string &labels = "");
+
+		/**
+		 * Write all metrics in the Prometheus text exposition format
+		 */
+		void print(std::ostream &stream) const;
+
+		/**
+		 * Format a label with escaped value
+		 * @return A string like key="value"
+		 */
+		static std::string label(const std::string &key, const std::string &value);
+
+	private:
+		MetricsRegistry();
+		virtual ~MetricsRegistry();
+
+		class Family
+		{
+		public:
+			Family();
+			virtual ~Family();
+
+			Metric::TYPE type;
+			std::string help;
+			std::map<std::string, Metric*> instances;
+
+			// number of requests not released yet for each instance
+			std::map<std::string, size_t> references;
+		};
+
+		Family& __family(const std::string &name, const std::string &help, Metric::TYPE type);
+
+		/**
+		 * Returns the instance of a family with the given labels and adds
+		 * a reference to it. NULL is returned if the instance does not exist.
+		 */
+		static Metric* __acquire(Family &f, const std::string &labels);
+
+		ibrcommon::Mutex _lock;
+		std::map<std::string, Family> _families;
+	};
+} /* namespace ibrcommon */
+
+#endif /* IBRCOMMON_METRICS_H_ */
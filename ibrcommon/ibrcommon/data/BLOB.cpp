@@ -28,6 +28,7 @@
 #include <string.h>
 #include <cstring>
 #include <cerrno>
+#include <algorithm>
 #include <vector>
 
 #ifdef __DEVELOPMENT_ASSERTIONS__
@@ -139,6 +140,11 @@ namespace ibrcommon
 		return ibrcommon::BLOB::Reference(new ibrcommon::FileBLOB(f));
 	}
 
+	ibrcommon::BLOB::Reference BLOB::view(const BLOB::Reference &ref, const std::streamsize offset, const std::streamsize length)
+	{
+		return ibrcommon::BLOB::Reference(new ibrcommon::RangeBLOB(ref, offset, length));
+	}
+
 	void BLOB::changeProvider(BLOB::Provider *p, bool auto_delete)
 	{
 		ibrcommon::BLOB::provider.change(p, auto_delete);
@@ -324,6 +330,146 @@ namespace ibrcommon
 		return _file.size();
 	}
 
+	RangeBLOB::RangeBLOB(const BLOB::Reference &origin, const std::streamsize offset, const std::streamsize length)
+	 : ibrcommon::BLOB(length), _origin(origin), _origin_stream(NULL), _detached(false), _length(length), _buf(offset, length), _stream(&_buf)
+	{
+	}
+
+	RangeBLOB::~RangeBLOB()
+	{
+		delete _origin_stream;
+	}
+
+	void RangeBLOB::clear()
+	{
+		// release the origin BLOB
+		delete _origin_stream;
+		_origin_stream = NULL;
+		_buf.attach(NULL);
+
+		// replace the range by a new BLOB
+		_origin = BLOB::create();
+		_detached = true;
+
+		_origin_stream = new BLOB::iostream(*_origin._blob);
+		_origin_stream->clear();
+	}
+
+	void RangeBLOB::open()
+	{
+		// lock and open the origin BLOB
+		_origin_stream = new BLOB::iostream(*_origin._blob);
+
+		if (!_detached)
+		{
+			_buf.attach(&(**_origin_stream));
+			_stream.clear();
+			_stream.seekg(0);
+		}
+	}
+
+	void RangeBLOB::close()
+	{
+		_buf.attach(NULL);
+
+		delete _origin_stream;
+		_origin_stream = NULL;
+	}
+
+	std::iostream& RangeBLOB::__get_stream()
+	{
+		if (_detached && (_origin_stream != NULL)) return **_origin_stream;
+		return _stream;
+	}
+
+	std::streamsize RangeBLOB::__get_size()
+	{
+		if (!_detached) return _length;
+		if (_origin_stream != NULL) return _origin_stream->size();
+		return _origin.size();
+	}
+
+	RangeBLOB::rangebuf::rangebuf(const std::streamsize offset, const std::streamsize length)
+	 : _origin(NULL), _offset(offset), _length(length), _pos(0), _synced(false)
+	{
+		setg(0, 0, 0);
+	}
+
+	RangeBLOB::rangebuf::~rangebuf()
+	{
+	}
+
+	void RangeBLOB::rangebuf::attach(std::istream *origin)
+	{
+		_origin = origin;
+		_pos = 0;
+		_synced = false;
+		setg(0, 0, 0);
+	}
+
+	RangeBLOB::rangebuf::int_type RangeBLOB::rangebuf::underflow()
+	{
+		if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+		if ((_origin == NULL) || (_pos >= _length)) return traits_type::eof();
+
+		// position the origin stream, this is only necessary after seeking
+		if (!_synced)
+		{
+			_origin->clear();
+			_origin->seekg(_offset + _pos, std::ios::beg);
+			_synced = true;
+		}
+
+		// allocate the buffer on the first read, small ranges get a small buffer
+		if (_buffer.empty()) _buffer.resize(static_cast<size_t>(std::min<std::streamsize>(_length, 0x10000)));
+
+		const std::streamsize remain = _length - _pos;
+		_origin->read(&_buffer[0], (remain < static_cast<std::streamsize>(_buffer.size())) ? remain : _buffer.size());
+
+		const std::streamsize bytes = _origin->gcount();
+		if (bytes <= 0)
+		{
+			_synced = false;
+			return traits_type::eof();
+		}
+
+		setg(&_buffer[0], &_buffer[0], &_buffer[0] + bytes);
+		_pos += bytes;
+
+		return traits_type::to_int_type(*gptr());
+	}
+
+	RangeBLOB::rangebuf::pos_type RangeBLOB::rangebuf::seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which)
+	{
+		// current position of the get pointer
+		const std::streamsize current = _pos - (egptr() - gptr());
+
+		switch (way)
+		{
+		case std::ios_base::beg:
+			return seekpos(off, which);
+
+		case std::ios_base::cur:
+			if (off == 0) return current;
+			return seekpos(current + off, which);
+
+		default:
+			return seekpos(_length + off, which);
+		}
+	}
+
+	RangeBLOB::rangebuf::pos_type RangeBLOB::rangebuf::seekpos(pos_type pos, std::ios_base::openmode which)
+	{
+		if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+		if ((pos < 0) || (pos > _length)) return pos_type(off_type(-1));
+
+		_pos = pos;
+		_synced = false;
+		setg(0, 0, 0);
+
+		return pos;
+	}
+
 	void FileBLOBProvider::TmpFileBLOB::clear()
 	{
 		// close the file
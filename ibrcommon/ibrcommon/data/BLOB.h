@@ -30,6 +30,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <vector>
 
 namespace ibrcommon
 {
@@ -129,6 +130,7 @@ namespace ibrcommon
 			std::streamsize size() const;
 
 		private:
+			friend class RangeBLOB;
 			refcnt_ptr<BLOB> _blob;
 		};
 
@@ -165,6 +167,18 @@ namespace ibrcommon
 		 */
 		static ibrcommon::BLOB::Reference open(const ibrcommon::File &f);
 
+		/**
+		 * Create a BLOB object which refers to a range of another BLOB
+		 * without copying the data. The origin BLOB is locked while the
+		 * view is opened. The data is copied into a new BLOB as soon as
+		 * the view is cleared to write other data into it.
+		 * @param ref The origin BLOB.
+		 * @param offset Offset of the range in the origin BLOB.
+		 * @param length Length of the range.
+		 * @return
+		 */
+		static ibrcommon::BLOB::Reference view(const BLOB::Reference &ref, const std::streamsize offset, const std::streamsize length);
+
 		/**
 		 * Changes the BLOB provider.
 		 */
@@ -229,6 +243,66 @@ namespace ibrcommon
 		File _file;
 	};
 
+	/**
+	 * A RangeBLOB provides read access to a range of another BLOB. Writing
+	 * to the range is only possible after clear() which replaces the
+	 * range by a new BLOB.
+	 */
+	class RangeBLOB : public ibrcommon::BLOB
+	{
+	public:
+		RangeBLOB(const BLOB::Reference &origin, const std::streamsize offset, const std::streamsize length);
+		virtual ~RangeBLOB();
+
+		virtual void clear();
+
+		virtual void open();
+		virtual void close();
+
+	protected:
+		std::iostream &__get_stream();
+		std::streamsize __get_size();
+
+	private:
+		class rangebuf : public std::streambuf
+		{
+		public:
+			rangebuf(const std::streamsize offset, const std::streamsize length);
+			virtual ~rangebuf();
+
+			void attach(std::istream *origin);
+
+		protected:
+			virtual int_type underflow();
+			virtual pos_type seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out);
+			virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out);
+
+		private:
+			std::istream *_origin;
+			const std::streamsize _offset;
+			const std::streamsize _length;
+
+			// position of the end of the buffer in the range
+			std::streamsize _pos;
+
+			// true, if the origin stream is positioned at _pos
+			bool _synced;
+
+			// read buffer, allocated on the first read
+			std::vector<char> _buffer;
+		};
+
+		BLOB::Reference _origin;
+		BLOB::iostream *_origin_stream;
+
+		// true, if the data has been replaced by an own BLOB
+		bool _detached;
+
+		const std::streamsize _length;
+		rangebuf _buf;
+		std::iostream _stream;
+	};
+
 	class MemoryBLOBProvider : public ibrcommon::BLOB::Provider
 	{
 	public:
@@ -48,6 +48,17 @@
 #include <signal.h>
 #include <unistd.h>
 
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#include <poll.h>
+#include <time.h>
+#include <vector>
+#endif
+
+#ifdef HAVE_SYS_EVENTFD_H
+#include <sys/eventfd.h>
+#endif
+
 namespace ibrcommon
 {
 #ifdef __WIN32__
@@ -181,6 +192,44 @@ namespace ibrcommon
 	}
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+	// max. number of events returned by one epoll_wait() call
+	static const int EPOLL_MAX_EVENTS = 64;
+
+	static void __deadline(struct timespec &deadline, const struct timeval &tv)
+	{
+		::clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec += tv.tv_sec;
+		deadline.tv_nsec += tv.tv_usec * 1000;
+
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	/**
+	 * Store the time left until the deadline in the timeval
+	 * like select() does and return it in milliseconds.
+	 */
+	static int __remaining(const struct timespec &deadline, struct timeval &tv)
+	{
+		struct timespec now;
+		::clock_gettime(CLOCK_MONOTONIC, &now);
+
+		long long left = (static_cast<long long>(deadline.tv_sec) - now.tv_sec) * 1000000LL
+				+ (deadline.tv_nsec - now.tv_nsec) / 1000;
+
+		if (left < 0) left = 0;
+
+		tv.tv_sec = static_cast<time_t>(left / 1000000LL);
+		tv.tv_usec = static_cast<suseconds_t>(left % 1000000LL);
+
+		// round up to not return before the deadline
+		return static_cast<int>((left + 999) / 1000);
+	}
+#endif
+
 	vsocket::pipesocket::pipesocket()
 	 : _output_fd(-1)
 	{ }
@@ -200,6 +249,17 @@ namespace ibrcommon
 		if (_state != SOCKET_DOWN)
 			throw socket_exception("socket is already up");
 
+#ifdef HAVE_SYS_EVENTFD_H
+		// an eventfd is the input and output of the interruption
+		_fd = ::eventfd(0, EFD_NONBLOCK);
+		if (_fd < 0)
+		{
+			IBRCOMMON_LOGGER_TAG("pipesocket", error) << "Error " << errno << " creating eventfd" << IBRCOMMON_LOGGER_ENDL;
+			throw socket_exception("failed to create eventfd");
+		}
+
+		_output_fd = _fd;
+#else
 		int pipe_fds[2];
 
 		// create a pipe for interruption
@@ -214,6 +274,7 @@ namespace ibrcommon
 
 		this->set_blocking_mode(false);
 		this->set_blocking_mode(false, _output_fd);
+#endif
 
 		_state = SOCKET_UP;
 	}
@@ -224,25 +285,44 @@ namespace ibrcommon
 			throw socket_exception("socket is not up");
 
 		this->close();
+#ifndef HAVE_SYS_EVENTFD_H
 		::close(_output_fd);
+#endif
+		_output_fd = -1;
 
 		_state = SOCKET_DOWN;
 	}
 
 	void vsocket::pipesocket::read(char *buf, size_t len) throw (socket_exception)
 	{
+#ifdef HAVE_SYS_EVENTFD_H
+		// reset the counter of the eventfd
+		eventfd_t value = 0;
+		if (::eventfd_read(this->fd(), &value) == -1)
+		{
+			// another select call has consumed the interruption
+			if (errno == EAGAIN) return;
+			throw socket_exception("read error");
+		}
+#else
 		ssize_t ret = piperead(this->fd(), buf, len);
 		if (ret == -1)
 			throw socket_exception("read error");
 		if (ret == 0)
 			throw socket_exception("end of file");
+#endif
 	}
 
 	void vsocket::pipesocket::write(const char *buf, size_t len) throw (socket_exception)
 	{
+#ifdef HAVE_SYS_EVENTFD_H
+		if (::eventfd_write(_output_fd, 1) == -1)
+			throw socket_exception("write error");
+#else
 		ssize_t ret = pipewrite(_output_fd, buf, len);
 		if (ret == -1)
 			throw socket_exception("write error");
+#endif
 	}
 
 	vsocket::SocketState::SocketState(STATE initial)
@@ -555,13 +635,39 @@ namespace ibrcommon
 	}
 
 	vsocket::vsocket()
-	 : _state(SocketState::DOWN), _select_count(0)
+	 : _state(SocketState::DOWN), _select_count(0), _epoll_fd(-1), _epoll_dirty(true), _trigger(LEVEL_TRIGGERED)
 	{
 		_pipe.up();
+
+#ifdef HAVE_SYS_EPOLL_H
+		_epoll_fd = ::epoll_create(EPOLL_MAX_EVENTS);
+
+		if (_epoll_fd != -1)
+		{
+			// the interruption is always level-triggered and has no socket assigned
+			struct epoll_event ev;
+			::memset(&ev, 0, sizeof ev);
+			ev.events = EPOLLIN;
+			ev.data.ptr = NULL;
+
+			if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _pipe.fd(), &ev) == -1)
+			{
+				::close(_epoll_fd);
+				_epoll_fd = -1;
+			}
+		}
+
+		if (_epoll_fd == -1)
+		{
+			IBRCOMMON_LOGGER_DEBUG_TAG("vsocket", 40) << "epoll not available (error " << errno << "), use select() instead" << IBRCOMMON_LOGGER_ENDL;
+		}
+#endif
 	}
 
 	vsocket::~vsocket()
 	{
+		if (_epoll_fd != -1) ::close(_epoll_fd);
+
 		try {
 			_pipe.down();
 		} catch (const socket_exception &ex) {
@@ -572,6 +678,7 @@ namespace ibrcommon
 	{
 		SafeLock l(_state, *this);
 		_sockets.insert(socket);
+		_epoll_dirty = true;
 	}
 
 	void vsocket::add(basesocket *socket, const vinterface &iface)
@@ -579,12 +686,14 @@ namespace ibrcommon
 		SafeLock l(_state, *this);
 		_sockets.insert(socket);
 		_socket_map[iface].insert(socket);
+		_epoll_dirty = true;
 	}
 
 	void vsocket::remove(basesocket *socket)
 	{
 		SafeLock l(_state, *this);
 		_sockets.erase(socket);
+		_epoll_dirty = true;
 
 		// search for the same socket in the map
 		for (std::map<vinterface, socketset>::iterator iter = _socket_map.begin(); iter != _socket_map.end(); ++iter)
@@ -604,6 +713,7 @@ namespace ibrcommon
 		SafeLock l(_state, *this);
 		_sockets.clear();
 		_socket_map.clear();
+		_epoll_dirty = true;
 	}
 
 	void vsocket::destroy()
@@ -617,6 +727,7 @@ namespace ibrcommon
 		}
 		_sockets.clear();
 		_socket_map.clear();
+		_epoll_dirty = true;
 	}
 
 	socketset vsocket::getAll() const
@@ -659,6 +770,12 @@ namespace ibrcommon
 			}
 		}
 
+		{
+			// register the new file descriptors on the next select call
+			ibrcommon::MutexLock l(_socket_lock);
+			_epoll_dirty = true;
+		}
+
 		// set state to IDLE
 		ibrcommon::MutexLock l(_state);
 		_state.set(SocketState::IDLE);
@@ -695,6 +812,7 @@ namespace ibrcommon
 					if ((*iter)->ready()) (*iter)->down();
 				} catch (const socket_exception&) { }
 			}
+			_epoll_dirty = true;
 		}
 
 		ibrcommon::MutexLock sl(_state);
@@ -706,7 +824,64 @@ namespace ibrcommon
 		_pipe.write("i", 1);
 	}
 
+	void vsocket::set_trigger_mode(TRIGGER_MODE mode)
+	{
+		SafeLock l(_state, *this);
+		ibrcommon::MutexLock sl(_socket_lock);
+
+		if (_trigger == mode) return;
+		_trigger = mode;
+
+#ifdef HAVE_SYS_EPOLL_H
+		// register all sockets again with the new mode
+		for (std::map<int, basesocket*>::const_iterator iter = _epoll_map.begin(); iter != _epoll_map.end(); ++iter)
+		{
+			::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, (*iter).first, NULL);
+		}
+		_epoll_map.clear();
+		_epoll_dirty = true;
+#endif
+	}
+
 	void vsocket::select(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv) throw (socket_exception)
+	{
+#ifdef HAVE_SYS_EPOLL_H
+		if (_epoll_fd != -1)
+		{
+			// the persistent registrations only monitor readable sockets
+			if ((writeset != NULL) || (errorset != NULL))
+			{
+				__poll(readset, writeset, errorset, tv);
+				return;
+			}
+
+			socketlist readable;
+			__epoll(readable, tv);
+
+			if (readset != NULL) readset->insert(readable.begin(), readable.end());
+			return;
+		}
+#endif
+
+		__select(readset, writeset, errorset, tv);
+	}
+
+	void vsocket::select(socketlist &readable, struct timeval *tv) throw (socket_exception)
+	{
+#ifdef HAVE_SYS_EPOLL_H
+		if (_epoll_fd != -1)
+		{
+			__epoll(readable, tv);
+			return;
+		}
+#endif
+
+		socketset readset;
+		__select(&readset, NULL, NULL, tv);
+		readable.insert(readable.end(), readset.begin(), readset.end());
+	}
+
+	void vsocket::__select(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv) throw (socket_exception)
 	{
 		fd_set fds_read;
 		fd_set fds_write;
@@ -734,6 +909,12 @@ namespace ibrcommon
 					basesocket &sock = (**iter);
 					if (!sock.ready()) continue;
 
+#ifndef __WIN32__
+					// fd_set can not hold this file descriptor
+					if (sock.fd() >= FD_SETSIZE)
+						throw socket_exception("file descriptor exceeds FD_SETSIZE");
+#endif
+
 					if (readset != NULL) {
 						FD_SET(sock.fd(), &fds_read);
 						if (high_fd < sock.fd()) high_fd = sock.fd();
@@ -822,4 +1003,215 @@ namespace ibrcommon
 			break;
 		}
 	}
+#ifdef HAVE_SYS_EPOLL_H
+	void vsocket::__poll(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv) throw (socket_exception)
+	{
+		std::vector<struct pollfd> fds;
+		socketlist socks;
+
+		struct timespec deadline;
+		if (tv != NULL) __deadline(deadline, *tv);
+
+		short events = 0;
+		if (readset != NULL) events |= POLLIN;
+		if (writeset != NULL) events |= POLLOUT;
+		if (errorset != NULL) events |= POLLPRI;
+
+		while (true)
+		{
+			SelectGuard guard(_state, _select_count, *this);
+
+			fds.clear();
+			socks.clear();
+
+			// add the interrupt fd
+			struct pollfd pfd;
+			pfd.fd = _pipe.fd();
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+			fds.push_back(pfd);
+
+			{
+				ibrcommon::MutexLock l(_socket_lock);
+				for (socketset::iterator iter = _sockets.begin(); iter != _sockets.end(); ++iter)
+				{
+					basesocket *sock = (*iter);
+					if (!sock->ready()) continue;
+
+					pfd.fd = sock->fd();
+					pfd.events = events;
+					fds.push_back(pfd);
+					socks.push_back(sock);
+				}
+			}
+
+			const int timeout = (tv == NULL) ? -1 : __remaining(deadline, *tv);
+			const int res = ::poll(&fds[0], fds.size(), timeout);
+
+			if (res < 0) {
+				// signal has been caught - handle it as interruption
+				if (errno == EINTR) continue;
+				throw socket_raw_error(errno, "unknown poll error");
+			}
+
+			if (tv != NULL) __remaining(deadline, *tv);
+
+			if (res == 0)
+				throw vsocket_timeout("select timeout");
+
+			if (fds[0].revents & POLLIN)
+			{
+				IBRCOMMON_LOGGER_DEBUG_TAG("vsocket::select", 90) << "unblocked by interrupt" << IBRCOMMON_LOGGER_ENDL;
+
+				ibrcommon::MutexLock l(_socket_lock);
+				char buf[2];
+				_pipe.read(buf, 2);
+
+				// start over with the poll call
+				continue;
+			}
+
+			ibrcommon::MutexLock l(_socket_lock);
+			for (size_t i = 0; i < socks.size(); ++i)
+			{
+				const short revents = fds[i + 1].revents;
+				if (revents == 0) continue;
+
+				if (revents & POLLNVAL)
+					throw socket_error(ERROR_CLOSED, "socket was closed");
+
+				// like select, report failed sockets as readable and writable
+				if ((readset != NULL) && (revents & (POLLIN | POLLHUP | POLLERR)))
+					readset->insert(socks[i]);
+
+				if ((writeset != NULL) && (revents & (POLLOUT | POLLHUP | POLLERR)))
+					writeset->insert(socks[i]);
+
+				if ((errorset != NULL) && (revents & POLLPRI))
+					errorset->insert(socks[i]);
+			}
+
+			break;
+		}
+	}
+
+	void vsocket::__epoll(socketlist &readable, struct timeval *tv) throw (socket_exception)
+	{
+		struct epoll_event events[EPOLL_MAX_EVENTS];
+
+		struct timespec deadline;
+		if (tv != NULL) __deadline(deadline, *tv);
+
+		while (true)
+		{
+			SelectGuard guard(_state, _select_count, *this);
+
+			{
+				ibrcommon::MutexLock l(_socket_lock);
+				__epoll_sync();
+			}
+
+			const int timeout = (tv == NULL) ? -1 : __remaining(deadline, *tv);
+			const int res = ::epoll_wait(_epoll_fd, events, EPOLL_MAX_EVENTS, timeout);
+
+			if (res < 0) {
+				// signal has been caught - handle it as interruption
+				if (errno == EINTR) continue;
+				throw socket_raw_error(errno, "unknown epoll error");
+			}
+
+			if (tv != NULL) __remaining(deadline, *tv);
+
+			if (res == 0)
+				throw vsocket_timeout("select timeout");
+
+			ibrcommon::MutexLock l(_socket_lock);
+
+			bool interrupted = false;
+			const size_t offset = readable.size();
+
+			for (int i = 0; i < res; ++i)
+			{
+				basesocket *sock = static_cast<basesocket*>(events[i].data.ptr);
+
+				if (sock == NULL) {
+					interrupted = true;
+					continue;
+				}
+
+				// the socket has been removed or closed since the registration
+				if ((_sockets.find(sock) == _sockets.end()) || !sock->ready()) {
+					_epoll_dirty = true;
+					continue;
+				}
+
+				readable.push_back(sock);
+			}
+
+			if (interrupted)
+			{
+				IBRCOMMON_LOGGER_DEBUG_TAG("vsocket::select", 90) << "unblocked by interrupt" << IBRCOMMON_LOGGER_ENDL;
+
+				char buf[2];
+				_pipe.read(buf, 2);
+			}
+
+			// Return the readable sockets even if interrupted, in edge-triggered
+			// mode they would not be reported again. Otherwise start over.
+			if (readable.size() == offset) continue;
+
+			break;
+		}
+	}
+
+	void vsocket::__epoll_sync()
+	{
+		if (!_epoll_dirty) return;
+
+		// drop the registrations of removed sockets and closed file descriptors
+		for (std::map<int, basesocket*>::iterator iter = _epoll_map.begin(); iter != _epoll_map.end();)
+		{
+			basesocket *sock = (*iter).second;
+
+			if ((_sockets.find(sock) != _sockets.end()) && sock->ready() && (sock->fd() == (*iter).first)) {
+				++iter;
+				continue;
+			}
+
+			// fails if the file descriptor has been closed already
+			::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, (*iter).first, NULL);
+			_epoll_map.erase(iter++);
+		}
+
+		// register all sockets not monitored yet
+		for (socketset::iterator iter = _sockets.begin(); iter != _sockets.end(); ++iter)
+		{
+			basesocket *sock = (*iter);
+			if (!sock->ready()) continue;
+
+			const int fd = sock->fd();
+			if (_epoll_map.find(fd) != _epoll_map.end()) continue;
+
+			struct epoll_event ev;
+			::memset(&ev, 0, sizeof ev);
+			ev.events = EPOLLIN;
+			if (_trigger == EDGE_TRIGGERED) ev.events |= EPOLLET;
+			ev.data.ptr = sock;
+
+			if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1)
+			{
+				// a closed file descriptor may be still registered
+				if ((errno != EEXIST) || (::epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &ev) == -1))
+				{
+					IBRCOMMON_LOGGER_TAG("vsocket", error) << "failed to register file descriptor " << fd << " (error " << errno << ")" << IBRCOMMON_LOGGER_ENDL;
+					continue;
+				}
+			}
+
+			_epoll_map[fd] = sock;
+		}
+
+		_epoll_dirty = false;
+	}
+#endif
 }
@@ -33,6 +33,7 @@
 #include <list>
 #include <set>
 #include <map>
+#include <vector>
 
 namespace ibrcommon
 {
@@ -41,6 +42,11 @@ namespace ibrcommon
 	 */
 	typedef std::set<basesocket*> socketset;
 
+	/**
+	 * socketlist is the ready-list of a select call
+	 */
+	typedef std::vector<basesocket*> socketlist;
+
 	class vsocket_timeout : public socket_exception
 	{
 	public:
@@ -55,9 +61,21 @@ namespace ibrcommon
 		{};
 	};
 
+	/**
+	 * The vsocket multiplexes a set of sockets. On systems with epoll the
+	 * sockets are registered persistently and a select call does not depend
+	 * on the number of sockets nor on the value of their file descriptors.
+	 * Everywhere else select() is used as fallback.
+	 */
 	class vsocket
 	{
 	public:
+		enum TRIGGER_MODE
+		{
+			LEVEL_TRIGGERED = 0,
+			EDGE_TRIGGERED = 1
+		};
+
 		/**
 		 * Constructor
 		 */
@@ -135,6 +153,22 @@ namespace ibrcommon
 		 */
 		void select(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv = NULL) throw (socket_exception);
 
+		/**
+		 * Wait until at least one of the associated sockets is readable.
+		 * @param readable Ready-list the readable sockets are appended to
+		 * @param tv Timeout of the call, decremented by the time spent waiting
+		 */
+		void select(socketlist &readable, struct timeval *tv = NULL) throw (socket_exception);
+
+		/**
+		 * Set the trigger mode for readable sockets. In edge-triggered mode
+		 * a socket is reported once when new data arrives, thus the caller
+		 * has to read until the socket would block. Without epoll the
+		 * sockets are always level-triggered.
+		 * @param mode The trigger mode
+		 */
+		void set_trigger_mode(TRIGGER_MODE mode);
+
 	private:
 		class pipesocket : public basesocket
 		{
@@ -213,6 +247,11 @@ namespace ibrcommon
 
 		void interrupt();
 
+		void __select(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv) throw (socket_exception);
+		void __poll(socketset *readset, socketset *writeset, socketset *errorset, struct timeval *tv) throw (socket_exception);
+		void __epoll(socketlist &readable, struct timeval *tv) throw (socket_exception);
+		void __epoll_sync();
+
 		ibrcommon::Mutex _socket_lock;
 		socketset _sockets;
 		std::map<vinterface, socketset> _socket_map;
@@ -221,6 +260,17 @@ namespace ibrcommon
 
 		SocketState _state;
 		int _select_count;
+
+		// epoll instance, -1 if select() is used
+		int _epoll_fd;
+
+		// registered file descriptors and their sockets
+		std::map<int, basesocket*> _epoll_map;
+
+		// true, if the registrations do not match the socket set
+		bool _epoll_dirty;
+
+		TRIGGER_MODE _trigger;
 	};
 }
 
@@ -43,10 +43,18 @@ namespace ibrcommon
 	bool TLSStream::_initialized = false;
 	bool TLSStream::_SSL_initialized = false;
 	ibrcommon::Mutex TLSStream::_initialization_lock;
+	bool TLSStream::_kernel_offload = false;
+
+	TLSStream::session_map TLSStream::_sessions;
+	ibrcommon::Mutex TLSStream::_session_lock;
+
+	/* sessions are only resumed by peers using the same context */
+	static const unsigned char session_id_context[] = "ibrcommon-tls";
 
 	TLSStream::TLSStream(std::iostream *stream)
 	  : iostream(this), _activated(false), in_buf_(BUFF_SIZE), out_buf_(BUFF_SIZE),
-	    _stream(stream), _server(false), _ssl(NULL), _peer_cert(NULL), _iostreamBIO(NULL)
+	    _stream(stream), _server(false), _fd(-1), _resumed(false), _offloaded(false),
+	    _ssl(NULL), _peer_cert(NULL), _iostreamBIO(NULL)
 	{
 		/* basic_streambuf related initialization */
 		// Initialize get pointer.  This should be zero so that underflow is called upon first read.
@@ -65,6 +73,40 @@ namespace ibrcommon
 		_server = val;
 	}
 
+	void TLSStream::setPeerId(const std::string &id)
+	{
+		_peer_id = id;
+	}
+
+	void TLSStream::setDescriptor(int fd)
+	{
+		_fd = fd;
+	}
+
+	bool TLSStream::isResumed() const
+	{
+		return _resumed;
+	}
+
+	bool TLSStream::isKernelOffloaded() const
+	{
+		return _offloaded;
+	}
+
+	void TLSStream::setKernelOffload(bool val)
+	{
+		ibrcommon::MutexLock l(_initialization_lock);
+		_kernel_offload = val;
+	}
+
+	void TLSStream::__cleanup()
+	{
+		if (_iostreamBIO != NULL) delete _iostreamBIO;
+		_iostreamBIO = NULL;
+		SSL_free(_ssl);
+		_ssl = NULL;
+	}
+
 	X509 *TLSStream::activate()
 	{
 		long error;
@@ -98,21 +140,54 @@ namespace ibrcommon
 			SSL_set_connect_state(_ssl);
 		}
 
-		/* create and assign BIO object */
-		try{
-			_iostreamBIO = new iostreamBIO(_stream);
-			//_bio = iostreamBIO::getBIO(_stream);
-		} catch(iostreamBIO::BIOException &ex){
-			throw BIOCreationException(ex.what());
+		/* give the session callback access to this stream */
+		SSL_set_app_data(_ssl, this);
+
+		/* offer the cached session of this peer for resumption */
+		if (!_server && !_peer_id.empty())
+		{
+			ibrcommon::MutexLock l(_session_lock);
+			session_map::const_iterator iter = _sessions.find(_peer_id);
+			if (iter != _sessions.end()) SSL_set_session(_ssl, (*iter).second);
 		}
-		try{
-			SSL_set_bio(_ssl, _iostreamBIO->getBIO(), _iostreamBIO->getBIO());
-		} catch(BIOCreationException &ex){
-			if (_iostreamBIO != NULL) delete _iostreamBIO;
-			_iostreamBIO = NULL;
-			SSL_free(_ssl);
-			_ssl = NULL;
-			throw;
+
+		/* hand the socket to openssl if the records should be processed by the kernel,
+		 * this is only possible if the underlying stream does not hold any received data */
+		bool offload = false;
+#ifdef SSL_OP_ENABLE_KTLS
+		offload = _kernel_offload && (_fd >= 0) && (_stream->rdbuf()->in_avail() <= 0);
+#endif
+
+		if (offload)
+		{
+#ifdef SSL_OP_ENABLE_KTLS
+			/* send all pending data of the underlying stream */
+			_stream->flush();
+
+			SSL_set_options(_ssl, SSL_OP_ENABLE_KTLS);
+			if (SSL_set_fd(_ssl, _fd) != 1) {
+				__cleanup();
+				throw BIOCreationException("Could not assign the socket descriptor.");
+			}
+#endif
+		}
+		else
+		{
+			/* create and assign BIO object */
+			try{
+				_iostreamBIO = new iostreamBIO(_stream);
+				//_bio = iostreamBIO::getBIO(_stream);
+			} catch(iostreamBIO::BIOException &ex){
+				SSL_free(_ssl);
+				_ssl = NULL;
+				throw BIOCreationException(ex.what());
+			}
+			try{
+				SSL_set_bio(_ssl, _iostreamBIO->getBIO(), _iostreamBIO->getBIO());
+			} catch(BIOCreationException &ex){
+				__cleanup();
+				throw;
+			}
 		}
 
 		/* perform TLS Handshake */
@@ -122,11 +197,11 @@ namespace ibrcommon
 
 			IBRCOMMON_LOGGER_TAG(TLSStream::TAG, error) << "TLS handshake failed: " << log_error_msg(errcode) << IBRCOMMON_LOGGER_ENDL;
 
+			/* do not try to resume this session again */
+			if (!_server) __forget_session(_peer_id);
+
 			/* cleanup */
-			if (_iostreamBIO != NULL) delete _iostreamBIO;
-			_iostreamBIO = NULL;
-			SSL_free(_ssl);
-			_ssl = NULL;
+			__cleanup();
 			throw TLSHandshakeException(log_error_msg(errcode));
 		}
 
@@ -137,19 +212,84 @@ namespace ibrcommon
 				X509_free(_peer_cert);
 				_peer_cert = NULL;
 			}
-			if (_iostreamBIO != NULL) delete _iostreamBIO;
-			_iostreamBIO = NULL;
-			SSL_free(_ssl);
-			_ssl = NULL;
+			if (!_server) __forget_session(_peer_id);
+			__cleanup();
 			std::stringstream ss; ss << "Certificate verification error " << error << ".";
 			throw TLSCertificateVerificationException(ss.str());
 		}
 
+		_resumed = (SSL_session_reused(_ssl) == 1);
+
+#ifdef SSL_OP_ENABLE_KTLS
+		if (offload) {
+			_offloaded = (BIO_get_ktls_send(SSL_get_wbio(_ssl)) == 1);
+		}
+#endif
+
+		IBRCOMMON_LOGGER_DEBUG_TAG(TLSStream::TAG, 40) << "TLS established using " << SSL_get_version(_ssl)
+				<< (_resumed ? ", session resumed" : "")
+				<< (_offloaded ? ", kernel offload" : "") << IBRCOMMON_LOGGER_ENDL;
+
 		_activated = true;
 
 		return _peer_cert;
 	}
 
+	int TLSStream::__new_session(SSL *ssl, SSL_SESSION *session)
+	{
+		TLSStream *stream = static_cast<TLSStream*>(SSL_get_app_data(ssl));
+
+		/* only client sessions are cached, the server uses the internal cache and tickets */
+		if ((stream == NULL) || stream->_server || stream->_peer_id.empty()) return 0;
+
+		ibrcommon::MutexLock l(_session_lock);
+
+		session_map::iterator iter = _sessions.find(stream->_peer_id);
+		if (iter != _sessions.end())
+		{
+			SSL_SESSION_free((*iter).second);
+			(*iter).second = session;
+		}
+		else
+		{
+			/* drop any session if the cache is full */
+			if (_sessions.size() >= MAX_SESSIONS)
+			{
+				SSL_SESSION_free((*_sessions.begin()).second);
+				_sessions.erase(_sessions.begin());
+			}
+
+			_sessions[stream->_peer_id] = session;
+		}
+
+		/* we keep the reference of the session */
+		return 1;
+	}
+
+	void TLSStream::__forget_session(const std::string &id)
+	{
+		if (id.empty()) return;
+
+		ibrcommon::MutexLock l(_session_lock);
+
+		session_map::iterator iter = _sessions.find(id);
+		if (iter == _sessions.end()) return;
+
+		SSL_SESSION_free((*iter).second);
+		_sessions.erase(iter);
+	}
+
+	void TLSStream::flushSessions()
+	{
+		ibrcommon::MutexLock l(_session_lock);
+
+		for (session_map::iterator iter = _sessions.begin(); iter != _sessions.end(); ++iter)
+		{
+			SSL_SESSION_free((*iter).second);
+		}
+		_sessions.clear();
+	}
+
 	TLSStream::traits::int_type TLSStream::underflow()
 	{
 		int num_bytes = 0;
@@ -267,8 +407,13 @@ namespace ibrcommon
 		}
 
 
-		/* create ssl context and throw exception if it fails */
-		_ssl_ctx = SSL_CTX_new(TLSv1_method());
+		/* create ssl context and throw exception if it fails,
+		 * the highest protocol version supported by both peers is negotiated */
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+		_ssl_ctx = SSL_CTX_new(TLS_method());
+#else
+		_ssl_ctx = SSL_CTX_new(SSLv23_method());
+#endif
 		if(!_ssl_ctx){
 			char err_buf[ERR_BUF_SIZE];
 			ERR_error_string_n(ERR_get_error(), err_buf, ERR_BUF_SIZE);
@@ -277,6 +422,14 @@ namespace ibrcommon
 			throw ContextCreationException(err_buf);
 		}
 
+		/* never fall back to SSL */
+		SSL_CTX_set_options(_ssl_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+
+		/* enable session resumption, clients keep their sessions per peer (see setPeerId()) */
+		SSL_CTX_set_session_cache_mode(_ssl_ctx, SSL_SESS_CACHE_BOTH);
+		SSL_CTX_set_session_id_context(_ssl_ctx, session_id_context, sizeof(session_id_context) - 1);
+		SSL_CTX_sess_set_new_cb(_ssl_ctx, TLSStream::__new_session);
+
 		/* set verification mode */
 		/* client and server require a valid certificate or the handshake fails */
 		SSL_CTX_set_verify(_ssl_ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
@@ -330,7 +483,16 @@ namespace ibrcommon
 		}
 
 		if(!enableEncryption){
-			if(!SSL_CTX_set_cipher_list(_ssl_ctx, "eNULL")){
+#ifdef TLS1_3_VERSION
+			/* TLS 1.3 does not define cipher suites without encryption */
+			SSL_CTX_set_max_proto_version(_ssl_ctx, TLS1_2_VERSION);
+#endif
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+			const char *cipher_list = "eNULL:@SECLEVEL=0";
+#else
+			const char *cipher_list = "eNULL";
+#endif
+			if(!SSL_CTX_set_cipher_list(_ssl_ctx, cipher_list)){
 				IBRCOMMON_LOGGER_TAG(TLSStream::TAG, critical) << "Could not set the cipherlist." << IBRCOMMON_LOGGER_ENDL;
 			}
 		}
@@ -345,6 +507,9 @@ namespace ibrcommon
 		if(!_initialized)
 			return;
 
+		/* cached sessions belong to the context */
+		flushSessions();
+
 		/* remove the SSL Context */
 		if(_ssl_ctx){
 			SSL_CTX_free(_ssl_ctx);
@@ -370,6 +535,9 @@ namespace ibrcommon
 					IBRCOMMON_LOGGER_DEBUG_TAG(TLSStream::TAG, 60) << "SSL_shutdown error " << log_error_msg(SSL_get_error(_ssl, ret)) << IBRCOMMON_LOGGER_ENDL;
 				}
 			}
+
+			/* make sure the close notify is sent */
+			_stream->flush();
 		}
 		IBRCOMMON_LOGGER_DEBUG_TAG(TLSStream::TAG, 60) << "Connection closed." << IBRCOMMON_LOGGER_ENDL;
 	}
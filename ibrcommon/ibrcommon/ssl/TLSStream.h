@@ -26,6 +26,8 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <map>
+#include <string>
 #include <openssl/ssl.h>
 #include "ibrcommon/thread/Mutex.h"
 #include "ibrcommon/data/File.h"
@@ -63,6 +65,34 @@ namespace ibrcommon
 		 */
 		void setServer(bool val);
 
+		/**
+		 * Set the identifier of the peer (e.g. its EID). In client mode the
+		 * TLS session negotiated with a peer is cached under this identifier
+		 * and resumed on the next connection to the same peer.
+		 * @param id
+		 */
+		void setPeerId(const std::string &id);
+
+		/**
+		 * Set the descriptor of the underlying socket. If kernel TLS offload
+		 * is enabled, the TLS records are handled by the kernel on this socket
+		 * instead of passing them through the underlying stream.
+		 * @param fd
+		 */
+		void setDescriptor(int fd);
+
+		/**
+		 * Returns true if the last handshake resumed a cached session
+		 */
+		bool isResumed() const;
+
+		/**
+		 * Returns true if the transmission of records is offloaded to the kernel.
+		 * In this case data written to the socket descriptor (e.g. by sendfile)
+		 * is encrypted by the kernel.
+		 */
+		bool isKernelOffloaded() const;
+
 		/*!
 		 * \brief Initializes the TLSStream class
 		 * \param certificate The certificate for the private Key
@@ -82,6 +112,18 @@ namespace ibrcommon
 	     */
 	    static void flushInitialization();
 
+	    /**
+	     * Enable or disable the offload of TLS records to the kernel (kTLS)
+	     * if it is supported by the system and the openssl library. This has to
+	     * be called before init().
+	     */
+	    static void setKernelOffload(bool val);
+
+	    /**
+	     * Remove all cached client sessions
+	     */
+	    static void flushSessions();
+
 		/*!
 		 * \brief checks if the Class is already initialized.
 		 * \return true if its initialized, false otherwise
@@ -94,8 +136,12 @@ namespace ibrcommon
 	     */
 	    void close();
 
-		/// The size of the input and output buffers.
-		static const size_t BUFF_SIZE = 5120;
+		/// The size of the input and output buffers. This is the max. size of a TLS record,
+		/// so a full buffer is sent as one record.
+		static const size_t BUFF_SIZE = 16384;
+
+		/// The max. number of cached client sessions
+		static const size_t MAX_SESSIONS = 256;
 
 		/*!
 		 * \return the X509 certificate of the peer
@@ -111,10 +157,31 @@ namespace ibrcommon
 	private:
 		std::string log_error_msg(int errnumber);
 
+		/**
+		 * Release all resources of a failed activation
+		 */
+		void __cleanup();
+
+		/**
+		 * Called by openssl if a new session has been negotiated
+		 */
+		static int __new_session(SSL *ssl, SSL_SESSION *session);
+
+		/**
+		 * Remove the cached session of a peer
+		 */
+		static void __forget_session(const std::string &id);
+
 		static bool _initialized;
 		/* this second initialized variable is needed, because init() can fail and SSL_library_init() is not reentrant. */
 		static bool _SSL_initialized;
 		static ibrcommon::Mutex _initialization_lock;
+		static bool _kernel_offload;
+
+		// cached client sessions by peer identifier
+		typedef std::map<std::string, SSL_SESSION*> session_map;
+		static session_map _sessions;
+		static ibrcommon::Mutex _session_lock;
 
 		bool _activated;
 		ibrcommon::Mutex _activation_lock;
@@ -128,6 +195,11 @@ namespace ibrcommon
 		/* indicates if this node is the server in the underlying tcp connection */
 		bool _server;
 
+		std::string _peer_id;
+		int _fd;
+		bool _resumed;
+		bool _offloaded;
+
 		static SSL_CTX *_ssl_ctx;
 		SSL *_ssl;
 		X509 *_peer_cert;
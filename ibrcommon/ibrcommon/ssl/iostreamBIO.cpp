@@ -22,6 +22,7 @@
 #include "ibrcommon/ssl/iostreamBIO.h"
 
 #include "ibrcommon/Logger.h"
+#include "ibrcommon/thread/MutexLock.h"
 
 #include <openssl/err.h>
 
@@ -43,6 +44,7 @@ static int create(BIO *bio);
 //static long (*callback_ctrl)(BIO *, int, bio_info_cb *);
 
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
 static BIO_METHOD iostream_method =
 {
 		iostreamBIO::type,
@@ -57,11 +59,60 @@ static BIO_METHOD iostream_method =
 		NULL//callback_ctrl
 };
 
+static BIO_METHOD* get_method()
+{
+	return &iostream_method;
+}
+
+static void set_data(BIO *bio, void *ptr)
+{
+	bio->ptr = ptr;
+}
+
+static void* get_data(BIO *bio)
+{
+	return bio->ptr;
+}
+#else
+/* since OpenSSL 1.1 the BIO_METHOD is opaque and has to be created once */
+static BIO_METHOD *iostream_method = NULL;
+static ibrcommon::Mutex iostream_method_lock;
+
+static BIO_METHOD* get_method()
+{
+	ibrcommon::MutexLock l(iostream_method_lock);
+
+	if (iostream_method == NULL)
+	{
+		iostream_method = BIO_meth_new(iostreamBIO::type | BIO_get_new_index(), iostreamBIO::name);
+		if (iostream_method == NULL) return NULL;
+
+		BIO_meth_set_write(iostream_method, bwrite);
+		BIO_meth_set_read(iostream_method, bread);
+		BIO_meth_set_ctrl(iostream_method, ctrl);
+		BIO_meth_set_create(iostream_method, create);
+	}
+
+	return iostream_method;
+}
+
+static void set_data(BIO *bio, void *ptr)
+{
+	BIO_set_data(bio, ptr);
+}
+
+static void* get_data(BIO *bio)
+{
+	return BIO_get_data(bio);
+}
+#endif
+
 iostreamBIO::iostreamBIO(iostream *stream)
 	:	_stream(stream)
 {
 	/* create BIO */
-	_bio = BIO_new(&iostream_method);
+	BIO_METHOD *method = get_method();
+	_bio = (method == NULL) ? NULL : BIO_new(method);
 	if(!_bio){
 		/* creation failed, throw exception */
 		char err_buf[ERR_BUF_SIZE];
@@ -72,7 +123,7 @@ iostreamBIO::iostreamBIO(iostream *stream)
 	}
 
 	/* save the iostream in the bio object */
-	_bio->ptr = stream;
+	set_data(_bio, stream);
 }
 
 BIO * iostreamBIO::getBIO(){
@@ -81,18 +132,22 @@ BIO * iostreamBIO::getBIO(){
 
 static int create(BIO *bio)
 {
-	bio->ptr = NULL;
+	set_data(bio, NULL);
 	/* (from openssl memory bio) */
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
 	bio->shutdown=1;
 	bio->init=1;
+#else
+	BIO_set_shutdown(bio, 1);
+	BIO_set_init(bio, 1);
+#endif
 	/* from bss_mem.c (openssl):
-	 * bio->num is used to hold the value to return on 'empty', if it is
-	 * 0, should_retry is not set
+	 * the value returned on 'empty' is 0 and should_retry is not set
 	 *
 	 * => -1 means the caller can retry, 0: retry is useless
 	 * it is set to 0 since the underlying stream is blocking
+	 * (see bread())
 	 */
-	bio->num= 0;
 
 	return 1;
 }
@@ -102,7 +157,7 @@ static int create(BIO *bio)
 static long ctrl(BIO *bio, int cmd, long  num, void *)
 {
 	long ret;
-	iostream *stream = reinterpret_cast<iostream*>(bio->ptr);
+	iostream *stream = reinterpret_cast<iostream*>(get_data(bio));
 
 	IBRCOMMON_LOGGER_DEBUG_TAG("iostreamBIO", 90) << "ctrl called, cmd: " << cmd << ", num: " << num << "." << IBRCOMMON_LOGGER_ENDL;
 
@@ -134,8 +189,14 @@ static long ctrl(BIO *bio, int cmd, long  num, void *)
 			ret = 0;
 		}
 		break;
+	case BIO_CTRL_PENDING:
+	case BIO_CTRL_WPENDING:
+		/* data is buffered in the underlying stream only */
+		ret = 0;
+		break;
 	default:
-		IBRCOMMON_LOGGER_TAG("iostreamBIO", warning) << "ctrl called with unhandled cmd: " << cmd << "." << IBRCOMMON_LOGGER_ENDL;
+		/* newer versions of openssl probe for several features (e.g. kernel tls) */
+		IBRCOMMON_LOGGER_DEBUG_TAG("iostreamBIO", 90) << "ctrl called with unhandled cmd: " << cmd << "." << IBRCOMMON_LOGGER_ENDL;
 		ret = 0;
 		break;
 	}
@@ -147,14 +208,14 @@ static long ctrl(BIO *bio, int cmd, long  num, void *)
 
 static int bread(BIO *bio, char *buf, int len)
 {
-	iostream *stream = reinterpret_cast<iostream*>(bio->ptr);
-	int num_bytes = bio->num;
+	iostream *stream = reinterpret_cast<iostream*>(get_data(bio));
+	int num_bytes = 0;
 
 	try{
 		/* make sure to read at least 1 byte and then read as much as we can */
 		num_bytes = static_cast<int>( stream->read(buf, 1).readsome(buf+1, len-1) + 1 );
 	} catch(ios_base::failure &ex){
-		/* ignore, bio->num will be returned and indicate the error */
+		/* ignore, zero will be returned and indicate the error */
 	}
 //	catch(ConnectionClosedException &ex){
 //		throw; //this exception will be catched at higher layers
@@ -170,7 +231,7 @@ static int bwrite(BIO *bio, const char *buf, int len)
 	if(len == 0){
 		return 0;
 	}
-	iostream *stream = reinterpret_cast<iostream*>(bio->ptr);
+	iostream *stream = reinterpret_cast<iostream*>(get_data(bio));
 
 	/* write the data */
 	try{
@@ -186,19 +247,9 @@ static int bwrite(BIO *bio, const char *buf, int len)
 		return 0;
 	}
 
-	/* flush the underlying stream */
-	try{
-		stream->flush();
-	} catch(ios_base::failure &ex){
-		/* ignore, the badbit is checked instead */
-	}
-//	catch(ConnectionClosedException &ex){
-//		throw;
-//	}
-	if(stream->bad()){
-		IBRCOMMON_LOGGER_DEBUG_TAG("iostreamBIO", 20) << "underlying Stream went bad while flushing (bwrite)." << IBRCOMMON_LOGGER_ENDL;
-		return 0;
-	}
+	/* the underlying stream is not flushed here, thus multiple records are
+	 * batched until openssl requests a flush (e.g. at the end of a handshake
+	 * flight) or the TLSStream is synchronized */
 
 	return len;
 }
@@ -0,0 +1,227 @@
+/*
+ * vsockettest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "net/vsockettest.h"
+#include "ibrcommon/config.h"
+#include "ibrcommon/net/vsocket.h"
+#include "ibrcommon/net/socket.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <unistd.h>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (vsockettest);
+
+/**
+ * Create a connected pair of sockets. The first one is added to
+ * the vsocket, the second one is returned for writing.
+ */
+static int create_pair(ibrcommon::vsocket &vs, ibrcommon::filesocket **sock)
+{
+	int fds[2];
+	CPPUNIT_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	*sock = new ibrcommon::filesocket(fds[0]);
+	vs.add(*sock);
+
+	return fds[1];
+}
+
+void vsockettest :: setUp (void)
+{
+}
+
+void vsockettest :: tearDown (void)
+{
+}
+
+void vsockettest :: readyListTest (void)
+{
+	ibrcommon::vsocket vs;
+	std::vector<ibrcommon::filesocket*> socks(16);
+	std::vector<int> peers(16);
+
+	for (size_t i = 0; i < socks.size(); ++i)
+	{
+		peers[i] = create_pair(vs, &socks[i]);
+	}
+
+	vs.up();
+
+	// make three sockets readable
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(peers[2], "a", 1));
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(peers[7], "b", 1));
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(peers[13], "c", 1));
+
+	ibrcommon::socketlist readable;
+	vs.select(readable);
+	CPPUNIT_ASSERT_EQUAL((size_t)3, readable.size());
+
+	// the set based select returns the same sockets
+	ibrcommon::socketset readset;
+	vs.select(&readset, NULL, NULL);
+	CPPUNIT_ASSERT_EQUAL((size_t)3, readset.size());
+	CPPUNIT_ASSERT(readset.find(socks[7]) != readset.end());
+
+	// writable sockets are reported too
+	ibrcommon::socketset writeset;
+	vs.select(NULL, &writeset, NULL);
+	CPPUNIT_ASSERT_EQUAL((size_t)16, writeset.size());
+
+	vs.destroy();
+
+	for (size_t i = 0; i < peers.size(); ++i) ::close(peers[i]);
+}
+
+void vsockettest :: timeoutTest (void)
+{
+	ibrcommon::vsocket vs;
+	ibrcommon::filesocket *sock = NULL;
+	int peer = create_pair(vs, &sock);
+
+	vs.up();
+
+	struct timeval tv;
+	tv.tv_sec = 0;
+	tv.tv_usec = 100000;
+
+	ibrcommon::socketlist readable;
+	CPPUNIT_ASSERT_THROW(vs.select(readable, &tv), ibrcommon::vsocket_timeout);
+	CPPUNIT_ASSERT(readable.empty());
+
+	// the timeout is decremented like select() does
+	CPPUNIT_ASSERT_EQUAL((time_t)0, tv.tv_sec);
+	CPPUNIT_ASSERT_EQUAL((suseconds_t)0, tv.tv_usec);
+
+	vs.destroy();
+	::close(peer);
+}
+
+void vsockettest :: removeTest (void)
+{
+	ibrcommon::vsocket vs;
+	ibrcommon::filesocket *s1 = NULL;
+	ibrcommon::filesocket *s2 = NULL;
+	int p1 = create_pair(vs, &s1);
+	int p2 = create_pair(vs, &s2);
+
+	vs.up();
+
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(p1, "a", 1));
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(p2, "b", 1));
+
+	// a removed socket is not reported anymore
+	vs.remove(s1);
+	s1->down();
+	delete s1;
+
+	ibrcommon::socketlist readable;
+	vs.select(readable);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, readable.size());
+	CPPUNIT_ASSERT(readable.front() == s2);
+
+	vs.destroy();
+	::close(p1);
+	::close(p2);
+}
+
+void vsockettest :: triggerModeTest (void)
+{
+	ibrcommon::vsocket vs;
+	ibrcommon::filesocket *sock = NULL;
+	int peer = create_pair(vs, &sock);
+
+	vs.up();
+
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(peer, "a", 1));
+
+	struct timeval tv;
+	ibrcommon::socketlist readable;
+
+	// level-triggered: reported as long as data is available
+	for (int i = 0; i < 2; ++i)
+	{
+		tv.tv_sec = 0; tv.tv_usec = 100000;
+		readable.clear();
+		vs.select(readable, &tv);
+		CPPUNIT_ASSERT_EQUAL((size_t)1, readable.size());
+	}
+
+#ifdef HAVE_SYS_EPOLL_H
+	vs.set_trigger_mode(ibrcommon::vsocket::EDGE_TRIGGERED);
+
+	// edge-triggered: reported once per arrival of new data
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(peer, "b", 1));
+
+	tv.tv_sec = 0; tv.tv_usec = 100000;
+	readable.clear();
+	vs.select(readable, &tv);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, readable.size());
+
+	tv.tv_sec = 0; tv.tv_usec = 100000;
+	readable.clear();
+	CPPUNIT_ASSERT_THROW(vs.select(readable, &tv), ibrcommon::vsocket_timeout);
+#endif
+
+	vs.destroy();
+	::close(peer);
+}
+
+void vsockettest :: highDescriptorTest (void)
+{
+#ifdef HAVE_SYS_EPOLL_H
+	const int high_fd = FD_SETSIZE + 16;
+
+	// raise the limit of open files if necessary
+	struct rlimit rl;
+	CPPUNIT_ASSERT(::getrlimit(RLIMIT_NOFILE, &rl) == 0);
+	if (rl.rlim_cur <= (rlim_t)high_fd)
+	{
+		if (rl.rlim_max <= (rlim_t)high_fd) return;
+		rl.rlim_cur = rl.rlim_max;
+		if (::setrlimit(RLIMIT_NOFILE, &rl) != 0) return;
+	}
+
+	int fds[2];
+	CPPUNIT_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	// move one end beyond the limit of select()
+	CPPUNIT_ASSERT_EQUAL(high_fd, ::dup2(fds[0], high_fd));
+	::close(fds[0]);
+
+	ibrcommon::vsocket vs;
+	ibrcommon::filesocket *sock = new ibrcommon::filesocket(high_fd);
+	vs.add(sock);
+	vs.up();
+
+	CPPUNIT_ASSERT_EQUAL((ssize_t)1, ::write(fds[1], "a", 1));
+
+	ibrcommon::socketset readset;
+	vs.select(&readset, NULL, NULL);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, readset.size());
+
+	vs.destroy();
+	::close(fds[1]);
+#endif
+}
@@ -133,6 +133,90 @@ void BLOBTest::testTmpFileBLOBCreate()
 
 /*=== END   tests for class 'TmpFileBLOB' ===*/
 
+/*=== BEGIN tests for class 'RangeBLOB' ===*/
+void BLOBTest::testRangeBLOBRead()
+{
+	ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		(*stream) << "0123456789";
+	}
+
+	ibrcommon::BLOB::Reference view = ibrcommon::BLOB::view(ref, 3, 4);
+
+	ibrcommon::BLOB::iostream stream = view.iostream();
+	CPPUNIT_ASSERT_EQUAL((std::streamsize)4, stream.size());
+
+	std::string data;
+	(*stream) >> data;
+	CPPUNIT_ASSERT_EQUAL(std::string("3456"), data);
+}
+
+void BLOBTest::testRangeBLOBSeek()
+{
+	ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		(*stream) << "0123456789";
+	}
+
+	ibrcommon::BLOB::Reference view = ibrcommon::BLOB::view(ref, 2, 6);
+
+	ibrcommon::BLOB::iostream stream = view.iostream();
+	(*stream).seekg(4, std::ios::beg);
+	CPPUNIT_ASSERT_EQUAL((char)'6', (char)(*stream).get());
+
+	(*stream).seekg(0, std::ios::beg);
+	CPPUNIT_ASSERT_EQUAL((char)'2', (char)(*stream).get());
+
+	// reading beyond the range has to fail
+	(*stream).seekg(6, std::ios::beg);
+	CPPUNIT_ASSERT((*stream).get() == std::char_traits<char>::eof());
+}
+
+void BLOBTest::testRangeBLOBCopyOnWrite()
+{
+	ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		(*stream) << "0123456789";
+	}
+
+	ibrcommon::BLOB::Reference view = ibrcommon::BLOB::view(ref, 0, 5);
+	{
+		ibrcommon::BLOB::iostream stream = view.iostream();
+		stream.clear();
+		(*stream) << "abc";
+	}
+
+	{
+		ibrcommon::BLOB::iostream stream = view.iostream();
+		CPPUNIT_ASSERT_EQUAL((std::streamsize)3, stream.size());
+
+		std::string data;
+		(*stream) >> data;
+		CPPUNIT_ASSERT_EQUAL(std::string("abc"), data);
+	}
+
+	// the origin has to be untouched
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		CPPUNIT_ASSERT_EQUAL((std::streamsize)10, stream.size());
+
+		std::string data;
+		(*stream) >> data;
+		CPPUNIT_ASSERT_EQUAL(std::string("0123456789"), data);
+	}
+}
+
+/*=== END   tests for class 'RangeBLOB' ===*/
+
 void BLOBTest::setUp()
 {
 }
@@ -38,6 +38,12 @@ class BLOBTest : public CppUnit::TestFixture {
 		void testTmpFileBLOBCreate();
 		/*=== END   tests for class 'TmpFileBLOB' ===*/
 
+		/*=== BEGIN tests for class 'RangeBLOB' ===*/
+		void testRangeBLOBRead();
+		void testRangeBLOBSeek();
+		void testRangeBLOBCopyOnWrite();
+		/*=== END   tests for class 'RangeBLOB' ===*/
+
 		void setUp();
 		void tearDown();
 
@@ -50,6 +56,9 @@ class BLOBTest : public CppUnit::TestFixture {
 //			CPPUNIT_TEST(testGetSize);
 			CPPUNIT_TEST(testStringBLOBCreate);
 			CPPUNIT_TEST(testTmpFileBLOBCreate);
+			CPPUNIT_TEST(testRangeBLOBRead);
+			CPPUNIT_TEST(testRangeBLOBSeek);
+			CPPUNIT_TEST(testRangeBLOBCopyOnWrite);
 		CPPUNIT_TEST_SUITE_END();
 };
 #endif /* BLOBTEST_HH */
@@ -0,0 +1,217 @@
+/*
+ * MetricsTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "MetricsTest.h"
+#include <ibrcommon/Metrics.h>
+#include <ibrcommon/thread/Thread.h>
+#include <sstream>
+#include <list>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MetricsTest);
+
+class MetricsTestRecorder : public ibrcommon::JoinableThread
+{
+public:
+	MetricsTestRecorder(ibrcommon::Histogram &h, ibrcommon::Counter &c, size_t count)
+	 : _histogram(h), _counter(c), _count(count)
+	{
+	}
+
+	virtual ~MetricsTestRecorder()
+	{
+		join();
+	}
+
+protected:
+	void run() throw ()
+	{
+		for (size_t i = 1; i <= _count; ++i)
+		{
+			_histogram.record(i);
+			_counter.inc();
+		}
+	}
+
+	void __cancellation() throw ()
+	{
+	}
+
+private:
+	ibrcommon::Histogram &_histogram;
+	ibrcommon::Counter &_counter;
+	const size_t _count;
+};
+
+void MetricsTest::setUp() {
+}
+
+void MetricsTest::tearDown() {
+}
+
+void MetricsTest::counterTest() {
+	ibrcommon::Counter c;
+	CPPUNIT_ASSERT_EQUAL((uint64_t)0, c.get());
+
+	c.inc();
+	c.inc(41);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)42, c.get());
+}
+
+void MetricsTest::gaugeTest() {
+	ibrcommon::Gauge g;
+	g.set(10);
+	g.add(-15);
+	CPPUNIT_ASSERT_EQUAL((int64_t)-5, g.get());
+
+	g.add(7);
+	CPPUNIT_ASSERT_EQUAL((int64_t)2, g.get());
+}
+
+void MetricsTest::bucketTest() {
+	// every value falls into the bucket whose bounds enclose it
+	for (uint64_t v = 0; v < 100000; ++v)
+	{
+		const size_t i = ibrcommon::Histogram::index(v);
+		CPPUNIT_ASSERT(ibrcommon::Histogram::lower(i) <= v);
+		CPPUNIT_ASSERT(ibrcommon::Histogram::upper(i) >= v);
+	}
+
+	// buckets are contiguous
+	for (size_t i = 0; i < ibrcommon::Histogram::BUCKETS - 1; ++i)
+	{
+		CPPUNIT_ASSERT_EQUAL(ibrcommon::Histogram::upper(i) + 1, ibrcommon::Histogram::lower(i + 1));
+	}
+
+	// out of range values go into the last bucket
+	CPPUNIT_ASSERT_EQUAL(ibrcommon::Histogram::BUCKETS - 1, ibrcommon::Histogram::index(~(uint64_t)0));
+}
+
+void MetricsTest::quantileTest() {
+	ibrcommon::Histogram h;
+
+	for (uint64_t v = 1; v <= 10000; ++v)
+	{
+		h.record(v);
+	}
+
+	const ibrcommon::Histogram::Snapshot s = h.snapshot();
+	CPPUNIT_ASSERT_EQUAL((uint64_t)10000, s.count);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)50005000, s.sum);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)10000, s.max);
+
+	// the relative error is bounded by the sub-bucket width
+	const double q[] = { 0.5, 0.9, 0.99, 0.999 };
+	for (size_t i = 0; i < 4; ++i)
+	{
+		const double expected = q[i] * 10000.0;
+		const double value = (double)s.quantile(q[i]);
+		CPPUNIT_ASSERT(value >= expected);
+		CPPUNIT_ASSERT(value <= expected * (1.0 + 1.0 / ibrcommon::Histogram::SUB_BUCKETS));
+	}
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)10000, s.quantile(1.0));
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, s.quantile(0.0));
+}
+
+void MetricsTest::threadTest() {
+	ibrcommon::Histogram h;
+	ibrcommon::Counter c;
+
+	std::list<MetricsTestRecorder*> threads;
+	for (size_t i = 0; i < 16; ++i)
+	{
+		threads.push_back(new MetricsTestRecorder(h, c, 10000));
+	}
+
+	for (std::list<MetricsTestRecorder*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		(*it)->start();
+	}
+
+	for (std::list<MetricsTestRecorder*>::iterator it = threads.begin(); it != threads.end(); ++it)
+	{
+		delete (*it);
+	}
+
+	const ibrcommon::Histogram::Snapshot s = h.snapshot();
+	CPPUNIT_ASSERT_EQUAL((uint64_t)160000, s.count);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)16 * 50005000, s.sum);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)160000, c.get());
+}
+
+void MetricsTest::registryTest() {
+	ibrcommon::MetricsRegistry &r = ibrcommon::MetricsRegistry::getInstance();
+
+	const std::string l1 = ibrcommon::MetricsRegistry::label("peer", "dtn://a\"b");
+	CPPUNIT_ASSERT_EQUAL(std::string("peer=\"dtn://a\\\"b\""), l1);
+
+	ibrcommon::Counter &c1 = r.counter("test_bytes_total", "Test bytes", l1);
+	ibrcommon::Counter &c2 = r.counter("test_bytes_total", "Test bytes", l1);
+	CPPUNIT_ASSERT(&c1 == &c2);
+	c1.inc(5);
+
+	ibrcommon::Histogram &h = r.histogram("test_latency_seconds", "Test latency", "", 0.5);
+	h.record(4);
+
+	// a name must not change its type
+	CPPUNIT_ASSERT_THROW(r.gauge("test_bytes_total", "Test bytes"), ibrcommon::Exception);
+
+	std::stringstream ss;
+	r.print(ss);
+	const std::string out = ss.str();
+
+	CPPUNIT_ASSERT(out.find("# TYPE test_bytes_total counter\n") != std::string::npos);
+	CPPUNIT_ASSERT(out.find("test_bytes_total{peer=\"dtn://a\\\"b\"} 5\n") != std::string::npos);
+	CPPUNIT_ASSERT(out.find("# TYPE test_latency_seconds summary\n") != std::string::npos);
+	CPPUNIT_ASSERT(out.find("test_latency_seconds{quantile=\"0.99\"} 2\n") != std::string::npos);
+	CPPUNIT_ASSERT(out.find("test_latency_seconds_count 1\n") != std::string::npos);
+}
+
+void MetricsTest::releaseTest() {
+	ibrcommon::MetricsRegistry &r = ibrcommon::MetricsRegistry::getInstance();
+
+	const std::string l1 = ibrcommon::MetricsRegistry::label("peer", "dtn://release");
+
+	// two users of the same metric
+	ibrcommon::Counter &c1 = r.counter("test_release_total", "Test release", l1);
+	ibrcommon::Counter &c2 = r.counter("test_release_total", "Test release", l1);
+	CPPUNIT_ASSERT(&c1 == &c2);
+	c1.inc(3);
+
+	// the metric is still in use after the first release
+	r.release("test_release_total", l1);
+	c2.inc(4);
+
+	std::stringstream s1;
+	r.print(s1);
+	CPPUNIT_ASSERT(s1.str().find("test_release_total{peer=\"dtn://release\"} 7\n") != std::string::npos);
+
+	// the last release removes the metric and its family
+	r.release("test_release_total", l1);
+
+	std::stringstream s2;
+	r.print(s2);
+	CPPUNIT_ASSERT(s2.str().find("test_release_total") == std::string::npos);
+
+	// releasing an unknown metric does nothing
+	r.release("test_release_total", l1);
+	r.release("test_unknown_total");
+}
@@ -0,0 +1,53 @@
+/*
+ * MetricsTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef METRICSTEST_H_
+#define METRICSTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MetricsTest : public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE(MetricsTest);
+	CPPUNIT_TEST(counterTest);
+	CPPUNIT_TEST(gaugeTest);
+	CPPUNIT_TEST(bucketTest);
+	CPPUNIT_TEST(quantileTest);
+	CPPUNIT_TEST(threadTest);
+	CPPUNIT_TEST(registryTest);
+	CPPUNIT_TEST(releaseTest);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+protected:
+	void counterTest();
+	void gaugeTest();
+	void bucketTest();
+	void quantileTest();
+	void threadTest();
+	void registryTest();
+	void releaseTest();
+};
+
+#endif /* METRICSTEST_H_ */
@@ -87,17 +87,17 @@ namespace dtn
 		 : _enabled(true), _timeout(5), _crosslayer(false) {}
 
 		Configuration::Debug::Debug()
-		 : _enabled(false), _quiet(false), _level(0), _profiling(false) {}
+		 : _enabled(false), _quiet(false), _level(0), _profiling(false), _trace_sampling(0) {}
 
 		Configuration::Logger::Logger()
 		 : _quiet(false), _options(0), _timestamps(false), _verbose(false) {}
 
 		Configuration::Network::Network()
-		 : _routing("default"), _forwarding(true), _prefer_direct(true), _tcp_nodelay(true), _tcp_chunksize(4096), _tcp_idle_timeout(0), _default_net("lo"), _use_default_net(false), _auto_connect(0), _fragmentation(false), _scheduling(false), _link_request_interval(5000)
+		 : _routing("default"), _forwarding(true), _prefer_direct(true), _tcp_nodelay(true), _tcp_chunksize(4096), _tcp_preemption_size(0), _tcp_idle_timeout(0), _default_net("lo"), _use_default_net(false), _auto_connect(0), _fragmentation(false), _multipath_stripe_size(0), _scheduling(false), _routing_threads(0), _routing_queue_limit(10000), _link_request_interval(5000)
 		{}
 
 		Configuration::Security::Security()
-		 : _enabled(false), _tlsEnabled(false), _tlsRequired(false), _tlsOptionalOnBadClock(false), _level(SECURITY_LEVEL_NONE), _disableEncryption(false), _generate_dh_params(false)
+		 : _enabled(false), _tlsEnabled(false), _tlsRequired(false), _tlsOptionalOnBadClock(false), _generate_dh_params(false), _level(SECURITY_LEVEL_NONE), _disableEncryption(false), _kernelOffload(false)
 		{}
 
 		Configuration::Daemon::Daemon()
@@ -421,6 +421,8 @@ namespace dtn
 			try {
 				_profiling = (conf.read<std::string>("profiling") == "yes");
 			} catch (const ibrcommon::ConfigFile::key_not_found&) { };
+
+			_trace_sampling = conf.read<unsigned int>("trace_sampling", 0);
 		}
 
 		void Configuration::Daemon::load(const ibrcommon::ConfigFile&)
@@ -528,6 +530,11 @@ namespace dtn
 			return _profiling;
 		}
 
+		unsigned int Configuration::Debug::traceSampling() const
+		{
+			return _trace_sampling;
+		}
+
 		bool Configuration::Debug::enabled() const
 		{
 			return _enabled;
@@ -648,6 +655,30 @@ namespace dtn
 			return nc;
 		}
 
+		Configuration::NetConfig Configuration::getMetricsInterface() const
+		{
+			Configuration::NetConfig nc("metrics", Configuration::NetConfig::NETWORK_TCP);
+
+			try {
+				nc.port = _conf.read<int>("metrics_port");
+			} catch (const ConfigFile::key_not_found&) {
+				throw ParameterNotSetException();
+			}
+
+			try {
+				const std::string interface_name = _conf.read<std::string>("metrics_interface");
+
+				if (interface_name != "any")
+				{
+					nc.iface = ibrcommon::vinterface(interface_name);
+				}
+			} catch (const ConfigFile::key_not_found&) {
+				nc.iface = ibrcommon::vinterface(ibrcommon::vinterface::LOOPBACK);
+			}
+
+			return nc;
+		}
+
 		ibrcommon::File Configuration::getAPISocket() const
 		{
 			try {
@@ -664,6 +695,16 @@ namespace dtn
 			return _conf.read<std::string>("storage", "default");
 		}
 
+		unsigned int Configuration::getStorageLanes() const
+		{
+			return _conf.read<unsigned int>("storage_lanes", 1);
+		}
+
+		bool Configuration::getStorageSync() const
+		{
+			return _conf.read<std::string>("storage_sync", "no") == "yes";
+		}
+
 		bool Configuration::getUsePersistentBundleSets() const
 		{
 			return _conf.read<std::string>("use_persistent_bundlesets", "no") == "yes";
@@ -794,6 +835,17 @@ namespace dtn
 				_prophet_config.gtmx_nf_max = conf.read<unsigned int>("prophet_gtmx_nf_max", 30);
 			}
 
+			/**
+			 * contact plan for the contact graph routing
+			 */
+			_contact_plan = ibrcommon::File(conf.read<std::string>("routing_contact_plan", "/etc/ibrdtn/contacts.txt"));
+
+			/**
+			 * threads and queue limit of the routing executor
+			 */
+			_routing_threads = conf.read<size_t>("routing_threads", 0);
+			_routing_queue_limit = conf.read<size_t>("routing_queue_limit", 10000);
+
 			/**
 			 * get the routing extension
 			 */
@@ -894,6 +946,7 @@ namespace dtn
 			 */
 			_tcp_nodelay = (conf.read<std::string>("tcp_nodelay", "yes") == "yes");
 			_tcp_chunksize = conf.read<unsigned int>("tcp_chunksize", 4096);
+			_tcp_preemption_size = conf.read<unsigned int>("tcp_preemption_size", 0);
 			_tcp_idle_timeout = conf.read<unsigned int>("tcp_idle_timeout", 0);
 
 			/**
@@ -906,6 +959,11 @@ namespace dtn
 			 */
 			_fragmentation = (conf.read<std::string>("fragmentation", "yes") == "yes");
 
+			/**
+			 * multipath striping of large bundles
+			 */
+			_multipath_stripe_size = conf.read<unsigned int>("multipath_stripe_size", 0);
+
 			/**
 			 * read internet devices
 			 */
@@ -983,9 +1041,25 @@ namespace dtn
 			if ( _routing == "epidemic" ) return EPIDEMIC_ROUTING;
 			if ( _routing == "flooding" ) return FLOOD_ROUTING;
 			if ( _routing == "prophet" ) return PROPHET_ROUTING;
+			if ( _routing == "contactgraph" ) return CONTACT_GRAPH_ROUTING;
 			return DEFAULT_ROUTING;
 		}
 
+		const ibrcommon::File& Configuration::Network::getContactPlan() const
+		{
+			return _contact_plan;
+		}
+
+		size_t Configuration::Network::getRoutingThreads() const
+		{
+			return _routing_threads;
+		}
+
+		size_t Configuration::Network::getRoutingQueueLimit() const
+		{
+			return _routing_queue_limit;
+		}
+
 
 		bool Configuration::Network::doForwarding() const
 		{
@@ -1017,6 +1091,11 @@ namespace dtn
 			return _tcp_chunksize;
 		}
 
+		dtn::data::Length Configuration::Network::getTCPPreemptionSize() const
+		{
+			return _tcp_preemption_size;
+		}
+
 		dtn::data::Timeout Configuration::Network::getTCPIdleTimeout() const
 		{
 			return _tcp_idle_timeout;
@@ -1027,6 +1106,11 @@ namespace dtn
 			return _auto_connect;
 		}
 
+		dtn::data::Length Configuration::Network::getMultipathStripeSize() const
+		{
+			return _multipath_stripe_size;
+		}
+
 		Configuration::Network::ProphetConfig Configuration::Network::getProphetConfig() const
 		{
 			return _prophet_config;
@@ -1121,6 +1205,9 @@ namespace dtn
 			// read if encryption should be disabled
 			_disableEncryption = (conf.read<std::string>("security_tls_disable_encryption", "no") == "yes");
 
+			// read if the kernel should process the TLS records
+			_kernelOffload = (conf.read<std::string>("security_tls_kernel_offload", "no") == "yes");
+
 			if (activateTLS)
 			{
 				_tlsEnabled = true;
@@ -1248,6 +1335,11 @@ namespace dtn
 			return _disableEncryption;
 		}
 
+		bool Configuration::Security::TLSKernelOffload() const
+		{
+			return _kernelOffload;
+		}
+
 		bool Configuration::Security::isGenerateDHParamsEnabled() const
 		{
 			return _generate_dh_params;
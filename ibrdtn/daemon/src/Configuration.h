@@ -122,6 +122,12 @@ namespace dtn
 			Configuration::NetConfig getAPIInterface() const;
 			ibrcommon::File getAPISocket() const;
 
+			/**
+			 * Get the interface of the HTTP metrics endpoint.
+			 * @exception ParameterNotSetException if no metrics port is configured
+			 */
+			Configuration::NetConfig getMetricsInterface() const;
+
 			/**
 			 * Get the version of this daemon.
 			 * @return The version string.
@@ -134,6 +140,17 @@ namespace dtn
 			 */
 			std::string getStorage() const;
 
+			/**
+			 * Get the number of parallel I/O threads of the storage.
+			 */
+			unsigned int getStorageLanes() const;
+
+			/**
+			 * returns, whether stored bundles are flushed to the disk before
+			 * they are reported as stored
+			 */
+			bool getStorageSync() const;
+
 			/**
 			 * returns, whether Persistent BundleSets are used (stored in SQL database)
 			 */
@@ -146,7 +163,8 @@ namespace dtn
 				EPIDEMIC_ROUTING = 1,
 				FLOOD_ROUTING = 2,
 				PROPHET_ROUTING = 3,
-				NO_ROUTING = 4
+				NO_ROUTING = 4,
+				CONTACT_GRAPH_ROUTING = 5
 			};
 
 			/**
@@ -197,6 +215,7 @@ namespace dtn
 				bool _quiet;
 				int _level;
 				bool _profiling;
+				unsigned int _trace_sampling;
 
 			public:
 				/**
@@ -220,6 +239,12 @@ namespace dtn
 				 * @return True, if profiling is activated
 				 */
 				bool profiling() const;
+
+				/**
+				 * Returns the rate of bundles to trace, e.g. 10 traces one of ten bundles.
+				 * @return Zero, if bundle tracing is disabled
+				 */
+				unsigned int traceSampling() const;
 			};
 
 			class Logger : public Configuration::Extension
@@ -315,13 +340,18 @@ namespace dtn
 				bool _prefer_direct;
 				bool _tcp_nodelay;
 				dtn::data::Length _tcp_chunksize;
+				dtn::data::Length _tcp_preemption_size;
 				dtn::data::Timeout _tcp_idle_timeout;
 				ibrcommon::vinterface _default_net;
 				bool _use_default_net;
 				dtn::data::Timeout _auto_connect;
 				bool _fragmentation;
+				dtn::data::Length _multipath_stripe_size;
 				bool _scheduling;
 				ProphetConfig _prophet_config;
+				ibrcommon::File _contact_plan;
+				size_t _routing_threads;
+				size_t _routing_queue_limit;
 				std::set<ibrcommon::vinterface> _internet_devices;
 				size_t _link_request_interval;
 
@@ -346,6 +376,23 @@ namespace dtn
 				 */
 				RoutingExtension getRoutingExtension() const;
 
+				/**
+				 * @return the file containing the contact plan for contact graph routing
+				 */
+				const ibrcommon::File& getContactPlan() const;
+
+				/**
+				 * @return The number of threads processing the tasks of
+				 * the routing extensions, zero for one per processor.
+				 */
+				size_t getRoutingThreads() const;
+
+				/**
+				 * @return The maximum number of queued routing tasks,
+				 * zero for no limit.
+				 */
+				size_t getRoutingQueueLimit() const;
+
 				/**
 				 * Define if forwarding is enabled. If not, only local bundles will be accepted.
 				 * @return True, if forwarding is enabled.
@@ -369,6 +416,13 @@ namespace dtn
 				 */
 				dtn::data::Length getTCPChunkSize() const;
 
+				/**
+				 * @return The size of payload segments after which a transmission
+				 * over TCP may be preempted by bundles of a higher priority, zero
+				 * if bundles are always sent at once.
+				 */
+				dtn::data::Length getTCPPreemptionSize() const;
+
 				/**
 				 * @return The idle timeout for TCP connections in seconds.
 				 */
@@ -384,6 +438,12 @@ namespace dtn
 				 */
 				bool doFragmentation() const;
 
+				/**
+				 * @return The minimal size of a stripe if large bundles are split
+				 * across all convergence layers to a neighbor, zero if disabled.
+				 */
+				dtn::data::Length getMultipathStripeSize() const;
+
 				/**
 				 * @return a struct containing the prophet configuration parameters
 				 */
@@ -483,6 +543,12 @@ namespace dtn
 				 */
 				bool TLSEncryptionDisabled() const;
 
+				/*!
+				 * \brief Checks if TLS records shall be processed by the kernel (kTLS).
+				 * \return true if kernel offload is requested, false otherwise
+				 */
+				bool TLSKernelOffload() const;
+
 				/*!
 				 * \brief Generate DH parameters automatically if necessary.
 				 * \return true if the DH parameters shall be generated automatically, false otherwise
@@ -510,6 +576,9 @@ namespace dtn
 
 				// TLS encryption disabled?
 				bool _disableEncryption;
+
+				// TLS records processed by the kernel?
+				bool _kernelOffload;
 			};
 
 			class Daemon : public Configuration::Extension
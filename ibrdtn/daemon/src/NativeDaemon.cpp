@@ -36,6 +36,7 @@
 #include "storage/BundleSeeker.h"
 #include "storage/MemoryBundleStorage.h"
 #include "storage/SimpleBundleStorage.h"
+#include "storage/LogBundleStorage.h"
 
 #include "core/BundleCore.h"
 #include "net/ConnectionManager.h"
@@ -51,6 +52,7 @@
 #include "routing/epidemic/EpidemicRoutingExtension.h"
 #include "routing/prophet/ProphetRoutingExtension.h"
 #include "routing/flooding/FloodRoutingExtension.h"
+#include "routing/contactgraph/ContactGraphRoutingExtension.h"
 
 #include "core/BundleExpiredEvent.h"
 #include "routing/RequeueBundleEvent.h"
@@ -84,6 +86,9 @@
 #include "net/IPNDAgent.h"
 
 #include "api/ApiServer.h"
+#include "api/MetricsServer.h"
+#include "core/BundleTracer.h"
+#include "api/RegistrationIndex.h"
 
 #include "Configuration.h"
 #include "EchoWorker.h"
@@ -104,6 +109,7 @@
 #ifdef IBRDTN_SUPPORT_BSP
 #include "security/SecurityManager.h"
 #include "security/SecurityKeyManager.h"
+#include "security/SecurityProcessor.h"
 #include "security/exchange/KeyExchanger.h"
 #include "security/exchange/KeyExchangeEvent.h"
 #endif
@@ -565,6 +571,10 @@ namespace dtn
 			dtn::net::ConvergenceLayer::stats_data data;
 			dtn::core::BundleCore::getInstance().getConnectionManager().getStats(data);
 
+#ifdef IBRDTN_SUPPORT_BSP
+			dtn::security::SecurityProcessor::getStats(data);
+#endif
+
 			for (dtn::net::ConvergenceLayer::stats_data::const_iterator iter = data.begin(); iter != data.end(); ++iter) {
 				const dtn::net::ConvergenceLayer::stats_pair &pair = (*iter);
 				ret.addData(pair.first, pair.second);
@@ -1039,6 +1049,12 @@ namespace dtn
 				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "Parallel event processing enabled using " << conf.getDaemon().getThreads() << " processes." << IBRCOMMON_LOGGER_ENDL;
 			}
 
+			if (conf.getDebug().traceSampling() > 0)
+			{
+				dtn::core::BundleTracer::getInstance().setSampling(conf.getDebug().traceSampling());
+				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "Bundle tracing enabled for one of " << conf.getDebug().traceSampling() << " bundles" << IBRCOMMON_LOGGER_ENDL;
+			}
+
 			// initialize the event switch
 			dtn::core::EventSwitch::getInstance().initialize();
 
@@ -1100,6 +1116,34 @@ namespace dtn
 		{
 			dtn::daemon::Configuration &conf = dtn::daemon::Configuration::getInstance();
 
+			/**
+			 * initialize blob storage mechanism
+			 * This has to be done before the storage is created, because a
+			 * storage may provide its own BLOBs. Received payloads are then
+			 * written directly into the storage without an additional copy.
+			 */
+			try {
+				// the configured BLOB path
+				ibrcommon::File blob_path = conf.getPath("blob");
+
+				// check if the BLOB path exists
+				if (!blob_path.exists()) {
+					// try to create the BLOB path
+					ibrcommon::File::createDirectory(blob_path);
+				}
+
+				if (blob_path.exists() && blob_path.isDirectory())
+				{
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "using BLOB path: " << blob_path.getPath() << IBRCOMMON_LOGGER_ENDL;
+					ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+				}
+				else
+				{
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, warning) << "BLOB path exists, but is not a directory! Fallback to memory based mode." << IBRCOMMON_LOGGER_ENDL;
+					ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
+				}
+			} catch (const dtn::daemon::Configuration::ParameterNotSetException&) { }
+
 			// create a storage for bundles
 			dtn::storage::BundleStorage *storage = NULL;
 
@@ -1158,7 +1202,7 @@ namespace dtn
 					}
 
 					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "using simple bundle storage in " << path.getPath() << IBRCOMMON_LOGGER_ENDL;
-					dtn::storage::SimpleBundleStorage *sbs = new dtn::storage::SimpleBundleStorage(path, conf.getLimit("storage"), static_cast<unsigned int>(conf.getLimit("storage_buffer")));
+					dtn::storage::SimpleBundleStorage *sbs = new dtn::storage::SimpleBundleStorage(path, conf.getLimit("storage"), static_cast<unsigned int>(conf.getLimit("storage_buffer")), conf.getStorageLanes(), conf.getStorageSync());
 					_components[RUNLEVEL_STORAGE].push_back(sbs);
 					storage = sbs;
 				} catch (const dtn::daemon::Configuration::ParameterNotSetException&) {
@@ -1169,6 +1213,24 @@ namespace dtn
 				}
 			}
 
+			if (conf.getStorage() == "log")
+			{
+				try {
+					ibrcommon::File path = conf.getPath("storage");
+
+					// create workdir if needed
+					if (!path.exists()) ibrcommon::File::createDirectory(path);
+
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "using log bundle storage in " << path.getPath() << IBRCOMMON_LOGGER_ENDL;
+					dtn::storage::LogBundleStorage *lbs = new dtn::storage::LogBundleStorage(path, conf.getLimit("storage"), conf.getLimit("storage_segment"));
+					_components[RUNLEVEL_STORAGE].push_back(lbs);
+					storage = lbs;
+				} catch (const dtn::daemon::Configuration::ParameterNotSetException&) {
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, error) << "storage for bundles" << IBRCOMMON_LOGGER_ENDL;
+					throw NativeDaemonException("initialization of the bundle storage failed");
+				}
+			}
+
 			if (storage == NULL)
 			{
 				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, error) << "bundle storage module \"" << conf.getStorage() << "\" do not exists!" << IBRCOMMON_LOGGER_ENDL;
@@ -1195,31 +1257,6 @@ namespace dtn
 				// set the storage as default seeker
 				dtn::core::BundleCore::getInstance().setSeeker( storage );
 			}
-
-			/**
-			 * initialize blob storage mechanism
-			 */
-			try {
-				// the configured BLOB path
-				ibrcommon::File blob_path = conf.getPath("blob");
-
-				// check if the BLOB path exists
-				if (!blob_path.exists()) {
-					// try to create the BLOB path
-					ibrcommon::File::createDirectory(blob_path);
-				}
-
-				if (blob_path.exists() && blob_path.isDirectory())
-				{
-					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "using BLOB path: " << blob_path.getPath() << IBRCOMMON_LOGGER_ENDL;
-					ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
-				}
-				else
-				{
-					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, warning) << "BLOB path exists, but is not a directory! Fallback to memory based mode." << IBRCOMMON_LOGGER_ENDL;
-					ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
-				}
-			} catch (const dtn::daemon::Configuration::ParameterNotSetException&) { }
 		}
 
 		void NativeDaemon::shutdown_storage() const throw (NativeDaemonException)
@@ -1241,6 +1278,17 @@ namespace dtn
 
 			// add the router to the components list
 			_components[RUNLEVEL_ROUTING].push_back(router);
+
+#ifdef IBRDTN_SUPPORT_BSP
+			dtn::daemon::Configuration &conf = dtn::daemon::Configuration::getInstance();
+
+			if (conf.getSecurity().enabled())
+			{
+				// process the bundle security blocks off the event switch
+				_components[RUNLEVEL_ROUTING].push_back(new dtn::security::SecurityProcessor(
+						static_cast<unsigned int>(conf.getLimit("security_workers")), conf.getLimit("security_queue")));
+			}
+#endif
 		}
 
 		void NativeDaemon::shutdown_routing() const throw (NativeDaemonException)
@@ -1274,6 +1322,9 @@ namespace dtn
 			}
 #endif
 
+			// deliver queued bundles to the subscribed registrations
+			_components[RUNLEVEL_API].push_back( new dtn::api::RegistrationIndex() );
+
 			if (conf.getNetwork().doFragmentation())
 			{
 				// manager class for fragmentations
@@ -1311,6 +1362,17 @@ namespace dtn
 			{
 				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "API disabled" << IBRCOMMON_LOGGER_ENDL;
 			}
+
+			try {
+				dtn::daemon::Configuration::NetConfig metricsconf = conf.getMetricsInterface();
+
+				try {
+					_components[RUNLEVEL_API].push_back(new dtn::api::MetricsServer(metricsconf.iface, metricsconf.port));
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "Metrics available at http://" << metricsconf.iface.toString() << ":" << metricsconf.port << "/metrics" << IBRCOMMON_LOGGER_ENDL;
+				} catch (const ibrcommon::socket_exception&) {
+					IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, error) << "Unable to bind to " << metricsconf.iface.toString() << ":" << metricsconf.port << ". Metrics not available!" << IBRCOMMON_LOGGER_ENDL;
+				}
+			} catch (const dtn::daemon::Configuration::ParameterNotSetException&) { };
 #endif
 		}
 
@@ -1670,6 +1732,16 @@ namespace dtn
 				break;
 			}
 
+			case dtn::daemon::Configuration::CONTACT_GRAPH_ROUTING:
+			{
+				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "Using contact graph routing extensions" << IBRCOMMON_LOGGER_ENDL;
+				router.add( new dtn::routing::ContactGraphRoutingExtension(conf.getNetwork().getContactPlan()) );
+
+				// add neighbor routing (direct-delivery) extension
+				router.add( new dtn::routing::NeighborRoutingExtension() );
+				break;
+			}
+
 			case dtn::daemon::Configuration::NO_ROUTING:
 				IBRCOMMON_LOGGER_TAG(NativeDaemon::TAG, info) << "Dynamic routing extensions disabled" << IBRCOMMON_LOGGER_ENDL;
 				break;
@@ -22,7 +22,6 @@
 #include "config.h"
 #include "Configuration.h"
 #include "api/ApiServer.h"
-#include "core/EventDispatcher.h"
 #include "core/BundleCore.h"
 
 #include <ibrcommon/net/vaddress.h>
@@ -117,8 +116,7 @@ namespace dtn
 			} catch (const ibrcommon::socket_exception &ex) {
 				IBRCOMMON_LOGGER_TAG(ApiServer::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
-			
-			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::add(this);
+
 			startGarbageCollector();
 		}
 
@@ -215,8 +213,6 @@ namespace dtn
 
 		void ApiServer::componentDown() throw ()
 		{
-			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::remove(this);
-
 			// put the server into shutdown mode
 			_shutdown = true;
 			
@@ -350,22 +346,6 @@ namespace dtn
 			}
 		}
 
-		void ApiServer::raiseEvent(const dtn::routing::QueueBundleEvent &queued) throw ()
-		{
-			// ignore fragments - we can not deliver them directly to the client
-			if (queued.bundle.isFragment()) return;
-
-			ibrcommon::MutexLock l(_connection_lock);
-			for (client_list::iterator iter = _connections.begin(); iter != _connections.end(); ++iter)
-			{
-				ClientHandler &conn = **iter;
-				if (conn.getRegistration().hasSubscribed(queued.bundle.destination))
-				{
-					conn.getRegistration().notify(Registration::NOTIFY_BUNDLE_AVAILABLE);
-				}
-			}
-		}
-
 		void ApiServer::startGarbageCollector()
 		{
 			try
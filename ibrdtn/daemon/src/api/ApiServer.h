@@ -25,9 +25,7 @@
 #include "Component.h"
 #include "api/Registration.h"
 #include "api/ClientHandler.h"
-#include "core/EventReceiver.h"
 #include "storage/BundleSeeker.h"
-#include "routing/QueueBundleEvent.h"
 #include <ibrcommon/net/vinterface.h>
 #include <ibrcommon/net/socket.h>
 #include <ibrcommon/thread/Mutex.h>
@@ -40,7 +38,7 @@ namespace dtn
 {
 	namespace api
 	{
-		class ApiServer : public dtn::daemon::IndependentComponent, public dtn::core::EventReceiver<dtn::routing::QueueBundleEvent>, public ApiServerInterface, public ibrcommon::TimerCallback
+		class ApiServer : public dtn::daemon::IndependentComponent, public ApiServerInterface, public ibrcommon::TimerCallback
 		{
 			static const std::string TAG;
 
@@ -56,8 +54,6 @@ namespace dtn
 
 			void freeRegistration(Registration &reg);
 
-			void raiseEvent(const dtn::routing::QueueBundleEvent &evt) throw ();
-
 			/**
 			 * retrieve a registration for a given handle from the ApiServers registration list
 			 * the registration is automatically set into the attached state
@@ -38,11 +38,14 @@
 #include "routing/QueueBundleEvent.h"
 #include "routing/RequeueBundleEvent.h"
 #include "core/TimeAdjustmentEvent.h"
+#include "core/EventProfiler.h"
+#include "core/BundleTracer.h"
 
 #include <ibrdtn/ibrdtn.h>
 #ifdef IBRDTN_SUPPORT_BSP
 #include "security/exchange/KeyExchangeData.h"
 #include "security/exchange/KeyExchangeEvent.h"
+#include "security/SecurityProcessor.h"
 #endif
 
 #include <ibrdtn/utils/Clock.h>
@@ -52,8 +55,10 @@
 #include <ibrcommon/link/LinkManager.h>
 #include <ibrcommon/link/LinkEvent.h>
 #include <ibrcommon/thread/RWLock.h>
+#include <ibrcommon/Metrics.h>
 
 #include <iomanip>
+#include <sstream>
 
 namespace dtn
 {
@@ -487,6 +492,26 @@ namespace dtn
 								_stream << pair.first << ": " << pair.second << std::endl;
 						}
 						_stream << std::endl;
+					} else if ( cmd[1] == "metrics" ) {
+						_stream << ClientHandler::API_STATUS_OK << " STATS METRICS" << std::endl;
+
+						// format in a separate stream, the precision of _stream is altered by other commands
+						std::stringstream ss;
+						ibrcommon::MetricsRegistry::getInstance().print(ss);
+						_stream << ss.str() << std::endl;
+#ifdef IBRDTN_SUPPORT_BSP
+					} else if ( cmd[1] == "security" ) {
+						_stream << ClientHandler::API_STATUS_OK << " STATS SECURITY" << std::endl;
+
+						dtn::net::ConvergenceLayer::stats_data data;
+						dtn::security::SecurityProcessor::getStats(data);
+
+						for (dtn::net::ConvergenceLayer::stats_data::const_iterator iter = data.begin(); iter != data.end(); ++iter) {
+							const dtn::net::ConvergenceLayer::stats_pair &pair = (*iter);
+								_stream << pair.first << ": " << pair.second << std::endl;
+						}
+						_stream << std::endl;
+#endif
 					} else if ( cmd[1] == "reset" ) {
 						dtn::core::EventDispatcher<dtn::core::BundleExpiredEvent>::resetCounter();
 						dtn::core::EventDispatcher<dtn::net::BundleReceivedEvent>::resetCounter();
@@ -498,11 +523,98 @@ namespace dtn
 						// reset cl stats
 						dtn::core::BundleCore::getInstance().getConnectionManager().resetStats();
 
+#ifdef IBRDTN_SUPPORT_BSP
+						// reset security stats
+						dtn::security::SecurityProcessor::resetStats();
+#endif
+
 						_stream << ClientHandler::API_STATUS_ACCEPTED << " STATS RESET" << std::endl;
 					} else {
 						throw ibrcommon::Exception("malformed command");
 					}
 				}
+				else if (cmd[0] == "trace")
+				{
+					if (cmd.size() < 2) throw ibrcommon::Exception("not enough parameters");
+
+					dtn::core::BundleTracer &tracer = dtn::core::BundleTracer::getInstance();
+
+					if (cmd[1] == "start")
+					{
+						unsigned int rate = 1;
+						if (cmd.size() > 2) {
+							std::stringstream ss(cmd[2]);
+							ss >> rate;
+						}
+
+						tracer.setSampling(rate);
+						_stream << ClientHandler::API_STATUS_OK << " TRACING STARTED" << std::endl;
+					}
+					else if (cmd[1] == "stop")
+					{
+						tracer.setSampling(0);
+						_stream << ClientHandler::API_STATUS_OK << " TRACING STOPPED" << std::endl;
+					}
+					else if (cmd[1] == "clear")
+					{
+						tracer.clear();
+						_stream << ClientHandler::API_STATUS_ACCEPTED << " TRACE CLEARED" << std::endl;
+					}
+					else if (cmd[1] == "export")
+					{
+						_stream << ClientHandler::API_STATUS_OK << " TRACE EXPORT" << std::endl;
+						tracer.exportJSON(_stream);
+						_stream << std::endl;
+					}
+					else
+					{
+						throw ibrcommon::Exception("malformed command");
+					}
+				}
+				else if (cmd[0] == "profile")
+				{
+					if (cmd.size() < 2) throw ibrcommon::Exception("not enough parameters");
+
+					dtn::core::EventProfiler &profiler = dtn::core::EventProfiler::getInstance();
+
+					if (cmd[1] == "start")
+					{
+						profiler.enable(true);
+						_stream << ClientHandler::API_STATUS_OK << " PROFILING STARTED" << std::endl;
+					}
+					else if (cmd[1] == "stop")
+					{
+						profiler.enable(false);
+						_stream << ClientHandler::API_STATUS_OK << " PROFILING STOPPED" << std::endl;
+					}
+					else if (cmd[1] == "reset")
+					{
+						profiler.reset();
+						_stream << ClientHandler::API_STATUS_ACCEPTED << " PROFILING RESET" << std::endl;
+					}
+					else if (cmd[1] == "top")
+					{
+						size_t limit = 20;
+						if (cmd.size() > 2) {
+							std::stringstream ss(cmd[2]);
+							ss >> limit;
+						}
+
+						_stream << ClientHandler::API_STATUS_OK << " PROFILE TOP" << std::endl;
+						profiler.printTop(_stream, limit);
+						_stream << std::endl;
+					}
+					else if (cmd[1] == "folded")
+					{
+						_stream << ClientHandler::API_STATUS_OK << " PROFILE FOLDED" << std::endl;
+						profiler.printFolded(_stream);
+						_stream << std::endl;
+					}
+					else
+					{
+						throw ibrcommon::Exception("malformed command");
+					}
+				}
 #ifdef IBRDTN_SUPPORT_BSP
 				else if (cmd[0] == "key-exchange")
 				{
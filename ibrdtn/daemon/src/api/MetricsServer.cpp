@@ -0,0 +1,189 @@
+/*
+ * MetricsServer.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "api/MetricsServer.h"
+
+#include <ibrcommon/net/vaddress.h>
+#include <ibrcommon/net/socketstream.h>
+#include <ibrcommon/Metrics.h>
+#include <ibrcommon/Logger.h>
+
+#include <sstream>
+
+namespace dtn
+{
+	namespace api
+	{
+		const std::string MetricsServer::TAG = "MetricsServer";
+
+		MetricsServer::MetricsServer(const ibrcommon::vinterface &net, int port)
+		 : _shutdown(false)
+		{
+			if (net.isLoopback()) {
+				if (ibrcommon::basesocket::hasSupport(AF_INET6)) {
+					ibrcommon::vaddress addr6(ibrcommon::vaddress::VADDR_LOCALHOST, port, AF_INET6);
+					_sockets.add(new ibrcommon::tcpserversocket(addr6, 5));
+				}
+
+				ibrcommon::vaddress addr4(ibrcommon::vaddress::VADDR_LOCALHOST, port, AF_INET);
+				_sockets.add(new ibrcommon::tcpserversocket(addr4, 5));
+			}
+			else if (net.isAny()) {
+				ibrcommon::vaddress addr(ibrcommon::vaddress::VADDR_ANY, port);
+				_sockets.add(new ibrcommon::tcpserversocket(addr, 5));
+			}
+			else {
+				// add a socket for each address on the interface
+				std::list<ibrcommon::vaddress> addrs = net.getAddresses();
+
+				// convert the port into a string
+				std::stringstream ss; ss << port;
+
+				for (std::list<ibrcommon::vaddress>::iterator iter = addrs.begin(); iter != addrs.end(); ++iter) {
+					ibrcommon::vaddress &addr = (*iter);
+
+					try {
+						// handle the addresses according to their family
+						switch (addr.family()) {
+						case AF_INET:
+						case AF_INET6:
+							addr.setService(ss.str());
+							_sockets.add(new ibrcommon::tcpserversocket(addr, 5), net);
+							break;
+
+						default:
+							break;
+						}
+					} catch (const ibrcommon::vaddress::address_exception &ex) {
+						IBRCOMMON_LOGGER_TAG(MetricsServer::TAG, warning) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					}
+				}
+			}
+		}
+
+		MetricsServer::~MetricsServer()
+		{
+			join();
+			_sockets.destroy();
+		}
+
+		void MetricsServer::__cancellation() throw ()
+		{
+			// shut-down all server sockets
+			_sockets.down();
+		}
+
+		void MetricsServer::componentUp() throw ()
+		{
+			_shutdown = false;
+
+			try {
+				// bring up all server sockets
+				_sockets.up();
+			} catch (const ibrcommon::socket_exception &ex) {
+				IBRCOMMON_LOGGER_TAG(MetricsServer::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+		}
+
+		void MetricsServer::componentRun() throw ()
+		{
+			try {
+				while (!_shutdown)
+				{
+					ibrcommon::socketset fds;
+					_sockets.select(&fds, NULL, NULL, NULL);
+
+					for (ibrcommon::socketset::iterator iter = fds.begin(); iter != fds.end(); ++iter)
+					{
+						ibrcommon::serversocket &sock = dynamic_cast<ibrcommon::serversocket&>(**iter);
+
+						ibrcommon::vaddress peeraddr;
+						ibrcommon::clientsocket *peersock = sock.accept(peeraddr);
+
+						if (_shutdown)
+						{
+							delete peersock;
+							return;
+						}
+
+						// requests are rare and small, answer them in this thread
+						serve(peersock);
+					}
+				}
+			} catch (const std::exception&) {
+				// ignore all errors
+				return;
+			}
+		}
+
+		void MetricsServer::serve(ibrcommon::clientsocket *sock) throw ()
+		{
+			// the stream is responsible for the client socket
+			ibrcommon::socketstream stream(sock);
+
+			try {
+				// do not let a slow client block further requests
+				timeval tv;
+				tv.tv_sec = 2;
+				tv.tv_usec = 0;
+				stream.setTimeout(tv);
+
+				// read the request line and headers, the path is not evaluated
+				std::string line;
+				while (std::getline(stream, line))
+				{
+					if (line.empty() || (line == "\r")) break;
+				}
+
+				if (stream.good())
+				{
+					std::stringstream body;
+					ibrcommon::MetricsRegistry::getInstance().print(body);
+					const std::string data = body.str();
+
+					stream << "HTTP/1.0 200 OK\r\n"
+							<< "Content-Type: text/plain; version=0.0.4\r\n"
+							<< "Content-Length: " << data.length() << "\r\n"
+							<< "Connection: close\r\n"
+							<< "\r\n"
+							<< data << std::flush;
+				}
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(MetricsServer::TAG, 10) << "request failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			stream.close();
+		}
+
+		void MetricsServer::componentDown() throw ()
+		{
+			_shutdown = true;
+
+			// close the listen socket
+			_sockets.down();
+		}
+
+		const std::string MetricsServer::getName() const
+		{
+			return "MetricsServer";
+		}
+	}
+}
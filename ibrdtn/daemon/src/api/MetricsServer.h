@@ -0,0 +1,69 @@
+/*
+ * MetricsServer.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef METRICSSERVER_H_
+#define METRICSSERVER_H_
+
+#include "Component.h"
+#include <ibrcommon/net/vinterface.h>
+#include <ibrcommon/net/vsocket.h>
+
+namespace dtn
+{
+	namespace api
+	{
+		/**
+		 * Serves the metrics registry as plain text over HTTP, so that
+		 * the daemon can be scraped by a Prometheus server.
+		 */
+		class MetricsServer : public dtn::daemon::IndependentComponent
+		{
+			static const std::string TAG;
+
+		public:
+			MetricsServer(const ibrcommon::vinterface &net, int port);
+			virtual ~MetricsServer();
+
+			/**
+			 * @see Component::getName()
+			 */
+			virtual const std::string getName() const;
+
+		protected:
+			void __cancellation() throw ();
+
+			void componentUp() throw ();
+			void componentRun() throw ();
+			void componentDown() throw ();
+
+		private:
+			/**
+			 * Answer a single HTTP request on the given socket
+			 */
+			void serve(ibrcommon::clientsocket *sock) throw ();
+
+			ibrcommon::vsocket _sockets;
+			bool _shutdown;
+		};
+	}
+}
+
+#endif /* METRICSSERVER_H_ */
@@ -22,7 +22,6 @@
 #include "api/NativeSession.h"
 #include "api/NativeSerializer.h"
 #include "core/BundleCore.h"
-#include "core/EventDispatcher.h"
 
 #include <ibrdtn/data/PayloadBlock.h>
 #include <ibrcommon/data/BLOB.h>
@@ -41,26 +40,20 @@ namespace dtn
 		const std::string NativeSession::TAG = "NativeSession";
 
 		NativeSession::NativeSession(NativeSessionCallback *session_cb, NativeSerializerCallback *serializer_cb)
-		 : _receiver(*this), _session_cb(session_cb), _serializer_cb(serializer_cb)
+		 : _session_cb(session_cb), _serializer_cb(serializer_cb)
 		{
 			// set the local endpoint to the default
 			_endpoint = _registration.getDefaultEID();
 
-			// listen to QueueBundleEvents
-			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::add(&_receiver);
-
 			IBRCOMMON_LOGGER_DEBUG_TAG(NativeSession::TAG, 15) << "Session created" << IBRCOMMON_LOGGER_ENDL;
 		}
 
 		NativeSession::NativeSession(NativeSessionCallback *session_cb, NativeSerializerCallback *serializer_cb, const std::string &handle)
-		 : _registration(handle), _receiver(*this), _session_cb(session_cb), _serializer_cb(serializer_cb)
+		 : _registration(handle), _session_cb(session_cb), _serializer_cb(serializer_cb)
 		{
 			// set the local endpoint to the default
 			_endpoint = _registration.getDefaultEID();
 
-			// listen to QueueBundleEvents
-			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::add(&_receiver);
-
 			IBRCOMMON_LOGGER_DEBUG_TAG(NativeSession::TAG, 15) << "Session created" << IBRCOMMON_LOGGER_ENDL;
 		}
 
@@ -78,9 +71,6 @@ namespace dtn
 
 		void NativeSession::destroy() throw ()
 		{
-			// un-listen from QueueBundleEvents
-			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::remove(&_receiver);
-
 			_registration.abort();
 		}
 
@@ -395,26 +385,6 @@ namespace dtn
 			}
 		}
 
-		NativeSession::BundleReceiver::BundleReceiver(NativeSession &session)
-		 : _session(session)
-		{
-		}
-
-		NativeSession::BundleReceiver::~BundleReceiver()
-		{
-		}
-
-		void NativeSession::BundleReceiver::raiseEvent(const dtn::routing::QueueBundleEvent &queued) throw ()
-		{
-			// ignore fragments - we can not deliver them directly to the client
-			if (queued.bundle.isFragment()) return;
-
-			if (_session._registration.hasSubscribed(queued.bundle.destination))
-			{
-				_session._registration.notify(Registration::NOTIFY_BUNDLE_AVAILABLE);
-			}
-		}
-
 		void NativeSession::receive() throw (NativeSessionException)
 		{
 			Registration &reg = _registration;
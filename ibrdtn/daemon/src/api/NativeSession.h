@@ -24,8 +24,6 @@
 
 #include "api/NativeSerializerCallback.h"
 #include "api/Registration.h"
-#include "core/EventReceiver.h"
-#include "routing/QueueBundleEvent.h"
 #include <ibrdtn/data/Bundle.h>
 #include <ibrdtn/data/StatusReportBlock.h>
 #include <ibrdtn/data/CustodySignalBlock.h>
@@ -250,18 +248,6 @@ namespace dtn
 			// local registration
 			dtn::api::Registration _registration;
 
-			class BundleReceiver : public dtn::core::EventReceiver<dtn::routing::QueueBundleEvent>
-			{
-			public:
-				BundleReceiver(NativeSession &session);
-				virtual ~BundleReceiver();
-
-				void raiseEvent(const dtn::routing::QueueBundleEvent &evt) throw ();
-
-			private:
-				NativeSession &_session;
-			} _receiver;
-
 			/**
 			 * Push out an notification to the native session callback.
 			 */
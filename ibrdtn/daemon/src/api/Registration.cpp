@@ -22,6 +22,7 @@
 #include "config.h"
 #include "Configuration.h"
 #include "api/Registration.h"
+#include "api/RegistrationIndex.h"
 #include "storage/BundleStorage.h"
 #include "core/BundleCore.h"
 #include "core/BundleEvent.h"
@@ -102,7 +103,7 @@ namespace dtn
 
 		Registration::Registration(const std::string &handle)
 		 : _handle(alloc_handle(handle)),
-		   _default_eid(core::BundleCore::local), _no_more_bundles(false),
+		   _default_eid(core::BundleCore::local), _no_more_bundles(false), _indexed(false),
 		   _persistent(false), _detached(false), _expiry(0), _filter_fragments(true)
 		{
 			_default_eid.setApplication(_handle);
@@ -110,7 +111,7 @@ namespace dtn
 
 		Registration::Registration()
 		 : _handle(alloc_handle()),
-		   _default_eid(core::BundleCore::local), _no_more_bundles(false),
+		   _default_eid(core::BundleCore::local), _no_more_bundles(false), _indexed(false),
 		   _persistent(false), _detached(false), _expiry(0), _filter_fragments(true)
 		{
 			_default_eid.setApplication(_handle);
@@ -118,6 +119,18 @@ namespace dtn
 
 		Registration::~Registration()
 		{
+			std::set<dtn::data::EID> endpoints;
+			{
+				ibrcommon::MutexLock l(_endpoints_lock);
+				endpoints.swap(_endpoints);
+			}
+
+			// remove all subscriptions from the index
+			for (std::set<dtn::data::EID>::const_iterator iter = endpoints.begin(); iter != endpoints.end(); ++iter)
+			{
+				RegistrationIndex::remove(*iter, *this);
+			}
+
 			free_handle(_handle);
 		}
 
@@ -218,6 +231,38 @@ namespace dtn
 			throw dtn::storage::NoBundleFoundException();
 		}
 
+		bool Registration::push(const dtn::data::MetaBundle &meta)
+		{
+			// filter fragments if requested
+			if (meta.isFragment() && _filter_fragments && dtn::daemon::Configuration::getInstance().getNetwork().doFragmentation())
+			{
+				return false;
+			}
+
+			{
+				ibrcommon::MutexLock l(_endpoints_lock);
+
+				// filter own bundles
+				if (_endpoints.find(meta.source) != _endpoints.end()) return false;
+
+				// the queue of a detached registration is not read, the bundles
+				// are fetched from the storage once a client attaches again
+				ibrcommon::MutexLock la(_attach_lock);
+				if (_detached)
+				{
+					_indexed = false;
+					return false;
+				}
+			}
+
+			if (!_queue.add(meta)) return false;
+
+			// wake-up the receiver
+			notify(NOTIFY_BUNDLE_AVAILABLE);
+
+			return true;
+		}
+
 		void Registration::underflow()
 		{
 			bool fragment_conf = dtn::daemon::Configuration::getInstance().getNetwork().doFragmentation();
@@ -225,6 +270,17 @@ namespace dtn
 			// expire outdated bundles in the list
 			_queue.expire(dtn::utils::Clock::getTime());
 
+			// lock the endpoints until the query is done, new subscriptions
+			// have to wait and reset the indexed state afterwards
+			ibrcommon::MutexLock l(_endpoints_lock);
+
+			// all stored bundles are already queued, new bundles are pushed by the index
+			if (_indexed)
+			{
+				_no_more_bundles = true;
+				throw dtn::storage::NoBundleFoundException();
+			}
+
 			/**
 			 * search for bundles in the storage
 			 */
@@ -323,17 +379,18 @@ namespace dtn
 			} filter(_endpoints, _queue, false, fragment_conf && _filter_fragments);
 
 			// query the database for more bundles
-			ibrcommon::MutexLock l(_endpoints_lock);
-
 			try {
 				dtn::core::BundleCore::getInstance().getSeeker().get( filter, _queue );
 			} catch (const dtn::storage::NoBundleFoundException&) {
+				// from now on, the index delivers new bundles directly
+				_indexed = true;
 				_no_more_bundles = true;
 				throw;
 			}
 		}
 
 		Registration::RegistrationQueue::RegistrationQueue()
+		 : _delivery_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_api_delivery_seconds", "Time bundles wait in a registration until they are delivered", "", 0.000001))
 		{
 		}
 
@@ -343,19 +400,31 @@ namespace dtn
 
 		void Registration::RegistrationQueue::put(const dtn::data::MetaBundle &bundle) throw ()
 		{
-			try {
-				_queue.push(bundle);
+			add(bundle);
+		}
 
+		bool Registration::RegistrationQueue::add(const dtn::data::MetaBundle &bundle) throw ()
+		{
+			try {
+				// the storage and the index may offer the same bundle concurrently
 				ibrcommon::MutexLock l(_lock);
+				if (_recv_bundles.has(bundle)) return false;
+
+				_queue.push(queued_bundle(bundle, ibrcommon::Histogram::now()));
 				_recv_bundles.add(bundle);
 
 				IBRCOMMON_LOGGER_DEBUG_TAG(Registration::TAG, 10) << "[RegistrationQueue] add bundle to list of delivered bundles: " << bundle.toString() << IBRCOMMON_LOGGER_ENDL;
+				return true;
 			} catch (const ibrcommon::Exception&) { }
+
+			return false;
 		}
 
 		dtn::data::MetaBundle Registration::RegistrationQueue::pop() throw (const ibrcommon::QueueUnblockedException)
 		{
-			return _queue.take();
+			const queued_bundle b = _queue.take();
+			_delivery_latency.record(ibrcommon::Histogram::now() - b.second);
+			return b.first;
 		}
 
 		bool Registration::RegistrationQueue::has(const dtn::data::BundleID &bundle) const throw ()
@@ -382,11 +451,19 @@ namespace dtn
 
 		void Registration::subscribe(const dtn::data::EID &endpoint)
 		{
+			// get new bundles for this endpoint through the index, this is done first
+			// to not miss any bundle queued before the next query of the storage
+			RegistrationIndex::add(endpoint, *this);
+
 			{
 				ibrcommon::MutexLock l(_endpoints_lock);
 
 				// add endpoint to the local set
-				_endpoints.insert(endpoint);
+				if (_endpoints.insert(endpoint).second)
+				{
+					// the storage may hold bundles for the new endpoint
+					_indexed = false;
+				}
 			}
 
 			// trigger the search for new bundles
@@ -395,8 +472,12 @@ namespace dtn
 
 		void Registration::unsubscribe(const dtn::data::EID &endpoint)
 		{
-			ibrcommon::MutexLock l(_endpoints_lock);
-			_endpoints.erase(endpoint);
+			{
+				ibrcommon::MutexLock l(_endpoints_lock);
+				if (_endpoints.erase(endpoint) == 0) return;
+			}
+
+			RegistrationIndex::remove(endpoint, *this);
 		}
 
 		/**
@@ -29,6 +29,7 @@
 #include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/Mutex.h>
 #include <ibrcommon/thread/Timer.h>
+#include <ibrcommon/Metrics.h>
 #include <string>
 #include <set>
 
@@ -160,6 +161,15 @@ namespace dtn
 
 			dtn::data::MetaBundle receiveMetaBundle() throw (dtn::storage::NoBundleFoundException);
 
+			/**
+			 * Put a bundle into the queue of this registration unless it is
+			 * filtered, has been queued before or the registration is detached.
+			 * This is called by the RegistrationIndex for bundles addressed to
+			 * a subscribed endpoint.
+			 * @return true, if the bundle has been queued
+			 */
+			bool push(const dtn::data::MetaBundle &meta);
+
 			/**
 			 * notify a bundle as delivered (and delete it if singleton destination)
 			 * @param id
@@ -265,6 +275,13 @@ namespace dtn
 				 */
 				virtual void put(const dtn::data::MetaBundle &bundle) throw ();
 
+				/**
+				 * Put a bundle into the registration queue if it has not
+				 * been queued before.
+				 * @return true, if the bundle has been queued
+				 */
+				bool add(const dtn::data::MetaBundle &bundle) throw ();
+
 				/**
 				 * Get the next bundle of the queue.
 				 * An exception is thrown if the queue is empty or the queue has been aborted
@@ -300,7 +317,12 @@ namespace dtn
 				dtn::data::BundleSet _recv_bundles;
 
 				// queue where the currently queued bundles are stored
-				ibrcommon::Queue<dtn::data::MetaBundle> _queue;
+				// along with the time of their enqueue
+				typedef std::pair<dtn::data::MetaBundle, uint64_t> queued_bundle;
+				ibrcommon::Queue<queued_bundle> _queue;
+
+				// time between enqueue and delivery in microseconds
+				ibrcommon::Histogram &_delivery_latency;
 			};
 
 			const std::string _handle;
@@ -314,6 +336,10 @@ namespace dtn
 			ibrcommon::Conditional _wait_for_cond;
 			bool _no_more_bundles;
 
+			// true, if all stored bundles have been queued and further
+			// bundles are pushed by the registration index
+			bool _indexed;
+
 			ibrcommon::Queue<NOTIFY_CALL> _notify_queue;
 
 			static const std::string gen_handle();
@@ -0,0 +1,106 @@
+/*
+ * RegistrationIndex.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "api/RegistrationIndex.h"
+#include "api/Registration.h"
+#include "core/EventDispatcher.h"
+#include <ibrcommon/Logger.h>
+
+namespace dtn
+{
+	namespace api
+	{
+		const std::string RegistrationIndex::TAG = "RegistrationIndex";
+
+		ibrcommon::Mutex RegistrationIndex::_lock;
+		RegistrationIndex::endpoint_map RegistrationIndex::_endpoints;
+
+		RegistrationIndex::RegistrationIndex()
+		{
+		}
+
+		RegistrationIndex::~RegistrationIndex()
+		{
+		}
+
+		const std::string RegistrationIndex::getName() const
+		{
+			return TAG;
+		}
+
+		void RegistrationIndex::componentUp() throw ()
+		{
+			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::add(this);
+		}
+
+		void RegistrationIndex::componentDown() throw ()
+		{
+			dtn::core::EventDispatcher<dtn::routing::QueueBundleEvent>::remove(this);
+		}
+
+		void RegistrationIndex::raiseEvent(const dtn::routing::QueueBundleEvent &queued) throw ()
+		{
+			const size_t matches = deliver(queued.bundle);
+
+			if (matches > 0)
+			{
+				IBRCOMMON_LOGGER_DEBUG_TAG(RegistrationIndex::TAG, 30) << "bundle " << queued.bundle.toString() << " queued for " << matches << " registration(s)" << IBRCOMMON_LOGGER_ENDL;
+			}
+		}
+
+		void RegistrationIndex::add(const dtn::data::EID &endpoint, Registration &reg)
+		{
+			ibrcommon::MutexLock l(_lock);
+			_endpoints[endpoint].insert(&reg);
+		}
+
+		void RegistrationIndex::remove(const dtn::data::EID &endpoint, Registration &reg)
+		{
+			ibrcommon::MutexLock l(_lock);
+
+			endpoint_map::iterator iter = _endpoints.find(endpoint);
+			if (iter == _endpoints.end()) return;
+
+			(*iter).second.erase(&reg);
+			if ((*iter).second.empty()) _endpoints.erase(iter);
+		}
+
+		size_t RegistrationIndex::deliver(const dtn::data::MetaBundle &meta)
+		{
+			size_t ret = 0;
+
+			ibrcommon::MutexLock l(_lock);
+
+			// registrations subscribed to the destination
+			endpoint_map::const_iterator eit = _endpoints.find(meta.destination);
+			if (eit == _endpoints.end()) return ret;
+
+			const registration_set &regs = (*eit).second;
+			for (registration_set::const_iterator iter = regs.begin(); iter != regs.end(); ++iter)
+			{
+				if ((*iter)->push(meta)) ret++;
+			}
+
+			return ret;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+/*
+ * RegistrationIndex.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef REGISTRATIONINDEX_H_
+#define REGISTRATIONINDEX_H_
+
+#include "Component.h"
+#include "core/EventReceiver.h"
+#include "routing/QueueBundleEvent.h"
+#include <ibrdtn/data/EID.h>
+#include <ibrdtn/data/MetaBundle.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <map>
+#include <set>
+
+namespace dtn
+{
+	namespace api
+	{
+		class Registration;
+
+		/**
+		 * The registration index maps destination endpoints to the
+		 * registrations subscribed to them. Queued bundles are put directly
+		 * into the queue of each matching registration, thus the cost of a
+		 * delivery depends on the number of matching subscribers only.
+		 */
+		class RegistrationIndex : public dtn::daemon::IntegratedComponent, public dtn::core::EventReceiver<dtn::routing::QueueBundleEvent>
+		{
+			static const std::string TAG;
+
+		public:
+			RegistrationIndex();
+			virtual ~RegistrationIndex();
+
+			/**
+			 * @see Component::getName()
+			 */
+			virtual const std::string getName() const;
+
+			void raiseEvent(const dtn::routing::QueueBundleEvent &evt) throw ();
+
+			/**
+			 * Add a subscription of a registration to the index
+			 */
+			static void add(const dtn::data::EID &endpoint, Registration &reg);
+
+			/**
+			 * Remove a subscription of a registration from the index
+			 */
+			static void remove(const dtn::data::EID &endpoint, Registration &reg);
+
+			/**
+			 * Put the bundle into the queue of all registrations subscribed
+			 * to its destination
+			 * @return The number of matching registrations
+			 */
+			static size_t deliver(const dtn::data::MetaBundle &meta);
+
+		protected:
+			void componentUp() throw ();
+			void componentDown() throw ();
+
+		private:
+			typedef std::set<Registration*> registration_set;
+			typedef std::map<dtn::data::EID, registration_set> endpoint_map;
+
+			static ibrcommon::Mutex _lock;
+			static endpoint_map _endpoints;
+		};
+	}
+}
+
+#endif /* REGISTRATIONINDEX_H_ */
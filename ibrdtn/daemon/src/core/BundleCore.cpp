@@ -48,6 +48,7 @@
 
 #ifdef IBRDTN_SUPPORT_BSP
 #include "security/SecurityManager.h"
+#include "security/SecurityProcessor.h"
 #include <ibrdtn/security/PayloadConfidentialBlock.h>
 #endif
 
@@ -627,6 +628,22 @@ namespace dtn
 			}
 #endif
 
+#ifdef IBRDTN_SUPPORT_BSP
+			// hand the bundle over to the security processor if encryption or signing is requested
+			if (dtn::security::SecurityProcessor::isRequested(bundle))
+			{
+				if (dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_SECURE, source, bundle)) return;
+
+				// no security processor is running, do it on our own
+				secure(bundle);
+			}
+#endif
+
+			forward(source, bundle);
+		}
+
+		void BundleCore::secure(dtn::data::Bundle &bundle)
+		{
 #ifdef IBRDTN_SUPPORT_BSP
 			// if the encrypt bit is set, then try to encrypt the bundle
 			if (bundle.get(dtn::data::PrimaryBlock::DTNSEC_REQUEST_ENCRYPT))
@@ -656,7 +673,10 @@ namespace dtn
 				}
 			}
 #endif
+		}
 
+		void BundleCore::forward(const dtn::data::EID &source, dtn::data::Bundle &bundle)
+		{
 			// get the payload size maximum
 			size_t maxPayloadLength = dtn::daemon::Configuration::getInstance().getLimit("payload");
 
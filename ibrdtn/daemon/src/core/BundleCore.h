@@ -180,6 +180,16 @@ namespace dtn
 			 */
 			static void inject(const dtn::data::EID &source, dtn::data::Bundle &bundle);
 
+			/**
+			 * Encrypt and sign the bundle as requested by the flags of the primary block
+			 */
+			static void secure(dtn::data::Bundle &bundle);
+
+			/**
+			 * Fragment the bundle if necessary and pass it to the routing
+			 */
+			static void forward(const dtn::data::EID &source, dtn::data::Bundle &bundle);
+
 		protected:
 			virtual void componentUp() throw ();
 			virtual void componentDown() throw ();
@@ -21,6 +21,7 @@
 
 #include "core/BundleEvent.h"
 #include "core/EventDispatcher.h"
+#include "core/BundleTracer.h"
 
 namespace dtn
 {
@@ -77,6 +78,8 @@ namespace dtn
 
 		void BundleEvent::raise(const dtn::data::MetaBundle &bundle, EventBundleAction action, dtn::data::StatusReportBlock::REASON_CODE reason)
 		{
+			if (action == BUNDLE_DELIVERED) BundleTracer::trace(BundleTracer::TRACE_DELIVERED, bundle);
+
 			// raise the new event
 			dtn::core::EventDispatcher<BundleEvent>::queue( new BundleEvent(bundle, action, reason) );
 		}
@@ -0,0 +1,291 @@
+/*
+ * BundleTracer.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/BundleTracer.h"
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/MonotonicClock.h>
+
+#include <algorithm>
+#include <sstream>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace dtn
+{
+	namespace core
+	{
+		volatile unsigned int BundleTracer::__rate = 0;
+
+		static pthread_key_t __tracer_key;
+		static pthread_once_t __tracer_once = PTHREAD_ONCE_INIT;
+
+		BundleTracer::Record::Record()
+		 : timestamp(0), stage(TRACE_RECEIVED), thread(0)
+		{
+		}
+
+		BundleTracer::Record::~Record()
+		{
+		}
+
+		BundleTracer::Buffer::Buffer(size_t t)
+		 : next(0), thread(t), orphaned(false)
+		{
+		}
+
+		BundleTracer::Buffer::~Buffer()
+		{
+		}
+
+		BundleTracer::BundleTracer()
+		 : _threads(0)
+		{
+		}
+
+		BundleTracer::~BundleTracer()
+		{
+		}
+
+		BundleTracer& BundleTracer::getInstance()
+		{
+			// never destroyed, threads may still trace on exit
+			static BundleTracer *instance = new BundleTracer();
+			return *instance;
+		}
+
+		void BundleTracer::setSampling(unsigned int rate)
+		{
+			__rate = rate;
+		}
+
+		unsigned int BundleTracer::getSampling() const
+		{
+			return __rate;
+		}
+
+		void BundleTracer::clear()
+		{
+			ibrcommon::MutexLock l(_buffers_lock);
+
+			for (std::list<Buffer*>::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+			{
+				Buffer &b = (**it);
+				ibrcommon::MutexLock lb(b.lock);
+				b.records.clear();
+				b.next = 0;
+			}
+		}
+
+		bool BundleTracer::__sampled(const dtn::data::BundleID &id, unsigned int rate)
+		{
+			if (rate <= 1) return true;
+
+			// mix the numeric parts of the ID, equal on all nodes
+			uint64_t h = id.timestamp.get<uint64_t>() * 0x9E3779B97F4A7C15ULL;
+			h ^= id.sequencenumber.get<uint64_t>() + 0x7F4A7C15ULL + (h << 6) + (h >> 2);
+			h ^= id.fragmentoffset.get<uint64_t>() + 0x7F4A7C15ULL + (h << 6) + (h >> 2);
+
+			return (h % rate) == 0;
+		}
+
+		void BundleTracer::__key_create()
+		{
+			pthread_key_create(&__tracer_key, &BundleTracer::__release);
+		}
+
+		void BundleTracer::__release(void *buffer)
+		{
+			BundleTracer &tracer = BundleTracer::getInstance();
+			ibrcommon::MutexLock l(tracer._buffers_lock);
+
+			// keep the records until the buffer is taken by another thread
+			static_cast<Buffer*>(buffer)->orphaned = true;
+		}
+
+		BundleTracer::Buffer& BundleTracer::__buffer()
+		{
+			pthread_once(&__tracer_once, &BundleTracer::__key_create);
+
+			Buffer *buffer = static_cast<Buffer*>(pthread_getspecific(__tracer_key));
+			if (buffer != NULL) return *buffer;
+
+			{
+				ibrcommon::MutexLock l(_buffers_lock);
+
+				// re-use the buffer of a finished thread
+				for (std::list<Buffer*>::iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+				{
+					if ((*it)->orphaned)
+					{
+						buffer = (*it);
+						buffer->orphaned = false;
+						buffer->thread = ++_threads;
+						break;
+					}
+				}
+
+				if (buffer == NULL)
+				{
+					buffer = new Buffer(++_threads);
+					_buffers.push_back(buffer);
+				}
+			}
+
+			pthread_setspecific(__tracer_key, buffer);
+			return *buffer;
+		}
+
+		void BundleTracer::__trace(STAGE stage, const dtn::data::BundleID &id, const dtn::data::EID *peer)
+		{
+			if (!__sampled(id, __rate)) return;
+
+			struct timespec ts;
+			ibrcommon::MonotonicClock::gettime(ts);
+
+			Buffer &b = __buffer();
+			ibrcommon::MutexLock l(b.lock);
+
+			// grow until the buffer is full, then overwrite the oldest record
+			if (b.records.size() < BUFFER_SIZE) b.records.push_back(Record());
+			Record &r = b.records[b.next];
+			b.next = (b.next + 1) % BUFFER_SIZE;
+
+			r.timestamp = static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + static_cast<uint64_t>(ts.tv_nsec / 1000);
+			r.stage = stage;
+			r.thread = b.thread;
+			r.bundle = id;
+			r.peer = (peer == NULL) ? dtn::data::EID() : (*peer);
+		}
+
+		const char* BundleTracer::getStageName(STAGE stage)
+		{
+			switch (stage)
+			{
+			case TRACE_RECEIVED: return "received";
+			case TRACE_STORED: return "stored";
+			case TRACE_QUEUED: return "queued";
+			case TRACE_SELECTED: return "selected";
+			case TRACE_HANDED: return "handed to cl";
+			case TRACE_TRANSMITTED: return "transmitted";
+			case TRACE_ACKED: return "acked";
+			case TRACE_DELIVERED: return "delivered";
+			case TRACE_PURGED: return "purged";
+			}
+
+			return "unknown";
+		}
+
+		std::string BundleTracer::__escape(const std::string &str)
+		{
+			std::string ret;
+
+			for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+			{
+				switch (*it)
+				{
+				case '\\': ret += "\\\\"; break;
+				case '"': ret += "\\\""; break;
+				default:
+					if (static_cast<unsigned char>(*it) >= 0x20) ret += *it;
+					break;
+				}
+			}
+
+			return ret;
+		}
+
+		struct __record_order
+		{
+			template<class R>
+			bool operator()(const R &a, const R &b) const
+			{
+				if (a.bundle < b.bundle) return true;
+				if (b.bundle < a.bundle) return false;
+				return a.timestamp < b.timestamp;
+			}
+		};
+
+		void BundleTracer::exportJSON(std::ostream &stream) const
+		{
+			std::vector<Record> records;
+
+			{
+				ibrcommon::MutexLock l(const_cast<ibrcommon::Mutex&>(_buffers_lock));
+
+				for (std::list<Buffer*>::const_iterator it = _buffers.begin(); it != _buffers.end(); ++it)
+				{
+					Buffer &b = (**it);
+					ibrcommon::MutexLock lb(b.lock);
+					records.insert(records.end(), b.records.begin(), b.records.end());
+				}
+			}
+
+			std::sort(records.begin(), records.end(), __record_order());
+
+			const pid_t pid = ::getpid();
+			size_t track = 0;
+			bool first = true;
+
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			for (std::vector<Record>::const_iterator it = records.begin(); it != records.end();)
+			{
+				// find all records of this bundle
+				std::vector<Record>::const_iterator end = it;
+				while (end != records.end() && !((*it).bundle != (*end).bundle)) ++end;
+
+				const std::string name = __escape((*it).bundle.toString());
+				std::stringstream id; id << "0x" << std::hex << ++track;
+
+				// each bundle is an async track from its first until its last record
+				if (!first) stream << ",";
+				first = false;
+
+				stream << "\n{\"name\":\"" << name << "\",\"cat\":\"bundle\",\"ph\":\"b\",\"id\":\"" << id.str()
+						<< "\",\"ts\":" << (*it).timestamp << ",\"pid\":" << pid << ",\"tid\":" << (*it).thread << "}";
+
+				uint64_t last = 0;
+				size_t last_thread = 0;
+				for (; it != end; ++it)
+				{
+					const Record &r = (*it);
+
+					stream << ",\n{\"name\":\"" << getStageName(r.stage) << "\",\"cat\":\"bundle\",\"ph\":\"n\",\"id\":\"" << id.str()
+							<< "\",\"ts\":" << r.timestamp << ",\"pid\":" << pid << ",\"tid\":" << r.thread
+							<< ",\"args\":{\"bundle\":\"" << name << "\"";
+
+					if (r.peer != dtn::data::EID())
+						stream << ",\"peer\":\"" << __escape(r.peer.getString()) << "\"";
+
+					stream << "}}";
+
+					last = r.timestamp;
+					last_thread = r.thread;
+				}
+
+				stream << ",\n{\"name\":\"" << name << "\",\"cat\":\"bundle\",\"ph\":\"e\",\"id\":\"" << id.str()
+						<< "\",\"ts\":" << last << ",\"pid\":" << pid << ",\"tid\":" << last_thread << "}";
+			}
+
+			stream << "\n]}" << std::endl;
+		}
+	}
+}
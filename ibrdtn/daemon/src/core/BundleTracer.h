@@ -0,0 +1,148 @@
+/*
+ * BundleTracer.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef BUNDLETRACER_H_
+#define BUNDLETRACER_H_
+
+#include <ibrdtn/data/BundleID.h>
+#include <ibrdtn/data/EID.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+#include <list>
+
+namespace dtn
+{
+	namespace core
+	{
+		/**
+		 * Records the lifecycle of sampled bundles in per-thread ring buffers.
+		 * Whether a bundle is sampled depends on its ID only, so all stages of
+		 * a sampled bundle are recorded. While tracing is disabled, a trace
+		 * point costs one comparison.
+		 */
+		class BundleTracer
+		{
+		public:
+			enum STAGE
+			{
+				TRACE_RECEIVED = 0,
+				TRACE_STORED = 1,
+				TRACE_QUEUED = 2,
+				TRACE_SELECTED = 3,
+				TRACE_HANDED = 4,
+				TRACE_TRANSMITTED = 5,
+				TRACE_ACKED = 6,
+				TRACE_DELIVERED = 7,
+				TRACE_PURGED = 8
+			};
+
+			// number of records of each thread
+			static const size_t BUFFER_SIZE = 4096;
+
+			static BundleTracer& getInstance();
+
+			/**
+			 * Record a stage of a bundle if it is sampled
+			 */
+			static void trace(STAGE stage, const dtn::data::BundleID &id)
+			{
+				if (__rate != 0) getInstance().__trace(stage, id, NULL);
+			}
+
+			/**
+			 * Record a stage of a bundle if it is sampled
+			 * @param peer The neighbor involved in this stage
+			 */
+			static void trace(STAGE stage, const dtn::data::BundleID &id, const dtn::data::EID &peer)
+			{
+				if (__rate != 0) getInstance().__trace(stage, id, &peer);
+			}
+
+			/**
+			 * Set the sampling rate
+			 * @param rate Trace one of rate bundles, zero disables tracing
+			 */
+			void setSampling(unsigned int rate);
+			unsigned int getSampling() const;
+
+			/**
+			 * Discard all records
+			 */
+			void clear();
+
+			/**
+			 * Write all records in the Chrome trace event format, each bundle
+			 * as an async track, readable by chrome://tracing and Perfetto
+			 */
+			void exportJSON(std::ostream &stream) const;
+
+			static const char* getStageName(STAGE stage);
+
+		private:
+			BundleTracer();
+			virtual ~BundleTracer();
+
+			class Record
+			{
+			public:
+				Record();
+				~Record();
+
+				uint64_t timestamp;
+				STAGE stage;
+				size_t thread;
+				dtn::data::BundleID bundle;
+				dtn::data::EID peer;
+			};
+
+			class Buffer
+			{
+			public:
+				Buffer(size_t thread);
+				~Buffer();
+
+				ibrcommon::Mutex lock;
+				std::vector<Record> records;
+				size_t next;
+				size_t thread;
+				bool orphaned;
+			};
+
+			void __trace(STAGE stage, const dtn::data::BundleID &id, const dtn::data::EID *peer);
+			Buffer& __buffer();
+
+			static bool __sampled(const dtn::data::BundleID &id, unsigned int rate);
+			static void __release(void *buffer);
+			static void __key_create();
+			static std::string __escape(const std::string &str);
+
+			static volatile unsigned int __rate;
+
+			ibrcommon::Mutex _buffers_lock;
+			std::list<Buffer*> _buffers;
+			size_t _threads;
+		};
+	}
+}
+
+#endif /* BUNDLETRACER_H_ */
@@ -11,9 +11,11 @@
 #include "core/Event.h"
 #include "core/EventSwitch.h"
 #include "core/EventReceiver.h"
+#include "core/EventProfiler.h"
 #include <ibrcommon/thread/Mutex.h>
 #include <ibrcommon/thread/MutexLock.h>
 #include <list>
+#include <typeinfo>
 
 namespace dtn
 {
@@ -31,7 +33,7 @@ namespace dtn
 			class EventProcessorImpl : public EventProcessor {
 			public:
 				EventProcessorImpl(EventDispatcher<E> &dispatcher)
-				: _dispatcher(dispatcher) { };
+				: _dispatcher(dispatcher), _profiler(EventProfiler::getInstance()) { };
 
 				virtual ~EventProcessorImpl() { };
 
@@ -42,13 +44,21 @@ namespace dtn
 							iter != _dispatcher._receivers.end(); ++iter)
 					{
 						EventReceiver<E> &receiver = (**iter);
-						receiver.raiseEvent(static_cast<const E&>(*evt));
+
+						if (_profiler.isEnabled()) {
+							const EventProfiler::Sample sample;
+							receiver.raiseEvent(static_cast<const E&>(*evt));
+							_profiler.record(typeid(E), typeid(receiver), sample);
+						} else {
+							receiver.raiseEvent(static_cast<const E&>(*evt));
+						}
 					}
 
 					_dispatcher._stat_count++;
 				}
 
 				EventDispatcher<E> &_dispatcher;
+				EventProfiler &_profiler;
 			};
 
 			void _reset() {
@@ -0,0 +1,256 @@
+/*
+ * EventProfiler.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/EventProfiler.h"
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/MonotonicClock.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace dtn
+{
+	namespace core
+	{
+		EventProfiler::Sample::Sample()
+		 : _wall(EventProfiler::__monotonic()), _cpu(EventProfiler::__cputime())
+		{
+		}
+
+		EventProfiler::Sample::~Sample()
+		{
+		}
+
+		uint64_t EventProfiler::Sample::wall() const
+		{
+			return EventProfiler::__monotonic() - _wall;
+		}
+
+		uint64_t EventProfiler::Sample::cpu() const
+		{
+			return EventProfiler::__cputime() - _cpu;
+		}
+
+		EventProfiler::Stats::Stats()
+		 : calls(0), wall(0), wall_max(0), cpu(0), dwell(0)
+		{
+		}
+
+		void EventProfiler::Stats::add(const Sample &sample, uint64_t d)
+		{
+			const uint64_t w = sample.wall();
+
+			calls++;
+			wall += w;
+			if (w > wall_max) wall_max = w;
+			cpu += sample.cpu();
+			dwell += d;
+		}
+
+		EventProfiler::EventProfiler()
+		 : _enabled(false), _since(__monotonic())
+		{
+		}
+
+		EventProfiler::~EventProfiler()
+		{
+		}
+
+		EventProfiler& EventProfiler::getInstance()
+		{
+			static EventProfiler instance;
+			return instance;
+		}
+
+		void EventProfiler::enable(bool val)
+		{
+			ibrcommon::MutexLock l(_lock);
+			if (val && !_enabled) _since = __monotonic();
+			_enabled = val;
+		}
+
+		bool EventProfiler::isEnabled() const
+		{
+			return _enabled;
+		}
+
+		void EventProfiler::reset()
+		{
+			ibrcommon::MutexLock l(_lock);
+			_events.clear();
+			_since = __monotonic();
+		}
+
+		void EventProfiler::record(const std::type_info &event, uint64_t dwell, const Sample &sample)
+		{
+			ibrcommon::MutexLock l(_lock);
+			_events[event.name()].stats.add(sample, dwell);
+		}
+
+		void EventProfiler::record(const std::type_info &event, const std::type_info &receiver, const Sample &sample)
+		{
+			ibrcommon::MutexLock l(_lock);
+			_events[event.name()].receivers[receiver.name()].add(sample, 0);
+		}
+
+		template<class T>
+		static bool __by_wall(const std::pair<uint64_t, T> &a, const std::pair<uint64_t, T> &b)
+		{
+			return a.first > b.first;
+		}
+
+		static void __print_row(std::ostream &stream, uint64_t calls, uint64_t wall, uint64_t wall_max, uint64_t cpu, uint64_t dwell, bool with_dwell)
+		{
+			// use a separate stream to leave the format of the output untouched
+			std::stringstream ss;
+			ss << std::fixed << std::setprecision(1)
+					<< std::setw(9) << calls
+					<< std::setw(11) << (static_cast<double>(wall) / 1000.0)
+					<< std::setw(9) << ((calls > 0) ? (wall / calls) : 0)
+					<< std::setw(10) << wall_max
+					<< std::setw(10) << (static_cast<double>(cpu) / 1000.0);
+
+			if (with_dwell)
+				ss << std::setw(10) << ((calls > 0) ? (dwell / calls) : 0);
+			else
+				ss << std::setw(10) << "-";
+
+			stream << ss.str();
+		}
+
+		void EventProfiler::printTop(std::ostream &stream, size_t limit) const
+		{
+			ibrcommon::MutexLock l(const_cast<ibrcommon::Mutex&>(_lock));
+
+			typedef std::pair<uint64_t, event_map::const_iterator> event_entry;
+			std::vector<event_entry> events;
+
+			for (event_map::const_iterator it = _events.begin(); it != _events.end(); ++it)
+			{
+				// events raised directly are only known by their receivers
+				uint64_t wall = (*it).second.stats.wall;
+				if ((*it).second.stats.calls == 0)
+				{
+					for (std::map<std::string, Stats>::const_iterator r = (*it).second.receivers.begin(); r != (*it).second.receivers.end(); ++r)
+						wall += (*r).second.wall;
+				}
+				events.push_back(event_entry(wall, it));
+			}
+
+			std::sort(events.begin(), events.end(), __by_wall<event_map::const_iterator>);
+
+			stream << "Profiling: " << (_enabled ? "enabled" : "disabled") << ", " << ((__monotonic() - _since) / 1000000) << " seconds" << std::endl;
+			stream << "    CALLS    WALL ms   AVG us    MAX us    CPU ms  DWELL us  EVENT / RECEIVER" << std::endl;
+
+			size_t count = 0;
+			for (std::vector<event_entry>::const_iterator it = events.begin(); it != events.end() && count < limit; ++it, ++count)
+			{
+				const EventStats &e = (*(*it).second).second;
+
+				__print_row(stream, e.stats.calls, e.stats.wall, e.stats.wall_max, e.stats.cpu, e.stats.dwell, e.stats.calls > 0);
+				stream << "  " << __demangle((*(*it).second).first) << std::endl;
+
+				typedef std::pair<uint64_t, std::map<std::string, Stats>::const_iterator> receiver_entry;
+				std::vector<receiver_entry> receivers;
+
+				for (std::map<std::string, Stats>::const_iterator r = e.receivers.begin(); r != e.receivers.end(); ++r)
+					receivers.push_back(receiver_entry((*r).second.wall, r));
+
+				std::sort(receivers.begin(), receivers.end(), __by_wall<std::map<std::string, Stats>::const_iterator>);
+
+				for (std::vector<receiver_entry>::const_iterator r = receivers.begin(); r != receivers.end(); ++r)
+				{
+					const Stats &s = (*(*r).second).second;
+					__print_row(stream, s.calls, s.wall, s.wall_max, s.cpu, 0, false);
+					stream << "    " << __demangle((*(*r).second).first) << std::endl;
+				}
+			}
+		}
+
+		void EventProfiler::printFolded(std::ostream &stream) const
+		{
+			ibrcommon::MutexLock l(const_cast<ibrcommon::Mutex&>(_lock));
+
+			for (event_map::const_iterator it = _events.begin(); it != _events.end(); ++it)
+			{
+				const std::string event = "EventSwitch;" + __demangle((*it).first);
+				const EventStats &e = (*it).second;
+
+				uint64_t receivers = 0;
+				for (std::map<std::string, Stats>::const_iterator r = e.receivers.begin(); r != e.receivers.end(); ++r)
+				{
+					if ((*r).second.wall == 0) continue;
+					stream << event << ";" << __demangle((*r).first) << " " << (*r).second.wall << std::endl;
+					receivers += (*r).second.wall;
+				}
+
+				// time spent in the dispatcher itself
+				if (e.stats.wall > receivers)
+				{
+					stream << event << " " << (e.stats.wall - receivers) << std::endl;
+				}
+			}
+		}
+
+		uint64_t EventProfiler::__monotonic()
+		{
+			struct timespec ts;
+			ibrcommon::MonotonicClock::gettime(ts);
+			return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + static_cast<uint64_t>(ts.tv_nsec / 1000);
+		}
+
+		uint64_t EventProfiler::__cputime()
+		{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+			struct timespec ts;
+			if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+			{
+				return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + static_cast<uint64_t>(ts.tv_nsec / 1000);
+			}
+#endif
+			return 0;
+		}
+
+		std::string EventProfiler::__demangle(const std::string &name)
+		{
+#ifdef __GNUG__
+			int status = 0;
+			char *ret = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status);
+
+			if (ret != NULL)
+			{
+				const std::string demangled(ret);
+				::free(ret);
+				return demangled;
+			}
+#endif
+			return name;
+		}
+	}
+}
@@ -0,0 +1,146 @@
+/*
+ * EventProfiler.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef EVENTPROFILER_H_
+#define EVENTPROFILER_H_
+
+#include <ibrcommon/thread/Mutex.h>
+#include <stdint.h>
+#include <typeinfo>
+#include <iostream>
+#include <string>
+#include <map>
+
+namespace dtn
+{
+	namespace core
+	{
+		/**
+		 * The event profiler attributes the time spent in the event switch
+		 * to event types and their receivers. It is enabled by the
+		 * profiling option or through the management API.
+		 */
+		class EventProfiler
+		{
+		public:
+			/**
+			 * Wall clock and CPU time of the calling thread at creation
+			 */
+			class Sample
+			{
+			public:
+				Sample();
+				~Sample();
+
+				/**
+				 * @return Elapsed wall clock time in microseconds
+				 */
+				uint64_t wall() const;
+
+				/**
+				 * @return Elapsed CPU time of the calling thread in microseconds
+				 */
+				uint64_t cpu() const;
+
+			private:
+				const uint64_t _wall;
+				const uint64_t _cpu;
+			};
+
+			static EventProfiler& getInstance();
+
+			void enable(bool val);
+			bool isEnabled() const;
+
+			/**
+			 * Discard all collected data
+			 */
+			void reset();
+
+			/**
+			 * Account the processing of an event by the event switch
+			 * @param event Type of the event
+			 * @param dwell Time the event spent in the queue in microseconds
+			 * @param sample Sample taken before the event has been processed
+			 */
+			void record(const std::type_info &event, uint64_t dwell, const Sample &sample);
+
+			/**
+			 * Account the delivery of an event to one receiver
+			 * @param event Type of the event
+			 * @param receiver Type of the receiver
+			 * @param sample Sample taken before the receiver has been called
+			 */
+			void record(const std::type_info &event, const std::type_info &receiver, const Sample &sample);
+
+			/**
+			 * Write a table of the event types ordered by the consumed
+			 * wall clock time, each followed by its receivers
+			 * @param limit Max. number of event types to list
+			 */
+			void printTop(std::ostream &stream, size_t limit) const;
+
+			/**
+			 * Write the wall clock time in the folded stack format
+			 * used by flame graph tools
+			 */
+			void printFolded(std::ostream &stream) const;
+
+		private:
+			EventProfiler();
+			virtual ~EventProfiler();
+
+			class Stats
+			{
+			public:
+				Stats();
+				void add(const Sample &sample, uint64_t dwell);
+
+				uint64_t calls;
+				uint64_t wall;
+				uint64_t wall_max;
+				uint64_t cpu;
+				uint64_t dwell;
+			};
+
+			class EventStats
+			{
+			public:
+				Stats stats;
+				std::map<std::string, Stats> receivers;
+			};
+
+			typedef std::map<std::string, EventStats> event_map;
+
+			static uint64_t __monotonic();
+			static uint64_t __cputime();
+			static std::string __demangle(const std::string &name);
+
+			volatile bool _enabled;
+			uint64_t _since;
+
+			ibrcommon::Mutex _lock;
+			event_map _events;
+		};
+	}
+}
+
+#endif /* EVENTPROFILER_H_ */
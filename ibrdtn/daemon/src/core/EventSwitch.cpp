@@ -22,6 +22,7 @@
 #include "core/EventSwitch.h"
 #include "core/EventReceiver.h"
 #include "core/EventDispatcher.h"
+#include "core/EventProfiler.h"
 
 #include <ibrcommon/thread/MutexLock.h>
 #include "core/GlobalEvent.h"
@@ -36,7 +37,10 @@ namespace dtn
 	namespace core
 	{
 		EventSwitch::EventSwitch()
-		 : _running(true), _shutdown(false), _wd(*this, _wlist), _inprogress(false)
+		 : _running(true), _shutdown(false), _wd(*this, _wlist), _inprogress(false),
+		   _wait_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_event_queue_wait_seconds", "Time events spend in the event queues", "", 0.000001)),
+		   _process_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_event_process_seconds", "Time spent to process an event", "", 0.000001)),
+		   _queue_length(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_event_queue_length", "Number of events in the event queues"))
 		{
 		}
 
@@ -53,6 +57,7 @@ namespace dtn
 			_queue = std::queue<Task*>();
 			_prio_queue = std::queue<Task*>();
 			_low_queue = std::queue<Task*>();
+			_queue_length.set(0);
 
 			// reset component state
 			_running = true;
@@ -131,12 +136,26 @@ namespace dtn
 
 			if (t != NULL)
 			{
+				_queue_length.add(-1);
+
+				const uint64_t start = ibrcommon::Histogram::now();
+				_wait_latency.record(start - t->queued);
+
 				if (profiling) {
 					inprogress = true;
 					tm.start();
 				}
 				// execute the event
-				t->processor.process(t->event);
+				EventProfiler &profiler = EventProfiler::getInstance();
+				if (profiler.isEnabled()) {
+					const EventProfiler::Sample sample;
+					t->processor.process(t->event);
+					profiler.record(typeid(*t->event), start - t->queued, sample);
+				} else {
+					t->processor.process(t->event);
+				}
+
+				_process_latency.record(ibrcommon::Histogram::now() - start);
 
 				if (profiling) {
 					tm.stop();
@@ -169,6 +188,7 @@ namespace dtn
 		{
 			if (profiling) {
 				IBRCOMMON_LOGGER_TAG("EventSwitch", warning) << "Profiling and stalled event detection enabled" << IBRCOMMON_LOGGER_ENDL;
+				EventProfiler::getInstance().enable(true);
 			}
 
 			for (size_t i = 0; i < threads; ++i)
@@ -230,6 +250,7 @@ namespace dtn
 			{
 				s._queue.push(t);
 			}
+			s._queue_length.add(1);
 			s._queue_cond.signal();
 		}
 
@@ -258,7 +279,7 @@ namespace dtn
 		}
 
 		EventSwitch::Task::Task(EventProcessor &proc, dtn::core::Event *evt)
-		 : processor(proc), event(evt)
+		 : processor(proc), event(evt), queued(ibrcommon::Histogram::now())
 		{
 		}
 
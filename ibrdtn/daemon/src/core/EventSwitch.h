@@ -28,6 +28,7 @@
 #include <ibrcommon/thread/Mutex.h>
 #include <ibrcommon/thread/Conditional.h>
 #include <ibrcommon/TimeMeasurement.h>
+#include <ibrcommon/Metrics.h>
 
 #include <list>
 #include <queue>
@@ -59,6 +60,9 @@ namespace dtn
 
 				EventProcessor &processor;
 				dtn::core::Event *event;
+
+				// monotonic time of the enqueue in microseconds
+				const uint64_t queued;
 			};
 
 			class Worker : public ibrcommon::JoinableThread
@@ -113,6 +117,10 @@ namespace dtn
 			ibrcommon::TimeMeasurement _tm;
 			bool _inprogress;
 
+			ibrcommon::Histogram &_wait_latency;
+			ibrcommon::Histogram &_process_latency;
+			ibrcommon::Gauge &_queue_length;
+
 			void process(ibrcommon::TimeMeasurement &tm, bool &inprogress, bool profiling);
 
 		protected:
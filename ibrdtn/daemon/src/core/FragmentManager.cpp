@@ -31,6 +31,8 @@
 #include <ibrcommon/Logger.h>
 #include <ibrcommon/thread/MutexLock.h>
 
+#include <algorithm>
+
 #include <ibrdtn/ibrdtn.h>
 #ifdef IBRDTN_SUPPORT_BSP
 #include "security/SecurityManager.h"
@@ -77,92 +79,31 @@ namespace dtn
 			// get reference to the storage
 			dtn::storage::BundleStorage &storage = dtn::core::BundleCore::getInstance().getStorage();
 
-			// TODO: scan storage for fragments to reassemble on startup
+			// restore the reassembly state of fragments received before
+			scan(storage);
 
-			dtn::storage::BundleResultList list;
+			dtn::data::Timestamp last_expiration = dtn::utils::Clock::getTime();
 
 			// create a task loop to reassemble fragments asynchronously
-			try {
-				while (_running)
-				{
-					dtn::data::MetaBundle meta = _incoming.poll();
-
-					// skip merge if complete bundle is already in the storage
-					dtn::data::BundleID origin(meta);
-					origin.setFragment(false);
-					if (storage.contains(origin)) continue;
-
-					// search for matching bundles
-					list.clear();
-					search(meta, list);
-
-					IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 20) << "found " << list.size() << " fragments similar to bundle " << meta.toString() << IBRCOMMON_LOGGER_ENDL;
-
-					// TODO: drop fragments if other fragments available containing the same payload or larger payload
-
-					// check first if all fragment are available
-					std::set<BundleMerger::Chunk> chunks;
-					for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-					{
-						const dtn::data::MetaBundle &m = (*iter);
-						if (meta.getPayloadLength() > 0)
-						{
-							BundleMerger::Chunk chunk(m.fragmentoffset.get<dtn::data::Length>(), m.getPayloadLength());
-							chunks.insert(chunk);
-						}
-					}
-
-					// wait for the next bundle if the fragment is not complete
-					if (!BundleMerger::Chunk::isComplete(meta.appdatalength.get<dtn::data::Length>(), chunks)) continue;
-
-					// create a new bundle merger container
-					dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
-
-					for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-					{
-						const dtn::data::MetaBundle &meta = (*iter);
-
-						if (meta.getPayloadLength() > 0)
-						{
-							IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 20) << "fragment: " << (*iter).toString() << IBRCOMMON_LOGGER_ENDL;
-
-							try {
-								// load bundle from storage
-								const dtn::data::Bundle bundle = dtn::core::BundleCore::getInstance().getStorage().get(*iter);
-
-								// merge the bundle
-								c << bundle;
-							} catch (const dtn::storage::NoBundleFoundException&) {
-								IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, error) << "could not load fragment to merge bundle" << IBRCOMMON_LOGGER_ENDL;
-							};
-						}
-					}
-
-					if (c.isComplete())
-					{
-						dtn::data::Bundle &merged = c.getBundle();
-
-						IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, notice) << "Bundle " << merged.toString() << " merged" << IBRCOMMON_LOGGER_ENDL;
-
-#ifdef IBRDTN_SUPPORT_BSP
-						// lets see if signatures and hashes are correct and remove them if possible
-						dtn::security::SecurityManager::getInstance().verify(merged);
-#endif
+			while (_running)
+			{
+				try {
+					// wake up once per second to expire reassemblies without new fragments
+					dtn::data::MetaBundle meta = _incoming.poll(1000);
 
-						// raise default bundle received event
-						dtn::net::BundleReceivedEvent::raise(dtn::core::BundleCore::local, merged, true);
+					merge(storage, meta);
+				} catch (const ibrcommon::QueueUnblockedException &ex) {
+					if (ex.reason != ibrcommon::QueueUnblockedException::QUEUE_TIMEOUT) return;
+				}
 
-						// delete all fragments of the merged bundle
-						if (merged.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
-						{
-							for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-							{
-								dtn::core::BundlePurgeEvent::raise(*iter);
-							}
-						}
-					}
+				// drop stale reassemblies once per second
+				const dtn::data::Timestamp now = dtn::utils::Clock::getTime();
+				if (now != last_expiration)
+				{
+					expire(now);
+					last_expiration = now;
 				}
-			} catch (const ibrcommon::QueueUnblockedException&) { }
+			}
 		}
 
 		void FragmentManager::componentDown() throw ()
@@ -171,34 +112,43 @@ namespace dtn
 
 			stop();
 			join();
+
+			_reassemblies.clear();
 		}
 
 		void FragmentManager::raiseEvent(const dtn::routing::QueueBundleEvent &queued) throw ()
 		{
 			// process fragments
-			if (!queued.bundle.isFragment()) return;
+			if (!isCandidate(queued.bundle)) return;
+
+			// push the meta bundle into the incoming queue
+			_incoming.push(queued.bundle);
+		}
+
+		bool FragmentManager::isCandidate(const dtn::data::MetaBundle &meta) throw ()
+		{
+			// process fragments
+			if (!meta.isFragment()) return false;
 
 			// do not merge a bundle if it is non-local and singleton
 			// we only touch local and group bundles which might be delivered locally
-			if (queued.bundle.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
+			if (meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
 			{
-				if (!queued.bundle.destination.sameHost(dtn::core::BundleCore::local))
+				if (!meta.destination.sameHost(dtn::core::BundleCore::local))
 				{
-					return;
+					return false;
 				}
 			}
 
-			// push the meta bundle into the incoming queue
-			_incoming.push(queued.bundle);
+			return true;
 		}
 
-		void FragmentManager::search(const dtn::data::MetaBundle &meta, dtn::storage::BundleResult &list)
+		void FragmentManager::scan(dtn::storage::BundleStorage &storage) throw ()
 		{
 			class BundleFilter : public dtn::storage::BundleSelector
 			{
 			public:
-				BundleFilter(const dtn::data::MetaBundle &meta)
-				 : _similar(meta)
+				BundleFilter()
 				{};
 
 				virtual ~BundleFilter() {};
@@ -207,28 +157,129 @@ namespace dtn
 
 				virtual bool shouldAdd(const dtn::data::MetaBundle &meta) const throw (dtn::storage::BundleSelectorException)
 				{
-					// fragments only
-					if (!meta.isFragment()) return false;
-
-					// with the same unique bundle id
-					if (meta.source != _similar.source) return false;
-					if (meta.timestamp != _similar.timestamp) return false;
-					if (meta.sequencenumber != _similar.sequencenumber) return false;
-
-					return true;
+					return FragmentManager::isCandidate(meta);
 				};
-
-			private:
-				const dtn::data::MetaBundle &_similar;
 			};
 
-			// create a bundle filter
-			BundleFilter filter(meta);
-			dtn::storage::BundleStorage &storage = dtn::core::BundleCore::getInstance().getStorage();
-			
+			// collect all fragments with a single query
+			BundleFilter filter;
+			dtn::storage::BundleResultList list;
+
 			try {
 				storage.get(filter, list);
 			} catch (const dtn::storage::NoBundleFoundException&) { }
+
+			if (list.empty()) return;
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 5) << "restore reassembly of " << list.size() << " fragments" << IBRCOMMON_LOGGER_ENDL;
+
+			for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+			{
+				if (!_running) return;
+				merge(storage, *iter);
+			}
+		}
+
+		void FragmentManager::merge(dtn::storage::BundleStorage &storage, const dtn::data::MetaBundle &meta) throw ()
+		{
+			// skip merge if complete bundle is already in the storage
+			dtn::data::BundleID origin(meta);
+			origin.setFragment(false);
+
+			if (storage.contains(origin))
+			{
+				_reassemblies.erase(origin);
+				return;
+			}
+
+			// ignore fragments without payload
+			if (meta.getPayloadLength() == 0) return;
+
+			// do not allocate a reassembly larger than the block size limit
+			if ((BundleCore::blocksizelimit > 0) && (meta.appdatalength.get<dtn::data::Length>() > BundleCore::blocksizelimit))
+			{
+				IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, warning) << "fragment " << meta.toString() << " not merged: application data length exceeds the block size limit" << IBRCOMMON_LOGGER_ENDL;
+				return;
+			}
+
+			Reassembly &r = _reassemblies[origin];
+
+			// skip fragments already merged
+			if (r.fragments.find(meta) != r.fragments.end()) return;
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 20) << "fragment: " << meta.toString() << IBRCOMMON_LOGGER_ENDL;
+
+			try {
+				// load the fragment from the storage and write its payload into the container
+				const dtn::data::Bundle bundle = storage.get(meta);
+				r.container << bundle;
+			} catch (const dtn::storage::NoBundleFoundException&) {
+				IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, error) << "could not load fragment to merge bundle" << IBRCOMMON_LOGGER_ENDL;
+				if (r.fragments.empty()) _reassemblies.erase(origin);
+				return;
+			} catch (const ibrcommon::Exception &ex) {
+				IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, error) << "could not merge fragment " << meta.toString() << ": " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				if (r.fragments.empty()) _reassemblies.erase(origin);
+				return;
+			}
+
+			r.fragments.insert(meta);
+			if (meta.expiretime > r.expires) r.expires = meta.expiretime;
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 20) << "received " << r.container.getCovered() << " of " << meta.appdatalength.toString() << " bytes of bundle " << origin.toString() << IBRCOMMON_LOGGER_ENDL;
+
+			// wait for the next bundle if the payload is not complete
+			if (!r.container.isComplete()) return;
+
+			dtn::data::Bundle &merged = r.container.getBundle();
+
+			IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, notice) << "Bundle " << merged.toString() << " merged" << IBRCOMMON_LOGGER_ENDL;
+
+#ifdef IBRDTN_SUPPORT_BSP
+			// lets see if signatures and hashes are correct and remove them if possible
+			dtn::security::SecurityManager::getInstance().verify(merged);
+#endif
+
+			// raise default bundle received event
+			dtn::net::BundleReceivedEvent::raise(dtn::core::BundleCore::local, merged, true);
+
+			// delete all fragments of the merged bundle
+			if (merged.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
+			{
+				for (std::set<dtn::data::BundleID>::const_iterator iter = r.fragments.begin(); iter != r.fragments.end(); ++iter)
+				{
+					dtn::core::BundlePurgeEvent::raise(dtn::data::MetaBundle::create(*iter));
+				}
+			}
+
+			_reassemblies.erase(origin);
+		}
+
+		void FragmentManager::expire(const dtn::data::Timestamp &timestamp) throw ()
+		{
+			for (reassembly_map::iterator iter = _reassemblies.begin(); iter != _reassemblies.end();)
+			{
+				const Reassembly &r = iter->second;
+
+				if (r.expires < timestamp)
+				{
+					IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 5) << "drop reassembly of expired bundle " << iter->first.toString() << IBRCOMMON_LOGGER_ENDL;
+					_reassemblies.erase(iter++);
+				}
+				else
+				{
+					++iter;
+				}
+			}
+		}
+
+		FragmentManager::Reassembly::Reassembly()
+		 : container(dtn::data::BundleMerger::getContainer()), expires(0)
+		{
+		}
+
+		FragmentManager::Reassembly::~Reassembly()
+		{
 		}
 
 		void FragmentManager::setOffset(const dtn::data::EID &peer, const dtn::data::BundleID &id, const dtn::data::Length &abs_offset, const dtn::data::Length &frag_offset) throw ()
@@ -253,6 +304,19 @@ namespace dtn
 			} catch (const dtn::storage::NoBundleFoundException&) { };
 		}
 
+		void FragmentManager::setOffset(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta, const dtn::data::Length &offset) throw ()
+		{
+			Transmission t;
+			t.id = meta;
+			t.peer = peer;
+			t.offset = offset;
+			t.expires = meta.expiretime;
+
+			ibrcommon::MutexLock l(_offsets_mutex);
+			_offsets.erase(t);
+			if (offset > 0) _offsets.insert(t);
+		}
+
 		dtn::data::Length FragmentManager::getOffset(const dtn::data::EID &peer, const dtn::data::BundleID &id) throw ()
 		{
 			ibrcommon::MutexLock l(_offsets_mutex);
@@ -335,11 +399,9 @@ namespace dtn
 				if (payloadLength <= maxPayloadLength)
 					throw FragmentationNotNecessaryException("Fragmentation not necessary. The payload block is smaller than the max. payload length.");
 
-				// copy the origin bundle as template for the new fragment
-				Bundle fragment = bundle;
-
-				// clear all the blocks
-				fragment.clear();
+				// copy the primary block of the origin bundle as template for the new fragment
+				Bundle fragment;
+				static_cast<dtn::data::PrimaryBlock&>(fragment) = bundle;
 
 				// set bundle is fragment flag
 				fragment.set(dtn::data::PrimaryBlock::FRAGMENT, true);
@@ -347,53 +409,33 @@ namespace dtn
 				// set application data length
 				fragment.appdatalength = payloadLength;
 
+				// the payload of each fragment refers to a range of the origin payload
 				ibrcommon::BLOB::Reference ref = payloadBlock.getBLOB();
-				ibrcommon::BLOB::iostream stream = ref.iostream();
 
-				bool isFirstFragment = true;
-				dtn::data::Length offset = 0;
-
-				while (!(*stream).eof() && (payloadLength > offset))
+				for (dtn::data::Length offset = 0; offset < payloadLength;)
 				{
+					const dtn::data::Length length = std::min(maxPayloadLength, payloadLength - offset);
+					const bool isFirstFragment = (offset == 0);
+
 					// clear all the blocks
 					fragment.clear();
 
 					// set fragment offset
 					fragment.fragmentoffset = offset;
 
-					// copy partial payload to the payload of the fragment
-					try {
-						// create new blob for fragment payload
-						ibrcommon::BLOB::Reference fragment_ref = ibrcommon::BLOB::create();
-
-						// get the iostream object
-						ibrcommon::BLOB::iostream fragment_stream = fragment_ref.iostream();
-
-						if ((offset + maxPayloadLength) > payloadLength) {
-							// copy payload to the fragment
-							ibrcommon::BLOB::copy(*fragment_stream, *stream, payloadLength - offset, 65535);
-						} else {
-							// copy payload to the fragment
-							ibrcommon::BLOB::copy(*fragment_stream, *stream, maxPayloadLength, 65535);
-						}
+					// create fragment payload block without copying the payload
+					ibrcommon::BLOB::Reference fragment_ref = ibrcommon::BLOB::view(ref, offset, length);
+					dtn::data::PayloadBlock &fragment_payloadBlock = fragment.push_back(fragment_ref);
 
-						// set new offset position
-						offset += fragment_stream.size();
+					// set new offset position
+					offset += length;
 
-						// create fragment payload block
-						dtn::data::PayloadBlock &fragment_payloadBlock = fragment.push_back(fragment_ref);
-
-						// add all necessary blocks from the bundle to the fragment
-						addBlocksFromBundleToFragment(bundle, fragment, fragment_payloadBlock, isFirstFragment, payloadLength == offset);
-					} catch (const ibrcommon::IOException &ex) {
-						IBRCOMMON_LOGGER_TAG(FragmentManager::TAG, error) << "error while splitting bundle into fragments: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					}
+					// add all necessary blocks from the bundle to the fragment
+					addBlocksFromBundleToFragment(bundle, fragment, fragment_payloadBlock, isFirstFragment, payloadLength == offset);
 
 					// add current fragment to fragments list
 					fragments.push_back(fragment);
 
-					if (isFirstFragment) isFirstFragment = false;
-
 					IBRCOMMON_LOGGER_DEBUG_TAG(FragmentManager::TAG, 5) << "Fragment created: " << fragment.toString() << IBRCOMMON_LOGGER_ENDL;
 				}
 			} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) {
@@ -24,12 +24,14 @@
 
 #include "Component.h"
 #include "core/EventReceiver.h"
-#include "storage/BundleResult.h"
+#include "storage/BundleStorage.h"
 #include "routing/QueueBundleEvent.h"
 #include <ibrdtn/data/MetaBundle.h>
+#include <ibrdtn/data/BundleMerger.h>
 #include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/Mutex.h>
 #include <list>
+#include <map>
 #include <set>
 
 namespace dtn
@@ -86,6 +88,15 @@ namespace dtn
 			 */
 			static void setOffset(const dtn::data::EID &peer, const dtn::data::BundleID &id, const dtn::data::Length &abs_offset, const dtn::data::Length &frag_offset) throw ();
 
+			/**
+			 * Updates the payload offset of a transmission sent in segments,
+			 * an offset of zero removes the transmission
+			 * @param peer
+			 * @param meta
+			 * @param offset
+			 */
+			static void setOffset(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta, const dtn::data::Length &offset) throw ();
+
 			/**
 			 * Get the offset of a transmission
 			 * @param peer
@@ -131,12 +142,54 @@ namespace dtn
 			 */
 			static void addBlocksFromBundleToFragment(const dtn::data::Bundle &bundle, dtn::data::Bundle &fragment, dtn::data::PayloadBlock &fragment_payloadBlock, bool isFirstFragment, bool isLastFragment);
 
-			// search for similar bundles in the storage
-			void search(const dtn::data::MetaBundle &meta, dtn::storage::BundleResult &list);
+			/**
+			 * State of a bundle to reassemble. The payload of each fragment
+			 * is written to its final position once the fragment arrives.
+			 */
+			class Reassembly
+			{
+			public:
+				Reassembly();
+				virtual ~Reassembly();
+
+				dtn::data::BundleMerger::Container container;
+
+				// fragments merged into the container
+				std::set<dtn::data::BundleID> fragments;
+
+				// the reassembly is dropped if all fragments are expired
+				dtn::data::Timestamp expires;
+			};
+
+			typedef std::map<dtn::data::BundleID, Reassembly> reassembly_map;
+
+			/**
+			 * Returns true if the fragment should be reassembled locally
+			 */
+			static bool isCandidate(const dtn::data::MetaBundle &meta) throw ();
+
+			/**
+			 * Queue all fragments in the storage to restore the reassembly
+			 * state after a restart
+			 */
+			void scan(dtn::storage::BundleStorage &storage) throw ();
+
+			/**
+			 * Add a fragment to the reassembly of its origin bundle
+			 */
+			void merge(dtn::storage::BundleStorage &storage, const dtn::data::MetaBundle &meta) throw ();
+
+			/**
+			 * Drop all reassemblies with expired fragments only
+			 */
+			void expire(const dtn::data::Timestamp &timestamp) throw ();
 
 			ibrcommon::Queue<dtn::data::MetaBundle> _incoming;
 			bool _running;
 
+			// reassemblies in progress, indexed by the id of the origin bundle
+			reassembly_map _reassemblies;
+
 			static ibrcommon::Mutex _offsets_mutex;
 			static std::set<Transmission> _offsets;
 		};
@@ -22,6 +22,7 @@
 #include "net/BundleReceivedEvent.h"
 #include "core/BundleCore.h"
 #include "core/EventDispatcher.h"
+#include "core/BundleTracer.h"
 #include <ibrcommon/Logger.h>
 
 namespace dtn
@@ -46,6 +47,8 @@ namespace dtn
 
 		void BundleReceivedEvent::raise(const dtn::data::EID &peer, const dtn::data::Bundle &bundle, const bool local)
 		{
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_RECEIVED, bundle, peer);
+
 			// raise the new event
 			dtn::core::EventDispatcher<BundleReceivedEvent>::queue( new BundleReceivedEvent(peer, bundle, local) );
 		}
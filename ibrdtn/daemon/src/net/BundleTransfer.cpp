@@ -23,7 +23,9 @@
 #include "routing/RequeueBundleEvent.h"
 #include "core/BundleEvent.h"
 #include "net/TransferCompletedEvent.h"
+#include "net/StripeScheduler.h"
 #include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Metrics.h>
 
 namespace dtn
 {
@@ -34,17 +36,56 @@ namespace dtn
 		{
 		}
 
+		BundleTransfer::BundleTransfer(const BundleTransfer &parent, const dtn::data::Length &offset, const dtn::data::Length &length, const refcnt_ptr<StripePath> &path)
+		 : _slot(new Slot(new Stripe(parent, offset, length, path)))
+		{
+			_slot->stripe->parent._slot->addStripe();
+		}
+
 		BundleTransfer::~BundleTransfer()
 		{
 		}
 
+		BundleTransfer::Stripe::Stripe(const BundleTransfer &p, const dtn::data::Length &o, const dtn::data::Length &l, const refcnt_ptr<StripePath> &sp)
+		 : parent(p), offset(o), length(l), path(sp), created(ibrcommon::Histogram::now())
+		{
+		}
+
+		BundleTransfer::Stripe::~Stripe()
+		{
+		}
+
 		BundleTransfer::Slot::Slot(const dtn::data::EID &n, const dtn::data::MetaBundle &b)
-		 : neighbor(n), bundle(b), _completed(false), _aborted(false), _abort_reason(TransferAbortedEvent::REASON_UNDEFINED)
+		 : neighbor(n), bundle(b), stripe(NULL), _completed(false), _aborted(false), _abort_reason(TransferAbortedEvent::REASON_UNDEFINED),
+		   _stripes(0), _stripes_completed(0)
+		{
+		}
+
+		BundleTransfer::Slot::Slot(Stripe *s)
+		 : neighbor(s->parent.getNeighbor()), bundle(s->parent.getBundle()), stripe(s), _completed(false), _aborted(false), _abort_reason(TransferAbortedEvent::REASON_UNDEFINED),
+		   _stripes(0), _stripes_completed(0)
 		{
 		}
 
 		BundleTransfer::Slot::~Slot()
 		{
+			// a stripe reports to its parent instead of raising events
+			if (stripe != NULL) {
+				if (_aborted) {
+					stripe->parent._slot->abort(_abort_reason);
+				} else if (_completed) {
+					stripe->parent._slot->completeStripe();
+				}
+
+				delete stripe;
+				return;
+			}
+
+			// the transfer is complete if all of its stripes are complete
+			if (_stripes > 0) {
+				_completed = (_stripes_completed == _stripes);
+			}
+
 			if (_aborted) {
 				// fire TransferAbortedEvent
 				dtn::net::TransferAbortedEvent::raise(neighbor, bundle, _abort_reason);
@@ -66,15 +107,56 @@ namespace dtn
 			return _slot->bundle;
 		}
 
+		bool BundleTransfer::isStripe() const
+		{
+			return (_slot->stripe != NULL);
+		}
+
+		dtn::data::Length BundleTransfer::getOffset() const
+		{
+			return (_slot->stripe == NULL) ? 0 : _slot->stripe->offset;
+		}
+
+		dtn::data::Length BundleTransfer::getLength() const
+		{
+			return (_slot->stripe == NULL) ? 0 : _slot->stripe->length;
+		}
+
 		void BundleTransfer::Slot::abort(const TransferAbortedEvent::AbortReason reason)
 		{
+			ibrcommon::MutexLock l(_lock);
 			_abort_reason = reason;
 			_aborted = true;
 		}
 
+		bool BundleTransfer::Slot::isAborted() const
+		{
+			ibrcommon::MutexLock l(const_cast<ibrcommon::Mutex&>(_lock));
+			return _aborted;
+		}
+
 		void BundleTransfer::Slot::complete()
 		{
+			ibrcommon::MutexLock l(_lock);
+			if (_completed) return;
 			_completed = true;
+
+			// feed the throughput of the path with the duration of the stripe
+			if (stripe != NULL) {
+				stripe->path->record(stripe->length, ibrcommon::Histogram::now() - stripe->created);
+			}
+		}
+
+		void BundleTransfer::Slot::addStripe()
+		{
+			ibrcommon::MutexLock l(_lock);
+			_stripes++;
+		}
+
+		void BundleTransfer::Slot::completeStripe()
+		{
+			ibrcommon::MutexLock l(_lock);
+			_stripes_completed++;
 		}
 
 		void BundleTransfer::abort(const TransferAbortedEvent::AbortReason reason)
@@ -82,6 +164,11 @@ namespace dtn
 			_slot->abort(reason);
 		}
 
+		bool BundleTransfer::isAborted() const
+		{
+			return _slot->isAborted();
+		}
+
 		void BundleTransfer::complete()
 		{
 			_slot->complete();
@@ -25,6 +25,8 @@
 #include <ibrdtn/data/MetaBundle.h>
 
 #include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/refcnt_ptr.h>
+#include <stdint.h>
 #include <map>
 
 #ifndef BUNDLETRANSFER_H_
@@ -34,28 +36,64 @@ namespace dtn
 {
 	namespace net
 	{
+		class StripePath;
+
 		class BundleTransfer {
 		public:
 			BundleTransfer(const dtn::data::EID &neighbor, const dtn::data::MetaBundle &bundle);
+
+			/**
+			 * Create a transfer of a part of the payload, a stripe of the parent
+			 * transfer. The parent is complete once all of its stripes are complete.
+			 * @param parent The transfer of the whole bundle
+			 * @param offset Offset of the stripe in the payload
+			 * @param length Number of payload bytes of the stripe
+			 * @param path The path measuring the throughput of the stripe
+			 */
+			BundleTransfer(const BundleTransfer &parent, const dtn::data::Length &offset, const dtn::data::Length &length, const refcnt_ptr<StripePath> &path);
+
 			virtual ~BundleTransfer();
 
 			const dtn::data::EID& getNeighbor() const;
 			const dtn::data::MetaBundle& getBundle() const;
 
+			/**
+			 * Returns true, if this transfer covers only a part of the payload
+			 */
+			bool isStripe() const;
+
+			/**
+			 * Returns the payload offset of a stripe
+			 */
+			dtn::data::Length getOffset() const;
+
+			/**
+			 * Returns the payload length of a stripe
+			 */
+			dtn::data::Length getLength() const;
+
 			/**
 			 * Mark this transmission as aborted
 			 */
 			void abort(const TransferAbortedEvent::AbortReason reason);
 
+			/**
+			 * Returns true, if this transmission has been aborted
+			 */
+			bool isAborted() const;
+
 			/**
 			 * Mark this transmission as complete
 			 */
 			void complete();
 
 		private:
+			class Stripe;
+
 			class Slot {
 			public:
 				Slot(const dtn::data::EID &neighbor, const dtn::data::MetaBundle &bundle);
+				Slot(Stripe *stripe);
 				virtual ~Slot();
 
 				const dtn::data::EID neighbor;
@@ -66,19 +104,55 @@ namespace dtn
 				 */
 				void abort(const TransferAbortedEvent::AbortReason reason);
 
+				/**
+				 * Returns true, if this transmission has been aborted
+				 */
+				bool isAborted() const;
+
 				/**
 				 * Mark this transmission as complete
 				 */
 				void complete();
 
+				/**
+				 * Account a new stripe of this transfer
+				 */
+				void addStripe();
+
+				/**
+				 * Mark one stripe of this transfer as complete
+				 */
+				void completeStripe();
+
+				// the stripe information, NULL for transfers of the whole bundle
+				Stripe * const stripe;
+
 			private:
+				ibrcommon::Mutex _lock;
 				bool _completed;
 				bool _aborted;
 				TransferAbortedEvent::AbortReason _abort_reason;
+				size_t _stripes;
+				size_t _stripes_completed;
 			};
 
 			refcnt_ptr<Slot> _slot;
 		};
+
+		/**
+		 * The part of the payload covered by a stripe
+		 */
+		class BundleTransfer::Stripe {
+		public:
+			Stripe(const BundleTransfer &parent, const dtn::data::Length &offset, const dtn::data::Length &length, const refcnt_ptr<StripePath> &path);
+			virtual ~Stripe();
+
+			BundleTransfer parent;
+			const dtn::data::Length offset;
+			const dtn::data::Length length;
+			refcnt_ptr<StripePath> path;
+			const uint64_t created;
+		};
 	} /* namespace net */
 } /* namespace dtn */
 #endif /* BUNDLETRANSFER_H_ */
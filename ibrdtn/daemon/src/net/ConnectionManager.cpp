@@ -24,6 +24,7 @@
 #include "core/EventDispatcher.h"
 #include "core/BundleEvent.h"
 #include "core/BundleCore.h"
+#include "core/BundleTracer.h"
 
 #include <ibrdtn/utils/Clock.h>
 #include <ibrcommon/Logger.h>
@@ -46,7 +47,7 @@ namespace dtn
 		};
 
 		ConnectionManager::ConnectionManager()
-		 : _next_autoconnect(0)
+		 : _snapshot(new NeighborSnapshot()), _snapshot_version(0), _next_autoconnect(0)
 		{
 		}
 
@@ -82,6 +83,9 @@ namespace dtn
 				ibrcommon::MutexLock l(_node_lock);
 				// clear the node list
 				_nodes.clear();
+
+				// publish an empty list of neighbors
+				__publish();
 			}
 
 			_next_autoconnect = 0;
@@ -111,6 +115,11 @@ namespace dtn
 					}
 					break;
 
+				case NODE_UNAVAILABLE:
+					// forget the throughput of all paths to this node
+					_stripes.remove(n.getEID());
+					break;
+
 				default:
 					break;
 			}
@@ -202,6 +211,9 @@ namespace dtn
 
 			dtn::core::Node &db = (*(ret.first)).second;
 
+			// true, if the neighbor snapshot is outdated
+			bool changed = ret.second;
+
 			if (!ret.second) {
 				dtn::data::Size old = db.size();
 
@@ -209,6 +221,8 @@ namespace dtn
 				db += n;
 
 				if (old != db.size()) {
+					changed = true;
+
 					// announce the new node
 					dtn::core::NodeEvent::raise(db, dtn::core::NODE_DATA_ADDED);
 				}
@@ -218,10 +232,13 @@ namespace dtn
 
 			if (db.isAvailable() && !db.isAnnounced() && isReachable(db)) {
 				db.setAnnounced(true);
+				changed = true;
 
 				// announce the new node
 				dtn::core::NodeEvent::raise(db, dtn::core::NODE_AVAILABLE);
 			}
+
+			if (changed) __publish();
 		}
 
 		void ConnectionManager::remove(const dtn::core::Node &n)
@@ -236,6 +253,9 @@ namespace dtn
 				db -= n;
 
 				if (old != db.size()) {
+					// update the neighbor snapshot
+					__publish();
+
 					// announce the new node
 					dtn::core::NodeEvent::raise(db, dtn::core::NODE_DATA_REMOVED);
 				}
@@ -246,14 +266,26 @@ namespace dtn
 
 		void ConnectionManager::add(ConvergenceLayer *cl)
 		{
-			ibrcommon::MutexLock l(_cl_lock);
-			_cl.insert( cl );
+			{
+				ibrcommon::MutexLock l(_cl_lock);
+				_cl.insert( cl );
+			}
+
+			// the reachability of neighbors may have changed
+			ibrcommon::MutexLock l(_node_lock);
+			__publish();
 		}
 
 		void ConnectionManager::remove(ConvergenceLayer *cl)
 		{
-			ibrcommon::MutexLock l(_cl_lock);
-			_cl.erase( cl );
+			{
+				ibrcommon::MutexLock l(_cl_lock);
+				_cl.erase( cl );
+			}
+
+			// the reachability of neighbors may have changed
+			ibrcommon::MutexLock l(_node_lock);
+			__publish();
 		}
 
 		void ConnectionManager::getStats(dtn::net::ConvergenceLayer::stats_data &data)
@@ -312,6 +344,7 @@ namespace dtn
 		void ConnectionManager::check_available()
 		{
 			ibrcommon::MutexLock l(_node_lock);
+			bool changed = false;
 
 			// search for outdated nodes
 			for (nodemap::iterator iter = _nodes.begin(); iter != _nodes.end(); ++iter)
@@ -321,16 +354,20 @@ namespace dtn
 
 				if (n.isAvailable() && isReachable(n)) {
 					n.setAnnounced(true);
+					changed = true;
 
 					// announce the unavailable event
 					dtn::core::NodeEvent::raise(n, dtn::core::NODE_AVAILABLE);
 				}
 			}
+
+			if (changed) __publish();
 		}
 
 		void ConnectionManager::check_unavailable()
 		{
 			ibrcommon::MutexLock l(_node_lock);
+			bool changed = false;
 
 			// search for outdated nodes
 			nodemap::iterator iter = _nodes.begin();
@@ -344,12 +381,17 @@ namespace dtn
 
 				if ( !n.isAvailable() ||  !isReachable(n) ) {
 					n.setAnnounced(false);
+					changed = true;
 
 					// announce the unavailable event
 					dtn::core::NodeEvent::raise(n, dtn::core::NODE_UNAVAILABLE);
 				}
 
-				if ( n.expire() )
+				const dtn::data::Size old = n.size();
+				const bool expired = n.expire();
+				if (old != n.size()) changed = true;
+
+				if ( expired )
 				{
 					if (n.isAnnounced()) {
 						// announce the unavailable event
@@ -364,6 +406,8 @@ namespace dtn
 					++iter;
 				}
 			}
+
+			if (changed) __publish();
 		}
 
 		void ConnectionManager::check_autoconnect()
@@ -459,8 +503,72 @@ namespace dtn
 			}
 		}
 
+		bool ConnectionManager::stripe(const dtn::core::Node &node, const dtn::net::BundleTransfer &job)
+		{
+			const dtn::daemon::Configuration::Network &config = dtn::daemon::Configuration::getInstance().getNetwork();
+			const dtn::data::Length stripe_size = config.getMultipathStripeSize();
+			const dtn::data::MetaBundle &meta = job.getBundle();
+
+			// striping is disabled or the bundle may not be fragmented
+			if ((stripe_size == 0) || job.isStripe()) return false;
+			if (!config.doFragmentation() || meta.get(dtn::data::PrimaryBlock::DONT_FRAGMENT)) return false;
+			if (meta.getPayloadLength() < (2 * stripe_size)) return false;
+
+			// lock convergence layers while iterating over them
+			ibrcommon::MutexLock l(_cl_lock);
+
+			// collect all convergence layers leading to this node
+			std::vector<ConvergenceLayer*> layers;
+			std::vector<refcnt_ptr<StripePath> > paths;
+			std::vector<double> throughputs;
+
+			const std::list<Node::URI> uri_list = node.getAll();
+			for (std::list<Node::URI>::const_iterator it = uri_list.begin(); it != uri_list.end(); ++it)
+			{
+				const Node::URI &uri = (*it);
+
+				for (std::set<ConvergenceLayer*>::iterator iter = _cl.begin(); iter != _cl.end(); ++iter)
+				{
+					ConvergenceLayer *cl = (*iter);
+					if (cl->getDiscoveryProtocol() != uri.protocol) continue;
+					if (!cl->isStripeCapable()) continue;
+					if (std::find(layers.begin(), layers.end(), cl) != layers.end()) continue;
+
+					layers.push_back(cl);
+					paths.push_back(_stripes.getPath(node.getEID(), uri.protocol));
+					throughputs.push_back(paths.back()->getThroughput());
+				}
+			}
+
+			if (layers.size() < 2) return false;
+
+			// the payload is large enough for at least two stripes
+			std::vector<dtn::data::Length> shares;
+			StripeScheduler::distribute(meta.getPayloadLength(), throughputs, stripe_size, shares);
+
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_HANDED, meta, node.getEID());
+
+			// queue one stripe per convergence layer, the original transfer
+			// completes once all stripes are complete
+			dtn::data::Length offset = 0;
+			for (size_t i = 0; i < layers.size(); ++i)
+			{
+				if (shares[i] == 0) continue;
+
+				IBRCOMMON_LOGGER_DEBUG_TAG("ConnectionManager", 20) << "stripe " << offset << "+" << shares[i] << " of " << meta.toString() << " via " << Node::toString(paths[i]->protocol) << IBRCOMMON_LOGGER_ENDL;
+
+				layers[i]->queue(node, dtn::net::BundleTransfer(job, offset, shares[i], paths[i]));
+				offset += shares[i];
+			}
+
+			return true;
+		}
+
 		void ConnectionManager::queue(const dtn::core::Node &node, const dtn::net::BundleTransfer &job)
 		{
+			// stripe large bundles across all convergence layers to the node
+			if (stripe(node, job)) return;
+
 			// get the list of all available URIs
 			std::list<Node::URI> uri_list = node.getAll();
 
@@ -478,6 +586,7 @@ namespace dtn
 					ConvergenceLayer *cl = (*iter);
 					if (cl->getDiscoveryProtocol() == uri.protocol)
 					{
+						dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_HANDED, job.getBundle(), node.getEID());
 						cl->queue(node, job);
 
 						// stop here, we queued the bundle already
@@ -530,17 +639,32 @@ namespace dtn
 
 		const std::set<dtn::core::Node> ConnectionManager::getNeighbors()
 		{
-			ibrcommon::MutexLock l(_node_lock);
+			return getNeighborSnapshot()->getNodes();
+		}
 
-			std::set<dtn::core::Node> ret;
+		const NeighborSnapshot::Reference ConnectionManager::getNeighborSnapshot() const
+		{
+			ibrcommon::MutexLock l(_snapshot_lock);
+			return _snapshot;
+		}
+
+		void ConnectionManager::__publish() throw ()
+		{
+			std::set<dtn::core::Node> nodes;
 
 			for (nodemap::const_iterator iter = _nodes.begin(); iter != _nodes.end(); ++iter)
 			{
 				const Node &n = (*iter).second;
-				if (n.isAvailable() && isReachable(n)) ret.insert( n );
+				if (n.isAvailable() && isReachable(n)) nodes.insert( n );
 			}
 
-			return ret;
+			// create the new snapshot outside of the snapshot lock
+			NeighborSnapshot::Reference snapshot(new NeighborSnapshot(nodes, ++_snapshot_version));
+
+			// swap the references, the previous snapshot is released
+			// without holding the lock if there are no other readers
+			ibrcommon::MutexLock l(_snapshot_lock);
+			std::swap(_snapshot, snapshot);
 		}
 
 		const dtn::core::Node ConnectionManager::getNeighbor(const dtn::data::EID &eid) throw (NeighborNotAvailableException)
@@ -552,15 +676,14 @@ namespace dtn
 			throw dtn::net::NeighborNotAvailableException();
 		}
 
-		bool ConnectionManager::isNeighbor(const dtn::core::Node &node)
+		bool ConnectionManager::isNeighbor(const dtn::core::Node &node) const
 		{
-			try {
-				ibrcommon::MutexLock l(_node_lock);
-				const Node &n = getNode(node.getEID());
-				if (n.isAvailable() && isReachable(n)) return true;
-			} catch (const NeighborNotAvailableException&) { }
+			return isNeighbor(node.getEID());
+		}
 
-			return false;
+		bool ConnectionManager::isNeighbor(const dtn::data::EID &eid) const
+		{
+			return getNeighborSnapshot()->contains(eid);
 		}
 
 		void ConnectionManager::updateNeighbor(const Node &n)
@@ -26,6 +26,8 @@
 #include "net/ConvergenceLayer.h"
 #include "net/P2PDialupExtension.h"
 #include "net/BundleReceiver.h"
+#include "net/NeighborSnapshot.h"
+#include "net/StripeScheduler.h"
 #include "core/EventReceiver.h"
 #include <ibrdtn/data/EID.h>
 #include "core/Node.h"
@@ -118,12 +120,25 @@ namespace dtn
 			 */
 			const std::set<dtn::core::Node> getNeighbors();
 
+			/**
+			 * Get the current snapshot of all neighbors. The snapshot is
+			 * immutable and does not copy any node data.
+			 * @return A reference to the latest published snapshot
+			 */
+			const NeighborSnapshot::Reference getNeighborSnapshot() const;
+
 			/**
 			 * Checks if a node is already known as neighbor.
 			 * @param
 			 * @return
 			 */
-			bool isNeighbor(const dtn::core::Node&);
+			bool isNeighbor(const dtn::core::Node&) const;
+
+			/**
+			 * Checks if a node with the given EID is a neighbor.
+			 * This uses the latest snapshot and does not lock the node database.
+			 */
+			bool isNeighbor(const dtn::data::EID &eid) const;
 
 			/**
 			 * Get the neighbor with the given EID.
@@ -171,6 +186,13 @@ namespace dtn
 			 */
 			void queue(const dtn::core::Node &node, const dtn::net::BundleTransfer &job);
 
+			/**
+			 * split a large bundle into stripes and queue them to all convergence
+			 * layers able to reach the node
+			 * @return False, if the bundle has not been split
+			 */
+			bool stripe(const dtn::core::Node &node, const dtn::net::BundleTransfer &job);
+
 			/**
 			 * checks for timed out nodes
 			 */
@@ -196,6 +218,12 @@ namespace dtn
 			 */
 			dtn::core::Node& getNode(const dtn::data::EID &eid) throw (NeighborNotAvailableException);
 
+			/**
+			 * publish a new snapshot of all available neighbors
+			 * the node lock has to be held by the caller
+			 */
+			void __publish() throw ();
+
 			// mutex for the list of convergence layers
 			ibrcommon::Mutex _cl_lock;
 
@@ -213,8 +241,16 @@ namespace dtn
 			typedef std::map<dtn::data::EID, dtn::core::Node> nodemap;
 			nodemap _nodes;
 
+			// latest snapshot of all available neighbors
+			mutable ibrcommon::Mutex _snapshot_lock;
+			NeighborSnapshot::Reference _snapshot;
+			dtn::data::Size _snapshot_version;
+
 			// next timestamp for autoconnect check
 			dtn::data::Timestamp _next_autoconnect;
+
+			// throughput of the paths used for multipath striping
+			StripeScheduler _stripes;
 		};
 	}
 }
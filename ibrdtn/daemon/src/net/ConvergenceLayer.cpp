@@ -30,6 +30,11 @@ namespace dtn
 		{
 		}
 
+		bool ConvergenceLayer::isStripeCapable() const
+		{
+			return false;
+		}
+
 		void ConvergenceLayer::resetStats()
 		{
 		}
@@ -59,6 +59,12 @@ namespace dtn
 
 			virtual void queue(const dtn::core::Node &n, const dtn::net::BundleTransfer &job) = 0;
 
+			/**
+			 * Returns true, if this convergence layer transmits stripes of a
+			 * transfer as fragments of the corresponding part of the payload.
+			 */
+			virtual bool isStripeCapable() const;
+
 			/**
 			 * This method opens a connection proactive.
 			 * @param n
@@ -784,8 +784,12 @@ namespace dtn
 						// reset skip flag
 						_skip = false;
 
-						// write the bundle into the stream
-						serializer << bundle; _stream.flush();
+						// write the bundle into the stream, a stripe as fragment
+						if (job.isStripe()) {
+							serializer << dtn::data::BundleFragment(bundle, job.getOffset(), job.getLength()); _stream.flush();
+						} else {
+							serializer << bundle; _stream.flush();
+						}
 
 						// check if the stream is still marked as good
 						if (_stream.good())
@@ -115,6 +115,12 @@ namespace dtn
 			return _service->getProtocol();
 		}
 
+		bool DatagramConvergenceLayer::isStripeCapable() const
+		{
+			// striping needs a reliable link to detect the completion of a stripe
+			return (_service->getParameter().flowcontrol != DatagramService::FLOW_NONE);
+		}
+
 		void DatagramConvergenceLayer::callback_send(DatagramConnection&, const char &flags, const unsigned int &seqno, const std::string &destination, const char *buf, const dtn::data::Length &len) throw (DatagramException)
 		{
 			// only on sender at once
@@ -65,6 +65,11 @@ namespace dtn
 			 */
 			dtn::core::Node::Protocol getDiscoveryProtocol() const;
 
+			/**
+			 * @see ConvergenceLayer::isStripeCapable()
+			 */
+			bool isStripeCapable() const;
+
 			/**
 			 * Queueing a job for a specific node. Starting point for the DTN core to submit
 			 * bundles to nodes behind the convergence layer
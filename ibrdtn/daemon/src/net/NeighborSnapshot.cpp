@@ -0,0 +1,71 @@
+/*
+ * NeighborSnapshot.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "net/NeighborSnapshot.h"
+
+namespace dtn
+{
+	namespace net
+	{
+		NeighborSnapshot::NeighborSnapshot()
+		 : _version(0)
+		{
+		}
+
+		NeighborSnapshot::NeighborSnapshot(const node_set &nodes, dtn::data::Size version)
+		 : _nodes(nodes), _version(version)
+		{
+			for (node_set::const_iterator iter = _nodes.begin(); iter != _nodes.end(); ++iter)
+			{
+				_eids.insert((*iter).getEID());
+			}
+		}
+
+		NeighborSnapshot::~NeighborSnapshot()
+		{
+		}
+
+		dtn::data::Size NeighborSnapshot::getVersion() const
+		{
+			return _version;
+		}
+
+		const NeighborSnapshot::node_set& NeighborSnapshot::getNodes() const
+		{
+			return _nodes;
+		}
+
+		bool NeighborSnapshot::contains(const dtn::data::EID &eid) const
+		{
+			return (_eids.find(eid) != _eids.end());
+		}
+
+		dtn::data::Size NeighborSnapshot::size() const
+		{
+			return _nodes.size();
+		}
+
+		bool NeighborSnapshot::empty() const
+		{
+			return _nodes.empty();
+		}
+	}
+}
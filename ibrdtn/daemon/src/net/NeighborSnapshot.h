@@ -0,0 +1,88 @@
+/*
+ * NeighborSnapshot.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NEIGHBORSNAPSHOT_H_
+#define NEIGHBORSNAPSHOT_H_
+
+#include "core/Node.h"
+#include <ibrdtn/data/EID.h>
+#include <ibrdtn/data/Number.h>
+#include <ibrcommon/refcnt_ptr.h>
+#include <set>
+
+namespace dtn
+{
+	namespace net
+	{
+		/**
+		 * An immutable copy of all available neighbors. The ConnectionManager
+		 * publishes a new snapshot each time the set of neighbors or their
+		 * attributes change. Readers hold a reference to the snapshot and do
+		 * not need to lock the node database.
+		 */
+		class NeighborSnapshot
+		{
+		public:
+			typedef std::set<dtn::core::Node> node_set;
+			typedef refcnt_ptr<const NeighborSnapshot> Reference;
+
+			/**
+			 * Create an empty snapshot
+			 */
+			NeighborSnapshot();
+
+			/**
+			 * Create a snapshot of the given nodes
+			 * @param nodes All available neighbors
+			 * @param version Version number of this snapshot
+			 */
+			NeighborSnapshot(const node_set &nodes, dtn::data::Size version);
+
+			virtual ~NeighborSnapshot();
+
+			/**
+			 * Returns the version of this snapshot. The version is incremented
+			 * with each published snapshot.
+			 */
+			dtn::data::Size getVersion() const;
+
+			/**
+			 * Returns all neighbors of this snapshot
+			 */
+			const node_set& getNodes() const;
+
+			/**
+			 * Returns true if the node with the given EID is part of this snapshot
+			 */
+			bool contains(const dtn::data::EID &eid) const;
+
+			dtn::data::Size size() const;
+			bool empty() const;
+
+		private:
+			const node_set _nodes;
+			std::set<dtn::data::EID> _eids;
+			const dtn::data::Size _version;
+		};
+	}
+}
+
+#endif /* NEIGHBORSNAPSHOT_H_ */
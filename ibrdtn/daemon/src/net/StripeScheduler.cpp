@@ -0,0 +1,167 @@
+/*
+ * StripeScheduler.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "net/StripeScheduler.h"
+#include <ibrcommon/thread/MutexLock.h>
+
+namespace dtn
+{
+	namespace net
+	{
+		const double StripePath::ALPHA = 0.3;
+
+		StripePath::StripePath(const dtn::data::EID &p, const dtn::core::Node::Protocol &proto)
+		 : peer(p), protocol(proto), _throughput(0.0),
+		   _label(ibrcommon::MetricsRegistry::label("peer", p.getString()) + "," + ibrcommon::MetricsRegistry::label("protocol", dtn::core::Node::toString(proto))),
+		   _gauge(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_multipath_throughput_bytes", "Estimated throughput of a path to a neighbor in bytes per second", _label)),
+		   _stripes(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_multipath_stripes_total", "Stripes completed over a path to a neighbor", _label))
+		{
+		}
+
+		StripePath::~StripePath()
+		{
+			ibrcommon::MetricsRegistry &metrics = ibrcommon::MetricsRegistry::getInstance();
+			metrics.release("dtnd_multipath_throughput_bytes", _label);
+			metrics.release("dtnd_multipath_stripes_total", _label);
+		}
+
+		void StripePath::record(const dtn::data::Length &length, const uint64_t duration)
+		{
+			const double sample = (double)length * 1000000.0 / (double)((duration > 0) ? duration : 1);
+
+			ibrcommon::MutexLock l(_lock);
+			_throughput = (_throughput > 0.0) ? ((1.0 - ALPHA) * _throughput + ALPHA * sample) : sample;
+
+			_gauge.set(static_cast<int64_t>(_throughput));
+			_stripes.inc();
+		}
+
+		double StripePath::getThroughput() const
+		{
+			ibrcommon::MutexLock l(_lock);
+			return _throughput;
+		}
+
+		StripeScheduler::StripeScheduler()
+		{
+		}
+
+		StripeScheduler::~StripeScheduler()
+		{
+		}
+
+		refcnt_ptr<StripePath> StripeScheduler::getPath(const dtn::data::EID &peer, const dtn::core::Node::Protocol &protocol)
+		{
+			ibrcommon::MutexLock l(_lock);
+
+			const path_key key(peer, protocol);
+			path_map::iterator it = _paths.find(key);
+
+			if (it == _paths.end())
+			{
+				it = _paths.insert(std::make_pair(key, refcnt_ptr<StripePath>(new StripePath(peer, protocol)))).first;
+			}
+
+			return (*it).second;
+		}
+
+		void StripeScheduler::remove(const dtn::data::EID &peer)
+		{
+			ibrcommon::MutexLock l(_lock);
+
+			for (path_map::iterator it = _paths.begin(); it != _paths.end();)
+			{
+				if ((*it).first.first == peer)
+					_paths.erase(it++);
+				else
+					++it;
+			}
+		}
+
+		void StripeScheduler::distribute(const dtn::data::Length &payload, const std::vector<double> &throughputs, const dtn::data::Length &min_size, std::vector<dtn::data::Length> &shares)
+		{
+			const size_t count = throughputs.size();
+			shares.assign(count, 0);
+			if (count == 0) return;
+
+			// paths without a measurement get the average weight
+			double known = 0.0;
+			size_t known_count = 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (throughputs[i] <= 0.0) continue;
+				known += throughputs[i];
+				known_count++;
+			}
+
+			const double average = (known_count > 0) ? (known / (double)known_count) : 1.0;
+
+			std::vector<double> weights(count);
+			std::vector<bool> used(count, true);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				weights[i] = (throughputs[i] > 0.0) ? throughputs[i] : average;
+			}
+
+			// drop the slowest paths until every path gets its minimal share
+			size_t active = count;
+			while ((active > 1) && (payload < active * min_size))
+			{
+				size_t slowest = count;
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (!used[i]) continue;
+					if ((slowest == count) || (weights[i] < weights[slowest])) slowest = i;
+				}
+
+				used[slowest] = false;
+				active--;
+			}
+
+			double total = 0.0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (used[i]) total += weights[i];
+			}
+
+			// distribute the payload above the minimal shares by weight
+			const dtn::data::Length base = (payload > active * min_size) ? min_size : (payload / active);
+			const dtn::data::Length remain = payload - (active * base);
+
+			dtn::data::Length assigned = 0;
+			size_t last = count;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (!used[i]) continue;
+
+				shares[i] = base + static_cast<dtn::data::Length>((double)remain * weights[i] / total);
+				assigned += shares[i];
+				last = i;
+			}
+
+			// the last path takes the rounding error
+			if (last < count) shares[last] = payload - (assigned - shares[last]);
+		}
+	} /* namespace net */
+} /* namespace dtn */
@@ -0,0 +1,124 @@
+/*
+ * StripeScheduler.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef STRIPESCHEDULER_H_
+#define STRIPESCHEDULER_H_
+
+#include "core/Node.h"
+#include "net/BundleTransfer.h"
+#include <ibrdtn/data/EID.h>
+#include <ibrdtn/data/Number.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/refcnt_ptr.h>
+#include <ibrcommon/Metrics.h>
+#include <stdint.h>
+#include <vector>
+#include <map>
+
+namespace dtn
+{
+	namespace net
+	{
+		/**
+		 * One way to a neighbor through a convergence layer. The path
+		 * estimates its throughput from the duration of completed stripes,
+		 * including the time the stripes waited in the convergence layer.
+		 */
+		class StripePath
+		{
+		public:
+			StripePath(const dtn::data::EID &peer, const dtn::core::Node::Protocol &protocol);
+			virtual ~StripePath();
+
+			/**
+			 * Add a measurement of a completed stripe
+			 * @param length Number of payload bytes of the stripe
+			 * @param duration Time from queuing until completion in microseconds
+			 */
+			void record(const dtn::data::Length &length, const uint64_t duration);
+
+			/**
+			 * Returns the estimated throughput in bytes per second,
+			 * zero if there is no measurement yet
+			 */
+			double getThroughput() const;
+
+			const dtn::data::EID peer;
+			const dtn::core::Node::Protocol protocol;
+
+		private:
+			// weight of a new measurement in the moving average
+			static const double ALPHA;
+
+			mutable ibrcommon::Mutex _lock;
+			double _throughput;
+
+			// the metrics of this path are released with the path
+			const std::string _label;
+			ibrcommon::Gauge &_gauge;
+			ibrcommon::Counter &_stripes;
+		};
+
+		/**
+		 * Distributes large bundles over all convergence layers leading to
+		 * the same neighbor. The payload is split into one stripe per path
+		 * and each stripe is sent as fragment, thus the neighbor reassembles
+		 * the bundle like any other proactively fragmented bundle.
+		 */
+		class StripeScheduler
+		{
+		public:
+			StripeScheduler();
+			virtual ~StripeScheduler();
+
+			/**
+			 * Returns the path to a neighbor using the given protocol
+			 */
+			refcnt_ptr<StripePath> getPath(const dtn::data::EID &peer, const dtn::core::Node::Protocol &protocol);
+
+			/**
+			 * Remove all paths to a neighbor
+			 */
+			void remove(const dtn::data::EID &peer);
+
+			/**
+			 * Split the payload into shares weighted by the throughput of each
+			 * path. Every share is at least min_size bytes large, paths with
+			 * the lowest throughput get no share if the payload is too small.
+			 * Paths without a measurement are weighted with the average of the
+			 * others to probe them.
+			 * @param payload Number of payload bytes to distribute
+			 * @param throughputs The estimated throughput of each path
+			 * @param min_size The minimal size of a share
+			 * @param shares The share of each path, zero if the path is not used
+			 */
+			static void distribute(const dtn::data::Length &payload, const std::vector<double> &throughputs, const dtn::data::Length &min_size, std::vector<dtn::data::Length> &shares);
+
+		private:
+			typedef std::pair<dtn::data::EID, dtn::core::Node::Protocol> path_key;
+			typedef std::map<path_key, refcnt_ptr<StripePath> > path_map;
+
+			ibrcommon::Mutex _lock;
+			path_map _paths;
+		};
+	} /* namespace net */
+} /* namespace dtn */
+#endif /* STRIPESCHEDULER_H_ */
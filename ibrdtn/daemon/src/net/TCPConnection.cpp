@@ -23,6 +23,7 @@
 #include "Configuration.h"
 #include "core/BundleCore.h"
 #include "core/BundleEvent.h"
+#include "core/BundleTracer.h"
 #include "storage/BundleStorage.h"
 #include "core/FragmentManager.h"
 
@@ -65,8 +66,8 @@ namespace dtn
 		 */
 		TCPConnection::TCPConnection(TCPConvergenceLayer &tcpsrv, const dtn::core::Node &node, ibrcommon::clientsocket *sock, const size_t timeout)
 		 : _peer(), _node(node), _socket(sock), _socket_stream(NULL), _sec_stream(NULL), _protocol_stream(NULL), _sender(*this),
-		   _keepalive_sender(*this, _keepalive_timeout), _timeout(timeout), _lastack(0), _resume_offset(0), _keepalive_timeout(0),
-		   _callback(tcpsrv), _flags(0), _aborted(false)
+		   _keepalive_sender(*this, _keepalive_timeout), _timeout(timeout), _lastack(0), _keepalive_timeout(0),
+		   _callback(tcpsrv), _flags(0), _aborted(false), _traffic_in(NULL), _traffic_out(NULL), _transfer_latency(NULL)
 		{
 		}
 
@@ -94,6 +95,22 @@ namespace dtn
 			} else if (_socket_stream != NULL) {
 				delete _socket_stream;
 			}
+
+			releaseMetrics();
+		}
+
+		void TCPConnection::releaseMetrics() throw ()
+		{
+			if (_traffic_in == NULL) return;
+
+			ibrcommon::MetricsRegistry &metrics = ibrcommon::MetricsRegistry::getInstance();
+			metrics.release("dtnd_tcpcl_received_bytes_total", _metrics_label);
+			metrics.release("dtnd_tcpcl_sent_bytes_total", _metrics_label);
+			metrics.release("dtnd_tcpcl_transfer_seconds", _metrics_label);
+
+			_traffic_in = NULL;
+			_traffic_out = NULL;
+			_transfer_latency = NULL;
 		}
 
 		void TCPConnection::queue(const dtn::net::BundleTransfer &job)
@@ -146,6 +163,10 @@ namespace dtn
 			{
 				try{
 					ibrcommon::TLSStream &tls = dynamic_cast<ibrcommon::TLSStream&>(*_sec_stream);
+
+					// resume the last session with this peer
+					tls.setPeerId(_peer.getEID().getString());
+
 					X509 *peer_cert = tls.activate();
 
 					// check the full EID first
@@ -214,6 +235,14 @@ namespace dtn
 				return;
 			}
 
+			// get the metrics of this peer
+			releaseMetrics();
+			ibrcommon::MetricsRegistry &metrics = ibrcommon::MetricsRegistry::getInstance();
+			_metrics_label = ibrcommon::MetricsRegistry::label("peer", _node.getEID().getString());
+			_traffic_in = &metrics.counter("dtnd_tcpcl_received_bytes_total", "Bytes received from a peer", _metrics_label);
+			_traffic_out = &metrics.counter("dtnd_tcpcl_sent_bytes_total", "Bytes sent to a peer", _metrics_label);
+			_transfer_latency = &metrics.histogram("dtnd_tcpcl_transfer_seconds", "Time from sending a bundle until the peer acknowledged it completely", _metrics_label, 0.000001);
+
 			_keepalive_timeout = header._keepalive * 1000;
 
 			try {
@@ -292,6 +321,7 @@ namespace dtn
 
 			// release the job
 			l.pop();
+			_sentinfo.pop();
 		}
 
 		void TCPConnection::eventBundleForwarded() throw ()
@@ -306,15 +336,31 @@ namespace dtn
 
 			// get the job on top of the sent queue
 			dtn::net::BundleTransfer &job = l.front();
+			const Transmission &info = _sentinfo.front();
+
+			if (info.last)
+			{
+				// mark job as complete
+				job.complete();
 
-			// mark job as complete
-			job.complete();
+				// forget the progress of a transmission sent in segments
+				if ((info.offset > 0) && !job.isStripe()) dtn::core::FragmentManager::setOffset(_peer.getEID(), job.getBundle(), 0);
+
+				// record the time until the bundle has been acknowledged
+				if (_transfer_latency != NULL) _transfer_latency->record(ibrcommon::Histogram::now() - info.time);
+			}
+			else
+			{
+				// a segment has been acknowledged, resume after it if the connection breaks
+				dtn::core::FragmentManager::setOffset(_peer.getEID(), job.getBundle(), info.next);
+			}
 
 			// set ACK to zero
 			_lastack = 0;
 
 			// release the job
 			l.pop();
+			_sentinfo.pop();
 		}
 
 		void TCPConnection::eventBundleAck(const dtn::data::Length &ack) throw ()
@@ -325,11 +371,13 @@ namespace dtn
 		void TCPConnection::addTrafficIn(size_t amount) throw ()
 		{
 			_callback.addTrafficIn(amount);
+			if (_traffic_in != NULL) _traffic_in->inc(amount);
 		}
 
 		void TCPConnection::addTrafficOut(size_t amount) throw ()
 		{
 			_callback.addTrafficOut(amount);
+			if (_traffic_out != NULL) _traffic_out->inc(amount);
 		}
 
 		void TCPConnection::initialize() throw ()
@@ -414,6 +462,11 @@ namespace dtn
 			_sec_stream = new ibrcommon::TLSStream(_socket_stream);
 			if (server) dynamic_cast<ibrcommon::TLSStream&>(*_sec_stream).setServer(true);
 			else dynamic_cast<ibrcommon::TLSStream&>(*_sec_stream).setServer(false);
+
+			// allow the kernel to process the records on this socket
+			try {
+				dynamic_cast<ibrcommon::TLSStream&>(*_sec_stream).setDescriptor(sock->fd());
+			} catch (const ibrcommon::socket_exception&) { };
 #endif
 
 			// create a new stream connection
@@ -622,8 +675,17 @@ namespace dtn
 			_wait.abort();
 		}
 
+		TCPConnection::Transmission::Transmission(const TransmissionScheduler::Job &job, bool l)
+		 : time(ibrcommon::Histogram::now()), offset(job.offset), next(job.offset + job.length), last(l)
+		{
+		}
+
+		TCPConnection::Transmission::~Transmission()
+		{
+		}
+
 		TCPConnection::Sender::Sender(TCPConnection &connection)
-		 : _connection(connection)
+		 : _connection(connection), _segment_size(dtn::daemon::Configuration::getInstance().getNetwork().getTCPPreemptionSize())
 		{
 		}
 
@@ -631,10 +693,39 @@ namespace dtn
 		{
 		}
 
+		void TCPConnection::Sender::push(const dtn::net::BundleTransfer &transfer)
+		{
+			const dtn::data::MetaBundle &meta = transfer.getBundle();
+
+			dtn::data::Length offset = 0;
+			dtn::data::Length length = 0;
+
+			if (transfer.isStripe())
+			{
+				// a stripe is sent at once as fragment of its part of the payload
+				offset = transfer.getOffset();
+				length = transfer.getLength();
+			}
+			else if (dtn::daemon::Configuration::getInstance().getNetwork().doFragmentation()
+					&& !meta.get(dtn::data::PrimaryBlock::DONT_FRAGMENT))
+			{
+				// get the offset, if this bundle has been reactively fragmented before
+				offset = dtn::core::FragmentManager::getOffset(_connection.getNode().getEID(), meta);
+
+				// send bundles below the expedited class in preemptible segments
+				if (TransmissionScheduler::getClass(meta) < TransmissionScheduler::CLASS_EXPEDITED)
+				{
+					length = _segment_size;
+				}
+			}
+
+			_scheduler.push(TransmissionScheduler::Job(transfer, offset, length));
+		}
+
 		void TCPConnection::Sender::__cancellation() throw ()
 		{
 			// cancel the main thread in here
-			ibrcommon::Queue<dtn::net::BundleTransfer>::abort();
+			_scheduler.abort();
 		}
 
 		void TCPConnection::Sender::run() throw ()
@@ -650,11 +741,15 @@ namespace dtn
 
 				while (stream.good())
 				{
-					dtn::net::BundleTransfer transfer = ibrcommon::Queue<dtn::net::BundleTransfer>::poll();
+					TransmissionScheduler::Job job = _scheduler.pop();
+					dtn::net::BundleTransfer &transfer = job.transfer;
 
 					// check if the transfer is directed to the connected neighbor
 					if (transfer.getNeighbor() != _connection.getNode().getEID()) continue;
 
+					// drop the remaining segments of a refused transfer
+					if (transfer.isAborted()) continue;
+
 					try {
 						// read the bundle out of the storage
 						dtn::data::Bundle bundle = storage.get(transfer.getBundle());
@@ -673,31 +768,43 @@ namespace dtn
 						}
 #endif
 
-						// send bundle
-						// get the offset, if this bundle has been reactively fragmented before
-						if (dtn::daemon::Configuration::getInstance().getNetwork().doFragmentation()
-								&& !bundle.get(dtn::data::PrimaryBlock::DONT_FRAGMENT))
-						{
-							_connection._resume_offset = dtn::core::FragmentManager::getOffset(_connection.getNode().getEID(), bundle);
-						}
-						else
-						{
-							_connection._resume_offset = 0;
-						}
+						// this is the last segment if it includes the end of the payload or the stripe
+						const dtn::data::Length end = transfer.isStripe() ? (transfer.getOffset() + transfer.getLength()) : bundle.getPayloadLength();
+						const bool last = (job.length == 0) || (job.offset + job.length >= end);
+
+						dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_TRANSMITTED, bundle, _connection.getNode().getEID());
 
 						// put the bundle into the sentqueue
-						_connection._sentqueue.push(transfer);
+						{
+							ibrcommon::Queue<dtn::net::BundleTransfer>::Locked l = _connection._sentqueue.exclusive();
+							l.push(transfer);
+							_connection._sentinfo.push(Transmission(job, last));
+						}
 
 						try {
 							// activate exceptions for this method
 							if (!stream.good()) throw ibrcommon::IOException("stream went bad");
 
-							if (_connection._resume_offset > 0)
+							if (!last)
+							{
+								IBRCOMMON_LOGGER_DEBUG_TAG(TCPConnection::TAG, 40) << "Transfer segment of bundle " << bundle.toString() << " to " << _connection.getNode().getEID().getString() << ", offset: " << job.offset << ", length: " << job.length << IBRCOMMON_LOGGER_ENDL;
+
+								// transmit the segment as fragment
+								serializer << dtn::data::BundleFragment(bundle, job.offset, job.length);
+							}
+							else if (transfer.isStripe())
 							{
-								IBRCOMMON_LOGGER_DEBUG_TAG(TCPConnection::TAG, 4) << "Resume transfer of bundle " << bundle.toString() << " to " << _connection.getNode().getEID().getString() << ", offset: " << _connection._resume_offset << IBRCOMMON_LOGGER_ENDL;
+								IBRCOMMON_LOGGER_DEBUG_TAG(TCPConnection::TAG, 40) << "Transfer stripe of bundle " << bundle.toString() << " to " << _connection.getNode().getEID().getString() << ", offset: " << job.offset << ", length: " << job.length << IBRCOMMON_LOGGER_ENDL;
+
+								// transmit the stripe as fragment
+								serializer << dtn::data::BundleFragment(bundle, job.offset, job.length);
+							}
+							else if (job.offset > 0)
+							{
+								IBRCOMMON_LOGGER_DEBUG_TAG(TCPConnection::TAG, 4) << "Resume transfer of bundle " << bundle.toString() << " to " << _connection.getNode().getEID().getString() << ", offset: " << job.offset << IBRCOMMON_LOGGER_ENDL;
 
 								// transmit the fragment
-								serializer << dtn::data::BundleFragment(bundle, _connection._resume_offset, -1);
+								serializer << dtn::data::BundleFragment(bundle, job.offset, -1);
 							}
 							else
 							{
@@ -707,6 +814,13 @@ namespace dtn
 
 							// flush the stream
 							stream << std::flush;
+
+							// schedule the remaining payload, bundles of a higher
+							// priority may be sent first
+							if (!last)
+							{
+								_scheduler.push(TransmissionScheduler::Job(transfer, job.offset + job.length, job.length));
+							}
 						} catch (const ibrcommon::Exception &ex) {
 							// the connection not available
 							IBRCOMMON_LOGGER_DEBUG_TAG(TCPConnection::TAG, 10) << "connection error: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
@@ -742,11 +856,11 @@ namespace dtn
 				// get the job on top of the sent queue
 				const dtn::net::BundleTransfer &job = l.front();
 
-				if ((_lastack > 0) && (_peer._flags.getBit(dtn::streams::StreamContactHeader::REQUEST_FRAGMENTATION)))
+				if ((_lastack > 0) && !job.isStripe() && (_peer._flags.getBit(dtn::streams::StreamContactHeader::REQUEST_FRAGMENTATION)))
 				{
 					// some data are already acknowledged
 					// store this information in the fragment manager
-					dtn::core::FragmentManager::setOffset(_peer.getEID(), job.getBundle(), _lastack, _resume_offset);
+					dtn::core::FragmentManager::setOffset(_peer.getEID(), job.getBundle(), _lastack, _sentinfo.front().offset);
 				}
 
 				// set last ack to zero
@@ -754,6 +868,7 @@ namespace dtn
 
 				// release the job
 				l.pop();
+				_sentinfo.pop();
 			}
 		}
 
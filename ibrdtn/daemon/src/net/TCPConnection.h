@@ -23,6 +23,7 @@
 #define TCPCONNECTION_H_
 
 #include "core/NodeEvent.h"
+#include "net/TransmissionScheduler.h"
 
 #include <ibrdtn/data/Bundle.h>
 #include <ibrdtn/data/EID.h>
@@ -36,8 +37,10 @@
 #include <ibrcommon/net/socketstream.h>
 #include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/SharedReference.h>
+#include <ibrcommon/Metrics.h>
 
 #include <memory>
+#include <queue>
 
 namespace dtn
 {
@@ -161,12 +164,17 @@ namespace dtn
 				size_t &_keepalive_timeout;
 			};
 
-			class Sender : public ibrcommon::JoinableThread, public ibrcommon::Queue<dtn::net::BundleTransfer>
+			class Sender : public ibrcommon::JoinableThread
 			{
 			public:
 				Sender(TCPConnection &connection);
 				virtual ~Sender();
 
+				/**
+				 * Queue a transfer in the transmission scheduler
+				 */
+				void push(const dtn::net::BundleTransfer &transfer);
+
 			protected:
 				void run() throw ();
 				void finally() throw ();
@@ -174,6 +182,32 @@ namespace dtn
 
 			private:
 				TCPConnection &_connection;
+				TransmissionScheduler _scheduler;
+
+				// size of payload segments, zero if bundles are not preemptible
+				const dtn::data::Length _segment_size;
+			};
+
+			/**
+			 * State of a transmission in the sent queue
+			 */
+			class Transmission
+			{
+			public:
+				Transmission(const TransmissionScheduler::Job &job, bool last);
+				virtual ~Transmission();
+
+				// time of the transmission
+				uint64_t time;
+
+				// offset of the transmitted payload
+				dtn::data::Length offset;
+
+				// offset of the next segment, if this is not the last one
+				dtn::data::Length next;
+
+				// true, if this transmission includes the end of the payload
+				bool last;
 			};
 
 			void __setup_socket(ibrcommon::clientsocket *sock, bool server);
@@ -214,8 +248,11 @@ namespace dtn
 			size_t _timeout;
 
 			ibrcommon::Queue<dtn::net::BundleTransfer> _sentqueue;
+
+			// state of each bundle in the sent queue, protected by its lock
+			std::queue<Transmission> _sentinfo;
+
 			dtn::data::Length _lastack;
-			dtn::data::Length _resume_offset;
 			size_t _keepalive_timeout;
 
 			TCPConvergenceLayer &_callback;
@@ -225,6 +262,18 @@ namespace dtn
 
 			/* with this boolean the connection is marked as aborted */
 			bool _aborted;
+
+			/* per-peer metrics, available once the contact header is received */
+			ibrcommon::Counter *_traffic_in;
+			ibrcommon::Counter *_traffic_out;
+			ibrcommon::Histogram *_transfer_latency;
+			std::string _metrics_label;
+
+			/**
+			 * Release the per-peer metrics, they are removed from the
+			 * registry once the last connection to the peer is gone
+			 */
+			void releaseMetrics() throw ();
 		};
 	}
 }
@@ -188,6 +188,11 @@ namespace dtn
 			return dtn::core::Node::CONN_TCPIP;
 		}
 
+		bool TCPConvergenceLayer::isStripeCapable() const
+		{
+			return true;
+		}
+
 		void TCPConvergenceLayer::onUpdateBeacon(const ibrcommon::vinterface &iface, DiscoveryBeacon &beacon) throw (dtn::net::DiscoveryBeaconHandler::NoServiceHereException)
 		{
 			ibrcommon::MutexLock l(_interface_lock);
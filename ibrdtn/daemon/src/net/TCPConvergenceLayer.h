@@ -98,6 +98,11 @@ namespace dtn
 			 */
 			dtn::core::Node::Protocol getDiscoveryProtocol() const;
 
+			/**
+			 * @see ConvergenceLayer::isStripeCapable()
+			 */
+			bool isStripeCapable() const;
+
 			/**
 			 * this method updates the given values
 			 */
@@ -22,6 +22,7 @@
 #include "net/TransferCompletedEvent.h"
 #include "core/BundleCore.h"
 #include "core/EventDispatcher.h"
+#include "core/BundleTracer.h"
 
 namespace dtn
 {
@@ -40,6 +41,8 @@ namespace dtn
 
 		void TransferCompletedEvent::raise(const dtn::data::EID peer, const dtn::data::MetaBundle &bundle)
 		{
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_ACKED, bundle, peer);
+
 			// raise the new event
 			dtn::core::EventDispatcher<TransferCompletedEvent>::queue( new TransferCompletedEvent(peer, bundle) );
 		}
@@ -0,0 +1,220 @@
+/*
+ * TransmissionScheduler.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "net/TransmissionScheduler.h"
+#include <ibrcommon/thread/MutexLock.h>
+
+namespace dtn
+{
+	namespace net
+	{
+		const dtn::data::Length TransmissionScheduler::_weights[TransmissionScheduler::CLASS_MAX] = { 1, 2, 4 };
+
+		TransmissionScheduler::Job::Job(const dtn::net::BundleTransfer &t, const dtn::data::Length &o, const dtn::data::Length &l)
+		 : transfer(t), offset(o), length(l), priority(TransmissionScheduler::getClass(t.getBundle())), _queued(0)
+		{
+		}
+
+		TransmissionScheduler::Job::~Job()
+		{
+		}
+
+		dtn::data::Length TransmissionScheduler::Job::getCost() const
+		{
+			const dtn::data::Length payload = transfer.getBundle().getPayloadLength();
+			const dtn::data::Length remain = (payload > offset) ? (payload - offset) : 0;
+
+			dtn::data::Length ret = ((length > 0) && (length < remain)) ? length : remain;
+
+			// every transmission costs at least one byte
+			return (ret > 0) ? ret : 1;
+		}
+
+		TransmissionScheduler::Statistics::Statistics(const CLASS c)
+		 : wait(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_scheduler_wait_seconds", "Time a transmission waited in the scheduler", ibrcommon::MetricsRegistry::label("class", getName(c)), 0.000001)),
+		   bytes(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_scheduler_bytes_total", "Payload bytes released by the scheduler", ibrcommon::MetricsRegistry::label("class", getName(c)))),
+		   jobs(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_scheduler_transmissions_total", "Transmissions and segments released by the scheduler", ibrcommon::MetricsRegistry::label("class", getName(c)))),
+		   length(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_scheduler_queue_length", "Transmissions waiting in the scheduler", ibrcommon::MetricsRegistry::label("class", getName(c))))
+		{
+		}
+
+		TransmissionScheduler::Statistics::~Statistics()
+		{
+		}
+
+		TransmissionScheduler::Statistics& TransmissionScheduler::getStatistics(const CLASS c)
+		{
+			static Statistics bulk(CLASS_BULK);
+			static Statistics normal(CLASS_NORMAL);
+			static Statistics expedited(CLASS_EXPEDITED);
+
+			switch (c)
+			{
+			case CLASS_EXPEDITED:
+				return expedited;
+
+			case CLASS_NORMAL:
+				return normal;
+
+			default:
+				return bulk;
+			}
+		}
+
+		TransmissionScheduler::TransmissionScheduler(const dtn::data::Length &quantum)
+		 : _quantum((quantum > 0) ? quantum : 1), _current(CLASS_EXPEDITED), _granted(false), _size(0)
+		{
+			for (int c = 0; c < CLASS_MAX; ++c)
+			{
+				_deficits[c] = 0;
+			}
+		}
+
+		TransmissionScheduler::~TransmissionScheduler()
+		{
+			abort();
+
+			// remove the remaining jobs from the statistics
+			ibrcommon::MutexLock l(_cond);
+			for (int c = 0; c < CLASS_MAX; ++c)
+			{
+				getStatistics(CLASS(c)).length.add(-static_cast<int64_t>(_queues[c].size()));
+			}
+		}
+
+		TransmissionScheduler::CLASS TransmissionScheduler::getClass(const dtn::data::MetaBundle &meta)
+		{
+			switch (meta.getPriority())
+			{
+			case 1:
+				return CLASS_EXPEDITED;
+
+			case 0:
+				return CLASS_NORMAL;
+
+			default:
+				return CLASS_BULK;
+			}
+		}
+
+		const std::string& TransmissionScheduler::getName(const CLASS c)
+		{
+			static const std::string names[CLASS_MAX] = { "bulk", "normal", "expedited" };
+			if ((c < 0) || (c >= CLASS_MAX)) return names[CLASS_BULK];
+			return names[c];
+		}
+
+		void TransmissionScheduler::push(const Job &job)
+		{
+			ibrcommon::MutexLock l(_cond);
+
+			_queues[job.priority].push_back(job);
+			_queues[job.priority].back()._queued = ibrcommon::Histogram::now();
+			_size++;
+
+			getStatistics(job.priority).length.add(1);
+
+			_cond.signal(true);
+		}
+
+		TransmissionScheduler::Job TransmissionScheduler::pop() throw (ibrcommon::QueueUnblockedException)
+		{
+			try {
+				ibrcommon::MutexLock l(_cond);
+
+				while (_size == 0)
+				{
+					_cond.wait();
+				}
+
+				Job job = __next();
+
+				Statistics &stats = getStatistics(job.priority);
+				stats.length.add(-1);
+				stats.wait.record(ibrcommon::Histogram::now() - job._queued);
+				stats.bytes.inc(job.getCost());
+				stats.jobs.inc();
+
+				return job;
+			} catch (const ibrcommon::Conditional::ConditionalAbortException &ex) {
+				throw ibrcommon::QueueUnblockedException(ex, "pop()");
+			}
+		}
+
+		TransmissionScheduler::Job TransmissionScheduler::__next()
+		{
+			while (true)
+			{
+				job_queue &q = _queues[_current];
+
+				// an empty class does not collect any deficit
+				if (q.empty())
+				{
+					_deficits[_current] = 0;
+					_granted = false;
+					_current = (_current + CLASS_MAX - 1) % CLASS_MAX;
+					continue;
+				}
+
+				// skip the round robin if there is only one active class
+				const bool alone = (q.size() == _size);
+
+				// grant the quantum once per visit of a class
+				if (!_granted)
+				{
+					_deficits[_current] += _quantum * _weights[_current];
+					_granted = true;
+				}
+
+				const dtn::data::Length cost = q.front().getCost();
+
+				if (alone || (cost <= _deficits[_current]))
+				{
+					_deficits[_current] = (cost < _deficits[_current]) ? (_deficits[_current] - cost) : 0;
+
+					Job job = q.front();
+					q.pop_front();
+					_size--;
+
+					if (q.empty()) _deficits[_current] = 0;
+
+					return job;
+				}
+
+				// move on to the next class, the deficit is kept for the next round
+				_granted = false;
+				_current = (_current + CLASS_MAX - 1) % CLASS_MAX;
+			}
+		}
+
+		void TransmissionScheduler::abort() throw ()
+		{
+			ibrcommon::MutexLock l(_cond);
+			_cond.abort();
+		}
+
+		size_t TransmissionScheduler::size() const
+		{
+			ibrcommon::MutexLock l(_cond);
+			return _size;
+		}
+	} /* namespace net */
+} /* namespace dtn */
@@ -0,0 +1,162 @@
+/*
+ * TransmissionScheduler.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef TRANSMISSIONSCHEDULER_H_
+#define TRANSMISSIONSCHEDULER_H_
+
+#include "net/BundleTransfer.h"
+#include <ibrdtn/data/MetaBundle.h>
+#include <ibrdtn/data/Number.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/thread/Queue.h>
+#include <ibrcommon/Metrics.h>
+#include <stdint.h>
+#include <deque>
+
+namespace dtn
+{
+	namespace net
+	{
+		/**
+		 * Orders the outgoing transmissions of one neighbor. Each priority
+		 * class of the bundle protocol has its own queue and the queues are
+		 * served with deficit round robin, thus expedited bundles get the
+		 * largest share of the link without starving bulk bundles.
+		 *
+		 * A transmission may cover only a segment of the payload. The sender
+		 * puts the remaining part back into the scheduler after each segment,
+		 * so a large bundle can be preempted at segment boundaries.
+		 */
+		class TransmissionScheduler
+		{
+		public:
+			enum CLASS
+			{
+				CLASS_BULK = 0,
+				CLASS_NORMAL = 1,
+				CLASS_EXPEDITED = 2,
+				CLASS_MAX = 3
+			};
+
+			/**
+			 * A transmission of the payload starting at offset. A length of
+			 * zero covers the payload up to its end.
+			 */
+			class Job
+			{
+			public:
+				Job(const dtn::net::BundleTransfer &transfer, const dtn::data::Length &offset = 0, const dtn::data::Length &length = 0);
+				virtual ~Job();
+
+				/**
+				 * Returns the number of payload bytes covered by this job
+				 */
+				dtn::data::Length getCost() const;
+
+				dtn::net::BundleTransfer transfer;
+				dtn::data::Length offset;
+				dtn::data::Length length;
+				CLASS priority;
+
+			private:
+				friend class TransmissionScheduler;
+				uint64_t _queued;
+			};
+
+			/**
+			 * @param quantum Number of bytes the bulk class may send per round,
+			 *   the other classes get a multiple of it
+			 */
+			TransmissionScheduler(const dtn::data::Length &quantum = 65536);
+			virtual ~TransmissionScheduler();
+
+			/**
+			 * Append a job to the queue of its priority class
+			 */
+			void push(const Job &job);
+
+			/**
+			 * Retrieves and removes the next job, waiting if necessary until
+			 * a job is available.
+			 * @throw ibrcommon::QueueUnblockedException if the scheduler has been aborted
+			 */
+			Job pop() throw (ibrcommon::QueueUnblockedException);
+
+			/**
+			 * Unblock all waiting threads
+			 */
+			void abort() throw ();
+
+			/**
+			 * Returns the number of queued jobs
+			 */
+			size_t size() const;
+
+			/**
+			 * Returns the priority class of a bundle
+			 */
+			static CLASS getClass(const dtn::data::MetaBundle &meta);
+
+			/**
+			 * Returns the name of a priority class
+			 */
+			static const std::string& getName(const CLASS c);
+
+		private:
+			typedef std::deque<Job> job_queue;
+
+			/**
+			 * Statistics of a priority class, shared by all schedulers
+			 */
+			class Statistics
+			{
+			public:
+				Statistics(const CLASS c);
+				virtual ~Statistics();
+
+				ibrcommon::Histogram &wait;
+				ibrcommon::Counter &bytes;
+				ibrcommon::Counter &jobs;
+				ibrcommon::Gauge &length;
+			};
+
+			static Statistics& getStatistics(const CLASS c);
+
+			/**
+			 * Select the next job with deficit round robin,
+			 * the caller has to hold the lock and at least one queue has to be non-empty
+			 */
+			Job __next();
+
+			// the weight of each class as a multiple of the quantum
+			static const dtn::data::Length _weights[CLASS_MAX];
+
+			mutable ibrcommon::Conditional _cond;
+			job_queue _queues[CLASS_MAX];
+			dtn::data::Length _deficits[CLASS_MAX];
+			const dtn::data::Length _quantum;
+			int _current;
+			bool _granted;
+			size_t _size;
+		};
+	} /* namespace net */
+} /* namespace dtn */
+#endif /* TRANSMISSIONSCHEDULER_H_ */
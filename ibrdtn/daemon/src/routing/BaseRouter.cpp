@@ -40,6 +40,7 @@
 #include <ibrdtn/ibrdtn.h>
 #ifdef IBRDTN_SUPPORT_BSP
 #include "security/SecurityManager.h"
+#include "security/SecurityProcessor.h"
 #endif
 
 namespace dtn
@@ -52,7 +53,9 @@ namespace dtn
 		 * implementation of the BaseRouter class
 		 */
 		BaseRouter::BaseRouter()
-		 : _known_bundles("router-known-bundles"), _purged_bundles("router-purged-bundles"), _extension_state(false), _next_expiration(0)
+		 : _known_bundles("router-known-bundles"), _purged_bundles("router-purged-bundles"), _extension_state(false),
+		   _executor(dtn::daemon::Configuration::getInstance().getNetwork().getRoutingThreads(), dtn::daemon::Configuration::getInstance().getNetwork().getRoutingQueueLimit()),
+		   _next_expiration(0)
 		{
 			// make the router globally available
 			dtn::core::BundleCore::getInstance().setRouter(this);
@@ -63,6 +66,9 @@ namespace dtn
 			// unregister this router from the core
 			dtn::core::BundleCore::getInstance().setRouter(NULL);
 
+			// stop all tasks before the extensions are gone
+			_executor.shutdown();
+
 			// delete all extensions
 			clearExtensions();
 		}
@@ -79,8 +85,13 @@ namespace dtn
 
 		void BaseRouter::remove(RoutingExtension *extension)
 		{
-			ibrcommon::RWLock l(_extensions_mutex);
-			_extensions.erase(extension);
+			{
+				ibrcommon::RWLock l(_extensions_mutex);
+				_extensions.erase(extension);
+			}
+
+			// drop the tasks of the extension
+			_executor.purge(*extension);
 		}
 
 		ibrcommon::RWMutex& BaseRouter::getExtensionMutex() throw ()
@@ -110,6 +121,9 @@ namespace dtn
 		{
 			ibrcommon::MutexLock l(_extensions_mutex);
 
+			// the extensions may queue tasks in componentUp()
+			_executor.startup();
+
 			_nh_extension.componentUp();
 			_retransmission_extension.componentUp();
 
@@ -122,9 +136,9 @@ namespace dtn
 			_extension_state = true;
 
 			// trigger all routing modules to react to initial topology
-			const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+			const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-			for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+			for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 			{
 				const dtn::core::Node &n = (*iter);
 
@@ -135,6 +149,10 @@ namespace dtn
 
 		void BaseRouter::extensionsDown() throw ()
 		{
+			// drop all queued tasks and release blocked threads before
+			// the lock is taken, they may hold the lock for reading
+			_executor.shutdown();
+
 			ibrcommon::MutexLock l(_extensions_mutex);
 
 			_extension_state = false;
@@ -221,6 +239,9 @@ namespace dtn
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::add(this);
 			dtn::core::EventDispatcher<dtn::net::ConnectionEvent>::add(this);
 			dtn::core::EventDispatcher<dtn::core::BundlePurgeEvent>::add(this);
+#ifdef IBRDTN_SUPPORT_BSP
+			dtn::core::EventDispatcher<dtn::security::BundleVerifiedEvent>::add(this);
+#endif
 		}
 
 		void BaseRouter::componentDown() throw ()
@@ -234,6 +255,9 @@ namespace dtn
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::remove(this);
 			dtn::core::EventDispatcher<dtn::net::ConnectionEvent>::remove(this);
 			dtn::core::EventDispatcher<dtn::core::BundlePurgeEvent>::remove(this);
+#ifdef IBRDTN_SUPPORT_BSP
+			dtn::core::EventDispatcher<dtn::security::BundleVerifiedEvent>::remove(this);
+#endif
 		}
 
 		/**
@@ -290,35 +314,19 @@ namespace dtn
 					dtn::data::Bundle bundle = event.bundle;
 
 #ifdef IBRDTN_SUPPORT_BSP
+					// verify secured bundles in the background, the processing continues
+					// with the BundleVerifiedEvent
+					if (dtn::security::SecurityProcessor::isSecured(bundle) &&
+							dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_VERIFY, event.peer, bundle))
+					{
+						return;
+					}
+
 					// lets see if signatures and hashes are correct and remove them if possible
 					dtn::security::SecurityManager::getInstance().verify(bundle);
 #endif
 
-					// increment value in the scope control hop limit block
-					try {
-						dtn::data::ScopeControlHopLimitBlock &schl = bundle.find<dtn::data::ScopeControlHopLimitBlock>();
-						schl.increment();
-					} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
-
-					// modify TrackingBlock
-					try {
-						dtn::data::TrackingBlock &track = bundle.find<dtn::data::TrackingBlock>();
-						track.append(dtn::core::BundleCore::local);
-					} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
-
-					// prevent loops
-					try {
-						ibrcommon::MutexLock l(_neighbor_database);
-
-						// add the bundle to the summary vector of the neighbor
-						_neighbor_database.get(event.peer).add(m);
-					} catch (const NeighborDatabase::NeighborNotAvailableException&) { };
-
-					// store the bundle into a storage module
-					getStorage().store(bundle);
-
-					// raise the queued event to notify all receivers about the new bundle
-					QueueBundleEvent::raise(m, event.peer);
+					__accept(event.peer, bundle, m);
 				}
 				else
 				{
@@ -349,6 +357,65 @@ namespace dtn
 			}
 		}
 
+#ifdef IBRDTN_SUPPORT_BSP
+		void BaseRouter::raiseEvent(const dtn::security::BundleVerifiedEvent &event) throw ()
+		{
+			const dtn::data::MetaBundle m = dtn::data::MetaBundle::create(event.bundle);
+
+			try {
+				dtn::data::Bundle bundle = event.bundle;
+				__accept(event.peer, bundle, m);
+
+				// finally create a bundle received event
+				dtn::core::BundleEvent::raise(m, dtn::core::BUNDLE_RECEIVED);
+			} catch (const ibrcommon::IOException &ex) {
+				IBRCOMMON_LOGGER_TAG(BaseRouter::TAG, notice) << "Unable to store bundle " << event.bundle.toString() << IBRCOMMON_LOGGER_ENDL;
+
+				// raise BundleEvent because we have to drop the bundle
+				dtn::core::BundleEvent::raise(m, dtn::core::BUNDLE_DELETED, dtn::data::StatusReportBlock::DEPLETED_STORAGE);
+			} catch (const dtn::storage::BundleStorage::StorageSizeExeededException &ex) {
+				IBRCOMMON_LOGGER_TAG(BaseRouter::TAG, notice) << "No space left for bundle " << event.bundle.toString() << IBRCOMMON_LOGGER_ENDL;
+
+				// raise BundleEvent because we have to drop the bundle
+				dtn::core::BundleEvent::raise(m, dtn::core::BUNDLE_DELETED, dtn::data::StatusReportBlock::DEPLETED_STORAGE);
+			} catch (const ibrcommon::Exception &ex) {
+				IBRCOMMON_LOGGER_TAG(BaseRouter::TAG, error) << "Bundle " << event.bundle.toString() << " dropped: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+
+				// raise BundleEvent because we have to drop the bundle
+				dtn::core::BundleEvent::raise(m, dtn::core::BUNDLE_DELETED, dtn::data::StatusReportBlock::DEPLETED_STORAGE);
+			}
+		}
+#endif
+
+		void BaseRouter::__accept(const dtn::data::EID &peer, dtn::data::Bundle &bundle, const dtn::data::MetaBundle &m)
+		{
+			// increment value in the scope control hop limit block
+			try {
+				dtn::data::ScopeControlHopLimitBlock &schl = bundle.find<dtn::data::ScopeControlHopLimitBlock>();
+				schl.increment();
+			} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
+
+			// modify TrackingBlock
+			try {
+				dtn::data::TrackingBlock &track = bundle.find<dtn::data::TrackingBlock>();
+				track.append(dtn::core::BundleCore::local);
+			} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
+
+			// prevent loops
+			try {
+				ibrcommon::MutexLock l(_neighbor_database);
+
+				// add the bundle to the summary vector of the neighbor
+				_neighbor_database.get(peer).add(m);
+			} catch (const NeighborDatabase::NeighborNotAvailableException&) { };
+
+			// store the bundle into a storage module
+			getStorage().store(bundle);
+
+			// raise the queued event to notify all receivers about the new bundle
+			QueueBundleEvent::raise(m, peer);
+		}
+
 		void BaseRouter::raiseEvent(const dtn::net::TransferAbortedEvent &event) throw ()
 		{
 			// if a transfer is aborted, then release the transfer resource of the peer
@@ -406,9 +473,9 @@ namespace dtn
 				} catch (const NeighborDatabase::NeighborNotAvailableException&) { };
 
 				// new bundles trigger a re-check for all neighbors
-				const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+				const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-				for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+				for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 				{
 					const dtn::core::Node &n = (*iter);
 
@@ -470,10 +537,10 @@ namespace dtn
 					ibrcommon::MutexLock l(_neighbor_database);
 
 					// get all active neighbors
-					const std::set<dtn::core::Node> neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+					const dtn::net::NeighborSnapshot::Reference neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
 					// touch all active neighbors
-					for (std::set<dtn::core::Node>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
+					for (dtn::net::NeighborSnapshot::node_set::const_iterator it = neighbors->getNodes().begin(); it != neighbors->getNodes().end(); ++it) {
 						try {
 							_neighbor_database.get( (*it).getEID() );
 						} catch (const NeighborDatabase::NeighborNotAvailableException&) { };
@@ -604,5 +671,10 @@ namespace dtn
 		{
 			return _neighbor_database;
 		}
+
+		RoutingExecutor& BaseRouter::getExecutor()
+		{
+			return _executor;
+		}
 	}
 }
@@ -30,6 +30,7 @@
 #include "storage/BundleSeeker.h"
 
 #include "routing/RoutingExtension.h"
+#include "routing/RoutingExecutor.h"
 #include "routing/NodeHandshakeExtension.h"
 #include "routing/RetransmissionExtension.h"
 
@@ -51,6 +52,10 @@
 #include "net/ConnectionEvent.h"
 #include "core/BundlePurgeEvent.h"
 
+#include <ibrdtn/ibrdtn.h>
+#ifdef IBRDTN_SUPPORT_BSP
+#include "security/BundleVerifiedEvent.h"
+#endif
 
 
 
@@ -67,6 +72,9 @@ namespace dtn
 			public dtn::core::EventReceiver<dtn::core::TimeEvent>,
 			public dtn::core::EventReceiver<dtn::net::ConnectionEvent>,
 			public dtn::core::EventReceiver<dtn::core::BundlePurgeEvent>
+#ifdef IBRDTN_SUPPORT_BSP
+			, public dtn::core::EventReceiver<dtn::security::BundleVerifiedEvent>
+#endif
 		{
 			static const std::string TAG;
 
@@ -144,6 +152,9 @@ namespace dtn
 			void raiseEvent(const dtn::core::TimeEvent &evt) throw ();
 			void raiseEvent(const dtn::net::ConnectionEvent &evt) throw ();
 			void raiseEvent(const dtn::core::BundlePurgeEvent &evt) throw ();
+#ifdef IBRDTN_SUPPORT_BSP
+			void raiseEvent(const dtn::security::BundleVerifiedEvent &evt) throw ();
+#endif
 
 			/**
 			 * provides direct access to the bundle storage
@@ -218,6 +229,11 @@ namespace dtn
 			 */
 			NeighborDatabase& getNeighborDB();
 
+			/**
+			 * Access to the executor running the tasks of all extensions
+			 */
+			RoutingExecutor& getExecutor();
+
 			/**
 			 * enable all extensions
 			 */
@@ -259,6 +275,11 @@ namespace dtn
 			void __eventTransferCompleted(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ();
 			void __eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ();
 
+			/**
+			 * Update the blocks of a received bundle, store it and announce it as queued
+			 */
+			void __accept(const dtn::data::EID &peer, dtn::data::Bundle &bundle, const dtn::data::MetaBundle &meta);
+
 			ibrcommon::Mutex _known_bundles_lock;
 			dtn::data::BundleSet _known_bundles;
 
@@ -274,6 +295,7 @@ namespace dtn
 			NeighborDatabase _neighbor_database;
 			NodeHandshakeExtension _nh_extension;
 			RetransmissionExtension _retransmission_extension;
+			RoutingExecutor _executor;
 
 			dtn::data::Timestamp _next_expiration;
 		};
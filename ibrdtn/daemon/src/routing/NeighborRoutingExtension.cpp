@@ -56,15 +56,9 @@ namespace dtn
 
 		NeighborRoutingExtension::~NeighborRoutingExtension()
 		{
-			join();
 		}
 
-		void NeighborRoutingExtension::__cancellation() throw ()
-		{
-			_taskqueue.abort();
-		}
-
-		void NeighborRoutingExtension::run() throw ()
+		void NeighborRoutingExtension::process(RoutingExecutor::Task &t) throw ()
 		{
 #ifdef HAVE_SQLITE
 			class BundleFilter : public dtn::storage::BundleSelector, public dtn::storage::SQLiteDatabase::SQLBundleQuery
@@ -107,93 +101,85 @@ namespace dtn
 
 			dtn::storage::BundleResultList list;
 
-			while (true)
-			{
-				NeighborDatabase &db = (**this).getNeighborDB();
+			NeighborDatabase &db = (**this).getNeighborDB();
 
-				try {
-					Task *t = _taskqueue.poll();
-					std::auto_ptr<Task> killer(t);
-
-					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 5) << "processing task " << t->toString() << IBRCOMMON_LOGGER_ENDL;
-
-					/**
-					 * SearchNextBundleTask triggers a search for a bundle to transfer
-					 * to another host. This Task is generated by TransferCompleted, TransferAborted
-					 * and node events.
-					 */
-					try {
-						SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(*t);
-
-						// lock the neighbor database while searching for bundles
-						{
-							// this destination is not handles by any static route
-							ibrcommon::MutexLock l(db);
-							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
-
-							// check if enough transfer slots available (threshold reached)
-							if (!entry.isTransferThresholdReached())
-								throw NeighborDatabase::NoMoreTransfersAvailable();
-
-							// create a new bundle filter
-							BundleFilter filter(*this, entry);
-
-							// query an unknown bundle from the storage, the list contains max. 10 items.
-							list.clear();
-							(**this).getSeeker().get(filter, list);
-						}
-
-						IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 5) << "got " << list.size() << " items to transfer to " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
-
-						// send the bundles as long as we have resources
-						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-						{
-							try {
-								// transfer the bundle to the neighbor
-								transferTo(task.eid, *iter);
-							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
-						}
-					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const dtn::storage::NoBundleFoundException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const std::bad_cast&) { };
-
-					/**
-					 * process a received bundle
-					 */
-					try {
-						const ProcessBundleTask &task = dynamic_cast<ProcessBundleTask&>(*t);
-
-						// lock the neighbor database while searching for bundles
-						{
-							// this destination is not handles by any static route
-							ibrcommon::MutexLock l(db);
-							NeighborDatabase::NeighborEntry &entry = db.get(task.nexthop, true);
-
-							if (!shouldRouteTo(task.bundle, entry))
-								throw NeighborDatabase::NoRouteKnownException();
-						}
-
-						// transfer the bundle to the neighbor
-						transferTo(task.nexthop, task.bundle);
-					} catch (const NeighborDatabase::AlreadyInTransitException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const NeighborDatabase::NoRouteKnownException &ex) {
-						// nothing to do here.
-					} catch (const std::bad_cast&) { };
-				} catch (const std::exception &ex) {
-					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 15) << "terminated due to " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					return;
-				}
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 5) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
 
-				yield();
+				/**
+				 * SearchNextBundleTask triggers a search for a bundle to transfer
+				 * to another host. This Task is generated by TransferCompleted, TransferAborted
+				 * and node events.
+				 */
+				try {
+					SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
+
+					// lock the neighbor database while searching for bundles
+					{
+						// this destination is not handles by any static route
+						ibrcommon::MutexLock l(db);
+						NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
+
+						// check if enough transfer slots available (threshold reached)
+						if (!entry.isTransferThresholdReached())
+							throw NeighborDatabase::NoMoreTransfersAvailable();
+
+						// create a new bundle filter
+						BundleFilter filter(*this, entry);
+
+						// query an unknown bundle from the storage, the list contains max. 10 items.
+						ibrcommon::Histogram::Timer timer(_search_latency);
+						list.clear();
+						(**this).getSeeker().get(filter, list);
+					}
+
+					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 5) << "got " << list.size() << " items to transfer to " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+
+					// send the bundles as long as we have resources
+					for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+					{
+						try {
+							// transfer the bundle to the neighbor
+							transferTo(task.eid, *iter);
+						} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+					}
+				} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const dtn::storage::NoBundleFoundException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const std::bad_cast&) { };
+
+				/**
+				 * process a received bundle
+				 */
+				try {
+					const ProcessBundleTask &task = dynamic_cast<ProcessBundleTask&>(t);
+
+					// lock the neighbor database while searching for bundles
+					{
+						// this destination is not handles by any static route
+						ibrcommon::MutexLock l(db);
+						NeighborDatabase::NeighborEntry &entry = db.get(task.nexthop, true);
+
+						if (!shouldRouteTo(task.bundle, entry))
+							throw NeighborDatabase::NoRouteKnownException();
+					}
+
+					// transfer the bundle to the neighbor
+					transferTo(task.nexthop, task.bundle);
+				} catch (const NeighborDatabase::AlreadyInTransitException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NoRouteKnownException &ex) {
+					// nothing to do here.
+				} catch (const std::bad_cast&) { };
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(NeighborRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
 		}
 
@@ -237,60 +223,48 @@ namespace dtn
 		void NeighborRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
 		{
 			// transfer the next bundle to this destination
-			_taskqueue.push( new SearchNextBundleTask( peer ) );
+			execute( new SearchNextBundleTask( peer ) );
 		}
 
 		void NeighborRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
 		{
 			// try to deliver new bundles to all neighbors
-			const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+			const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-			for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+			for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 			{
 				const dtn::core::Node &n = (*iter);
 
 				if (n.getEID() != peer) {
 					// transfer the next bundle to this destination
-					_taskqueue.push( new ProcessBundleTask(meta, peer, n.getEID()) );
+					execute( new ProcessBundleTask(meta, peer, n.getEID()) );
 				}
 			}
 		}
 
 		void NeighborRoutingExtension::componentUp() throw ()
 		{
-			// reset the task queue
-			_taskqueue.reset();
-
-			// routine checked for throw() on 15.02.2013
-			try {
-				// run the thread
-				start();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(NeighborRoutingExtension::TAG, error) << "componentUp failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
+			// the tasks are processed by the routing executor
 		}
 
 		void NeighborRoutingExtension::componentDown() throw ()
 		{
-			// routine checked for throw() on 15.02.2013
-			try {
-				// stop the thread
-				stop();
-				join();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(NeighborRoutingExtension::TAG, error) << "componentDown failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
 		}
 
 		/****************************************/
 
 		NeighborRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &e)
-		 : eid(e)
+		 : RoutingExecutor::Task(e), eid(e)
 		{ }
 
 		NeighborRoutingExtension::SearchNextBundleTask::~SearchNextBundleTask()
 		{ }
 
+		bool NeighborRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
 		std::string NeighborRoutingExtension::SearchNextBundleTask::toString()
 		{
 			return "SearchNextBundleTask: " + eid.getString();
@@ -299,7 +273,7 @@ namespace dtn
 		/****************************************/
 
 		NeighborRoutingExtension::ProcessBundleTask::ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &o, const dtn::data::EID &n)
-		 : bundle(meta), origin(o), nexthop(n)
+		 : RoutingExecutor::Task(n), bundle(meta), origin(o), nexthop(n)
 		{ }
 
 		NeighborRoutingExtension::ProcessBundleTask::~ProcessBundleTask()
@@ -28,7 +28,6 @@
 
 #include <ibrdtn/data/MetaBundle.h>
 #include "ibrdtn/data/EID.h"
-#include <ibrcommon/thread/Queue.h>
 #include <list>
 #include <map>
 #include <queue>
@@ -37,7 +36,7 @@ namespace dtn
 {
 	namespace routing
 	{
-		class NeighborRoutingExtension : public RoutingExtension, public ibrcommon::JoinableThread
+		class NeighborRoutingExtension : public RoutingExtension
 		{
 			static const std::string TAG;
 
@@ -53,29 +52,22 @@ namespace dtn
 			void componentDown() throw ();
 
 		protected:
-			void run() throw ();
-			void __cancellation() throw ();
+			void process(RoutingExecutor::Task &task) throw ();
 
 		private:
-			class Task
-			{
-			public:
-				virtual ~Task() {};
-				virtual std::string toString() = 0;
-			};
-
-			class SearchNextBundleTask : public Task
+			class SearchNextBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				SearchNextBundleTask(const dtn::data::EID &eid);
 				virtual ~SearchNextBundleTask();
 
 				virtual std::string toString();
+				virtual bool isCoalescable() const;
 
 				const dtn::data::EID eid;
 			};
 
-			class ProcessBundleTask : public Task
+			class ProcessBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &origin, const dtn::data::EID &nexthop);
@@ -89,11 +81,6 @@ namespace dtn
 			};
 
 			bool shouldRouteTo(const dtn::data::MetaBundle &meta, const NeighborDatabase::NeighborEntry &n) const;
-
-			/**
-			 * hold queued tasks for later processing
-			 */
-			ibrcommon::Queue<NeighborRoutingExtension::Task* > _taskqueue;
 		};
 	}
 }
@@ -22,6 +22,7 @@
 #include "routing/QueueBundleEvent.h"
 #include "core/BundleCore.h"
 #include "core/EventDispatcher.h"
+#include "core/BundleTracer.h"
 
 namespace dtn
 {
@@ -40,6 +41,8 @@ namespace dtn
 
 		void QueueBundleEvent::raise(const dtn::data::MetaBundle &bundle, const dtn::data::EID &origin)
 		{
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_QUEUED, bundle, origin);
+
 			// raise the new event
 			dtn::core::EventDispatcher<QueueBundleEvent>::queue( new QueueBundleEvent(bundle, origin) );
 		}
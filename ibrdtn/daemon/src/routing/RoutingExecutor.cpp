@@ -0,0 +1,487 @@
+/*
+ * RoutingExecutor.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/RoutingExecutor.h"
+#include "routing/RoutingExtension.h"
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Logger.h>
+#include <typeinfo>
+#include <pthread.h>
+
+namespace dtn
+{
+	namespace routing
+	{
+		const std::string RoutingExecutor::TAG = "RoutingExecutor";
+
+		// marks the worker threads of an executor
+		static pthread_key_t __worker_key;
+		static pthread_once_t __worker_once = PTHREAD_ONCE_INIT;
+
+		static void __worker_key_create()
+		{
+			pthread_key_create(&__worker_key, NULL);
+		}
+
+		RoutingExecutor::Task::Task()
+		 : _exclusive(true), _owner(NULL), _queued(0)
+		{
+		}
+
+		RoutingExecutor::Task::Task(const dtn::data::EID &peer)
+		 : _peer(peer), _exclusive(false), _owner(NULL), _queued(0)
+		{
+		}
+
+		RoutingExecutor::Task::~Task()
+		{
+		}
+
+		bool RoutingExecutor::Task::isCoalescable() const
+		{
+			return false;
+		}
+
+		const dtn::data::EID& RoutingExecutor::Task::getPeer() const
+		{
+			return _peer;
+		}
+
+		bool RoutingExecutor::Task::isExclusive() const
+		{
+			return _exclusive;
+		}
+
+		RoutingExecutor::TaskList::TaskList()
+		{
+		}
+
+		RoutingExecutor::TaskList::~TaskList()
+		{
+		}
+
+		bool RoutingExecutor::TaskList::push(Task *task)
+		{
+			if (task->isCoalescable())
+			{
+				// a queued task of the same type does the same work
+				if (!_pending.insert(typeid(*task).name()).second) return false;
+			}
+
+			tasks.push_back(task);
+			return true;
+		}
+
+		RoutingExecutor::Task* RoutingExecutor::TaskList::pop()
+		{
+			Task *task = tasks.front();
+			tasks.pop_front();
+
+			// new tasks of this type are not redundant anymore
+			if (task->isCoalescable()) _pending.erase(typeid(*task).name());
+
+			return task;
+		}
+
+		bool RoutingExecutor::TaskList::empty() const
+		{
+			return tasks.empty();
+		}
+
+		RoutingExecutor::Lane::Lane()
+		 : running(false), ready(false)
+		{
+		}
+
+		RoutingExecutor::Lane::~Lane()
+		{
+		}
+
+		RoutingExecutor::Owner::Owner()
+		 : running(0), exclusive_running(false)
+		{
+		}
+
+		RoutingExecutor::Owner::~Owner()
+		{
+		}
+
+		RoutingExecutor::RoutingExecutor(const size_t threads, const size_t limit)
+		 : _threads((threads > 0) ? threads : ((ibrcommon::Thread::getNumberOfProcessors() > 0) ? ibrcommon::Thread::getNumberOfProcessors() : 1)),
+		   _limit(limit), _running(false), _size(0), _active(0),
+		   _queued_gauge(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_routing_tasks_queued", "Routing tasks waiting for a worker")),
+		   _running_gauge(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_routing_tasks_running", "Routing tasks in progress")),
+		   _executed(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_routing_tasks_total", "Routing tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "executed"))),
+		   _coalesced(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_routing_tasks_total", "Routing tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "coalesced"))),
+		   _dropped(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_routing_tasks_total", "Routing tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "dropped"))),
+		   _throttled(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_routing_tasks_throttled_total", "Routing tasks delayed because the queue was full")),
+		   _wait_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_routing_task_wait_seconds", "Time routing tasks spend in the queue", "", 0.000001)),
+		   _process_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_routing_task_process_seconds", "Time spent to process a routing task", "", 0.000001))
+		{
+		}
+
+		RoutingExecutor::~RoutingExecutor()
+		{
+			shutdown();
+		}
+
+		void RoutingExecutor::startup()
+		{
+			ibrcommon::MutexLock l(_cond);
+			if (_running) return;
+
+			_running = true;
+
+			for (size_t i = 0; i < _threads; ++i)
+			{
+				Worker *w = new Worker(*this);
+
+				try {
+					w->start();
+					_workers.push_back(w);
+				} catch (const ibrcommon::ThreadException &ex) {
+					IBRCOMMON_LOGGER_TAG(RoutingExecutor::TAG, error) << "failed to start a worker: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					delete w;
+				}
+			}
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(RoutingExecutor::TAG, 10) << _workers.size() << " workers started" << IBRCOMMON_LOGGER_ENDL;
+		}
+
+		void RoutingExecutor::shutdown()
+		{
+			{
+				ibrcommon::MutexLock l(_cond);
+				if (!_running) return;
+
+				_running = false;
+
+				// drop all queued tasks
+				for (lane_map::iterator it = _lanes.begin(); it != _lanes.end();)
+				{
+					__drop((*it).second);
+
+					if ((*it).second.running) {
+						++it;
+					} else {
+						_lanes.erase(it++);
+					}
+				}
+
+				for (owner_map::iterator it = _owners.begin(); it != _owners.end(); ++it)
+				{
+					__drop((*it).second.exclusive);
+				}
+
+				_ready.clear();
+
+				// wake-up all workers and blocked producers
+				_cond.signal(true);
+			}
+
+			// the workers leave after their running task
+			for (std::list<Worker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+			{
+				Worker *w = (*it);
+				w->stop();
+				w->join();
+				delete w;
+			}
+
+			_workers.clear();
+		}
+
+		void RoutingExecutor::push(RoutingExtension &owner, Task *task)
+		{
+			pthread_once(&__worker_once, __worker_key_create);
+			task->_owner = &owner;
+
+			ibrcommon::MutexLock l(_cond);
+
+			// block other threads while the queue is full, the workers
+			// are never blocked because they are the ones to drain the queue
+			if ((_limit > 0) && (_size >= _limit) && _running && (pthread_getspecific(__worker_key) != this))
+			{
+				_throttled.inc();
+
+				while (_running && (_size >= _limit))
+				{
+					_cond.wait();
+				}
+			}
+
+			if (!_running)
+			{
+				_dropped.inc();
+				delete task;
+				return;
+			}
+
+			if (task->isExclusive())
+			{
+				if (!_owners[&owner].exclusive.push(task))
+				{
+					_coalesced.inc();
+					delete task;
+					return;
+				}
+			}
+			else
+			{
+				const lane_key key(&owner, task->getPeer());
+				Lane &lane = _lanes[key];
+
+				if (!lane.push(task))
+				{
+					_coalesced.inc();
+					delete task;
+					return;
+				}
+
+				// a running lane is put back into the ready list once its task is done
+				if (!lane.running && !lane.ready)
+				{
+					lane.ready = true;
+					_ready.push_back(key);
+				}
+			}
+
+			task->_queued = ibrcommon::Histogram::now();
+			_size++;
+			_queued_gauge.add(1);
+
+			_cond.signal(true);
+		}
+
+		void RoutingExecutor::purge(RoutingExtension &owner)
+		{
+			ibrcommon::MutexLock l(_cond);
+
+			for (lane_map::iterator it = _lanes.begin(); it != _lanes.end();)
+			{
+				if ((*it).first.first != &owner) {
+					++it;
+					continue;
+				}
+
+				__drop((*it).second);
+
+				if ((*it).second.running) {
+					++it;
+				} else {
+					_lanes.erase(it++);
+				}
+			}
+
+			for (std::list<lane_key>::iterator it = _ready.begin(); it != _ready.end();)
+			{
+				if ((*it).first == &owner) {
+					_ready.erase(it++);
+				} else {
+					++it;
+				}
+			}
+
+			owner_map::iterator oit = _owners.find(&owner);
+			if (oit == _owners.end()) return;
+
+			__drop((*oit).second.exclusive);
+
+			// wait until the running tasks are finished
+			while ((*oit).second.running > 0)
+			{
+				_cond.wait();
+			}
+
+			_owners.erase(oit);
+		}
+
+		size_t RoutingExecutor::size() const
+		{
+			ibrcommon::MutexLock l(_cond);
+			return _size;
+		}
+
+		size_t RoutingExecutor::getThreads() const
+		{
+			return _threads;
+		}
+
+		RoutingExecutor::Task* RoutingExecutor::__next()
+		{
+			while (_running)
+			{
+				// exclusive tasks start as soon as their extension is idle
+				for (owner_map::iterator it = _owners.begin(); it != _owners.end(); ++it)
+				{
+					Owner &o = (*it).second;
+
+					if (!o.exclusive.empty() && (o.running == 0))
+					{
+						o.running++;
+						o.exclusive_running = true;
+						return __take(o.exclusive);
+					}
+				}
+
+				// take the first lane not held back by an exclusive task
+				for (std::list<lane_key>::iterator it = _ready.begin(); it != _ready.end(); ++it)
+				{
+					Owner &o = _owners[(*it).first];
+					if (o.exclusive_running || !o.exclusive.empty()) continue;
+
+					Lane &lane = _lanes[*it];
+					lane.ready = false;
+					lane.running = true;
+					o.running++;
+
+					_ready.erase(it);
+					return __take(lane);
+				}
+
+				_cond.wait();
+			}
+
+			return NULL;
+		}
+
+		RoutingExecutor::Task* RoutingExecutor::__take(TaskList &list)
+		{
+			Task *task = list.pop();
+
+			_size--;
+			_queued_gauge.add(-1);
+			_active++;
+			_running_gauge.add(1);
+			_wait_latency.record(ibrcommon::Histogram::now() - task->_queued);
+
+			// there is room for blocked producers
+			_cond.signal(true);
+
+			return task;
+		}
+
+		void RoutingExecutor::__done(Task *task)
+		{
+			ibrcommon::MutexLock l(_cond);
+
+			Owner &o = _owners[task->_owner];
+			o.running--;
+
+			if (task->isExclusive())
+			{
+				o.exclusive_running = false;
+			}
+			else
+			{
+				const lane_key key(task->_owner, task->getPeer());
+				lane_map::iterator it = _lanes.find(key);
+
+				if (it != _lanes.end())
+				{
+					Lane &lane = (*it).second;
+					lane.running = false;
+
+					if (lane.empty() || !_running)
+					{
+						_lanes.erase(it);
+					}
+					else
+					{
+						// queue the lane behind all other ready lanes
+						lane.ready = true;
+						_ready.push_back(key);
+					}
+				}
+			}
+
+			_active--;
+			_running_gauge.add(-1);
+
+			_cond.signal(true);
+		}
+
+		void RoutingExecutor::__drop(TaskList &list)
+		{
+			while (!list.empty())
+			{
+				Task *task = list.pop();
+
+				_size--;
+				_queued_gauge.add(-1);
+				_dropped.inc();
+
+				delete task;
+			}
+		}
+
+		void RoutingExecutor::process()
+		{
+			pthread_once(&__worker_once, __worker_key_create);
+			pthread_setspecific(__worker_key, this);
+
+			while (true)
+			{
+				Task *task = NULL;
+
+				{
+					ibrcommon::MutexLock l(_cond);
+					task = __next();
+				}
+
+				if (task == NULL) break;
+
+				IBRCOMMON_LOGGER_DEBUG_TAG(RoutingExecutor::TAG, 50) << "processing task " << task->toString() << IBRCOMMON_LOGGER_ENDL;
+
+				{
+					ibrcommon::Histogram::Timer timer(_process_latency);
+					task->_owner->process(*task);
+				}
+
+				_executed.inc();
+
+				__done(task);
+				delete task;
+			}
+
+			pthread_setspecific(__worker_key, NULL);
+		}
+
+		RoutingExecutor::Worker::Worker(RoutingExecutor &executor)
+		 : _executor(executor)
+		{
+		}
+
+		RoutingExecutor::Worker::~Worker()
+		{
+		}
+
+		void RoutingExecutor::Worker::run() throw ()
+		{
+			_executor.process();
+		}
+
+		void RoutingExecutor::Worker::__cancellation() throw ()
+		{
+			// the executor wakes up its workers on shutdown
+		}
+	} /* namespace routing */
+} /* namespace dtn */
@@ -0,0 +1,277 @@
+/*
+ * RoutingExecutor.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROUTINGEXECUTOR_H_
+#define ROUTINGEXECUTOR_H_
+
+#include <ibrdtn/data/EID.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/Metrics.h>
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+
+namespace dtn
+{
+	namespace routing
+	{
+		class RoutingExtension;
+
+		/**
+		 * Executes the tasks of all routing extensions on a shared pool of
+		 * worker threads. The tasks of an extension are sorted into lanes,
+		 * one for each peer. The tasks of a lane are processed one after
+		 * another, while the lanes of different peers run in parallel.
+		 *
+		 * A task without a peer is exclusive: it waits until no other task
+		 * of its extension is running and holds back all other tasks of the
+		 * extension until it is finished, thus it may change the routing
+		 * state of the extension without further locking.
+		 */
+		class RoutingExecutor
+		{
+			static const std::string TAG;
+
+		public:
+			class Task
+			{
+			public:
+				/**
+				 * Create an exclusive task
+				 */
+				Task();
+
+				/**
+				 * Create a task for the lane of the given peer
+				 */
+				Task(const dtn::data::EID &peer);
+
+				virtual ~Task();
+
+				virtual std::string toString() = 0;
+
+				/**
+				 * Returns true, if this task is redundant as long as a task of
+				 * the same type is queued in the same lane. A new task is dropped
+				 * in this case.
+				 */
+				virtual bool isCoalescable() const;
+
+				/**
+				 * Returns the peer of the lane
+				 */
+				const dtn::data::EID& getPeer() const;
+
+				/**
+				 * Returns true, if this task is exclusive
+				 */
+				bool isExclusive() const;
+
+			private:
+				friend class RoutingExecutor;
+
+				const dtn::data::EID _peer;
+				const bool _exclusive;
+				RoutingExtension *_owner;
+
+				// monotonic time of the enqueue in microseconds
+				uint64_t _queued;
+			};
+
+			/**
+			 * @param threads Number of worker threads, zero for one per processor
+			 * @param limit Maximum number of queued tasks, zero for no limit
+			 */
+			RoutingExecutor(const size_t threads = 0, const size_t limit = 0);
+			virtual ~RoutingExecutor();
+
+			/**
+			 * Start the worker threads
+			 */
+			void startup();
+
+			/**
+			 * Drop all queued tasks, wait until the running tasks
+			 * are finished and stop the worker threads
+			 */
+			void shutdown();
+
+			/**
+			 * Queue a task of an extension. The executor takes the ownership
+			 * of the task. If the queue limit is reached, the caller is blocked
+			 * until there is room for the task. Worker threads are never blocked,
+			 * so extensions can queue follow-up tasks while processing one.
+			 */
+			void push(RoutingExtension &owner, Task *task);
+
+			/**
+			 * Drop all queued tasks of an extension and wait until
+			 * its running tasks are finished
+			 */
+			void purge(RoutingExtension &owner);
+
+			/**
+			 * Returns the number of queued tasks
+			 */
+			size_t size() const;
+
+			/**
+			 * Returns the number of worker threads
+			 */
+			size_t getThreads() const;
+
+		private:
+			class Worker : public ibrcommon::JoinableThread
+			{
+			public:
+				Worker(RoutingExecutor &executor);
+				virtual ~Worker();
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				RoutingExecutor &_executor;
+			};
+
+			typedef std::pair<RoutingExtension*, dtn::data::EID> lane_key;
+
+			/**
+			 * Queued tasks in order of arrival
+			 */
+			class TaskList
+			{
+			public:
+				TaskList();
+				virtual ~TaskList();
+
+				/**
+				 * Append a task
+				 * @return False, if the task has been coalesced with a queued one
+				 */
+				bool push(Task *task);
+
+				/**
+				 * Remove and return the first task
+				 */
+				Task* pop();
+
+				bool empty() const;
+
+				std::deque<Task*> tasks;
+
+			private:
+				// types of the queued coalescable tasks
+				std::set<std::string> _pending;
+			};
+
+			class Lane : public TaskList
+			{
+			public:
+				Lane();
+				virtual ~Lane();
+
+				// true, if a task of this lane is running
+				bool running;
+
+				// true, if this lane is in the ready list
+				bool ready;
+			};
+
+			class Owner
+			{
+			public:
+				Owner();
+				virtual ~Owner();
+
+				// queued exclusive tasks
+				TaskList exclusive;
+
+				// number of running tasks
+				size_t running;
+
+				// true, if an exclusive task is running
+				bool exclusive_running;
+			};
+
+			typedef std::map<lane_key, Lane> lane_map;
+			typedef std::map<RoutingExtension*, Owner> owner_map;
+
+			/**
+			 * Wait for the next runnable task and mark its lane as running,
+			 * the caller has to hold the lock
+			 * @return The task or NULL if the executor has been stopped
+			 */
+			Task* __next();
+
+			/**
+			 * Take the first task of a list and update the statistics,
+			 * the caller has to hold the lock
+			 */
+			Task* __take(TaskList &list);
+
+			/**
+			 * Mark the lane of a processed task as idle
+			 */
+			void __done(Task *task);
+
+			/**
+			 * Delete all tasks of a list,
+			 * the caller has to hold the lock
+			 */
+			void __drop(TaskList &list);
+
+			/**
+			 * Process tasks until the executor is stopped
+			 */
+			void process();
+
+			const size_t _threads;
+			const size_t _limit;
+
+			mutable ibrcommon::Conditional _cond;
+			bool _running;
+
+			lane_map _lanes;
+			owner_map _owners;
+			std::list<lane_key> _ready;
+			size_t _size;
+			size_t _active;
+
+			std::list<Worker*> _workers;
+
+			ibrcommon::Gauge &_queued_gauge;
+			ibrcommon::Gauge &_running_gauge;
+			ibrcommon::Counter &_executed;
+			ibrcommon::Counter &_coalesced;
+			ibrcommon::Counter &_dropped;
+			ibrcommon::Counter &_throttled;
+			ibrcommon::Histogram &_wait_latency;
+			ibrcommon::Histogram &_process_latency;
+		};
+	} /* namespace routing */
+} /* namespace dtn */
+#endif /* ROUTINGEXECUTOR_H_ */
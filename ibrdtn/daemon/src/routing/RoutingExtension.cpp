@@ -22,6 +22,7 @@
 #include "routing/RoutingExtension.h"
 #include "routing/BaseRouter.h"
 #include "core/BundleCore.h"
+#include "core/BundleTracer.h"
 #include <ibrcommon/Logger.h>
 
 namespace dtn
@@ -34,6 +35,7 @@ namespace dtn
 		 * base implementation of the Extension class
 		 */
 		RoutingExtension::RoutingExtension()
+		 : _search_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_routing_search_seconds", "Time spent to search bundles for a neighbor", "", 0.000001))
 		{ }
 
 		RoutingExtension::~RoutingExtension()
@@ -44,6 +46,11 @@ namespace dtn
 			return dtn::core::BundleCore::getInstance().getRouter();
 		}
 
+		void RoutingExtension::execute(RoutingExecutor::Task *task)
+		{
+			(**this).getExecutor().push(*this, task);
+		}
+
 		/**
 		 * Transfer one bundle to another node.
 		 * @param destination The EID of the other node.
@@ -63,6 +70,8 @@ namespace dtn
 				entry.acquireTransfer(meta);
 			}
 
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_SELECTED, meta, destination);
+
 			try {
 				// create a new bundle transfer object
 				dtn::net::BundleTransfer transfer(destination, meta);
@@ -24,9 +24,11 @@
 
 #include "routing/NeighborDatabase.h"
 #include "routing/NodeHandshake.h"
+#include "routing/RoutingExecutor.h"
 #include "core/Event.h"
 #include <ibrdtn/data/BundleID.h>
 #include <ibrdtn/data/EID.h>
+#include <ibrcommon/Metrics.h>
 
 namespace dtn
 {
@@ -36,6 +38,7 @@ namespace dtn
 
 		class RoutingExtension
 		{
+			friend class RoutingExecutor;
 			static const std::string TAG;
 
 		public:
@@ -94,7 +97,24 @@ namespace dtn
 			 */
 			void transferTo(const dtn::data::EID &destination, const dtn::data::MetaBundle &meta);
 
+			/**
+			 * Queue a task on the routing executor. The task is
+			 * processed later by a call of process().
+			 * @param task The task to queue, the executor takes the ownership
+			 */
+			void execute(RoutingExecutor::Task *task);
+
+			/**
+			 * Process a task queued by this extension. This method is called
+			 * by the workers of the routing executor, tasks of different peers
+			 * may be processed in parallel.
+			 */
+			virtual void process(RoutingExecutor::Task &task) throw () { };
+
 			BaseRouter& operator*();
+
+			// time spent to search bundles for a neighbor in microseconds
+			ibrcommon::Histogram &_search_latency;
 		};
 	} /* namespace routing */
 } /* namespace dtn */
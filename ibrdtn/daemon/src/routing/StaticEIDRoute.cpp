@@ -0,0 +1,83 @@
+/*
+ * StaticEIDRoute.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/StaticEIDRoute.h"
+#include "routing/StaticRouteChangeEvent.h"
+#include <typeinfo>
+#include <sstream>
+
+namespace dtn
+{
+	namespace routing
+	{
+		StaticEIDRoute::StaticEIDRoute(const dtn::data::EID &match, const dtn::data::EID &nexthop, const dtn::data::Timestamp &et)
+		 : _nexthop(nexthop), _match(match), expiretime(et)
+		{
+		}
+
+		StaticEIDRoute::~StaticEIDRoute()
+		{
+		}
+
+		bool StaticEIDRoute::match(const dtn::data::EID &eid) const
+		{
+			return _match.sameHost(eid);
+		}
+
+		const dtn::data::EID& StaticEIDRoute::getDestination() const
+		{
+			return _nexthop;
+		}
+
+		const std::string StaticEIDRoute::toString() const
+		{
+			std::stringstream ss;
+			ss << _match.getString() << " => " << _nexthop.getString();
+			return ss.str();
+		}
+
+		const dtn::data::Timestamp& StaticEIDRoute::getExpiration() const
+		{
+			return expiretime;
+		}
+
+		void StaticEIDRoute::raiseExpired() const
+		{
+			dtn::routing::StaticRouteChangeEvent::raiseEvent(dtn::routing::StaticRouteChangeEvent::ROUTE_EXPIRED, _nexthop, _match);
+		}
+
+		bool StaticEIDRoute::equals(const StaticRoute &route) const
+		{
+			try {
+				const StaticEIDRoute &r = dynamic_cast<const StaticEIDRoute&>(route);
+				return (_nexthop == r._nexthop) && (_match == r._match);
+			} catch (const std::bad_cast&) {
+				return false;
+			}
+		}
+
+		bool StaticEIDRoute::getHost(dtn::data::EID &host) const
+		{
+			host = _match.getNode();
+			return true;
+		}
+	}
+}
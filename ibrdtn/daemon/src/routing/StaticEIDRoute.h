@@ -0,0 +1,74 @@
+/*
+ * StaticEIDRoute.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef STATICEIDROUTE_H_
+#define STATICEIDROUTE_H_
+
+#include "routing/StaticRoute.h"
+
+namespace dtn
+{
+	namespace routing
+	{
+		/**
+		 * A static route matching all endpoints of one host
+		 */
+		class StaticEIDRoute : public StaticRoute
+		{
+		public:
+			StaticEIDRoute(const dtn::data::EID &match, const dtn::data::EID &nexthop, const dtn::data::Timestamp &expiretime = 0);
+			virtual ~StaticEIDRoute();
+
+			bool match(const dtn::data::EID &eid) const;
+			const dtn::data::EID& getDestination() const;
+
+			/**
+			 * Describe this route as a one-line-string.
+			 * @return
+			 */
+			const std::string toString() const;
+
+			const dtn::data::Timestamp& getExpiration() const;
+
+			/**
+			 * Raise the StaticRouteChangeEvent for expiration
+			 */
+			void raiseExpired() const;
+
+			/**
+			 * Compare this static route with another one
+			 */
+			bool equals(const StaticRoute &route) const;
+
+			/**
+			 * Returns the node EID matched by this route
+			 */
+			bool getHost(dtn::data::EID &host) const;
+
+		private:
+			const dtn::data::EID _nexthop;
+			const dtn::data::EID _match;
+			const dtn::data::Timestamp expiretime;
+		};
+	}
+}
+
+#endif /* STATICEIDROUTE_H_ */
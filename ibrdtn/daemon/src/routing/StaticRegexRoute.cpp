@@ -113,6 +113,26 @@ namespace dtn
 			dtn::routing::StaticRouteChangeEvent::raiseEvent(dtn::routing::StaticRouteChangeEvent::ROUTE_EXPIRED, _dest, _regex_str);
 		}
 
+		const std::string StaticRegexRoute::getPrefix() const
+		{
+			// only anchored expressions have a literal prefix
+			if (_invalid || (_regex_str.length() == 0) || (_regex_str[0] != '^')) return "";
+
+			// stop at the first special character of the basic regular expression syntax
+			const std::string::size_type end = _regex_str.find_first_of(".[\\*^$", 1);
+			if (end == std::string::npos) return _regex_str.substr(1);
+
+			// escapes may introduce alternations (\|) or quantifiers (\?, \{n\}),
+			// thus the expression has no reliable literal prefix
+			const char c = _regex_str[end];
+			if (c == '\\') return "";
+
+			// a quantifier applies to the last literal character
+			if (c == '*') return _regex_str.substr(1, (end > 1) ? (end - 2) : 0);
+
+			return _regex_str.substr(1, end - 1);
+		}
+
 		bool StaticRegexRoute::equals(const StaticRoute &route) const
 		{
 			try {
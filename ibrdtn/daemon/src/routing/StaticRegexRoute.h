@@ -34,6 +34,11 @@ namespace dtn
 			 */
 			bool equals(const StaticRoute &route) const;
 
+			/**
+			 * Returns the literal prefix of an anchored expression
+			 */
+			const std::string getPrefix() const;
+
 			/**
 			 * copy and assignment operators
 			 * @param obj The object to copy
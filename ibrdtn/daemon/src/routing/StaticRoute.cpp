@@ -13,5 +13,15 @@ namespace dtn
 	{
 		// virtual destructor
 		StaticRoute::~StaticRoute() {}
+
+		bool StaticRoute::getHost(dtn::data::EID&) const
+		{
+			return false;
+		}
+
+		const std::string StaticRoute::getPrefix() const
+		{
+			return "";
+		}
 	}
 }
@@ -33,6 +33,21 @@ namespace dtn
 			 * Compare this static route with another one
 			 */
 			virtual bool equals(const StaticRoute &route) const = 0;
+
+			/**
+			 * If this route matches all endpoints of exactly one host, the
+			 * node EID of that host is returned in the given parameter.
+			 * Such routes can be looked up without calling match().
+			 * @return True, if the route is bound to a single host
+			 */
+			virtual bool getHost(dtn::data::EID &host) const;
+
+			/**
+			 * Returns a literal prefix of the string representation of all
+			 * EIDs matched by this route. An empty string is returned if the
+			 * matching EIDs do not share a common prefix.
+			 */
+			virtual const std::string getPrefix() const;
 		};
 	}
 }
@@ -0,0 +1,283 @@
+/*
+ * StaticRouteTable.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/StaticRouteTable.h"
+
+namespace dtn
+{
+	namespace routing
+	{
+		StaticRouteTable::StaticRouteTable(size_t cache_limit)
+		 : _cache_limit(cache_limit)
+		{
+		}
+
+		StaticRouteTable::~StaticRouteTable()
+		{
+			clear();
+		}
+
+		void StaticRouteTable::add(StaticRoute *route)
+		{
+			// delete all similar routes
+			remove(*route);
+
+			_routes.push_back(route);
+			_nexthops[route->getDestination()]++;
+
+			dtn::data::EID host;
+			if (route->getHost(host))
+			{
+				_host_routes[host].push_back(route);
+			}
+			else
+			{
+				_pattern_routes.add(route->getPrefix(), route);
+			}
+
+			invalidate();
+		}
+
+		void StaticRouteTable::remove(const StaticRoute &route)
+		{
+			for (std::list<StaticRoute*>::iterator iter = _routes.begin(); iter != _routes.end();)
+			{
+				if ((*iter)->equals(route))
+				{
+					erase(iter++);
+				}
+				else
+				{
+					++iter;
+				}
+			}
+		}
+
+		void StaticRouteTable::clear()
+		{
+			for (std::list<StaticRoute*>::iterator iter = _routes.begin(); iter != _routes.end(); ++iter)
+			{
+				delete (*iter);
+			}
+
+			_routes.clear();
+			_host_routes.clear();
+			_pattern_routes.clear();
+			_nexthops.clear();
+
+			invalidate();
+		}
+
+		dtn::data::Timestamp StaticRouteTable::expire(const dtn::data::Timestamp &timestamp)
+		{
+			dtn::data::Timestamp next_expire = 0;
+
+			for (std::list<StaticRoute*>::iterator iter = _routes.begin(); iter != _routes.end();)
+			{
+				const StaticRoute *route = (*iter);
+
+				if ((route->getExpiration() > 0) && (route->getExpiration() < timestamp))
+				{
+					route->raiseExpired();
+					erase(iter++);
+				}
+				else
+				{
+					if ((next_expire == 0) || (next_expire > route->getExpiration()))
+					{
+						next_expire = route->getExpiration();
+					}
+
+					++iter;
+				}
+			}
+
+			return next_expire;
+		}
+
+		const StaticRouteTable::route_list& StaticRouteTable::match(const dtn::data::EID &destination)
+		{
+			route_map::const_iterator cit = _cache.find(destination);
+			if (cit != _cache.end()) return (*cit).second;
+
+			// drop all cached results if the cache limit is reached
+			if (_cache.size() >= _cache_limit) _cache.clear();
+
+			route_list &ret = _cache[destination];
+
+			// add all routes bound to the host of the destination
+			route_map::const_iterator hit = _host_routes.find(destination.getNode());
+			if (hit != _host_routes.end())
+			{
+				ret = (*hit).second;
+			}
+
+			// evaluate all other routes with a matching prefix
+			route_list candidates;
+			_pattern_routes.find(destination.getString(), candidates);
+
+			for (route_list::const_iterator iter = candidates.begin(); iter != candidates.end(); ++iter)
+			{
+				const StaticRoute *route = (*iter);
+				if (route->match(destination)) ret.push_back(route);
+			}
+
+			return ret;
+		}
+
+		bool StaticRouteTable::match(const dtn::data::EID &destination, const dtn::data::EID &nexthop)
+		{
+			if (!hasNexthop(nexthop)) return false;
+
+			const route_list &routes = match(destination);
+
+			for (route_list::const_iterator iter = routes.begin(); iter != routes.end(); ++iter)
+			{
+				if ((*iter)->getDestination() == nexthop) return true;
+			}
+
+			return false;
+		}
+
+		bool StaticRouteTable::hasNexthop(const dtn::data::EID &nexthop) const
+		{
+			return (_nexthops.find(nexthop) != _nexthops.end());
+		}
+
+		size_t StaticRouteTable::size() const
+		{
+			return _routes.size();
+		}
+
+		void StaticRouteTable::erase(const std::list<StaticRoute*>::iterator &iter)
+		{
+			StaticRoute *route = (*iter);
+
+			// decrement the next-hop counter
+			nexthop_map::iterator nit = _nexthops.find(route->getDestination());
+			if (nit != _nexthops.end())
+			{
+				if ((--(*nit).second) == 0) _nexthops.erase(nit);
+			}
+
+			// remove the route from the indexes
+			dtn::data::EID host;
+			if (route->getHost(host))
+			{
+				route_map::iterator hit = _host_routes.find(host);
+				if (hit != _host_routes.end())
+				{
+					(*hit).second.remove(route);
+					if ((*hit).second.empty()) _host_routes.erase(hit);
+				}
+			}
+			else
+			{
+				_pattern_routes.remove(route->getPrefix(), route);
+			}
+
+			_routes.erase(iter);
+			delete route;
+
+			invalidate();
+		}
+
+		void StaticRouteTable::invalidate()
+		{
+			_cache.clear();
+		}
+
+		StaticRouteTable::PrefixTree::PrefixTree()
+		{
+		}
+
+		StaticRouteTable::PrefixTree::~PrefixTree()
+		{
+			clear();
+		}
+
+		void StaticRouteTable::PrefixTree::add(const std::string &prefix, const StaticRoute *route)
+		{
+			PrefixTree *node = this;
+
+			for (std::string::const_iterator it = prefix.begin(); it != prefix.end(); ++it)
+			{
+				PrefixTree *&child = node->_children[*it];
+				if (child == NULL) child = new PrefixTree();
+				node = child;
+			}
+
+			node->_routes.push_back(route);
+		}
+
+		void StaticRouteTable::PrefixTree::remove(const std::string &prefix, const StaticRoute *route)
+		{
+			if (prefix.empty())
+			{
+				_routes.remove(route);
+				return;
+			}
+
+			std::map<char, PrefixTree*>::iterator it = _children.find(prefix[0]);
+			if (it == _children.end()) return;
+
+			PrefixTree *child = (*it).second;
+			child->remove(prefix.substr(1), route);
+
+			// drop empty branches
+			if (child->_routes.empty() && child->_children.empty())
+			{
+				delete child;
+				_children.erase(it);
+			}
+		}
+
+		void StaticRouteTable::PrefixTree::clear()
+		{
+			for (std::map<char, PrefixTree*>::iterator it = _children.begin(); it != _children.end(); ++it)
+			{
+				delete (*it).second;
+			}
+
+			_children.clear();
+			_routes.clear();
+		}
+
+		void StaticRouteTable::PrefixTree::find(const std::string &str, route_list &routes) const
+		{
+			const PrefixTree *node = this;
+			std::string::const_iterator it = str.begin();
+
+			while (true)
+			{
+				routes.insert(routes.end(), node->_routes.begin(), node->_routes.end());
+
+				if (it == str.end()) break;
+
+				std::map<char, PrefixTree*>::const_iterator cit = node->_children.find(*it);
+				if (cit == node->_children.end()) break;
+
+				node = (*cit).second;
+				++it;
+			}
+		}
+	}
+}
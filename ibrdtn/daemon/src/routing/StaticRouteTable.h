@@ -0,0 +1,156 @@
+/*
+ * StaticRouteTable.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef STATICROUTETABLE_H_
+#define STATICROUTETABLE_H_
+
+#include "routing/StaticRoute.h"
+#include <ibrdtn/data/EID.h>
+#include <list>
+#include <map>
+
+namespace dtn
+{
+	namespace routing
+	{
+		/**
+		 * The static route table holds all static routes and answers the
+		 * question which routes match a given destination. Routes bound to a
+		 * single host are indexed by their node EID. All other routes (e.g.
+		 * regular expressions) are indexed by their literal prefix and only
+		 * evaluated if the destination starts with that prefix. Results are
+		 * cached per destination until the set of routes changes.
+		 *
+		 * This class is not thread-safe.
+		 */
+		class StaticRouteTable
+		{
+		public:
+			typedef std::list<const StaticRoute*> route_list;
+
+			/**
+			 * @param cache_limit Maximum number of destinations in the match cache
+			 */
+			StaticRouteTable(size_t cache_limit = 4096);
+			virtual ~StaticRouteTable();
+
+			/**
+			 * Add a route to the table. All routes equal to the new route
+			 * are replaced. The table takes the ownership of the route.
+			 */
+			void add(StaticRoute *route);
+
+			/**
+			 * Remove all routes equal to the given route
+			 */
+			void remove(const StaticRoute &route);
+
+			/**
+			 * Remove all routes
+			 */
+			void clear();
+
+			/**
+			 * Remove all routes expired before the given timestamp and raise
+			 * the expiration event for each of them.
+			 * @return The next expiration time of the remaining routes or zero
+			 */
+			dtn::data::Timestamp expire(const dtn::data::Timestamp &timestamp);
+
+			/**
+			 * Returns all routes matching the given destination. The returned
+			 * list is valid until the table is modified.
+			 */
+			const route_list& match(const dtn::data::EID &destination);
+
+			/**
+			 * Returns true if at least one route to the destination
+			 * uses the given next-hop
+			 */
+			bool match(const dtn::data::EID &destination, const dtn::data::EID &nexthop);
+
+			/**
+			 * Returns true if at least one route uses the given next-hop
+			 */
+			bool hasNexthop(const dtn::data::EID &nexthop) const;
+
+			/**
+			 * Returns the number of routes in the table
+			 */
+			size_t size() const;
+
+		private:
+			/**
+			 * Remove and delete the route at the given position
+			 */
+			void erase(const std::list<StaticRoute*>::iterator &iter);
+
+			/**
+			 * Drop all cached match results
+			 */
+			void invalidate();
+
+			typedef std::map<dtn::data::EID, route_list> route_map;
+			typedef std::map<dtn::data::EID, size_t> nexthop_map;
+
+			/**
+			 * Character tree of route prefixes
+			 */
+			class PrefixTree
+			{
+			public:
+				PrefixTree();
+				virtual ~PrefixTree();
+
+				void add(const std::string &prefix, const StaticRoute *route);
+				void remove(const std::string &prefix, const StaticRoute *route);
+				void clear();
+
+				/**
+				 * Append all routes with a prefix of the given string to the list
+				 */
+				void find(const std::string &str, route_list &routes) const;
+
+			private:
+				route_list _routes;
+				std::map<char, PrefixTree*> _children;
+			};
+
+			// all routes in order of insertion (owned by this table)
+			std::list<StaticRoute*> _routes;
+
+			// routes bound to a single host, indexed by the node EID
+			route_map _host_routes;
+
+			// routes which need to be evaluated using match()
+			PrefixTree _pattern_routes;
+
+			// number of routes per next-hop
+			nexthop_map _nexthops;
+
+			// cached results of match() per destination
+			route_map _cache;
+			const size_t _cache_limit;
+		};
+	}
+}
+
+#endif /* STATICROUTETABLE_H_ */
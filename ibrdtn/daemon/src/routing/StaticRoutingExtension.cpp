@@ -22,6 +22,7 @@
 #include "config.h"
 #include "Configuration.h"
 #include "routing/StaticRoutingExtension.h"
+#include "routing/StaticEIDRoute.h"
 #include "routing/QueueBundleEvent.h"
 
 #include "net/TransferAbortedEvent.h"
@@ -56,28 +57,14 @@ namespace dtn
 
 		StaticRoutingExtension::~StaticRoutingExtension()
 		{
-			join();
-
-			// delete all static routes
-			for (std::list<StaticRoute*>::iterator iter = _routes.begin();
-					iter != _routes.end(); ++iter)
-			{
-				StaticRoute *route = (*iter);
-				delete route;
-			}
-		}
-
-		void StaticRoutingExtension::__cancellation() throw ()
-		{
-			_taskqueue.abort();
 		}
 
-		void StaticRoutingExtension::run() throw ()
+		void StaticRoutingExtension::process(RoutingExecutor::Task &t) throw ()
 		{
 			class BundleFilter : public dtn::storage::BundleSelector
 			{
 			public:
-				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const std::list<const StaticRoute*> &routes)
+				BundleFilter(const NeighborDatabase::NeighborEntry &entry, StaticRouteTable &routes)
 				 : _entry(entry), _routes(routes)
 				{};
 
@@ -113,235 +100,172 @@ namespace dtn
 						return false;
 					}
 
-					// search for one rule that match
-					for (std::list<const StaticRoute*>::const_iterator iter = _routes.begin();
-							iter != _routes.end(); ++iter)
-					{
-						const StaticRoute &route = (**iter);
-
-						if (route.match(meta.destination))
-						{
-							return true;
-						}
-					}
-
-					return false;
+					// search for one rule that match and leads to this neighbor
+					return _routes.match(meta.destination, _entry.eid);
 				};
 
 			private:
 				const NeighborDatabase::NeighborEntry &_entry;
-				const std::list<const StaticRoute*> &_routes;
+				StaticRouteTable &_routes;
 			};
 
-			// announce static routes here
-			const std::multimap<std::string, std::string> &routes = dtn::daemon::Configuration::getInstance().getNetwork().getStaticRoutes();
-
-			for (std::multimap<std::string, std::string>::const_iterator iter = routes.begin(); iter != routes.end(); ++iter)
-			{
-				const dtn::data::EID nexthop((*iter).second);
-				dtn::routing::StaticRouteChangeEvent::raiseEvent(dtn::routing::StaticRouteChangeEvent::ROUTE_ADD, nexthop, (*iter).first);
-			}
-
 			dtn::storage::BundleResultList list;
 
-			while (true)
-			{
-				NeighborDatabase &db = (**this).getNeighborDB();
-				std::list<const StaticRoute*> routes;
-
-				try {
-					Task *t = _taskqueue.poll();
-					std::auto_ptr<Task> killer(t);
-
-					IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 5) << "processing task " << t->toString() << IBRCOMMON_LOGGER_ENDL;
+			NeighborDatabase &db = (**this).getNeighborDB();
 
-					try {
-						SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(*t);
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 5) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
 
-						// remove all routes of the previous round
-						routes.clear();
+				try {
+					SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
 
-						// look for routes to this node
-						for (std::list<StaticRoute*>::const_iterator iter = _routes.begin();
-								iter != _routes.end(); ++iter)
-						{
-							const StaticRoute *route = (*iter);
-							if (route->getDestination() == task.eid)
-							{
-								// add to the valid routes
-								routes.push_back(route);
-							}
-						}
+					// look for routes to this node
+					bool nexthop = false;
+					{
+						ibrcommon::MutexLock l(_routes_lock);
+						nexthop = _routes.hasNexthop(task.eid);
+					}
 
-						if (!routes.empty())
+					if (nexthop)
+					{
+						// lock the neighbor database while searching for bundles
 						{
-							// lock the neighbor database while searching for bundles
-							{
-								// this destination is not handles by any static route
-								ibrcommon::MutexLock l(db);
-								NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
+							// this destination is not handles by any static route
+							ibrcommon::MutexLock l(db);
+							ibrcommon::MutexLock rl(_routes_lock);
+							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
 
-								// check if enough transfer slots available (threshold reached)
-								if (!entry.isTransferThresholdReached())
-									throw NeighborDatabase::NoMoreTransfersAvailable();
+							// check if enough transfer slots available (threshold reached)
+							if (!entry.isTransferThresholdReached())
+								throw NeighborDatabase::NoMoreTransfersAvailable();
 
-								// get the bundle filter of the neighbor
-								BundleFilter filter(entry, routes);
+							// get the bundle filter of the neighbor
+							BundleFilter filter(entry, _routes);
 
-								// some debug
-								IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+							// some debug
+							IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
 
-								// query all bundles from the storage
-								list.clear();
-								(**this).getSeeker().get(filter, list);
-							}
-
-							// send the bundles as long as we have resources
-							for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-							{
-								try {
-									// transfer the bundle to the neighbor
-									transferTo(task.eid, *iter);
-								} catch (const NeighborDatabase::AlreadyInTransitException&) { };
-							}
+							// query all bundles from the storage
+							ibrcommon::Histogram::Timer timer(_search_latency);
+							list.clear();
+							(**this).getSeeker().get(filter, list);
 						}
-					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const dtn::storage::NoBundleFoundException &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					} catch (const std::bad_cast&) { };
-
-					try {
-						const ProcessBundleTask &task = dynamic_cast<ProcessBundleTask&>(*t);
-						IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 50) << "search static route for " << task.bundle.toString() << IBRCOMMON_LOGGER_ENDL;
-
-						// look for routes to this node
-						for (std::list<StaticRoute*>::const_iterator iter = _routes.begin();
-								iter != _routes.end(); ++iter)
+
+						// send the bundles as long as we have resources
+						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
 						{
-							const StaticRoute &route = (**iter);
-							IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 50) << "check static route: " << route.toString() << IBRCOMMON_LOGGER_ENDL;
 							try {
-								if (route.match(task.bundle.destination))
-								{
-									// transfer the bundle to the neighbor
-									transferTo(route.getDestination(), task.bundle);
-								}
-							} catch (const NeighborDatabase::NeighborNotAvailableException&) {
-								// neighbor is not available, can not forward this bundle
-							} catch (const NeighborDatabase::NoMoreTransfersAvailable&) {
+								// transfer the bundle to the neighbor
+								transferTo(task.eid, *iter);
 							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
 						}
-					} catch (const std::bad_cast&) { };
+					}
+				} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const dtn::storage::NoBundleFoundException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const std::bad_cast&) { };
 
-					try {
-						const RouteChangeTask &task = dynamic_cast<RouteChangeTask&>(*t);
+				try {
+					const ProcessBundleTask &task = dynamic_cast<ProcessBundleTask&>(t);
+					IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 50) << "search static route for " << task.bundle.toString() << IBRCOMMON_LOGGER_ENDL;
 
-						// delete all similar routes
-						for (std::list<StaticRoute*>::iterator iter = _routes.begin();
-								iter != _routes.end();)
+					// look for routes to this node, the table caches the result of match()
+					StaticRouteTable::route_list routes;
+					{
+						ibrcommon::MutexLock l(_routes_lock);
+						routes = _routes.match(task.bundle.destination);
+					}
+
+					for (StaticRouteTable::route_list::const_iterator iter = routes.begin();
+							iter != routes.end(); ++iter)
+					{
+						const StaticRoute &route = (**iter);
+						IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 50) << "matching static route: " << route.toString() << IBRCOMMON_LOGGER_ENDL;
+						try {
+							// transfer the bundle to the neighbor
+							transferTo(route.getDestination(), task.bundle);
+						} catch (const NeighborDatabase::NeighborNotAvailableException&) {
+							// neighbor is not available, can not forward this bundle
+						} catch (const NeighborDatabase::NoMoreTransfersAvailable&) {
+						} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+					}
+				} catch (const std::bad_cast&) { };
+
+				try {
+					const RouteChangeTask &task = dynamic_cast<RouteChangeTask&>(t);
+
+					if (task.type == RouteChangeTask::ROUTE_ADD)
+					{
+						// add the route and replace all similar routes
 						{
-							StaticRoute *route = (*iter);
-							if (route->equals(*task.route))
-							{
-								delete route;
-								_routes.erase(iter++);
-							}
-							else
-							{
-								++iter;
-							}
+							ibrcommon::MutexLock l(_routes_lock);
+							_routes.add(task.route);
 						}
+						execute( new SearchNextBundleTask(task.route->getDestination()) );
 
-						if (task.type == RouteChangeTask::ROUTE_ADD)
+						if (task.route->getExpiration() > 0)
 						{
-							_routes.push_back(task.route);
-							_taskqueue.push( new SearchNextBundleTask(task.route->getDestination()) );
-
-							if (task.route->getExpiration() > 0)
+							ibrcommon::MutexLock l(_expire_lock);
+							if (next_expire == 0 || next_expire > task.route->getExpiration())
 							{
-								ibrcommon::MutexLock l(_expire_lock);
-								if (next_expire == 0 || next_expire > task.route->getExpiration())
-								{
-									next_expire = task.route->getExpiration();
-								}
+								next_expire = task.route->getExpiration();
 							}
 						}
-						else
-						{
-							delete task.route;
-
-							// force a expiration process
-							ibrcommon::MutexLock l(_expire_lock);
-							next_expire = 1;
-						}
-					} catch (const bad_cast&) { };
-
-					try {
-						dynamic_cast<ClearRoutesTask&>(*t);
-
-						// delete all static routes
-						for (std::list<StaticRoute*>::iterator iter = _routes.begin();
-								iter != _routes.end(); ++iter)
+					}
+					else
+					{
+						// delete all similar routes
 						{
-							StaticRoute *route = (*iter);
-							delete route;
+							ibrcommon::MutexLock l(_routes_lock);
+							_routes.remove(*task.route);
 						}
-						_routes.clear();
+						delete task.route;
 
+						// force a expiration process
 						ibrcommon::MutexLock l(_expire_lock);
-						next_expire = 0;
-					} catch (const bad_cast&) { };
+						next_expire = 1;
+					}
+				} catch (const bad_cast&) { };
 
-					try {
-						const ExpireTask &task = dynamic_cast<ExpireTask&>(*t);
+				try {
+					dynamic_cast<ClearRoutesTask&>(t);
 
-						ibrcommon::MutexLock l(_expire_lock);
-						next_expire = 0;
+					// delete all static routes
+					{
+						ibrcommon::MutexLock l(_routes_lock);
+						_routes.clear();
+					}
 
-						// search for expired items
-						for (std::list<StaticRoute*>::iterator iter = _routes.begin();
-								iter != _routes.end();)
-						{
-							StaticRoute *route = (*iter);
+					ibrcommon::MutexLock l(_expire_lock);
+					next_expire = 0;
+				} catch (const bad_cast&) { };
 
-							if ((route->getExpiration() > 0) && (route->getExpiration() < task.timestamp))
-							{
-								route->raiseExpired();
-								delete route;
-								_routes.erase(iter++);
-							}
-							else
-							{
-								if ((next_expire == 0) || (next_expire > route->getExpiration()))
-								{
-									next_expire = route->getExpiration();
-								}
+				try {
+					const ExpireTask &task = dynamic_cast<ExpireTask&>(t);
 
-								++iter;
-							}
-						}
-					} catch (const bad_cast&) { };
+					ibrcommon::MutexLock l(_expire_lock);
 
-				} catch (const std::exception &ex) {
-					IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 15) << "terminated due to " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					return;
-				}
+					// remove expired items
+					ibrcommon::MutexLock rl(_routes_lock);
+					next_expire = _routes.expire(task.timestamp);
+				} catch (const bad_cast&) { };
 
-				yield();
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(StaticRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
 		}
 
 		void StaticRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
 		{
-			_taskqueue.push( new SearchNextBundleTask(peer) );
+			execute( new SearchNextBundleTask(peer) );
 		}
 
 		void StaticRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
 		{
-			_taskqueue.push( new ProcessBundleTask(meta, peer) );
+			execute( new ProcessBundleTask(meta, peer) );
 		}
 
 		void StaticRoutingExtension::raiseEvent(const dtn::core::TimeEvent&) throw ()
@@ -352,7 +276,7 @@ namespace dtn
 			ibrcommon::MutexLock l(_expire_lock);
 			if ((next_expire != 0) && (next_expire < monotonic))
 			{
-				_taskqueue.push( new ExpireTask( monotonic ) );
+				execute( new ExpireTask( monotonic ) );
 			}
 		}
 
@@ -361,7 +285,7 @@ namespace dtn
 			// on route change, generate a task
 			if (route.type == dtn::routing::StaticRouteChangeEvent::ROUTE_CLEAR)
 			{
-				_taskqueue.push( new ClearRoutesTask() );
+				execute( new ClearRoutesTask() );
 				return;
 			}
 
@@ -373,23 +297,23 @@ namespace dtn
 				r = new StaticRegexRoute(route.pattern, route.nexthop);
 #else
 				dtn::data::Timestamp et = dtn::utils::Clock::getMonotonicTimestamp() + route.timeout;
-				r = new EIDRoute(route.pattern, route.nexthop, et);
+				r = new StaticEIDRoute(route.pattern, route.nexthop, et);
 #endif
 			}
 			else
 			{
 				dtn::data::Timestamp et = dtn::utils::Clock::getMonotonicTimestamp() + route.timeout;
-				r = new EIDRoute(route.destination, route.nexthop, et);
+				r = new StaticEIDRoute(route.destination, route.nexthop, et);
 			}
 
 			switch (route.type)
 			{
 			case dtn::routing::StaticRouteChangeEvent::ROUTE_ADD:
-				_taskqueue.push( new RouteChangeTask( RouteChangeTask::ROUTE_ADD, r ) );
+				execute( new RouteChangeTask( RouteChangeTask::ROUTE_ADD, r ) );
 				break;
 
 			case dtn::routing::StaticRouteChangeEvent::ROUTE_DEL:
-				_taskqueue.push( new RouteChangeTask( RouteChangeTask::ROUTE_DEL, r ) );
+				execute( new RouteChangeTask( RouteChangeTask::ROUTE_DEL, r ) );
 				break;
 
 			default:
@@ -402,15 +326,13 @@ namespace dtn
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::add(this);
 			dtn::core::EventDispatcher<dtn::routing::StaticRouteChangeEvent>::add(this);
 
-			// reset the task queue
-			_taskqueue.reset();
+			// announce static routes here
+			const std::multimap<std::string, std::string> &routes = dtn::daemon::Configuration::getInstance().getNetwork().getStaticRoutes();
 
-			// routine checked for throw() on 15.02.2013
-			try {
-				// run the thread
-				start();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(StaticRoutingExtension::TAG, error) << "componentUp failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			for (std::multimap<std::string, std::string>::const_iterator iter = routes.begin(); iter != routes.end(); ++iter)
+			{
+				const dtn::data::EID nexthop((*iter).second);
+				dtn::routing::StaticRouteChangeEvent::raiseEvent(dtn::routing::StaticRouteChangeEvent::ROUTE_ADD, nexthop, (*iter).first);
 			}
 		}
 
@@ -418,76 +340,20 @@ namespace dtn
 		{
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::remove(this);
 			dtn::core::EventDispatcher<dtn::routing::StaticRouteChangeEvent>::remove(this);
-
-			// routine checked for throw() on 15.02.2013
-			try {
-				// stop the thread
-				stop();
-				join();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(StaticRoutingExtension::TAG, error) << "componentDown failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
 		}
 
-		StaticRoutingExtension::EIDRoute::EIDRoute(const dtn::data::EID &match, const dtn::data::EID &nexthop, const dtn::data::Timestamp &et)
-		 : _nexthop(nexthop), _match(match), expiretime(et)
-		{
-		}
-
-		StaticRoutingExtension::EIDRoute::~EIDRoute()
-		{
-		}
-
-		bool StaticRoutingExtension::EIDRoute::match(const dtn::data::EID &eid) const
-		{
-			return _match.sameHost(eid);
-		}
-
-		const dtn::data::EID& StaticRoutingExtension::EIDRoute::getDestination() const
-		{
-			return _nexthop;
-		}
-
-		/**
-		 * Describe this route as a one-line-string.
-		 * @return
-		 */
-		const std::string StaticRoutingExtension::EIDRoute::toString() const
-		{
-			std::stringstream ss;
-			ss << _match.getString() << " => " << _nexthop.getString();
-			return ss.str();
-		}
-
-		const dtn::data::Timestamp& StaticRoutingExtension::EIDRoute::getExpiration() const
-		{
-			return expiretime;
-		}
-
-		void StaticRoutingExtension::EIDRoute::raiseExpired() const
-		{
-			dtn::routing::StaticRouteChangeEvent::raiseEvent(dtn::routing::StaticRouteChangeEvent::ROUTE_EXPIRED, _nexthop, _match);
-		}
-
-		bool StaticRoutingExtension::EIDRoute::equals(const StaticRoute &route) const
-		{
-			try {
-				const StaticRoutingExtension::EIDRoute &r = dynamic_cast<const StaticRoutingExtension::EIDRoute&>(route);
-				return (_nexthop == r._nexthop) && (_match == r._match);
-			} catch (const std::bad_cast&) {
-				return false;
-			}
-		}
-
-		/****************************************/
-
 		StaticRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &e)
-		 : eid(e)
+		 : RoutingExecutor::Task(e), eid(e)
 		{ }
 
 		StaticRoutingExtension::SearchNextBundleTask::~SearchNextBundleTask()
 		{ }
 
+		bool StaticRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
 		std::string StaticRoutingExtension::SearchNextBundleTask::toString()
 		{
 			return "SearchNextBundleTask: " + eid.getString();
@@ -496,7 +362,7 @@ namespace dtn
 		/****************************************/
 
 		StaticRoutingExtension::ProcessBundleTask::ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &o)
-		 : bundle(meta), origin(o)
+		 : RoutingExecutor::Task(o), bundle(meta), origin(o)
 		{ }
 
 		StaticRoutingExtension::ProcessBundleTask::~ProcessBundleTask()
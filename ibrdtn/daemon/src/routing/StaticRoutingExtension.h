@@ -23,19 +23,19 @@
 #define STATICROUTINGEXTENSION_H_
 
 #include "routing/StaticRoute.h"
+#include "routing/StaticRouteTable.h"
 #include "routing/RoutingExtension.h"
 #include "routing/StaticRouteChangeEvent.h"
 #include "core/TimeEvent.h"
 #include "core/EventReceiver.h"
 #include <ibrdtn/data/MetaBundle.h>
-#include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/Mutex.h>
 
 namespace dtn
 {
 	namespace routing
 	{
-		class StaticRoutingExtension : public RoutingExtension, public ibrcommon::JoinableThread,
+		class StaticRoutingExtension : public RoutingExtension,
 			public dtn::core::EventReceiver<dtn::core::TimeEvent>,
 			public dtn::core::EventReceiver<dtn::routing::StaticRouteChangeEvent>
 		{
@@ -62,62 +62,22 @@ namespace dtn
 			void componentDown() throw ();
 
 		protected:
-			void run() throw ();
-			void __cancellation() throw ();
+			void process(RoutingExecutor::Task &task) throw ();
 
 		private:
-			class EIDRoute : public StaticRoute
-			{
-			public:
-				EIDRoute(const dtn::data::EID &match, const dtn::data::EID &nexthop, const dtn::data::Timestamp &expiretime = 0);
-				virtual ~EIDRoute();
-
-				bool match(const dtn::data::EID &eid) const;
-				const dtn::data::EID& getDestination() const;
-
-				/**
-				 * Describe this route as a one-line-string.
-				 * @return
-				 */
-				const std::string toString() const;
-
-				const dtn::data::Timestamp& getExpiration() const;
-
-				/**
-				 * Raise the StaticRouteChangeEvent for expiration
-				 */
-				void raiseExpired() const;
-
-				/**
-				 * Compare this static route with another one
-				 */
-				bool equals(const StaticRoute &route) const;
-
-			private:
-				const dtn::data::EID _nexthop;
-				const dtn::data::EID _match;
-				const dtn::data::Timestamp expiretime;
-			};
-
-			class Task
-			{
-			public:
-				virtual ~Task() {};
-				virtual std::string toString() = 0;
-			};
-
-			class SearchNextBundleTask : public Task
+			class SearchNextBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				SearchNextBundleTask(const dtn::data::EID &eid);
 				virtual ~SearchNextBundleTask();
 
 				virtual std::string toString();
+				virtual bool isCoalescable() const;
 
 				const dtn::data::EID eid;
 			};
 
-			class ProcessBundleTask : public Task
+			class ProcessBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &origin);
@@ -129,7 +89,7 @@ namespace dtn
 				const dtn::data::EID origin;
 			};
 
-			class ClearRoutesTask : public Task
+			class ClearRoutesTask : public RoutingExecutor::Task
 			{
 			public:
 				ClearRoutesTask();
@@ -137,7 +97,7 @@ namespace dtn
 				virtual std::string toString();
 			};
 
-			class RouteChangeTask : public Task
+			class RouteChangeTask : public RoutingExecutor::Task
 			{
 			public:
 				enum CHANGE_TYPE
@@ -155,7 +115,7 @@ namespace dtn
 				StaticRoute *route;
 			};
 
-			class ExpireTask : public Task
+			class ExpireTask : public RoutingExecutor::Task
 			{
 			public:
 				ExpireTask(dtn::data::Timestamp timestamp);
@@ -167,14 +127,16 @@ namespace dtn
 			};
 
 			/**
-			 * hold queued tasks for later processing
+			 * table of static routes
 			 */
-			ibrcommon::Queue<StaticRoutingExtension::Task* > _taskqueue;
+			StaticRouteTable _routes;
 
 			/**
-			 * static list of routes
+			 * the route table caches the results of a match, thus tasks
+			 * of different peers have to lock it while reading
 			 */
-			std::list<StaticRoute*> _routes;
+			ibrcommon::Mutex _routes_lock;
+
 			ibrcommon::Mutex _expire_lock;
 			dtn::data::Timestamp next_expire;
 		};
@@ -0,0 +1,314 @@
+/*
+ * ContactGraph.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/contactgraph/ContactGraph.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace dtn
+{
+	namespace routing
+	{
+		ContactGraph::Route::Route()
+		 : departure(0), arrival(0), expires(0), hops(0)
+		{
+		}
+
+		ContactGraph::Route::~Route()
+		{
+		}
+
+		ContactGraph::RouteTable::RouteTable()
+		 : _time(0), _expires(0)
+		{
+		}
+
+		ContactGraph::RouteTable::~RouteTable()
+		{
+		}
+
+		const ContactGraph::Route* ContactGraph::RouteTable::find(const dtn::data::EID &destination) const
+		{
+			route_map::const_iterator it = _routes.find(destination);
+			if (it == _routes.end()) return NULL;
+			return &(it->second);
+		}
+
+		const std::set<dtn::data::EID>& ContactGraph::RouteTable::getNexthops() const
+		{
+			return _nexthops;
+		}
+
+		const dtn::data::Timestamp& ContactGraph::RouteTable::getTime() const
+		{
+			return _time;
+		}
+
+		const dtn::data::Timestamp& ContactGraph::RouteTable::getExpiration() const
+		{
+			return _expires;
+		}
+
+		size_t ContactGraph::RouteTable::size() const
+		{
+			return _routes.size();
+		}
+
+		void ContactGraph::RouteTable::clear()
+		{
+			_routes.clear();
+			_nexthops.clear();
+			_time = 0;
+			_expires = 0;
+		}
+
+		bool ContactGraph::Window::operator<(const Window &other) const
+		{
+			if (start != other.start) return (start < other.start);
+			return (end < other.end);
+		}
+
+		bool ContactGraph::Window::starts_after(const dtn::data::Timestamp &time, const Window &window)
+		{
+			return (time < window.start);
+		}
+
+		ContactGraph::Edge::Edge(const size_t t, const dtn::data::Timestamp &d)
+		 : to(t), delay(d)
+		{
+		}
+
+		bool ContactGraph::Edge::depart(const dtn::data::Timestamp &time, dtn::data::Timestamp &departure, const Window* &window) const
+		{
+			// first window starting after the given time
+			std::vector<Window>::const_iterator next = std::upper_bound(windows.begin(), windows.end(), time, Window::starts_after);
+
+			// one of the windows started before is still open
+			if (next != windows.begin())
+			{
+				const Window &prev = *(next - 1);
+				if (prev.reach >= time)
+				{
+					departure = time;
+					window = &windows[prev.reach_index];
+					return true;
+				}
+			}
+
+			if (next == windows.end()) return false;
+
+			// wait for the next window
+			departure = (*next).start;
+			window = &(*next);
+			return true;
+		}
+
+		ContactGraph::ContactGraph()
+		 : _contacts(0)
+		{
+		}
+
+		ContactGraph::~ContactGraph()
+		{
+		}
+
+		void ContactGraph::build(const ContactPlan &plan)
+		{
+			_nodes.clear();
+			_index.clear();
+			_edges.clear();
+			_contacts = 0;
+
+			// index of the edge between two nodes with a specific delay
+			typedef std::pair<std::pair<size_t, size_t>, dtn::data::Timestamp> edge_key;
+			std::map<edge_key, size_t> edges;
+
+			const ContactPlan::contact_list &contacts = plan.getContacts();
+			for (ContactPlan::contact_list::const_iterator it = contacts.begin(); it != contacts.end(); ++it)
+			{
+				const Contact &c = (*it);
+				size_t index[2];
+				const dtn::data::EID *eids[2] = { &c.from, &c.to };
+
+				for (int i = 0; i < 2; ++i)
+				{
+					std::map<dtn::data::EID, size_t>::const_iterator nit = _index.find(*eids[i]);
+					if (nit == _index.end())
+					{
+						index[i] = _nodes.size();
+						_index[*eids[i]] = index[i];
+						_nodes.push_back(*eids[i]);
+						_edges.push_back(edge_list());
+					}
+					else
+					{
+						index[i] = nit->second;
+					}
+				}
+
+				// windows with different delays can not share an edge, because
+				// the earliest departure would not be the earliest arrival
+				const edge_key key(std::make_pair(index[0], index[1]), c.delay);
+				std::map<edge_key, size_t>::const_iterator eit = edges.find(key);
+
+				edge_list &out = _edges[index[0]];
+				if (eit == edges.end())
+				{
+					edges[key] = out.size();
+					out.push_back(Edge(index[1], c.delay));
+					eit = edges.find(key);
+				}
+
+				Window w;
+				w.start = c.start;
+				w.end = c.end;
+				w.reach_index = 0;
+
+				out[eit->second].windows.push_back(w);
+				_contacts++;
+			}
+
+			// sort the windows of each edge and compute the largest end reached so far
+			for (std::vector<edge_list>::iterator nit = _edges.begin(); nit != _edges.end(); ++nit)
+			{
+				for (edge_list::iterator eit = (*nit).begin(); eit != (*nit).end(); ++eit)
+				{
+					std::vector<Window> &windows = (*eit).windows;
+					std::sort(windows.begin(), windows.end());
+
+					for (size_t i = 0; i < windows.size(); ++i)
+					{
+						if ((i > 0) && (windows[i - 1].reach > windows[i].end))
+						{
+							windows[i].reach = windows[i - 1].reach;
+							windows[i].reach_index = windows[i - 1].reach_index;
+						}
+						else
+						{
+							windows[i].reach = windows[i].end;
+							windows[i].reach_index = i;
+						}
+					}
+				}
+			}
+		}
+
+		void ContactGraph::compute(const dtn::data::EID &source, const dtn::data::Timestamp &now, RouteTable &table) const
+		{
+			table.clear();
+			table._time = now;
+			table._expires = dtn::data::Timestamp::max();
+
+			std::map<dtn::data::EID, size_t>::const_iterator sit = _index.find(source);
+			if (sit == _index.end()) return;
+
+			const size_t src = sit->second;
+			const size_t n = _nodes.size();
+
+			// labels of each node, the first hop is n as long as a node is not reached
+			std::vector<dtn::data::Timestamp> arrival(n, dtn::data::Timestamp::max());
+			std::vector<dtn::data::Timestamp> departure(n, 0);
+			std::vector<dtn::data::Timestamp> expires(n, 0);
+			std::vector<dtn::data::Timestamp> closes(n, 0);
+			std::vector<size_t> first(n, n);
+			std::vector<size_t> hops(n, 0);
+			std::vector<bool> done(n, false);
+
+			typedef std::pair<dtn::data::Timestamp, size_t> entry;
+			std::priority_queue<entry, std::vector<entry>, std::greater<entry> > heap;
+
+			arrival[src] = now;
+			heap.push(entry(now, src));
+
+			while (!heap.empty())
+			{
+				const size_t u = heap.top().second;
+				heap.pop();
+
+				// skip outdated entries
+				if (done[u]) continue;
+				done[u] = true;
+
+				const edge_list &out = _edges[u];
+				for (edge_list::const_iterator eit = out.begin(); eit != out.end(); ++eit)
+				{
+					const Edge &e = (*eit);
+					if (done[e.to]) continue;
+
+					dtn::data::Timestamp dep;
+					const Window *w = NULL;
+					if (!e.depart(arrival[u], dep, w)) continue;
+
+					const dtn::data::Timestamp t = dep + e.delay;
+					if (!(t < arrival[e.to])) continue;
+
+					arrival[e.to] = t;
+					closes[e.to] = w->end;
+					hops[e.to] = hops[u] + 1;
+
+					if (u == src)
+					{
+						first[e.to] = e.to;
+						departure[e.to] = dep;
+						expires[e.to] = w->end;
+					}
+					else
+					{
+						first[e.to] = first[u];
+						departure[e.to] = departure[u];
+						expires[e.to] = expires[u];
+					}
+
+					heap.push(entry(t, e.to));
+				}
+			}
+
+			for (size_t v = 0; v < n; ++v)
+			{
+				if ((v == src) || (first[v] == n)) continue;
+
+				Route r;
+				r.nexthop = _nodes[first[v]];
+				r.departure = departure[v];
+				r.arrival = arrival[v];
+				r.expires = expires[v];
+				r.hops = hops[v];
+
+				table._routes.insert(std::make_pair(_nodes[v], r));
+				table._nexthops.insert(r.nexthop);
+
+				// the table expires if any contact of the routes is over
+				if (closes[v] < table._expires) table._expires = closes[v];
+			}
+		}
+
+		size_t ContactGraph::getNodes() const
+		{
+			return _nodes.size();
+		}
+
+		size_t ContactGraph::getContacts() const
+		{
+			return _contacts;
+		}
+	} /* namespace routing */
+} /* namespace dtn */
@@ -0,0 +1,187 @@
+/*
+ * ContactGraph.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef CONTACTGRAPH_H_
+#define CONTACTGRAPH_H_
+
+#include "routing/contactgraph/ContactPlan.h"
+#include <ibrdtn/data/EID.h>
+#include <ibrdtn/data/Number.h>
+#include <vector>
+#include <map>
+#include <set>
+
+namespace dtn
+{
+	namespace routing
+	{
+		/**
+		 * The contact plan compiled into a time-expanded graph. All contacts
+		 * between two nodes with the same delay are merged into one edge with
+		 * a sorted list of time windows, thus the earliest departure over an
+		 * edge is found with a binary search and is also the earliest arrival.
+		 * Contacts with different delays end up in parallel edges. Earliest-arrival routes to all nodes are
+		 * computed with a single run of Dijkstra's algorithm.
+		 */
+		class ContactGraph
+		{
+		public:
+			/**
+			 * The earliest-arrival route to one destination
+			 */
+			class Route
+			{
+			public:
+				Route();
+				virtual ~Route();
+
+				// the first hop on the route
+				dtn::data::EID nexthop;
+
+				// the time the bundle leaves this node
+				dtn::data::Timestamp departure;
+
+				// the time the bundle arrives at the destination
+				dtn::data::Timestamp arrival;
+
+				// the end of the contact to the first hop
+				dtn::data::Timestamp expires;
+
+				size_t hops;
+			};
+
+			/**
+			 * Routes to all reachable destinations computed at one point in time
+			 */
+			class RouteTable
+			{
+			public:
+				typedef std::map<dtn::data::EID, Route> route_map;
+
+				RouteTable();
+				virtual ~RouteTable();
+
+				/**
+				 * Returns the route to a destination node or NULL if
+				 * the destination is not reachable
+				 */
+				const Route* find(const dtn::data::EID &destination) const;
+
+				/**
+				 * Returns all nodes used as first hop
+				 */
+				const std::set<dtn::data::EID>& getNexthops() const;
+
+				/**
+				 * Returns the time the table has been computed at
+				 */
+				const dtn::data::Timestamp& getTime() const;
+
+				/**
+				 * Returns the time at which a contact used by any of the
+				 * routes is over and the table has to be computed again
+				 */
+				const dtn::data::Timestamp& getExpiration() const;
+
+				size_t size() const;
+				void clear();
+
+			private:
+				friend class ContactGraph;
+
+				route_map _routes;
+				std::set<dtn::data::EID> _nexthops;
+				dtn::data::Timestamp _time;
+				dtn::data::Timestamp _expires;
+			};
+
+			ContactGraph();
+			virtual ~ContactGraph();
+
+			/**
+			 * Replace the graph with the contacts of a contact plan
+			 */
+			void build(const ContactPlan &plan);
+
+			/**
+			 * Compute the earliest-arrival routes from the source to all
+			 * other nodes for a bundle ready to leave at the given time
+			 */
+			void compute(const dtn::data::EID &source, const dtn::data::Timestamp &now, RouteTable &table) const;
+
+			/**
+			 * Returns the number of nodes in the graph
+			 */
+			size_t getNodes() const;
+
+			/**
+			 * Returns the number of contacts in the graph
+			 */
+			size_t getContacts() const;
+
+		private:
+			class Window
+			{
+			public:
+				dtn::data::Timestamp start;
+				dtn::data::Timestamp end;
+
+				// largest end of this and all earlier windows and its index
+				dtn::data::Timestamp reach;
+				size_t reach_index;
+
+				bool operator<(const Window &other) const;
+
+				/**
+				 * Returns true, if the window starts after the given time
+				 */
+				static bool starts_after(const dtn::data::Timestamp &time, const Window &window);
+			};
+
+			class Edge
+			{
+			public:
+				Edge(const size_t to, const dtn::data::Timestamp &delay);
+
+				/**
+				 * Find the earliest departure over this edge at or after the given time
+				 * @return False, if there is no window left
+				 */
+				bool depart(const dtn::data::Timestamp &time, dtn::data::Timestamp &departure, const Window* &window) const;
+
+				size_t to;
+
+				// the delay shared by all windows of this edge
+				dtn::data::Timestamp delay;
+
+				std::vector<Window> windows;
+			};
+
+			typedef std::vector<Edge> edge_list;
+
+			std::vector<dtn::data::EID> _nodes;
+			std::map<dtn::data::EID, size_t> _index;
+			std::vector<edge_list> _edges;
+			size_t _contacts;
+		};
+	} /* namespace routing */
+} /* namespace dtn */
+#endif /* CONTACTGRAPH_H_ */
@@ -0,0 +1,312 @@
+/*
+ * ContactGraphRoutingExtension.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/contactgraph/ContactGraphRoutingExtension.h"
+#include "routing/BaseRouter.h"
+#include "core/BundleCore.h"
+#include "core/EventDispatcher.h"
+
+#include <ibrdtn/utils/Clock.h>
+
+#include <ibrcommon/Logger.h>
+#include <ibrcommon/thread/MutexLock.h>
+
+#include <typeinfo>
+#include <memory>
+
+namespace dtn
+{
+	namespace routing
+	{
+		const std::string ContactGraphRoutingExtension::TAG = "ContactGraphRoutingExtension";
+
+		ContactGraphRoutingExtension::ContactGraphRoutingExtension(const ibrcommon::File &plan)
+		 : _plan(plan), _expires(0),
+		   _compute_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_contactgraph_compute_seconds", "Time spent to compute the routes of the contact graph", "", 0.000001)),
+		   _routes(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_contactgraph_routes", "Destinations reachable through the contact graph"))
+		{
+		}
+
+		ContactGraphRoutingExtension::~ContactGraphRoutingExtension()
+		{
+		}
+
+		void ContactGraphRoutingExtension::load()
+		{
+			ContactPlan plan;
+
+			try {
+				plan.load(_plan, dtn::utils::Clock::getTime());
+			} catch (const ContactPlan::ParseException &ex) {
+				// keep the current graph instead of installing a partial plan
+				IBRCOMMON_LOGGER_TAG(ContactGraphRoutingExtension::TAG, error) << "failed to load contact plan: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				return;
+			}
+
+			_graph.build(plan);
+
+			IBRCOMMON_LOGGER_TAG(ContactGraphRoutingExtension::TAG, info) << "contact plan with " << _graph.getContacts() << " contacts between " << _graph.getNodes() << " nodes loaded" << IBRCOMMON_LOGGER_ENDL;
+		}
+
+		void ContactGraphRoutingExtension::update(const dtn::data::Timestamp &timestamp)
+		{
+			{
+				ibrcommon::Histogram::Timer timer(_compute_latency);
+				_graph.compute(dtn::core::BundleCore::local, timestamp, _table);
+			}
+
+			_routes.set(static_cast<int64_t>(_table.size()));
+
+			{
+				ibrcommon::MutexLock l(_expire_lock);
+				_expires = _table.getExpiration();
+			}
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(ContactGraphRoutingExtension::TAG, 10) << "routes to " << _table.size() << " destinations computed, next update at " << _table.getExpiration().toString() << IBRCOMMON_LOGGER_ENDL;
+
+			// routes may have moved to other neighbors
+			const std::set<dtn::data::EID> &nexthops = _table.getNexthops();
+			for (std::set<dtn::data::EID>::const_iterator iter = nexthops.begin(); iter != nexthops.end(); ++iter)
+			{
+				execute( new SearchNextBundleTask(*iter) );
+			}
+		}
+
+		void ContactGraphRoutingExtension::process(RoutingExecutor::Task &t) throw ()
+		{
+			class BundleFilter : public dtn::storage::BundleSelector
+			{
+			public:
+				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const ContactGraph::RouteTable &table)
+				 : _entry(entry), _table(table)
+				{};
+
+				virtual ~BundleFilter() {};
+
+				virtual dtn::data::Size limit() const throw () { return _entry.getFreeTransferSlots(); };
+
+				virtual bool shouldAdd(const dtn::data::MetaBundle &meta) const throw (dtn::storage::BundleSelectorException)
+				{
+					// check Scope Control Block - do not forward bundles with hop limit == 0
+					if (meta.hopcount == 0)
+					{
+						return false;
+					}
+
+					// do not forward local bundles
+					if ((meta.destination.getNode() == dtn::core::BundleCore::local)
+							&& meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON)
+						)
+					{
+						return false;
+					}
+
+					// check Scope Control Block - do not forward non-group bundles with hop limit <= 1
+					if ((meta.hopcount <= 1) && (meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON)))
+					{
+						return false;
+					}
+
+					// do not forward bundles already known by the destination
+					if (_entry.has(meta))
+					{
+						return false;
+					}
+
+					// the route has to lead to this neighbor
+					const ContactGraph::Route *route = _table.find(meta.destination.getNode());
+					if ((route == NULL) || (route->nexthop != _entry.eid))
+					{
+						return false;
+					}
+
+					// do not forward bundles expiring before their arrival
+					return (route->arrival <= meta.expiretime);
+				};
+
+			private:
+				const NeighborDatabase::NeighborEntry &_entry;
+				const ContactGraph::RouteTable &_table;
+			};
+
+			dtn::storage::BundleResultList list;
+
+			NeighborDatabase &db = (**this).getNeighborDB();
+
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(ContactGraphRoutingExtension::TAG, 5) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
+
+				try {
+					SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
+
+					// look for routes leading to this node
+					if (_table.getNexthops().find(task.eid) != _table.getNexthops().end())
+					{
+						// lock the neighbor database while searching for bundles
+						{
+							ibrcommon::MutexLock l(db);
+							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
+
+							// check if enough transfer slots available (threshold reached)
+							if (!entry.isTransferThresholdReached())
+								throw NeighborDatabase::NoMoreTransfersAvailable();
+
+							// get the bundle filter of the neighbor
+							BundleFilter filter(entry, _table);
+
+							// some debug
+							IBRCOMMON_LOGGER_DEBUG_TAG(ContactGraphRoutingExtension::TAG, 40) << "search some bundles routed over " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+
+							// query all bundles from the storage
+							ibrcommon::Histogram::Timer timer(_search_latency);
+							list.clear();
+							(**this).getSeeker().get(filter, list);
+						}
+
+						// send the bundles as long as we have resources
+						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+						{
+							try {
+								// transfer the bundle to the neighbor
+								transferTo(task.eid, *iter);
+							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+						}
+					}
+				} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const dtn::storage::NoBundleFoundException &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				} catch (const std::bad_cast&) { };
+
+				try {
+					const ProcessBundleTask &task = dynamic_cast<ProcessBundleTask&>(t);
+
+					const ContactGraph::Route *route = _table.find(task.bundle.destination.getNode());
+
+					// local bundles are not in the table, the own node has no route
+					if ((route != NULL) && (route->arrival <= task.bundle.expiretime))
+					{
+						IBRCOMMON_LOGGER_DEBUG_TAG(ContactGraphRoutingExtension::TAG, 50) << "route for " << task.bundle.toString() << " over " << route->nexthop.getString() << IBRCOMMON_LOGGER_ENDL;
+
+						try {
+							// transfer the bundle to the next hop, if it is a neighbor right now
+							transferTo(route->nexthop, task.bundle);
+						} catch (const NeighborDatabase::NeighborNotAvailableException&) {
+							// wait for the contact to the next hop
+						} catch (const NeighborDatabase::NoMoreTransfersAvailable&) {
+						} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+					}
+				} catch (const std::bad_cast&) { };
+
+				try {
+					const UpdateTask &task = dynamic_cast<UpdateTask&>(t);
+					update(task.timestamp);
+				} catch (const std::bad_cast&) { };
+
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(ContactGraphRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+		}
+
+		void ContactGraphRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
+		{
+			execute( new SearchNextBundleTask(peer) );
+		}
+
+		void ContactGraphRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
+		{
+			execute( new ProcessBundleTask(meta, peer) );
+		}
+
+		void ContactGraphRoutingExtension::raiseEvent(const dtn::core::TimeEvent &time) throw ()
+		{
+			ibrcommon::MutexLock l(_expire_lock);
+
+			// compute the routes again once a contact used by them is over
+			if ((_expires != 0) && (_expires < time.getTimestamp()))
+			{
+				_expires = 0;
+				execute( new UpdateTask( time.getTimestamp() ) );
+			}
+		}
+
+		void ContactGraphRoutingExtension::componentUp() throw ()
+		{
+			dtn::core::EventDispatcher<dtn::core::TimeEvent>::add(this);
+
+			// compile the contact plan and compute the initial routes
+			load();
+			execute( new UpdateTask( dtn::utils::Clock::getTime() ) );
+		}
+
+		void ContactGraphRoutingExtension::componentDown() throw ()
+		{
+			dtn::core::EventDispatcher<dtn::core::TimeEvent>::remove(this);
+		}
+
+		ContactGraphRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &e)
+		 : RoutingExecutor::Task(e), eid(e)
+		{ }
+
+		ContactGraphRoutingExtension::SearchNextBundleTask::~SearchNextBundleTask()
+		{ }
+
+		bool ContactGraphRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
+		std::string ContactGraphRoutingExtension::SearchNextBundleTask::toString()
+		{
+			return "SearchNextBundleTask: " + eid.getString();
+		}
+
+		/****************************************/
+
+		ContactGraphRoutingExtension::ProcessBundleTask::ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &o)
+		 : RoutingExecutor::Task(o), bundle(meta), origin(o)
+		{ }
+
+		ContactGraphRoutingExtension::ProcessBundleTask::~ProcessBundleTask()
+		{ }
+
+		std::string ContactGraphRoutingExtension::ProcessBundleTask::toString()
+		{
+			return "ProcessBundleTask: " + bundle.toString();
+		}
+
+		/****************************************/
+
+		ContactGraphRoutingExtension::UpdateTask::UpdateTask(const dtn::data::Timestamp &t)
+		 : timestamp(t)
+		{ }
+
+		ContactGraphRoutingExtension::UpdateTask::~UpdateTask()
+		{ }
+
+		std::string ContactGraphRoutingExtension::UpdateTask::toString()
+		{
+			return "UpdateTask: " + timestamp.toString();
+		}
+	} /* namespace routing */
+} /* namespace dtn */
@@ -0,0 +1,136 @@
+/*
+ * ContactGraphRoutingExtension.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef CONTACTGRAPHROUTINGEXTENSION_H_
+#define CONTACTGRAPHROUTINGEXTENSION_H_
+
+#include "routing/RoutingExtension.h"
+#include "routing/contactgraph/ContactPlan.h"
+#include "routing/contactgraph/ContactGraph.h"
+#include "core/TimeEvent.h"
+#include "core/EventReceiver.h"
+#include <ibrdtn/data/MetaBundle.h>
+#include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/Metrics.h>
+
+namespace dtn
+{
+	namespace routing
+	{
+		/**
+		 * Forwards bundles along scheduled contacts. The contact plan is
+		 * compiled into a contact graph and the earliest-arrival routes to
+		 * all destinations are computed in advance. The route table is only
+		 * computed again if a contact used by one of the routes is over,
+		 * thus each bundle costs a single lookup in the route table.
+		 */
+		class ContactGraphRoutingExtension : public RoutingExtension,
+			public dtn::core::EventReceiver<dtn::core::TimeEvent>
+		{
+			static const std::string TAG;
+
+		public:
+			/**
+			 * @param plan File containing the contact plan
+			 */
+			ContactGraphRoutingExtension(const ibrcommon::File &plan);
+			virtual ~ContactGraphRoutingExtension();
+
+			/**
+			 * This method is called every time something has changed. The module
+			 * should search again for bundles to transfer to the given peer.
+			 */
+			virtual void eventDataChanged(const dtn::data::EID &peer) throw ();
+
+			/**
+			 * This method is called every time a bundle was queued
+			 */
+			virtual void eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ();
+
+			void raiseEvent(const dtn::core::TimeEvent &evt) throw ();
+			void componentUp() throw ();
+			void componentDown() throw ();
+
+		protected:
+			void process(RoutingExecutor::Task &task) throw ();
+
+		private:
+			class SearchNextBundleTask : public RoutingExecutor::Task
+			{
+			public:
+				SearchNextBundleTask(const dtn::data::EID &eid);
+				virtual ~SearchNextBundleTask();
+
+				virtual std::string toString();
+				virtual bool isCoalescable() const;
+
+				const dtn::data::EID eid;
+			};
+
+			class ProcessBundleTask : public RoutingExecutor::Task
+			{
+			public:
+				ProcessBundleTask(const dtn::data::MetaBundle &meta, const dtn::data::EID &origin);
+				virtual ~ProcessBundleTask();
+
+				virtual std::string toString();
+
+				const dtn::data::MetaBundle bundle;
+				const dtn::data::EID origin;
+			};
+
+			class UpdateTask : public RoutingExecutor::Task
+			{
+			public:
+				UpdateTask(const dtn::data::Timestamp &timestamp);
+				virtual ~UpdateTask();
+
+				virtual std::string toString();
+
+				const dtn::data::Timestamp timestamp;
+			};
+
+			/**
+			 * Load the contact plan and compile it into the contact graph
+			 */
+			void load();
+
+			/**
+			 * Compute the route table for the given time and
+			 * search for bundles to all first hops
+			 */
+			void update(const dtn::data::Timestamp &timestamp);
+
+			const ibrcommon::File _plan;
+			ContactGraph _graph;
+			ContactGraph::RouteTable _table;
+
+			ibrcommon::Mutex _expire_lock;
+			dtn::data::Timestamp _expires;
+
+			// time to compute the route table in microseconds
+			ibrcommon::Histogram &_compute_latency;
+			ibrcommon::Gauge &_routes;
+		};
+	} /* namespace routing */
+} /* namespace dtn */
+#endif /* CONTACTGRAPHROUTINGEXTENSION_H_ */
@@ -0,0 +1,147 @@
+/*
+ * ContactPlan.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "routing/contactgraph/ContactPlan.h"
+#include <fstream>
+#include <sstream>
+
+namespace dtn
+{
+	namespace routing
+	{
+		Contact::Contact(const dtn::data::EID &f, const dtn::data::EID &t,
+				const dtn::data::Timestamp &s, const dtn::data::Timestamp &e,
+				const dtn::data::Timestamp &d)
+		 : from(f), to(t), start(s), end(e), delay(d)
+		{
+		}
+
+		Contact::~Contact()
+		{
+		}
+
+		std::string Contact::toString() const
+		{
+			std::stringstream ss;
+			ss << from.getString() << " -> " << to.getString() << " [" << start.toString() << ", " << end.toString() << "] delay " << delay.toString();
+			return ss.str();
+		}
+
+		ContactPlan::ContactPlan()
+		{
+		}
+
+		ContactPlan::~ContactPlan()
+		{
+		}
+
+		/**
+		 * Parse a point in time, a leading '+' makes it relative to the reference
+		 */
+		static bool parse_time(const std::string &value, const dtn::data::Timestamp &reference, dtn::data::Timestamp &ret)
+		{
+			const bool relative = (value.length() > 0) && (value[0] == '+');
+
+			std::stringstream ss(relative ? value.substr(1) : value);
+			dtn::data::Size t = 0;
+			if (!(ss >> t) || !ss.eof()) return false;
+
+			ret = relative ? (reference + t) : dtn::data::Timestamp(t);
+			return true;
+		}
+
+		void ContactPlan::load(std::istream &stream, const dtn::data::Timestamp &reference) throw (ParseException)
+		{
+			// add the contacts only if the whole plan is valid
+			contact_list contacts;
+			std::string line;
+			size_t lineno = 0;
+
+			while (std::getline(stream, line))
+			{
+				lineno++;
+
+				std::stringstream ls(line);
+				std::string start, end, from, to;
+
+				// skip empty lines and comments
+				if (!(ls >> start) || (start[0] == '#')) continue;
+
+				dtn::data::Timestamp delay = 0;
+				dtn::data::Size d = 0;
+
+				Contact c(dtn::data::EID(), dtn::data::EID(), 0, 0);
+
+				if (!(ls >> end >> from >> to)
+						|| !parse_time(start, reference, c.start)
+						|| !parse_time(end, reference, c.end)
+						|| (c.end < c.start))
+				{
+					std::stringstream ss;
+					ss << "invalid contact in line " << lineno;
+					throw ParseException(ss.str());
+				}
+
+				if (ls >> d) delay = d;
+
+				c.from = dtn::data::EID(from).getNode();
+				c.to = dtn::data::EID(to).getNode();
+				c.delay = delay;
+
+				contacts.push_back(c);
+			}
+
+			_contacts.insert(_contacts.end(), contacts.begin(), contacts.end());
+		}
+
+		void ContactPlan::load(const ibrcommon::File &file, const dtn::data::Timestamp &reference) throw (ParseException)
+		{
+			std::ifstream stream(file.getPath().c_str());
+
+			if (!stream.good())
+			{
+				throw ParseException("can not open contact plan " + file.getPath());
+			}
+
+			load(stream, reference);
+		}
+
+		void ContactPlan::add(const Contact &contact)
+		{
+			_contacts.push_back(contact);
+		}
+
+		void ContactPlan::clear()
+		{
+			_contacts.clear();
+		}
+
+		const ContactPlan::contact_list& ContactPlan::getContacts() const
+		{
+			return _contacts;
+		}
+
+		size_t ContactPlan::size() const
+		{
+			return _contacts.size();
+		}
+	} /* namespace routing */
+} /* namespace dtn */
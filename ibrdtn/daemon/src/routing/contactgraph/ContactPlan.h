@@ -0,0 +1,111 @@
+/*
+ * ContactPlan.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef CONTACTPLAN_H_
+#define CONTACTPLAN_H_
+
+#include <ibrdtn/data/EID.h>
+#include <ibrdtn/data/Number.h>
+#include <ibrcommon/data/File.h>
+#include <ibrcommon/Exceptions.h>
+#include <iostream>
+#include <vector>
+
+namespace dtn
+{
+	namespace routing
+	{
+		/**
+		 * A scheduled contact from one node to another. During the contact
+		 * bundles can be transmitted and arrive after the given delay.
+		 */
+		class Contact
+		{
+		public:
+			Contact(const dtn::data::EID &from, const dtn::data::EID &to,
+					const dtn::data::Timestamp &start, const dtn::data::Timestamp &end,
+					const dtn::data::Timestamp &delay = 0);
+			virtual ~Contact();
+
+			std::string toString() const;
+
+			dtn::data::EID from;
+			dtn::data::EID to;
+
+			// window of the contact in DTN time
+			dtn::data::Timestamp start;
+			dtn::data::Timestamp end;
+
+			// one-way propagation delay in seconds
+			dtn::data::Timestamp delay;
+		};
+
+		/**
+		 * A list of scheduled contacts. The plan is read from a text file
+		 * with one contact per line:
+		 *
+		 *   <start> <end> <from> <to> [<delay>]
+		 *
+		 * Start and end are given in DTN time or relative to the time
+		 * of loading if prefixed with a '+'. Empty lines and lines
+		 * starting with a '#' are ignored.
+		 */
+		class ContactPlan
+		{
+		public:
+			class ParseException : public ibrcommon::Exception
+			{
+			public:
+				ParseException(const std::string &what)
+				: ibrcommon::Exception(what) { };
+
+				virtual ~ParseException() throw () { };
+			};
+
+			typedef std::vector<Contact> contact_list;
+
+			ContactPlan();
+			virtual ~ContactPlan();
+
+			/**
+			 * Read contacts from a stream. On a parse error none of the
+			 * contacts of the stream are added.
+			 * @param reference The time relative contacts are based on
+			 */
+			void load(std::istream &stream, const dtn::data::Timestamp &reference) throw (ParseException);
+
+			/**
+			 * Read contacts from a file
+			 */
+			void load(const ibrcommon::File &file, const dtn::data::Timestamp &reference) throw (ParseException);
+
+			void add(const Contact &contact);
+			void clear();
+
+			const contact_list& getContacts() const;
+			size_t size() const;
+
+		private:
+			contact_list _contacts;
+		};
+	} /* namespace routing */
+} /* namespace dtn */
+#endif /* CONTACTPLAN_H_ */
@@ -64,7 +64,6 @@ namespace dtn
 
 		EpidemicRoutingExtension::~EpidemicRoutingExtension()
 		{
-			join();
 		}
 
 		void EpidemicRoutingExtension::requestHandshake(const dtn::data::EID&, NodeHandshake &request) const
@@ -75,15 +74,15 @@ namespace dtn
 		void EpidemicRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
 		{
 			// transfer the next bundle to this destination
-			_taskqueue.push( new SearchNextBundleTask( peer ) );
+			execute( new SearchNextBundleTask( peer ) );
 		}
 
 		void EpidemicRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
 		{
 			// new bundles trigger a recheck for all neighbors
-			const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+			const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-			for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+			for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 			{
 				const dtn::core::Node &n = (*iter);
 
@@ -100,50 +99,26 @@ namespace dtn
 			if (handshake.state == NodeHandshakeEvent::HANDSHAKE_COMPLETED)
 			{
 				// transfer the next bundle to this destination
-				_taskqueue.push( new SearchNextBundleTask( handshake.peer ) );
+				execute( new SearchNextBundleTask( handshake.peer ) );
 			}
 		}
 
 		void EpidemicRoutingExtension::componentUp() throw ()
 		{
 			dtn::core::EventDispatcher<dtn::routing::NodeHandshakeEvent>::add(this);
-
-			// reset the task queue
-			_taskqueue.reset();
-
-			// routine checked for throw() on 15.02.2013
-			try {
-				// run the thread
-				start();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(EpidemicRoutingExtension::TAG, error) << "componentUp failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
 		}
 
 		void EpidemicRoutingExtension::componentDown() throw ()
 		{
 			dtn::core::EventDispatcher<dtn::routing::NodeHandshakeEvent>::remove(this);
-
-			try {
-				// stop the thread
-				stop();
-				join();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(EpidemicRoutingExtension::TAG, error) << "componentDown failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
-		}
-
-		void EpidemicRoutingExtension::__cancellation() throw ()
-		{
-			_taskqueue.abort();
 		}
 
-		void EpidemicRoutingExtension::run() throw ()
+		void EpidemicRoutingExtension::process(RoutingExecutor::Task &t) throw ()
 		{
 			class BundleFilter : public dtn::storage::BundleSelector
 			{
 			public:
-				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const std::set<dtn::core::Node> &neighbors)
+				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const dtn::net::NeighborSnapshot &neighbors)
 				 : _entry(entry), _neighbors(neighbors)
 				{};
 
@@ -183,10 +158,8 @@ namespace dtn
 					// if this is a singleton bundle ...
 					if (meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
 					{
-						const dtn::core::Node n(meta.destination.getNode());
-
 						// do not forward the bundle if the final destination is available
-						if (_neighbors.find(n) != _neighbors.end())
+						if (_neighbors.contains(meta.destination.getNode()))
 						{
 							return false;
 						}
@@ -208,100 +181,100 @@ namespace dtn
 
 			private:
 				const NeighborDatabase::NeighborEntry &_entry;
-				const std::set<dtn::core::Node> &_neighbors;
+				const dtn::net::NeighborSnapshot &_neighbors;
 			};
 
 			// list for bundles
 			dtn::storage::BundleResultList list;
 
-			// set of known neighbors
-			std::set<dtn::core::Node> neighbors;
+			// empty snapshot used if "prefer direct" is disabled
+			const dtn::net::NeighborSnapshot::Reference no_neighbors(new dtn::net::NeighborSnapshot());
 
-			while (true)
-			{
-				try {
-					Task *t = _taskqueue.poll();
-					std::auto_ptr<Task> killer(t);
+			// snapshot of known neighbors
+			dtn::net::NeighborSnapshot::Reference neighbors = no_neighbors;
 
-					IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 50) << "processing task " << t->toString() << IBRCOMMON_LOGGER_ENDL;
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 50) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
 
+				try {
+					/**
+					 * SearchNextBundleTask triggers a search for a bundle to transfer
+					 * to another host. This Task is generated by TransferCompleted, TransferAborted
+					 * and node events.
+					 */
 					try {
-						/**
-						 * SearchNextBundleTask triggers a search for a bundle to transfer
-						 * to another host. This Task is generated by TransferCompleted, TransferAborted
-						 * and node events.
-						 */
-						try {
-							SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(*t);
+						SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
 
-							// lock the neighbor database while searching for bundles
-							try {
-								NeighborDatabase &db = (**this).getNeighborDB();
-								ibrcommon::MutexLock l(db);
-								NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
-
-								// check if enough transfer slots available (threshold reached)
-								if (!entry.isTransferThresholdReached())
-									throw NeighborDatabase::NoMoreTransfersAvailable();
-
-								if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
-									// get current neighbor list
-									neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
-								} else {
-									// "prefer direct" option disabled - clear the list of neighbors
-									neighbors.clear();
-								}
-
-								// get the bundle filter of the neighbor
-								const BundleFilter filter(entry, neighbors);
-
-								// some debug output
-								IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
-
-								// query some unknown bundle from the storage
-								list.clear();
-								(**this).getSeeker().get(filter, list);
-							} catch (const dtn::storage::BundleSelectorException&) {
-								// query a new summary vector from this neighbor
-								(**this).doHandshake(task.eid);
+						// lock the neighbor database while searching for bundles
+						try {
+							NeighborDatabase &db = (**this).getNeighborDB();
+							ibrcommon::MutexLock l(db);
+							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
+
+							// check if enough transfer slots available (threshold reached)
+							if (!entry.isTransferThresholdReached())
+								throw NeighborDatabase::NoMoreTransfersAvailable();
+
+							if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
+								// get current neighbor list
+								neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
+							} else {
+								// "prefer direct" option disabled - clear the list of neighbors
+								neighbors = no_neighbors;
 							}
 
-							// send the bundles as long as we have resources
-							for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-							{
-								try {
-									// transfer the bundle to the neighbor
-									transferTo(task.eid, *iter);
-								} catch (const NeighborDatabase::AlreadyInTransitException&) { };
-							}
-						} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const dtn::storage::NoBundleFoundException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const std::bad_cast&) { };
-					} catch (const ibrcommon::Exception &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					}
-				} catch (const std::exception &ex) {
-					IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 15) << "terminated due to " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					return;
-				}
+							// get the bundle filter of the neighbor
+							const BundleFilter filter(entry, *neighbors);
+
+							// some debug output
+							IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+
+							// query some unknown bundle from the storage
+							ibrcommon::Histogram::Timer timer(_search_latency);
+							list.clear();
+							(**this).getSeeker().get(filter, list);
+						} catch (const dtn::storage::BundleSelectorException&) {
+							// query a new summary vector from this neighbor
+							(**this).doHandshake(task.eid);
+						}
 
-				yield();
+						// send the bundles as long as we have resources
+						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+						{
+							try {
+								// transfer the bundle to the neighbor
+								transferTo(task.eid, *iter);
+							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+						}
+					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const dtn::storage::NoBundleFoundException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const std::bad_cast&) { };
+				} catch (const ibrcommon::Exception &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				}
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(EpidemicRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
 		}
 
 		/****************************************/
 
 		EpidemicRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &e)
-		 : eid(e)
+		 : RoutingExecutor::Task(e), eid(e)
 		{ }
 
 		EpidemicRoutingExtension::SearchNextBundleTask::~SearchNextBundleTask()
 		{ }
 
+		bool EpidemicRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
 		std::string EpidemicRoutingExtension::SearchNextBundleTask::toString()
 		{
 			return "SearchNextBundleTask: " + eid.getString();
@@ -35,8 +35,6 @@
 #include <ibrdtn/data/BundleString.h>
 #include <ibrdtn/data/ExtensionBlock.h>
 
-#include <ibrcommon/thread/Queue.h>
-#include <ibrcommon/thread/Thread.h>
 
 #include <list>
 #include <queue>
@@ -45,7 +43,7 @@ namespace dtn
 {
 	namespace routing
 	{
-		class EpidemicRoutingExtension : public RoutingExtension, public ibrcommon::JoinableThread, public dtn::core::EventReceiver<dtn::routing::NodeHandshakeEvent>
+		class EpidemicRoutingExtension : public RoutingExtension, public dtn::core::EventReceiver<dtn::routing::NodeHandshakeEvent>
 		{
 			static const std::string TAG;
 
@@ -67,32 +65,20 @@ namespace dtn
 			virtual void requestHandshake(const dtn::data::EID&, NodeHandshake&) const;
 
 		protected:
-			void run() throw ();
-			void __cancellation() throw ();
+			void process(RoutingExecutor::Task &task) throw ();
 
 		private:
-			class Task
-			{
-			public:
-				virtual ~Task() {};
-				virtual std::string toString() = 0;
-			};
-
-			class SearchNextBundleTask : public Task
+			class SearchNextBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				SearchNextBundleTask(const dtn::data::EID &eid);
 				virtual ~SearchNextBundleTask();
 
 				virtual std::string toString();
+				virtual bool isCoalescable() const;
 
 				const dtn::data::EID eid;
 			};
-
-			/**
-			 * hold queued tasks for later processing
-			 */
-			ibrcommon::Queue<EpidemicRoutingExtension::Task* > _taskqueue;
 		};
 	}
 }
@@ -59,21 +59,20 @@ namespace dtn
 
 		FloodRoutingExtension::~FloodRoutingExtension()
 		{
-			join();
 		}
 
 		void FloodRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
 		{
 			// transfer the next bundle to this destination
-			_taskqueue.push( new SearchNextBundleTask( peer ) );
+			execute( new SearchNextBundleTask( peer ) );
 		}
 
 		void FloodRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
 		{
 			// new bundles trigger a recheck for all neighbors
-			const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+			const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-			for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+			for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 			{
 				const dtn::core::Node &n = (*iter);
 
@@ -86,41 +85,17 @@ namespace dtn
 		}
 
 		void FloodRoutingExtension::componentUp() throw ()
-		{
-			// reset the task queue
-			_taskqueue.reset();
-
-			// routine checked for throw() on 15.02.2013
-			try {
-				// run the thread
-				start();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(FloodRoutingExtension::TAG, error) << "componentUp failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
-		}
+		{		}
 
 		void FloodRoutingExtension::componentDown() throw ()
-		{
-			try {
-				// stop the thread
-				stop();
-				join();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(FloodRoutingExtension::TAG, error) << "componentDown failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
-		}
-
-		void FloodRoutingExtension::__cancellation() throw ()
-		{
-			_taskqueue.abort();
-		}
+		{		}
 
-		void FloodRoutingExtension::run() throw ()
+		void FloodRoutingExtension::process(RoutingExecutor::Task &t) throw ()
 		{
 			class BundleFilter : public dtn::storage::BundleSelector
 			{
 			public:
-				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const std::set<dtn::core::Node> &neighbors)
+				BundleFilter(const NeighborDatabase::NeighborEntry &entry, const dtn::net::NeighborSnapshot &neighbors)
 				 : _entry(entry), _neighbors(neighbors)
 				{};
 
@@ -160,10 +135,8 @@ namespace dtn
 					// if this is a singleton bundle ...
 					if (meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
 					{
-						const dtn::core::Node n(meta.destination.getNode());
-
 						// do not forward the bundle if the final destination is available
-						if (_neighbors.find(n) != _neighbors.end())
+						if (_neighbors.contains(meta.destination.getNode()))
 						{
 							return false;
 						}
@@ -180,93 +153,93 @@ namespace dtn
 
 			private:
 				const NeighborDatabase::NeighborEntry &_entry;
-				const std::set<dtn::core::Node> &_neighbors;
+				const dtn::net::NeighborSnapshot &_neighbors;
 			};
 
 			// list for bundles
 			dtn::storage::BundleResultList list;
 
-			// set of known neighbors
-			std::set<dtn::core::Node> neighbors;
+			// empty snapshot used if "prefer direct" is disabled
+			const dtn::net::NeighborSnapshot::Reference no_neighbors(new dtn::net::NeighborSnapshot());
 
-			while (true)
-			{
-				try {
-					Task *t = _taskqueue.poll();
-					std::auto_ptr<Task> killer(t);
+			// snapshot of known neighbors
+			dtn::net::NeighborSnapshot::Reference neighbors = no_neighbors;
 
-					IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 50) << "processing task " << t->toString() << IBRCOMMON_LOGGER_ENDL;
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 50) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
 
+				try {
 					try {
-						try {
-							SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(*t);
+						SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
 
-							// lock the neighbor database while searching for bundles
-							{
-								NeighborDatabase &db = (**this).getNeighborDB();
+						// lock the neighbor database while searching for bundles
+						{
+							NeighborDatabase &db = (**this).getNeighborDB();
 
-								ibrcommon::MutexLock l(db);
-								NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
+							ibrcommon::MutexLock l(db);
+							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
 
-								// check if enough transfer slots available (threshold reached)
-								if (!entry.isTransferThresholdReached())
-									throw NeighborDatabase::NoMoreTransfersAvailable();
+							// check if enough transfer slots available (threshold reached)
+							if (!entry.isTransferThresholdReached())
+								throw NeighborDatabase::NoMoreTransfersAvailable();
 
-								if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
-									// get current neighbor list
-									neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
-								} else {
-									// "prefer direct" option disabled - clear the list of neighbors
-									neighbors.clear();
-								}
+							if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
+								// get current neighbor list
+								neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
+							} else {
+								// "prefer direct" option disabled - clear the list of neighbors
+								neighbors = no_neighbors;
+							}
 
-								// get the bundle filter of the neighbor
-								BundleFilter filter(entry, neighbors);
+							// get the bundle filter of the neighbor
+							BundleFilter filter(entry, *neighbors);
 
-								// some debug
-								IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+							// some debug
+							IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
 
-								// query all bundles from the storage
-								list.clear();
-								(**this).getSeeker().get(filter, list);
-							}
+							// query all bundles from the storage
+							ibrcommon::Histogram::Timer timer(_search_latency);
+							list.clear();
+							(**this).getSeeker().get(filter, list);
+						}
 
-							// send the bundles as long as we have resources
-							for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-							{
-								try {
-									// transfer the bundle to the neighbor
-									transferTo(task.eid, *iter);
-								} catch (const NeighborDatabase::AlreadyInTransitException&) { };
-							}
-						} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const dtn::storage::NoBundleFoundException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const std::bad_cast&) { };
-					} catch (const ibrcommon::Exception &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					}
-				} catch (const std::exception &ex) {
-					IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 15) << "terminated due to " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					return;
+						// send the bundles as long as we have resources
+						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+						{
+							try {
+								// transfer the bundle to the neighbor
+								transferTo(task.eid, *iter);
+							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+						}
+					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const dtn::storage::NoBundleFoundException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const std::bad_cast&) { };
+				} catch (const ibrcommon::Exception &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 				}
-
-				yield();
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(FloodRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
 		}
 
 		/****************************************/
 
 		FloodRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &e)
-		 : eid(e)
+		 : RoutingExecutor::Task(e), eid(e)
 		{ }
 
 		FloodRoutingExtension::SearchNextBundleTask::~SearchNextBundleTask()
 		{ }
 
+		bool FloodRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
 		std::string FloodRoutingExtension::SearchNextBundleTask::toString()
 		{
 			return "SearchNextBundleTask: " + eid.getString();
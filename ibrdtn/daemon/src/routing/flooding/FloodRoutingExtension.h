@@ -31,7 +31,6 @@
 #include <ibrdtn/data/SDNV.h>
 #include <ibrdtn/data/BundleString.h>
 
-#include <ibrcommon/thread/Queue.h>
 
 #include <list>
 #include <queue>
@@ -40,7 +39,7 @@ namespace dtn
 {
 	namespace routing
 	{
-		class FloodRoutingExtension : public RoutingExtension, public ibrcommon::JoinableThread
+		class FloodRoutingExtension : public RoutingExtension
 		{
 			static const std::string TAG;
 
@@ -56,32 +55,20 @@ namespace dtn
 			void componentDown() throw ();
 
 		protected:
-			void run() throw ();
-			void __cancellation() throw ();
+			void process(RoutingExecutor::Task &task) throw ();
 
 		private:
-			class Task
-			{
-			public:
-				virtual ~Task() {};
-				virtual std::string toString() = 0;
-			};
-
-			class SearchNextBundleTask : public Task
+			class SearchNextBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				SearchNextBundleTask(const dtn::data::EID &eid);
 				virtual ~SearchNextBundleTask();
 
 				virtual std::string toString();
+				virtual bool isCoalescable() const;
 
 				const dtn::data::EID eid;
 			};
-
-			/**
-			 * hold queued tasks for later processing
-			 */
-			ibrcommon::Queue<FloodRoutingExtension::Task* > _taskqueue;
 		};
 	}
 }
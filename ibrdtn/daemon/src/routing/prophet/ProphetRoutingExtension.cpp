@@ -80,8 +80,6 @@ namespace dtn
 
 		ProphetRoutingExtension::~ProphetRoutingExtension()
 		{
-			stop();
-			join();
 			delete _forwardingStrategy;
 		}
 
@@ -208,7 +206,7 @@ namespace dtn
 		void ProphetRoutingExtension::eventDataChanged(const dtn::data::EID &peer) throw ()
 		{
 			// transfer the next bundle to this destination
-			_taskqueue.push( new SearchNextBundleTask( peer ) );
+			execute( new SearchNextBundleTask( peer ) );
 		}
 
 		void ProphetRoutingExtension::eventTransferCompleted(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
@@ -223,9 +221,9 @@ namespace dtn
 		void ProphetRoutingExtension::eventBundleQueued(const dtn::data::EID &peer, const dtn::data::MetaBundle &meta) throw ()
 		{
 			// new bundles trigger a recheck for all neighbors
-			const std::set<dtn::core::Node> nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
+			const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
 
-			for (std::set<dtn::core::Node>::const_iterator iter = nl.begin(); iter != nl.end(); ++iter)
+			for (dtn::net::NeighborSnapshot::node_set::const_iterator iter = nl->getNodes().begin(); iter != nl->getNodes().end(); ++iter)
 			{
 				const dtn::core::Node &n = (*iter);
 
@@ -256,7 +254,7 @@ namespace dtn
 
 			if ((_next_exchange_timestamp > 0) && (_next_exchange_timestamp < now))
 			{
-				_taskqueue.push( new NextExchangeTask() );
+				execute( new NextExchangeTask() );
 
 				// define the next exchange timestamp
 				_next_exchange_timestamp = now + _next_exchange_timeout;
@@ -268,7 +266,7 @@ namespace dtn
 			if (handshake.state == NodeHandshakeEvent::HANDSHAKE_COMPLETED)
 			{
 				// transfer the next bundle to this destination
-				_taskqueue.push( new SearchNextBundleTask( handshake.peer ) );
+				execute( new SearchNextBundleTask( handshake.peer ) );
 			}
 		}
 
@@ -288,19 +286,8 @@ namespace dtn
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::add(this);
 			dtn::core::EventDispatcher<dtn::core::BundlePurgeEvent>::add(this);
 
-			// reset task queue
-			_taskqueue.reset();
-
 			// restore persistent routing data
 			if (_persistent_file.exists()) restore(_persistent_file);
-
-			// routine checked for throw() on 15.02.2013
-			try {
-				// run the thread
-				start();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(ProphetRoutingExtension::TAG, error) << "componentUp failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
 		}
 
 		void ProphetRoutingExtension::componentDown() throw ()
@@ -311,14 +298,6 @@ namespace dtn
 
 			// store persistent routing data
 			if (_persistent_file.isValid()) store(_persistent_file);
-
-			try {
-				// stop the thread
-				stop();
-				join();
-			} catch (const ibrcommon::ThreadException &ex) {
-				IBRCOMMON_LOGGER_TAG(ProphetRoutingExtension::TAG, error) << "componentDown failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-			}
 		}
 
 		ibrcommon::ThreadsafeReference<DeliveryPredictabilityMap> ProphetRoutingExtension::getDeliveryPredictabilityMap()
@@ -340,12 +319,12 @@ namespace dtn
 			return ibrcommon::ThreadsafeReference<const AcknowledgementSet>(_acknowledgementSet, const_cast<AcknowledgementSet&>(_acknowledgementSet));
 		}
 
-		void ProphetRoutingExtension::ProphetRoutingExtension::run() throw ()
+		void ProphetRoutingExtension::process(RoutingExecutor::Task &t) throw ()
 		{
 			class BundleFilter : public dtn::storage::BundleSelector
 			{
 			public:
-				BundleFilter(const NeighborDatabase::NeighborEntry &entry, ForwardingStrategy &strategy, const DeliveryPredictabilityMap &dpm, const std::set<dtn::core::Node> &neighbors)
+				BundleFilter(const NeighborDatabase::NeighborEntry &entry, ForwardingStrategy &strategy, const DeliveryPredictabilityMap &dpm, const dtn::net::NeighborSnapshot &neighbors)
 				 : _entry(entry), _strategy(strategy), _dpm(dpm), _neighbors(neighbors)
 				{ };
 
@@ -385,10 +364,8 @@ namespace dtn
 					// if this is a singleton bundle ...
 					if (meta.get(dtn::data::PrimaryBlock::DESTINATION_IS_SINGLETON))
 					{
-						const dtn::core::Node n(meta.destination.getNode());
-
 						// do not forward the bundle if the final destination is available
-						if (_neighbors.find(n) != _neighbors.end())
+						if (_neighbors.contains(meta.destination.getNode()))
 						{
 							return false;
 						}
@@ -427,121 +404,111 @@ namespace dtn
 				const NeighborDatabase::NeighborEntry &_entry;
 				const ForwardingStrategy &_strategy;
 				const DeliveryPredictabilityMap &_dpm;
-				const std::set<dtn::core::Node> &_neighbors;
+				const dtn::net::NeighborSnapshot &_neighbors;
 			};
 
 			// list for bundles
 			dtn::storage::BundleResultList list;
 
-			// set of known neighbors
-			std::set<dtn::core::Node> neighbors;
+			// empty snapshot used if "prefer direct" is disabled
+			const dtn::net::NeighborSnapshot::Reference no_neighbors(new dtn::net::NeighborSnapshot());
 
-			while (true)
-			{
-				try {
-					Task *t = _taskqueue.poll();
-					std::auto_ptr<Task> killer(t);
+			// snapshot of known neighbors
+			dtn::net::NeighborSnapshot::Reference neighbors = no_neighbors;
 
-					IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 50) << "processing task " << t->toString() << IBRCOMMON_LOGGER_ENDL;
+			try {
+				IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 50) << "processing task " << t.toString() << IBRCOMMON_LOGGER_ENDL;
 
+				try {
+					/**
+					 * SearchNextBundleTask triggers a search for a bundle to transfer
+					 * to another host. This Task is generated by TransferCompleted, TransferAborted
+					 * and node events.
+					 */
 					try {
-						/**
-						 * SearchNextBundleTask triggers a search for a bundle to transfer
-						 * to another host. This Task is generated by TransferCompleted, TransferAborted
-						 * and node events.
-						 */
+						SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(t);
+
+						// lock the neighbor database while searching for bundles
 						try {
-							SearchNextBundleTask &task = dynamic_cast<SearchNextBundleTask&>(*t);
+							NeighborDatabase &db = (**this).getNeighborDB();
 
-							// lock the neighbor database while searching for bundles
-							try {
-								NeighborDatabase &db = (**this).getNeighborDB();
-
-								ibrcommon::MutexLock l(db);
-								NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
-
-								// check if enough transfer slots available (threshold reached)
-								if (!entry.isTransferThresholdReached())
-									throw NeighborDatabase::NoMoreTransfersAvailable();
-
-								// get the DeliveryPredictabilityMap of the potentially next hop
-								const DeliveryPredictabilityMap &dpm = entry.getDataset<DeliveryPredictabilityMap>();
-
-								if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
-									// get current neighbor list
-									neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
-								} else {
-									// "prefer direct" option disabled - clear the list of neighbors
-									neighbors.clear();
-								}
-
-								// get the bundle filter of the neighbor
-								const BundleFilter filter(entry, *_forwardingStrategy, dpm, neighbors);
-
-								// some debug output
-								IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
-
-								// query some unknown bundle from the storage, the list contains max. 10 items.
-								list.clear();
-								(**this).getSeeker().get(filter, list);
-							} catch (const NeighborDatabase::DatasetNotAvailableException&) {
-								// if there is no DeliveryPredictabilityMap for the next hop
-								// perform a routing handshake with the peer
-								(**this).doHandshake(task.eid);
-							} catch (const dtn::storage::BundleSelectorException&) {
-								// query a new summary vector from this neighbor
-								(**this).doHandshake(task.eid);
-							}
+							ibrcommon::MutexLock l(db);
+							NeighborDatabase::NeighborEntry &entry = db.get(task.eid, true);
 
-							// send the bundles as long as we have resources
-							for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
-							{
-								const dtn::data::MetaBundle &meta = (*iter);
+							// check if enough transfer slots available (threshold reached)
+							if (!entry.isTransferThresholdReached())
+								throw NeighborDatabase::NoMoreTransfersAvailable();
 
-								try {
-									transferTo(task.eid, meta);
-								} catch (const NeighborDatabase::AlreadyInTransitException&) { };
-							}
-						} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const dtn::storage::NoBundleFoundException &ex) {
-							IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t->toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-						} catch (const std::bad_cast&) { }
-
-						/**
-						 * NextExchangeTask is a timer based event, that triggers
-						 * a new dp_map exchange for every connected node
-						 */
-						try {
-							dynamic_cast<NextExchangeTask&>(*t);
-
-							std::set<dtn::core::Node> neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighbors();
-							std::set<dtn::core::Node>::const_iterator it;
-							for(it = neighbors.begin(); it != neighbors.end(); ++it)
-							{
-								try{
-									(**this).doHandshake(it->getEID());
-								} catch (const ibrcommon::Exception &ex) { }
+							// get the DeliveryPredictabilityMap of the potentially next hop
+							const DeliveryPredictabilityMap &dpm = entry.getDataset<DeliveryPredictabilityMap>();
+
+							if (dtn::daemon::Configuration::getInstance().getNetwork().doPreferDirect()) {
+								// get current neighbor list
+								neighbors = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
+							} else {
+								// "prefer direct" option disabled - clear the list of neighbors
+								neighbors = no_neighbors;
 							}
-						} catch (const std::bad_cast&) { }
 
-					} catch (const ibrcommon::Exception &ex) {
-						IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					}
-				} catch (const std::exception &ex) {
-					IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 15) << "terminated due to " << ex.what() << IBRCOMMON_LOGGER_ENDL;
-					return;
-				}
+							// get the bundle filter of the neighbor
+							const BundleFilter filter(entry, *_forwardingStrategy, dpm, *neighbors);
+
+							// some debug output
+							IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 40) << "search some bundles not known by " << task.eid.getString() << IBRCOMMON_LOGGER_ENDL;
+
+							// query some unknown bundle from the storage, the list contains max. 10 items.
+							ibrcommon::Histogram::Timer timer(_search_latency);
+							list.clear();
+							(**this).getSeeker().get(filter, list);
+						} catch (const NeighborDatabase::DatasetNotAvailableException&) {
+							// if there is no DeliveryPredictabilityMap for the next hop
+							// perform a routing handshake with the peer
+							(**this).doHandshake(task.eid);
+						} catch (const dtn::storage::BundleSelectorException&) {
+							// query a new summary vector from this neighbor
+							(**this).doHandshake(task.eid);
+						}
 
-				yield();
-			}
-		}
+						// send the bundles as long as we have resources
+						for (std::list<dtn::data::MetaBundle>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+						{
+							const dtn::data::MetaBundle &meta = (*iter);
 
-		void ProphetRoutingExtension::__cancellation() throw ()
-		{
-			_taskqueue.abort();
+							try {
+								transferTo(task.eid, meta);
+							} catch (const NeighborDatabase::AlreadyInTransitException&) { };
+						}
+					} catch (const NeighborDatabase::NoMoreTransfersAvailable &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const NeighborDatabase::NeighborNotAvailableException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const dtn::storage::NoBundleFoundException &ex) {
+						IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 10) << "task " << t.toString() << " aborted: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					} catch (const std::bad_cast&) { }
+
+					/**
+					 * NextExchangeTask is a timer based event, that triggers
+					 * a new dp_map exchange for every connected node
+					 */
+					try {
+						dynamic_cast<NextExchangeTask&>(t);
+
+						const dtn::net::NeighborSnapshot::Reference nl = dtn::core::BundleCore::getInstance().getConnectionManager().getNeighborSnapshot();
+						dtn::net::NeighborSnapshot::node_set::const_iterator it;
+						for(it = nl->getNodes().begin(); it != nl->getNodes().end(); ++it)
+						{
+							try{
+								(**this).doHandshake(it->getEID());
+							} catch (const ibrcommon::Exception &ex) { }
+						}
+					} catch (const std::bad_cast&) { }
+
+				} catch (const ibrcommon::Exception &ex) {
+					IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 20) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				}
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_DEBUG_TAG(ProphetRoutingExtension::TAG, 15) << "task " << t.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
 		}
 
 		float ProphetRoutingExtension::p_encounter(const dtn::data::EID &neighbor) const
@@ -714,7 +681,7 @@ namespace dtn
 		}
 
 		ProphetRoutingExtension::SearchNextBundleTask::SearchNextBundleTask(const dtn::data::EID &eid)
-			: eid(eid)
+			: RoutingExecutor::Task(eid), eid(eid)
 		{
 		}
 
@@ -722,7 +689,12 @@ namespace dtn
 		{
 		}
 
-		std::string ProphetRoutingExtension::SearchNextBundleTask::toString() const
+		bool ProphetRoutingExtension::SearchNextBundleTask::isCoalescable() const
+		{
+			return true;
+		}
+
+		std::string ProphetRoutingExtension::SearchNextBundleTask::toString()
 		{
 			return "SearchNextBundleTask: " + eid.getString();
 		}
@@ -735,7 +707,7 @@ namespace dtn
 		{
 		}
 
-		std::string ProphetRoutingExtension::NextExchangeTask::toString() const
+		std::string ProphetRoutingExtension::NextExchangeTask::toString()
 		{
 			return "NextExchangeTask";
 		}
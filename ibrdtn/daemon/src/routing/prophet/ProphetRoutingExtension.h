@@ -33,7 +33,6 @@
 #include "core/BundlePurgeEvent.h"
 
 #include <ibrcommon/thread/Mutex.h>
-#include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/ThreadsafeReference.h>
 
 #include <map>
@@ -53,7 +52,7 @@ namespace dtn
 		 * predictabilityMaps with neighbors.
 		 * For a detailed description of the protocol, see draft-irtf-dtnrg-prophet-09
 		 */
-		class ProphetRoutingExtension : public RoutingExtension, public ibrcommon::JoinableThread,
+		class ProphetRoutingExtension : public RoutingExtension,
 			public dtn::core::EventReceiver<dtn::routing::NodeHandshakeEvent>,
 			public dtn::core::EventReceiver<dtn::core::TimeEvent>,
 			public dtn::core::EventReceiver<dtn::core::BundlePurgeEvent>
@@ -104,8 +103,7 @@ namespace dtn
 			 */
 			ibrcommon::ThreadsafeReference<const AcknowledgementSet> getAcknowledgementSet() const;
 		protected:
-			virtual void run() throw ();
-			void __cancellation() throw ();
+			void process(RoutingExecutor::Task &task) throw ();
 		private:
 			/*!
 			 * Updates the DeliveryPredictabilityMap in the event that a neighbor has been encountered.
@@ -153,35 +151,27 @@ namespace dtn
 
 			ibrcommon::File _persistent_file; ///< This file is used to store persistent routing data
 
-			class Task
-			{
-			public:
-				virtual ~Task() {};
-				virtual std::string toString() const = 0;
-			};
-
-			class SearchNextBundleTask : public Task
+			class SearchNextBundleTask : public RoutingExecutor::Task
 			{
 			public:
 				SearchNextBundleTask(const dtn::data::EID &eid);
 				virtual ~SearchNextBundleTask();
 
-				virtual std::string toString() const;
+				virtual std::string toString();
+				virtual bool isCoalescable() const;
 
 				const dtn::data::EID eid;
 			};
 
-			class NextExchangeTask : public Task
+			class NextExchangeTask : public RoutingExecutor::Task
 			{
 			public:
 				NextExchangeTask();
 				virtual ~NextExchangeTask();
 
-				virtual std::string toString() const;
+				virtual std::string toString();
 			};
 
-			ibrcommon::Queue<Task* > _taskqueue;
-
 		public:
 			/*!
 			 * \brief The GRTR forwarding strategy.
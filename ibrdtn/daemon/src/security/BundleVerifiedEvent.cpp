@@ -0,0 +1,55 @@
+/*
+ * BundleVerifiedEvent.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "security/BundleVerifiedEvent.h"
+#include "core/EventDispatcher.h"
+
+namespace dtn
+{
+	namespace security
+	{
+		BundleVerifiedEvent::BundleVerifiedEvent(const dtn::data::EID &p, const dtn::data::Bundle &b)
+		 : peer(p), bundle(b)
+		{
+		}
+
+		BundleVerifiedEvent::~BundleVerifiedEvent()
+		{
+		}
+
+		void BundleVerifiedEvent::raise(const dtn::data::EID &peer, const dtn::data::Bundle &bundle)
+		{
+			// raise the new event
+			dtn::core::EventDispatcher<BundleVerifiedEvent>::queue( new BundleVerifiedEvent(peer, bundle) );
+		}
+
+		const std::string BundleVerifiedEvent::getName() const
+		{
+			return "BundleVerifiedEvent";
+		}
+
+		std::string BundleVerifiedEvent::getMessage() const
+		{
+			return "bundle " + bundle.toString() + " from " + peer.getString() + " verified";
+		}
+	}
+}
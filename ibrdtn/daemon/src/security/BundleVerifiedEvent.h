@@ -0,0 +1,60 @@
+/*
+ * BundleVerifiedEvent.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef BUNDLEVERIFIEDEVENT_H_
+#define BUNDLEVERIFIEDEVENT_H_
+
+#include "core/Event.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/EID.h>
+
+namespace dtn
+{
+	namespace security
+	{
+		/**
+		 * This event is raised by the SecurityProcessor once the security
+		 * blocks of a received bundle have been verified.
+		 */
+		class BundleVerifiedEvent : public dtn::core::Event
+		{
+		public:
+			virtual ~BundleVerifiedEvent();
+
+			const std::string getName() const;
+			std::string getMessage() const;
+
+			// the neighbor the bundle has been received from
+			const dtn::data::EID peer;
+
+			// the verified bundle
+			const dtn::data::Bundle bundle;
+
+			static void raise(const dtn::data::EID &peer, const dtn::data::Bundle &bundle);
+
+		private:
+			BundleVerifiedEvent(const dtn::data::EID &peer, const dtn::data::Bundle &bundle);
+		};
+	}
+}
+
+#endif /* BUNDLEVERIFIEDEVENT_H_ */
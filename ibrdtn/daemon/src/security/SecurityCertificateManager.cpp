@@ -121,6 +121,7 @@ namespace dtn
 				// load configuration
 				onConfigurationChanged( dtn::daemon::Configuration::getInstance() );
 
+				ibrcommon::TLSStream::setKernelOffload(dtn::daemon::Configuration::getInstance().getSecurity().TLSKernelOffload());
 				ibrcommon::TLSStream::init(_cert, _privateKey, _trustedCAPath, !dtn::daemon::Configuration::getInstance().getSecurity().TLSEncryptionDisabled());
 
 				IBRCOMMON_LOGGER_TAG(SecurityCertificateManager::TAG, info) << "Initialization succeeded." << IBRCOMMON_LOGGER_ENDL;
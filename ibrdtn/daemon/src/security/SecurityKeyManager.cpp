@@ -19,15 +19,22 @@
  *
  */
 
+#include "config.h"
 #include "Configuration.h"
 #include "core/BundleCore.h"
 #include "security/SecurityKeyManager.h"
 #include <ibrdtn/data/DTNTime.h>
 #include <ibrcommon/Logger.h>
+#include <ibrcommon/thread/MutexLock.h>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
 #include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
 
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
@@ -46,10 +53,21 @@ namespace dtn
 		}
 
 		SecurityKeyManager::SecurityKeyManager()
+		 : _notify_fd(-1)
 		{
 		}
 
 		SecurityKeyManager::~SecurityKeyManager()
+		{
+			if (_notify_fd != -1) ::close(_notify_fd);
+		}
+
+		SecurityKeyManager::CachedKey::CachedKey(const dtn::security::SecurityKey &k)
+		 : key(k), modified(0)
+		{
+		}
+
+		SecurityKeyManager::CachedKey::~CachedKey()
 		{
 		}
 
@@ -66,6 +84,9 @@ namespace dtn
 				_key = sec.getKey();
 				_ca = sec.getCertificate();
 
+				// watch the key path to drop changed keys from the cache
+				watch();
+
 				// check if there is a local key
 				if (!dtn::core::BundleCore::local.isNone() && !hasKey(dtn::core::BundleCore::local, SecurityKey::KEY_PUBLIC))
 				{
@@ -80,7 +101,121 @@ namespace dtn
 				_path = ibrcommon::File();
 				_key = ibrcommon::File();
 				_ca = ibrcommon::File();
+
+				watch();
+			}
+		}
+
+		void SecurityKeyManager::watch()
+		{
+			ibrcommon::MutexLock l(_cache_lock);
+
+			_cache.clear();
+
+			if (_notify_fd != -1)
+			{
+				::close(_notify_fd);
+				_notify_fd = -1;
+			}
+
+			if (!_path.isValid()) return;
+
+#ifdef HAVE_SYS_INOTIFY_H
+			_notify_fd = inotify_init();
+			if (_notify_fd == -1) return;
+
+			// the notifications are read without blocking on each key look-up
+			::fcntl(_notify_fd, F_SETFL, ::fcntl(_notify_fd, F_GETFL) | O_NONBLOCK);
+
+			if (inotify_add_watch(_notify_fd, _path.getPath().c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO) == -1)
+			{
+				IBRCOMMON_LOGGER_TAG(SecurityKeyManager::TAG, warning) << "can not watch " << _path.getPath() << " for changes" << IBRCOMMON_LOGGER_ENDL;
+				::close(_notify_fd);
+				_notify_fd = -1;
 			}
+#endif
+		}
+
+		void SecurityKeyManager::__poll() const
+		{
+#ifdef HAVE_SYS_INOTIFY_H
+			if (_notify_fd == -1) return;
+
+			char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+			while (true)
+			{
+				const ssize_t len = ::read(_notify_fd, buf, sizeof(buf));
+				if (len <= 0) return;
+
+				for (char *ptr = buf; ptr < buf + len; )
+				{
+					const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(ptr);
+					ptr += sizeof(struct inotify_event) + event->len;
+
+					// events got lost, forget all keys
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						_cache.clear();
+						continue;
+					}
+
+					if (event->len == 0) continue;
+
+					std::string name(event->name);
+
+					// changed meta-data invalidates the key too
+					const std::string meta_ext = ".txt";
+					if ((name.length() > meta_ext.length()) && (name.compare(name.length() - meta_ext.length(), meta_ext.length(), meta_ext) == 0))
+					{
+						name.erase(name.length() - meta_ext.length());
+					}
+
+					_cache.erase(_path.get(name).getPath());
+				}
+			}
+#endif
+		}
+
+		bool SecurityKeyManager::__lookup(const ibrcommon::File &keyfile, dtn::security::SecurityKey &key) const
+		{
+			__poll();
+
+			key_cache::iterator iter = _cache.find(keyfile.getPath());
+			if (iter == _cache.end()) return false;
+
+			CachedKey &entry = (*iter).second;
+
+			// without notifications the modification time of the file is compared
+			if (_notify_fd == -1)
+			{
+				if (!keyfile.exists() || (keyfile.lastmodify() != entry.modified) || (entry.key.getMetaFilename().exists() && (entry.key.getMetaFilename().lastmodify() > entry.modified)))
+				{
+					_cache.erase(iter);
+					return false;
+				}
+			}
+
+			key = entry.key;
+			return true;
+		}
+
+		void SecurityKeyManager::__cache(const ibrcommon::File &keyfile, const dtn::security::SecurityKey &key, const time_t modified) const
+		{
+			// do not cache keys stored outside of the key path, e.g. the default shared key
+			if (key.file.getPath() != keyfile.getPath()) return;
+
+			CachedKey entry(key);
+			entry.modified = modified;
+
+			_cache.erase(keyfile.getPath());
+			_cache.insert(std::make_pair(keyfile.getPath(), entry));
+		}
+
+		void SecurityKeyManager::invalidate(const ibrcommon::File &file) const
+		{
+			ibrcommon::MutexLock l(_cache_lock);
+			_cache.erase(file.getPath());
 		}
 
 		const std::string SecurityKeyManager::hash(const dtn::data::EID &eid)
@@ -151,26 +286,50 @@ namespace dtn
 
 		dtn::security::SecurityKey SecurityKeyManager::get(const std::string &prefix, const dtn::data::EID &ref, const dtn::security::SecurityKey::KeyType type) const throw (SecurityKey::KeyNotFoundException)
 		{
+			const ibrcommon::File keyfile = getKeyFile(prefix, ref, type);
+
+			// hold the lock until the key is cached, an invalidation
+			// while loading would leave an outdated key in the cache
+			ibrcommon::MutexLock l(_cache_lock);
+
 			dtn::security::SecurityKey keydata;
+			if (__lookup(keyfile, keydata)) return keydata;
+
 			keydata.reference = ref.getNode();
 			keydata.type = type;
-			keydata.file = getKeyFile(prefix, ref, type);
+			keydata.file = keyfile;
+
+			// a change during the load is detected by the next look-up
+			const time_t modified = keyfile.exists() ? keyfile.lastmodify() : 0;
 
 			// load security key
 			load(keydata);
+			__cache(keyfile, keydata, modified);
 
 			return keydata;
 		}
 
 		dtn::security::SecurityKey SecurityKeyManager::get(const dtn::data::EID &ref, const dtn::security::SecurityKey::KeyType type) const throw (SecurityKey::KeyNotFoundException)
 		{
+			const ibrcommon::File keyfile = getKeyFile(ref.getNode(), type);
+
+			// hold the lock until the key is cached, an invalidation
+			// while loading would leave an outdated key in the cache
+			ibrcommon::MutexLock l(_cache_lock);
+
 			dtn::security::SecurityKey keydata;
+			if (__lookup(keyfile, keydata)) return keydata;
+
 			keydata.reference = ref.getNode();
 			keydata.type = type;
-			keydata.file = getKeyFile(keydata.reference, type);
+			keydata.file = keyfile;
+
+			// a change during the load is detected by the next look-up
+			const time_t modified = keyfile.exists() ? keyfile.lastmodify() : 0;
 
 			// load security key
 			load(keydata);
+			__cache(keyfile, keydata, modified);
 
 			return keydata;
 		}
@@ -227,6 +386,9 @@ namespace dtn
 			// store meta-data
 			std::ofstream metastream(keydata.getMetaFilename().getPath().c_str(), std::ios::out | std::ios::trunc);
 			metastream << key;
+			metastream.close();
+
+			invalidate(keydata.file);
 		}
 
 		void SecurityKeyManager::store(const std::string &prefix, const dtn::security::SecurityKey &key, const std::string &data)
@@ -243,6 +405,9 @@ namespace dtn
 			// store meta-data
 			std::ofstream metastream(keydata.getMetaFilename().getPath().c_str(), std::ios::out | std::ios::trunc);
 			metastream << key;
+			metastream.close();
+
+			invalidate(keydata.file);
 		}
 
 		void SecurityKeyManager::remove(const SecurityKey &key)
@@ -253,6 +418,8 @@ namespace dtn
 
 			// remove meta file
 			key.getMetaFilename().remove();
+
+			invalidate(key.file);
 		}
 
 		const ibrcommon::File SecurityKeyManager::getKeyFile(const dtn::data::EID &peer, const dtn::security::SecurityKey::KeyType type) const
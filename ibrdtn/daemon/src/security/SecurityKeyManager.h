@@ -28,7 +28,9 @@
 #include <ibrdtn/data/BundleString.h>
 #include <ibrdtn/data/SDNV.h>
 #include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/Mutex.h>
 #include <iostream>
+#include <map>
 
 namespace dtn
 {
@@ -130,6 +132,63 @@ namespace dtn
 			 */
 			void load(dtn::security::SecurityKey &key) const;
 
+			/**
+			 * Entry of the key cache
+			 */
+			class CachedKey
+			{
+			public:
+				CachedKey(const dtn::security::SecurityKey &key);
+				virtual ~CachedKey();
+
+				dtn::security::SecurityKey key;
+
+				// modification time of the key file, used if no
+				// file notifications are available
+				time_t modified;
+			};
+
+			// loaded keys, indexed by the path of the key file which
+			// is derived from the prefix, the EID and the key type
+			typedef std::map<std::string, CachedKey> key_cache;
+
+			/**
+			 * Look-up a key in the cache, returns false if the key has
+			 * not been loaded before or the key file has been changed,
+			 * the cache lock has to be held
+			 */
+			bool __lookup(const ibrcommon::File &keyfile, dtn::security::SecurityKey &key) const;
+
+			/**
+			 * Put a loaded key into the cache along with the modification
+			 * time of the key file before it was loaded,
+			 * the cache lock has to be held
+			 */
+			void __cache(const ibrcommon::File &keyfile, const dtn::security::SecurityKey &key, const time_t modified) const;
+
+			/**
+			 * Remove a key from the cache, the key file or the meta-data
+			 * file could be given
+			 */
+			void invalidate(const ibrcommon::File &file) const;
+
+			/**
+			 * Start watching the key path for changes
+			 */
+			void watch();
+
+			/**
+			 * Process all pending file notifications,
+			 * the cache lock has to be held
+			 */
+			void __poll() const;
+
+			mutable ibrcommon::Mutex _cache_lock;
+			mutable key_cache _cache;
+
+			// inotify descriptor watching the key path
+			int _notify_fd;
+
 			ibrcommon::File _path;
 			ibrcommon::File _ca;
 			ibrcommon::File _key;
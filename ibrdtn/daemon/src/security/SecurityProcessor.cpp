@@ -0,0 +1,336 @@
+/*
+ * SecurityProcessor.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "security/SecurityProcessor.h"
+#include "security/SecurityManager.h"
+#include "security/BundleVerifiedEvent.h"
+#include "core/BundleCore.h"
+#include "core/BundleEvent.h"
+
+#include <ibrdtn/security/BundleAuthenticationBlock.h>
+#include <ibrdtn/security/PayloadIntegrityBlock.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Logger.h>
+
+#include <algorithm>
+#include <sstream>
+#include <unistd.h>
+
+namespace dtn
+{
+	namespace security
+	{
+		const std::string SecurityProcessor::TAG = "SecurityProcessor";
+		const dtn::data::Size SecurityProcessor::DEFAULT_LIMIT = 64;
+
+		ibrcommon::Mutex SecurityProcessor::_instance_lock;
+		SecurityProcessor* SecurityProcessor::_instance = NULL;
+
+		SecurityProcessor::SecurityProcessor(unsigned int workers, dtn::data::Size limit)
+		 : _worker_count(workers > 0 ? workers : std::max(1L, ::sysconf(_SC_NPROCESSORS_ONLN))),
+		   _limit(limit > 0 ? limit : DEFAULT_LIMIT), _running(false), _submitters(0),
+		   _stats_queued(0), _stats_processed(0), _stats_failed(0), _stats_blocked(0), _stats_max_pending(0)
+		{
+		}
+
+		SecurityProcessor::~SecurityProcessor()
+		{
+		}
+
+		const std::string SecurityProcessor::getName() const
+		{
+			return "SecurityProcessor";
+		}
+
+		void SecurityProcessor::componentUp() throw ()
+		{
+			{
+				ibrcommon::MutexLock l(_jobs_cond);
+				_running = true;
+			}
+
+			for (unsigned int i = 0; i < _worker_count; ++i)
+			{
+				Worker *w = new Worker(*this);
+				_workers.push_back(w);
+				w->start();
+			}
+
+			IBRCOMMON_LOGGER_TAG(SecurityProcessor::TAG, info) << "started with " << _worker_count << " workers and " << _limit << " queue slots" << IBRCOMMON_LOGGER_ENDL;
+
+			ibrcommon::MutexLock l(_instance_lock);
+			_instance = this;
+		}
+
+		void SecurityProcessor::componentDown() throw ()
+		{
+			// no new jobs are accepted from now on
+			{
+				ibrcommon::MutexLock l(_instance_lock);
+				if (_instance == this) _instance = NULL;
+			}
+
+			// stop accepting jobs and wake-up blocked submitters, the
+			// workers process all pending jobs before they leave
+			{
+				ibrcommon::MutexLock l(_jobs_cond);
+				_running = false;
+				_jobs_cond.signal(true);
+			}
+
+			for (std::vector<Worker*>::iterator iter = _workers.begin(); iter != _workers.end(); ++iter)
+			{
+				Worker *w = (*iter);
+				w->stop();
+				w->join();
+				delete w;
+			}
+			_workers.clear();
+
+			// wait until all submitters left this processor
+			ibrcommon::MutexLock l(_jobs_cond);
+			while (_submitters > 0) _jobs_cond.wait();
+		}
+
+		bool SecurityProcessor::submit(Operation op, const dtn::data::EID &peer, const dtn::data::Bundle &bundle) throw ()
+		{
+			SecurityProcessor *p = NULL;
+
+			// register as submitter, thus the processor is not stopped until we left
+			{
+				ibrcommon::MutexLock l(_instance_lock);
+				if (_instance == NULL) return false;
+
+				p = _instance;
+
+				ibrcommon::MutexLock lj(p->_jobs_cond);
+				++p->_submitters;
+			}
+
+			// push the job without holding the instance lock, it may block
+			Job *job = new Job(op, peer, bundle);
+			const bool ret = p->push(job);
+			if (!ret) delete job;
+
+			ibrcommon::MutexLock l(p->_jobs_cond);
+			--p->_submitters;
+			p->_jobs_cond.signal(true);
+
+			return ret;
+		}
+
+		bool SecurityProcessor::push(Job *job) throw ()
+		{
+			ibrcommon::MutexLock l(_jobs_cond);
+
+			// count each submission which has to wait for a free slot
+			if (_running && (_jobs.size() >= _limit))
+			{
+				ibrcommon::MutexLock ls(_stats_lock);
+				++_stats_blocked;
+			}
+
+			while (_running && (_jobs.size() >= _limit))
+			{
+				_jobs_cond.wait();
+			}
+
+			if (!_running) return false;
+
+			_jobs.push_back(job);
+			_jobs_cond.signal(true);
+
+			ibrcommon::MutexLock ls(_stats_lock);
+			++_stats_queued;
+			if (_jobs.size() > _stats_max_pending) _stats_max_pending = _jobs.size();
+
+			return true;
+		}
+
+		SecurityProcessor::Job* SecurityProcessor::pop() throw ()
+		{
+			ibrcommon::MutexLock l(_jobs_cond);
+
+			while (_running && _jobs.empty())
+			{
+				_jobs_cond.wait();
+			}
+
+			// pending jobs are processed even if the processor is stopping
+			if (_jobs.empty()) return NULL;
+
+			Job *job = _jobs.front();
+			_jobs.pop_front();
+
+			// there is room for blocked submitters
+			_jobs_cond.signal(true);
+
+			return job;
+		}
+
+		dtn::data::Size SecurityProcessor::pending() const throw ()
+		{
+			ibrcommon::MutexLock l(_jobs_cond);
+			return _jobs.size();
+		}
+
+		bool SecurityProcessor::isSecured(const dtn::data::Bundle &bundle) throw ()
+		{
+			for (dtn::data::Bundle::const_iterator iter = bundle.begin(); iter != bundle.end(); ++iter)
+			{
+				const dtn::data::block_t type = (**iter).getType();
+
+				if (type == dtn::security::BundleAuthenticationBlock::BLOCK_TYPE) return true;
+				if (type == dtn::security::PayloadIntegrityBlock::BLOCK_TYPE) return true;
+			}
+
+			return false;
+		}
+
+		bool SecurityProcessor::isRequested(const dtn::data::Bundle &bundle) throw ()
+		{
+			return bundle.get(dtn::data::PrimaryBlock::DTNSEC_REQUEST_ENCRYPT) || bundle.get(dtn::data::PrimaryBlock::DTNSEC_REQUEST_SIGN);
+		}
+
+		void SecurityProcessor::process(Job &job) throw ()
+		{
+			bool success = true;
+
+			// bundles which failed the security checks were never accepted and
+			// are dropped silently, other errors delete an accepted bundle
+			bool deleted = false;
+
+			switch (job.op)
+			{
+				case OP_VERIFY:
+				{
+					try {
+						// lets see if signatures and hashes are correct and remove them if possible
+						dtn::security::SecurityManager::getInstance().verify(job.bundle);
+
+						// hand the verified bundle back to the router
+						dtn::security::BundleVerifiedEvent::raise(job.peer, job.bundle);
+					} catch (const dtn::security::VerificationFailedException &ex) {
+						IBRCOMMON_LOGGER_TAG(SecurityProcessor::TAG, notice) << "Security checks failed (" << ex.what() << "), bundle will be dropped: " << job.bundle.toString() << IBRCOMMON_LOGGER_ENDL;
+						success = false;
+					} catch (const std::exception &ex) {
+						IBRCOMMON_LOGGER_TAG(SecurityProcessor::TAG, error) << "Verification of " << job.bundle.toString() << " failed, bundle will be dropped: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+						success = false;
+						deleted = true;
+					}
+					break;
+				}
+
+				case OP_SECURE:
+				{
+					try {
+						dtn::core::BundleCore::secure(job.bundle);
+						dtn::core::BundleCore::forward(job.peer, job.bundle);
+					} catch (const std::exception &ex) {
+						IBRCOMMON_LOGGER_TAG(SecurityProcessor::TAG, error) << "Unable to secure " << job.bundle.toString() << ", bundle will be dropped: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+						success = false;
+						deleted = true;
+					}
+					break;
+				}
+			}
+
+			// raise BundleEvent because we have to drop the bundle
+			if (deleted) dtn::core::BundleEvent::raise(dtn::data::MetaBundle::create(job.bundle), dtn::core::BUNDLE_DELETED);
+
+			ibrcommon::MutexLock l(_stats_lock);
+			++_stats_processed;
+			if (!success) ++_stats_failed;
+		}
+
+		void SecurityProcessor::getStats(dtn::net::ConvergenceLayer::stats_data &data)
+		{
+			ibrcommon::MutexLock l(_instance_lock);
+			if (_instance == NULL) return;
+
+			SecurityProcessor &p = *_instance;
+			const dtn::data::Size pending = p.pending();
+
+			ibrcommon::MutexLock ls(p._stats_lock);
+
+			std::stringstream ss;
+
+			ss << pending; data["security|pending"] = ss.str(); ss.str("");
+			ss << p._limit; data["security|limit"] = ss.str(); ss.str("");
+			ss << p._stats_max_pending; data["security|max-pending"] = ss.str(); ss.str("");
+			ss << p._stats_queued; data["security|queued"] = ss.str(); ss.str("");
+			ss << p._stats_processed; data["security|processed"] = ss.str(); ss.str("");
+			ss << p._stats_failed; data["security|failed"] = ss.str(); ss.str("");
+			ss << p._stats_blocked; data["security|blocked"] = ss.str();
+		}
+
+		void SecurityProcessor::resetStats()
+		{
+			ibrcommon::MutexLock l(_instance_lock);
+			if (_instance == NULL) return;
+
+			SecurityProcessor &p = *_instance;
+			ibrcommon::MutexLock ls(p._stats_lock);
+
+			p._stats_queued = 0;
+			p._stats_processed = 0;
+			p._stats_failed = 0;
+			p._stats_blocked = 0;
+			p._stats_max_pending = 0;
+		}
+
+		SecurityProcessor::Job::Job(Operation o, const dtn::data::EID &p, const dtn::data::Bundle &b)
+		 : op(o), peer(p), bundle(b)
+		{
+		}
+
+		SecurityProcessor::Job::~Job()
+		{
+		}
+
+		SecurityProcessor::Worker::Worker(SecurityProcessor &processor)
+		 : _processor(processor)
+		{
+		}
+
+		SecurityProcessor::Worker::~Worker()
+		{
+			join();
+		}
+
+		void SecurityProcessor::Worker::run() throw ()
+		{
+			Job *job = NULL;
+
+			while ((job = _processor.pop()) != NULL)
+			{
+				_processor.process(*job);
+				delete job;
+			}
+		}
+
+		void SecurityProcessor::Worker::__cancellation() throw ()
+		{
+			// the processor wakes up its workers on shutdown
+		}
+	}
+}
@@ -0,0 +1,182 @@
+/*
+ * SecurityProcessor.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef SECURITYPROCESSOR_H_
+#define SECURITYPROCESSOR_H_
+
+#include "Component.h"
+#include "net/ConvergenceLayer.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/EID.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <vector>
+#include <deque>
+
+namespace dtn
+{
+	namespace security
+	{
+		/**
+		 * The security processor runs the expensive BSP operations on a pool
+		 * of worker threads. Received bundles are verified and locally created
+		 * bundles are encrypted and signed concurrently to the routing and the
+		 * convergence layers. The results are re-injected as events.
+		 *
+		 * The number of pending jobs is limited. If the queue is full, the
+		 * submitting thread is blocked until a worker takes the next job.
+		 * On shutdown, the workers process all pending jobs before they leave.
+		 */
+		class SecurityProcessor : public dtn::daemon::IntegratedComponent
+		{
+			static const std::string TAG;
+
+		public:
+			enum Operation
+			{
+				// verify the BAB and PIB of a received bundle and raise a BundleVerifiedEvent
+				OP_VERIFY = 0,
+
+				// encrypt and sign a local bundle as requested and inject it
+				OP_SECURE = 1
+			};
+
+			/**
+			 * Constructor
+			 * @param workers Number of worker threads, zero selects the number of processors.
+			 * @param limit Maximum number of pending jobs, zero selects a default.
+			 */
+			SecurityProcessor(unsigned int workers = 0, dtn::data::Size limit = 0);
+			virtual ~SecurityProcessor();
+
+			virtual const std::string getName() const;
+
+			/**
+			 * Queue a bundle for processing. If no processor is running, false is
+			 * returned and the caller has to process the bundle by itself.
+			 */
+			static bool submit(Operation op, const dtn::data::EID &peer, const dtn::data::Bundle &bundle) throw ();
+
+			/**
+			 * Returns true if the bundle contains authentication or integrity blocks
+			 */
+			static bool isSecured(const dtn::data::Bundle &bundle) throw ();
+
+			/**
+			 * Returns true if encryption or signing is requested for the bundle
+			 */
+			static bool isRequested(const dtn::data::Bundle &bundle) throw ();
+
+			/**
+			 * Add the statistics of the running processor
+			 */
+			static void getStats(dtn::net::ConvergenceLayer::stats_data &data);
+
+			/**
+			 * Reset the statistics
+			 */
+			static void resetStats();
+
+		protected:
+			virtual void componentUp() throw ();
+			virtual void componentDown() throw ();
+
+		private:
+			class Job
+			{
+			public:
+				Job(Operation op, const dtn::data::EID &peer, const dtn::data::Bundle &bundle);
+				virtual ~Job();
+
+				const Operation op;
+				const dtn::data::EID peer;
+				dtn::data::Bundle bundle;
+			};
+
+			class Worker : public ibrcommon::JoinableThread
+			{
+			public:
+				Worker(SecurityProcessor &processor);
+				virtual ~Worker();
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				SecurityProcessor &_processor;
+			};
+
+			/**
+			 * Put a job into the queue, blocks if the queue is full
+			 * @return False, if the processor has been stopped meanwhile
+			 */
+			bool push(Job *job) throw ();
+
+			/**
+			 * Take the next job out of the queue, blocks if the queue is empty
+			 * @return The next job or NULL if the processor has been stopped
+			 */
+			Job* pop() throw ();
+
+			/**
+			 * Returns the number of pending jobs
+			 */
+			dtn::data::Size pending() const throw ();
+
+			/**
+			 * Process a single job
+			 */
+			void process(Job &job) throw ();
+
+			static const dtn::data::Size DEFAULT_LIMIT;
+
+			const unsigned int _worker_count;
+			const dtn::data::Size _limit;
+
+			// pending jobs, the conditional is signaled on any change
+			mutable ibrcommon::Conditional _jobs_cond;
+			std::deque<Job*> _jobs;
+			bool _running;
+
+			// number of threads within submit()
+			dtn::data::Size _submitters;
+
+			std::vector<Worker*> _workers;
+
+			// statistics
+			ibrcommon::Mutex _stats_lock;
+			dtn::data::Size _stats_queued;
+			dtn::data::Size _stats_processed;
+			dtn::data::Size _stats_failed;
+			dtn::data::Size _stats_blocked;
+			dtn::data::Size _stats_max_pending;
+
+			// the running processor
+			static ibrcommon::Mutex _instance_lock;
+			static SecurityProcessor *_instance;
+		};
+	}
+}
+
+#endif /* SECURITYPROCESSOR_H_ */
@@ -22,6 +22,7 @@
 #include "core/BundleCore.h"
 #include "storage/BundleStorage.h"
 #include "core/CustodyEvent.h"
+#include "core/BundleTracer.h"
 #include <ibrdtn/data/PayloadBlock.h>
 #include <ibrdtn/data/BundleID.h>
 #include <ibrcommon/thread/MutexLock.h>
@@ -32,7 +33,11 @@ namespace dtn
 	namespace storage
 	{
 		BundleStorage::BundleStorage(const dtn::data::Length &maxsize)
-		 : _faulty(false), _maxsize(maxsize), _currentsize(0)
+		 : _faulty(false),
+		   _store_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_storage_store_seconds", "Time spent to store a bundle", "", 0.000001)),
+		   _get_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_storage_get_seconds", "Time spent to load a bundle", "", 0.000001)),
+		   _search_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_storage_search_seconds", "Time spent to search for bundles", "", 0.000001)),
+		   _maxsize(maxsize), _currentsize(0)
 		{
 		}
 
@@ -170,6 +175,7 @@ namespace dtn
 		void BundleStorage::eventBundleAdded(const dtn::data::MetaBundle &b) throw ()
 		{
 			IBRCOMMON_LOGGER_DEBUG_TAG("BundleStorage", 2) << "add bundle to index: " << b.toString() << IBRCOMMON_LOGGER_ENDL;
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_STORED, b);
 
 			for (index_list::iterator it = _indexes.begin(); it != _indexes.end(); ++it) {
 				BundleIndex &index = (**it);
@@ -180,6 +186,7 @@ namespace dtn
 		void BundleStorage::eventBundleRemoved(const dtn::data::BundleID &id) throw ()
 		{
 			IBRCOMMON_LOGGER_DEBUG_TAG("BundleStorage", 2) << "remove bundle from index: " << id.toString() << IBRCOMMON_LOGGER_ENDL;
+			dtn::core::BundleTracer::trace(dtn::core::BundleTracer::TRACE_PURGED, id);
 
 			for (index_list::iterator it = _indexes.begin(); it != _indexes.end(); ++it) {
 				BundleIndex &index = (**it);
@@ -32,6 +32,7 @@
 #include <ibrdtn/data/CustodySignalBlock.h>
 #include <ibrcommon/data/BloomFilter.h>
 #include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/Metrics.h>
 
 #include <stdexcept>
 #include <iterator>
@@ -195,6 +196,11 @@ namespace dtn
 
 			bool _faulty;
 
+			// latency of store(), get() and the bundle search in microseconds
+			ibrcommon::Histogram &_store_latency;
+			ibrcommon::Histogram &_get_latency;
+			ibrcommon::Histogram &_search_latency;
+
 		private:
 			ibrcommon::Mutex _sizelock;
 			const dtn::data::Length _maxsize;
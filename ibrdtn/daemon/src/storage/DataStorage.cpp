@@ -19,7 +19,9 @@
  *
  */
 
+#include "config.h"
 #include "storage/DataStorage.h"
+#include <ibrcommon/Logger.h>
 #include <typeinfo>
 #include <sstream>
 #include <iomanip>
@@ -32,6 +34,11 @@
 #include <cstring>
 #include <cerrno>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace dtn
 {
 	namespace storage
@@ -86,10 +93,56 @@ namespace dtn
 		std::istream& DataStorage::istream::operator*()
 		{ return *_stream; }
 
-		DataStorage::DataStorage(Callback &callback, const ibrcommon::File &path, unsigned int write_buffer, bool initialize)
-		 : _callback(callback), _path(path), _tasks(), _store_sem(write_buffer), _store_limited(write_buffer > 0), _faulty(false)
+		const size_t DataStorage::Statistics::LATENCY_BUCKETS;
+
+		DataStorage::Statistics::Statistics()
+		 : queue_depth(0), queue_depth_max(0), stored(0), store_failed(0), removed(0), remove_failed(0), batches(0), syncs(0)
+		{
+			for (size_t i = 0; i < LATENCY_BUCKETS; ++i)
+			{
+				store_latency[i] = 0;
+				remove_latency[i] = 0;
+			}
+		}
+
+		DataStorage::Statistics::~Statistics()
+		{
+		}
+
+		size_t DataStorage::Statistics::getBucket(double microseconds)
+		{
+			size_t bucket = 0;
+			for (double limit = 1.0; (bucket < (LATENCY_BUCKETS - 1)) && (microseconds >= limit); limit *= 2.0)
+			{
+				++bucket;
+			}
+			return bucket;
+		}
+
+		const size_t DataStorage::BATCH_LIMIT = 64;
+		const size_t DataStorage::SYNCFS_THRESHOLD = 16;
+
+		DataStorage::DataStorage(Callback &callback, const ibrcommon::File &path, unsigned int write_buffer, bool initialize, unsigned int lanes, bool sync)
+		 : _callback(callback), _path(path), _store_sem(write_buffer), _store_limited(write_buffer > 0), _faulty(false), _sync(sync),
+		   _queue_gauge(ibrcommon::MetricsRegistry::getInstance().gauge("dtnd_datastorage_queue_length", "Store and remove tasks not completed yet")),
+		   _store_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_datastorage_store_seconds", "Time from queuing to completion of a store task", "", 0.000001)),
+		   _remove_latency(ibrcommon::MetricsRegistry::getInstance().histogram("dtnd_datastorage_remove_seconds", "Time from queuing to completion of a remove task", "", 0.000001)),
+		   _stored(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_tasks_total", "Store and remove tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "stored"))),
+		   _store_failed(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_tasks_total", "Store and remove tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "store_failed"))),
+		   _removed(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_tasks_total", "Store and remove tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "removed"))),
+		   _remove_failed(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_tasks_total", "Store and remove tasks by their outcome", ibrcommon::MetricsRegistry::label("result", "remove_failed"))),
+		   _batches(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_batches_total", "Batches of tasks processed by the I/O lanes")),
+		   _syncs(ibrcommon::MetricsRegistry::getInstance().counter("dtnd_datastorage_syncs_total", "Sync operations to flush stored data to the disk"))
 		// limit the number of bundles in the write buffer
 		{
+			// create at least one lane
+			if (lanes == 0) lanes = 1;
+
+			for (unsigned int i = 0; i < lanes; ++i)
+			{
+				_lanes.push_back(new Lane(*this));
+			}
+
 			// initialize the storage
 			if (initialize)
 			{
@@ -101,6 +154,7 @@ namespace dtn
 
 					for (std::list<ibrcommon::File>::iterator iter = files.begin(); iter != files.end(); ++iter)
 					{
+						if ((*iter).isSystem()) continue;
 						(*iter).remove(true);
 					}
 				}
@@ -114,24 +168,42 @@ namespace dtn
 
 		DataStorage::~DataStorage()
 		{
-			_tasks.abort();
+			__cancellation();
 			join();
 
-			// delete all task objects
-			try {
-				while (true)
-				{
-					Task *t = _tasks.take();
-					delete t;
+			for (std::vector<Lane*>::iterator it = _lanes.begin(); it != _lanes.end(); ++it)
+			{
+				Lane *lane = (*it);
+
+				// make sure the lane is not running anymore
+				lane->join();
+
+				// delete all task objects
+				try {
+					while (true)
+					{
+						Task *t = lane->tasks.take();
+						_queue_gauge.add(-1);
+						delete t;
+					}
+				} catch (const ibrcommon::QueueUnblockedException&) {
+					// exit
 				}
-			} catch (const ibrcommon::QueueUnblockedException&) {
-				// exit
+
+				delete lane;
 			}
 		}
 
 		void DataStorage::reset()
 		{
 			JoinableThread::reset();
+
+			for (size_t i = 0; i < _lanes.size(); ++i)
+			{
+				// the first lane is processed by this thread and never started
+				if (i > 0) _lanes[i]->reset();
+				_lanes[i]->tasks.reset();
+			}
 		}
 
 		void DataStorage::setFaulty(bool mode)
@@ -139,30 +211,119 @@ namespace dtn
 			_faulty = mode;
 		}
 
-		void DataStorage::iterateAll()
+		const DataStorage::Statistics DataStorage::getStatistics()
+		{
+			ibrcommon::MutexLock l(_pending_cond);
+			return _stats;
+		}
+
+		void DataStorage::iterateAll(unsigned int threads)
 		{
-			std::list<ibrcommon::File> files;
-			_path.getFiles(files);
+			std::vector<ibrcommon::File> files;
+			collect(_path, files);
 
-			for (std::list<ibrcommon::File>::const_iterator iter = files.begin(); iter != files.end(); ++iter)
+			if ((threads <= 1) || (files.size() < threads))
 			{
-				if (!(*iter).isSystem() && !(*iter).isDirectory())
+				for (std::vector<ibrcommon::File>::const_iterator iter = files.begin(); iter != files.end(); ++iter)
 				{
 					DataStorage::Hash hash(*iter);
-					DataStorage::istream stream(_global_mutex, *iter);
+					DataStorage::istream stream(getLane(hash).mutex, *iter);
 
 					_callback.iterateDataStorage(hash, stream);
 				}
+				return;
+			}
+
+			// distribute the files among the readers
+			std::list<Reader*> readers;
+			for (unsigned int i = 0; i < threads; ++i)
+			{
+				readers.push_back(new Reader(*this, files, i, threads));
+			}
+
+			for (std::list<Reader*>::iterator it = readers.begin(); it != readers.end(); ++it)
+			{
+				try {
+					(*it)->start();
+				} catch (const ibrcommon::ThreadException &ex) {
+					IBRCOMMON_LOGGER_TAG("DataStorage", error) << "failed to start reader: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				}
+			}
+
+			for (std::list<Reader*>::iterator it = readers.begin(); it != readers.end(); ++it)
+			{
+				(*it)->join();
+				delete (*it);
+			}
+		}
+
+		void DataStorage::list(std::set<Hash> &hashes) const
+		{
+			std::vector<ibrcommon::File> files;
+			collect(_path, files);
+
+			for (std::vector<ibrcommon::File>::const_iterator iter = files.begin(); iter != files.end(); ++iter)
+			{
+				hashes.insert(DataStorage::Hash(*iter));
+			}
+		}
+
+		void DataStorage::collect(const ibrcommon::File &path, std::vector<ibrcommon::File> &files) const
+		{
+			std::list<ibrcommon::File> entries;
+			path.getFiles(entries);
+
+			for (std::list<ibrcommon::File>::const_iterator iter = entries.begin(); iter != entries.end(); ++iter)
+			{
+				const ibrcommon::File &file = (*iter);
+
+				// skip hidden files, they are not managed by the data storage
+				if (file.isSystem() || (file.getBasename()[0] == '.')) continue;
+
+				if (file.isDirectory())
+				{
+					// descend into the fan-out directories
+					if ((path == _path) && (file.getBasename().length() == 2)) collect(file, files);
+				}
+				else
+				{
+					files.push_back(file);
+				}
+			}
+		}
+
+		DataStorage::Reader::Reader(DataStorage &storage, const std::vector<ibrcommon::File> &files, size_t first, size_t step)
+		 : _storage(storage), _files(files), _first(first), _step(step)
+		{
+		}
+
+		DataStorage::Reader::~Reader()
+		{
+			join();
+		}
+
+		void DataStorage::Reader::run() throw ()
+		{
+			for (size_t i = _first; i < _files.size(); i += _step)
+			{
+				DataStorage::Hash hash(_files[i]);
+				DataStorage::istream stream(_mutex, _files[i]);
+
+				_storage._callback.iterateDataStorage(hash, stream);
 			}
 		}
 
+		void DataStorage::Reader::__cancellation() throw ()
+		{
+		}
+
 		void DataStorage::store(const DataStorage::Hash &hash, DataStorage::Container *data)
 		{
 			// wait for resources
 			if (_store_limited) _store_sem.wait();
 
 			// put the task into the queue
-			_tasks.push( new StoreDataTask(hash, data) );
+			enqueue(hash, new StoreDataTask(hash, data));
 		}
 
 		const DataStorage::Hash DataStorage::store(DataStorage::Container *data)
@@ -175,105 +336,435 @@ namespace dtn
 
 		DataStorage::istream DataStorage::retrieve(const DataStorage::Hash &hash) throw (DataNotAvailableException)
 		{
-			ibrcommon::File file = _path.get(hash.value);
+			return DataStorage::istream(getLane(hash).mutex, locate(hash));
+		}
+
+		void DataStorage::remove(const DataStorage::Hash &hash)
+		{
+			enqueue(hash, new RemoveDataTask(hash));
+		}
 
-			if (!file.exists())
+		void DataStorage::enqueue(const Hash &hash, Task *t)
+		{
 			{
-				throw DataNotAvailableException("file " + file.getPath() + " not found");
+				ibrcommon::MutexLock l(_pending_cond);
+				_stats.queue_depth++;
+				if (_stats.queue_depth > _stats.queue_depth_max) _stats.queue_depth_max = _stats.queue_depth;
 			}
 
-			return DataStorage::istream(_global_mutex, file);
+			_queue_gauge.add(1);
+
+			getLane(hash).tasks.push(t);
 		}
 
-		void DataStorage::remove(const DataStorage::Hash &hash)
+		void DataStorage::wait()
 		{
-			_tasks.push( new RemoveDataTask(hash) );
+			ibrcommon::MutexLock l(_pending_cond);
+			while (_stats.queue_depth > 0) _pending_cond.wait();
 		}
 
-		void DataStorage::wait()
+		unsigned int DataStorage::getBucket(const Hash &hash)
 		{
-			_tasks.wait(ibrcommon::Queue< Task* >::QUEUE_EMPTY);
+			// FNV-1a, the hash values itself share a common prefix
+			unsigned int h = 2166136261U;
+			for (std::string::const_iterator it = hash.value.begin(); it != hash.value.end(); ++it)
+			{
+				h ^= static_cast<unsigned char>(*it);
+				h *= 16777619U;
+			}
+			return (h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24)) & 0xff;
+		}
+
+		DataStorage::Lane& DataStorage::getLane(const Hash &hash)
+		{
+			return *_lanes[getBucket(hash) % _lanes.size()];
+		}
+
+		ibrcommon::File DataStorage::getFile(const Hash &hash) const
+		{
+			std::stringstream ss;
+			ss << std::hex << std::setw(2) << std::setfill('0') << getBucket(hash);
+			return _path.get(ss.str()).get(hash.value);
+		}
+
+		ibrcommon::File DataStorage::locate(const Hash &hash) const throw (DataNotAvailableException)
+		{
+			ibrcommon::File file = getFile(hash);
+			if (file.exists()) return file;
+
+			// look for a file of the flat layout
+			file = _path.get(hash.value);
+			if (file.exists()) return file;
+
+			throw DataNotAvailableException("file " + file.getPath() + " not found");
+		}
+
+		void DataStorage::setup() throw ()
+		{
+			// the first lane is processed by this thread
+			for (size_t i = 1; i < _lanes.size(); ++i)
+			{
+				try {
+					_lanes[i]->start();
+				} catch (const ibrcommon::ThreadException&) {
+				}
+			}
+		}
+
+		void DataStorage::finally() throw ()
+		{
+			for (size_t i = 1; i < _lanes.size(); ++i)
+			{
+				try {
+					_lanes[i]->stop();
+					_lanes[i]->join();
+				} catch (const ibrcommon::ThreadException&) {
+				}
+			}
 		}
 
 		void DataStorage::__cancellation() throw ()
 		{
-			_tasks.abort();
+			for (std::vector<Lane*>::iterator it = _lanes.begin(); it != _lanes.end(); ++it)
+			{
+				(*it)->tasks.abort();
+			}
 		}
 
 		void DataStorage::run() throw ()
+		{
+			process(*_lanes[0]);
+		}
+
+		void DataStorage::process(Lane &lane) throw ()
 		{
 			try {
 				while (true)
 				{
-					_tasks.wait(ibrcommon::Queue<Task*>::QUEUE_NOT_EMPTY);
-					Task *t = _tasks.front();
+					lane.tasks.wait(ibrcommon::Queue<Task*>::QUEUE_NOT_EMPTY);
 
-					try {
-						StoreDataTask &store = dynamic_cast<StoreDataTask&>(*t);
+					// collect all queued tasks up to the batch limit
+					std::list<Task*> batch;
+					{
+						ibrcommon::Queue<Task*>::Locked q = lane.tasks.exclusive();
+						while (!q.empty() && (batch.size() < BATCH_LIMIT))
+						{
+							batch.push_back(q.front());
+							q.pop();
+						}
+					}
+
+					std::list<StoreDataTask*> stored;
+					std::list<RemoveDataTask*> removals;
+					std::list<int> fds;
+					Statistics stats;
+
+					for (std::list<Task*>::iterator it = batch.begin(); it != batch.end(); ++it)
+					{
+						Task *t = (*it);
 
 						try {
-							ibrcommon::File destination = _path.get(store.hash.value);
+							StoreDataTask &store = dynamic_cast<StoreDataTask&>(*t);
 
+							// a deferred removal of the same hash has to be done first
+							for (std::list<RemoveDataTask*>::const_iterator r = removals.begin(); r != removals.end(); ++r)
 							{
-								ibrcommon::MutexLock l(_global_mutex);
-								std::ofstream stream(destination.getPath().c_str(), ios::out | ios::binary | ios::trunc);
-
-								// check the streams health
-								if (!stream.good() || _faulty)
+								if ((*r)->hash == store.hash)
 								{
-									std::stringstream ss; ss << "unable to open filestream [" << std::strerror(errno) << "]";
-									throw ibrcommon::IOException(ss.str());
+									unlink(lane, removals, stats);
+									break;
 								}
-
-								store._container->serialize(stream);
-								stream.close();
 							}
 
-							// release resources
-							if (_store_limited) _store_sem.post();
+							try {
+								const int fd = write(lane, store);
+								if (fd >= 0) fds.push_back(fd);
 
-							// notify the stored item
-							_callback.eventDataStorageStored(store.hash);
-						} catch (const ibrcommon::Exception &ex) {
-							// release resources
-							if (_store_limited) _store_sem.post();
+								// notify after the data has been synced
+								stored.push_back(&store);
+							} catch (const ibrcommon::Exception &ex) {
+								// release resources
+								if (_store_limited) _store_sem.post();
 
-							// notify the fail of store action
-							_callback.eventDataStorageStoreFailed(store.hash, ex);
-						}
-					} catch (const std::bad_cast&) {
-					}
+								stats.store_failed++;
 
-					try {
-						RemoveDataTask &remove = dynamic_cast<RemoveDataTask&>(*t);
+								// notify the fail of store action
+								_callback.eventDataStorageStoreFailed(store.hash, ex);
+							}
+						} catch (const std::bad_cast&) {
+						}
 
 						try {
-							ibrcommon::File destination = _path.get(remove.hash.value);
-							{
-								ibrcommon::MutexLock l(_global_mutex);
-								if (!destination.exists())
-								{
-									throw DataNotAvailableException();
-								}
-								destination.remove();
-							}
-							_callback.eventDataStorageRemoved(remove.hash);
-						} catch (const ibrcommon::Exception &ex) {
-							_callback.eventDataStorageRemoveFailed(remove.hash, ex);
+							RemoveDataTask &remove = dynamic_cast<RemoveDataTask&>(*t);
+
+							// defer removals to the end of the batch
+							removals.push_back(&remove);
+						} catch (const std::bad_cast&) {
 						}
-					} catch (const std::bad_cast&) {
+					}
+
+					// flush all written files
+					if (!fds.empty())
+					{
+						sync(fds);
+						stats.syncs++;
+					}
+
+					for (std::list<StoreDataTask*>::iterator it = stored.begin(); it != stored.end(); ++it)
+					{
+						StoreDataTask &store = **it;
+
+						// release resources
+						if (_store_limited) _store_sem.post();
+
+						store.latency.stop();
+						stats.store_latency[Statistics::getBucket(store.latency.getMicroseconds())]++;
+						_store_latency.record(static_cast<uint64_t>(store.latency.getMicroseconds()));
+						stats.stored++;
+
+						// notify the stored item
+						_callback.eventDataStorageStored(store.hash);
+					}
 
+					unlink(lane, removals, stats);
+
+					for (std::list<Task*>::iterator it = batch.begin(); it != batch.end(); ++it)
+					{
+						delete (*it);
+					}
+
+					_queue_gauge.add(-static_cast<int64_t>(batch.size()));
+					_stored.inc(stats.stored);
+					_store_failed.inc(stats.store_failed);
+					_removed.inc(stats.removed);
+					_remove_failed.inc(stats.remove_failed);
+					_syncs.inc(stats.syncs);
+					_batches.inc();
+
+					// merge statistics and signal completion of the batch
+					ibrcommon::MutexLock l(_pending_cond);
+					_stats.queue_depth -= batch.size();
+					_stats.stored += stats.stored;
+					_stats.store_failed += stats.store_failed;
+					_stats.removed += stats.removed;
+					_stats.remove_failed += stats.remove_failed;
+					_stats.syncs += stats.syncs;
+					_stats.batches++;
+
+					for (size_t i = 0; i < Statistics::LATENCY_BUCKETS; ++i)
+					{
+						_stats.store_latency[i] += stats.store_latency[i];
+						_stats.remove_latency[i] += stats.remove_latency[i];
 					}
 
-					delete t;
-					_tasks.pop();
+					_pending_cond.signal(true);
 				}
 			} catch (const ibrcommon::QueueUnblockedException&) {
 				// exit
 			}
 		}
 
+		int DataStorage::write(Lane &lane, StoreDataTask &task) throw (ibrcommon::Exception)
+		{
+			if (_faulty)
+			{
+				throw ibrcommon::IOException("unable to open filestream [faulty mode]");
+			}
+
+			ibrcommon::File destination = getFile(task.hash);
+
+			// create the fan-out directory on first use
+			const unsigned int bucket = getBucket(task.hash);
+			if (lane.directories.find(bucket) == lane.directories.end())
+			{
+				ibrcommon::File dir = destination.getParent();
+				ibrcommon::File::createDirectory(dir);
+				lane.directories.insert(bucket);
+			}
+
+			ibrcommon::MutexLock l(lane.mutex);
+
+			const size_t size = task._container->getSize();
+			int fd = -1;
+
+			std::ios_base::openmode mode = ios::out | ios::binary | ios::trunc;
+
+			if (_sync || (size > 0))
+			{
+				// the descriptor is kept open to sync the file later
+				fd = ::open(destination.getPath().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+#ifdef HAVE_POSIX_FALLOCATE
+				// allocate the whole file at once, the stream must not truncate it again
+				if ((fd >= 0) && (size > 0) && (::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0))
+				{
+					mode = ios::in | ios::out | ios::binary;
+				}
+#endif
+			}
+
+			// close the descriptor on any error
+			FileGuard guard(fd);
+
+			std::ofstream stream(destination.getPath().c_str(), mode);
+
+			// check the streams health
+			if (!stream.good())
+			{
+				std::stringstream ss; ss << "unable to open filestream [" << std::strerror(errno) << "]";
+				throw ibrcommon::IOException(ss.str());
+			}
+
+			try {
+				task._container->serialize(stream);
+
+				// cut off allocated space which has not been written
+				const std::streamoff written = stream.tellp();
+				stream.close();
+
+				if ((fd >= 0) && (written >= 0) && (static_cast<size_t>(written) < size))
+				{
+					if (::ftruncate(fd, static_cast<off_t>(written)) != 0)
+					{
+						std::stringstream ss; ss << "unable to truncate file [" << std::strerror(errno) << "]";
+						throw ibrcommon::IOException(ss.str());
+					}
+				}
+			} catch (const ibrcommon::Exception&) {
+				throw;
+			} catch (const std::exception &ex) {
+				throw ibrcommon::IOException(ex.what());
+			}
+
+			// the descriptor is only kept to sync the file
+			if (!_sync) return -1;
+
+			return guard.release();
+		}
+
+		DataStorage::FileGuard::FileGuard(int fd)
+		 : _fd(fd)
+		{
+		}
+
+		DataStorage::FileGuard::~FileGuard()
+		{
+			if (_fd >= 0) ::close(_fd);
+		}
+
+		int DataStorage::FileGuard::release()
+		{
+			const int fd = _fd;
+			_fd = -1;
+			return fd;
+		}
+
+		void DataStorage::sync(std::list<int> &fds) throw ()
+		{
+#ifdef HAVE_SYNCFS
+			// one call is cheaper than flushing many files one by one
+			if (fds.size() >= SYNCFS_THRESHOLD)
+			{
+				::syncfs(fds.front());
+			}
+			else
+#endif
+			{
+				for (std::list<int>::const_iterator it = fds.begin(); it != fds.end(); ++it)
+				{
+#ifdef HAVE_FDATASYNC
+					::fdatasync(*it);
+#else
+					::fsync(*it);
+#endif
+				}
+			}
+
+			for (std::list<int>::const_iterator it = fds.begin(); it != fds.end(); ++it)
+			{
+				::close(*it);
+			}
+
+			fds.clear();
+		}
+
+		void DataStorage::unlink(Lane &lane, std::list<RemoveDataTask*> &removals, Statistics &stats) throw ()
+		{
+			std::list<RemoveDataTask*> removed;
+			std::list< std::pair<RemoveDataTask*, DataNotAvailableException> > failed;
+
+			// remove all files while holding the lock once
+			{
+				ibrcommon::MutexLock l(lane.mutex);
+
+				for (std::list<RemoveDataTask*>::iterator it = removals.begin(); it != removals.end(); ++it)
+				{
+					RemoveDataTask *remove = (*it);
+
+					try {
+						ibrcommon::File destination = locate(remove->hash);
+						destination.remove();
+						removed.push_back(remove);
+					} catch (const DataNotAvailableException &ex) {
+						failed.push_back( std::make_pair(remove, ex) );
+					}
+				}
+			}
+
+			removals.clear();
+
+			for (std::list<RemoveDataTask*>::iterator it = removed.begin(); it != removed.end(); ++it)
+			{
+				RemoveDataTask &remove = **it;
+
+				remove.latency.stop();
+				stats.remove_latency[Statistics::getBucket(remove.latency.getMicroseconds())]++;
+				_remove_latency.record(static_cast<uint64_t>(remove.latency.getMicroseconds()));
+				stats.removed++;
+
+				_callback.eventDataStorageRemoved(remove.hash);
+			}
+
+			for (std::list< std::pair<RemoveDataTask*, DataNotAvailableException> >::iterator it = failed.begin(); it != failed.end(); ++it)
+			{
+				stats.remove_failed++;
+				_callback.eventDataStorageRemoveFailed((*it).first->hash, (*it).second);
+			}
+		}
+
+		DataStorage::Lane::Lane(DataStorage &storage)
+		 : _storage(storage)
+		{
+		}
+
+		DataStorage::Lane::~Lane()
+		{
+			tasks.abort();
+			join();
+		}
+
+		void DataStorage::Lane::run() throw ()
+		{
+			_storage.process(*this);
+		}
+
+		void DataStorage::Lane::__cancellation() throw ()
+		{
+			tasks.abort();
+		}
+
 		DataStorage::Container::~Container() {}
+
+		size_t DataStorage::Container::getSize() const
+		{
+			return 0;
+		}
+
+		DataStorage::Task::Task()
+		{
+			latency.start();
+		}
+
 		DataStorage::Task::~Task() {}
 
 		DataStorage::StoreDataTask::StoreDataTask(const Hash &h, Container *c)
@@ -29,7 +29,13 @@
 #include <ibrcommon/thread/Queue.h>
 #include <ibrcommon/thread/Thread.h>
 #include <ibrcommon/thread/Semaphore.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/TimeMeasurement.h>
+#include <ibrcommon/Metrics.h>
 #include <memory>
+#include <vector>
+#include <list>
+#include <set>
 
 #ifndef DATASTORAGE_H_
 #define DATASTORAGE_H_
@@ -54,6 +60,13 @@ namespace dtn
 				virtual ~Container() = 0;
 				virtual std::string getId() const = 0;
 				virtual std::ostream& serialize(std::ostream &stream) = 0;
+
+				/**
+				 * Returns the number of bytes written by serialize() or zero
+				 * if the size is not known in advance. A known size allows
+				 * the storage to allocate the whole file before writing.
+				 */
+				virtual size_t getSize() const;
 			};
 
 			class Hash
@@ -94,7 +107,52 @@ namespace dtn
 				virtual void iterateDataStorage(const Hash &hash, DataStorage::istream &stream) = 0;
 			};
 
-			DataStorage(Callback &callback, const ibrcommon::File &path, unsigned int write_buffer = 0, bool initialize = false);
+			class Statistics
+			{
+			public:
+				Statistics();
+				virtual ~Statistics();
+
+				/**
+				 * Number of buckets of the latency histograms. Bucket n counts
+				 * all tasks completed in less than 2^n microseconds, the last
+				 * bucket counts everything above.
+				 */
+				static const size_t LATENCY_BUCKETS = 24;
+
+				/**
+				 * Returns the histogram bucket for a latency in microseconds
+				 */
+				static size_t getBucket(double microseconds);
+
+				// number of queued and unfinished tasks
+				size_t queue_depth;
+				size_t queue_depth_max;
+
+				dtn::data::Size stored;
+				dtn::data::Size store_failed;
+				dtn::data::Size removed;
+				dtn::data::Size remove_failed;
+
+				// number of processed batches and sync operations
+				dtn::data::Size batches;
+				dtn::data::Size syncs;
+
+				// latency from queuing to completion of a task
+				dtn::data::Size store_latency[LATENCY_BUCKETS];
+				dtn::data::Size remove_latency[LATENCY_BUCKETS];
+			};
+
+			/**
+			 * Constructor
+			 * @param callback Receiver of all store and remove events.
+			 * @param path Directory to store the data in.
+			 * @param write_buffer Maximum number of queued store tasks. Zero means unlimited.
+			 * @param initialize If true, all existing data in the path is removed.
+			 * @param lanes Number of parallel I/O threads. Each hash is bound to one lane.
+			 * @param sync If true, stored data is flushed to the disk before it is reported as stored.
+			 */
+			DataStorage(Callback &callback, const ibrcommon::File &path, unsigned int write_buffer = 0, bool initialize = false, unsigned int lanes = 1, bool sync = false);
 			virtual ~DataStorage();
 
 			const Hash store(Container *data);
@@ -110,14 +168,26 @@ namespace dtn
 
 			/**
 			 * iterate through all the data and call the iterateDataStorage() on each dataset
+			 * @param threads Number of threads reading the data concurrently. More than
+			 * one thread may only be used as long as the storage is not started.
 			 */
-			void iterateAll();
+			void iterateAll(unsigned int threads = 1);
+
+			/**
+			 * Collect the hashes of all stored data without reading it
+			 */
+			void list(std::set<Hash> &hashes) const;
 
 			/**
 			 * reset the data storage
 			 */
 			void reset();
 
+			/**
+			 * Returns a snapshot of the queue depth and latency statistics
+			 */
+			const Statistics getStatistics();
+
 			/*** BEGIN: methods for unit-testing ***/
 
 			/**
@@ -129,14 +199,20 @@ namespace dtn
 			/*** END: methods for unit-testing ***/
 
 		protected:
+			void setup() throw ();
 			void run() throw ();
+			void finally() throw ();
 			void __cancellation() throw ();
 
 		private:
 			class Task
 			{
 			public:
+				Task();
 				virtual ~Task() = 0;
+
+				// measures the time since the task has been queued
+				ibrcommon::TimeMeasurement latency;
 			};
 
 			class StoreDataTask : public Task
@@ -158,14 +234,129 @@ namespace dtn
 				const Hash hash;
 			};
 
+			/**
+			 * A lane processes the tasks of all hashes assigned to it. The first
+			 * lane is processed by the thread of the data storage itself, all
+			 * others have their own thread.
+			 */
+			class Lane : public ibrcommon::JoinableThread
+			{
+			public:
+				Lane(DataStorage &storage);
+				virtual ~Lane();
+
+				ibrcommon::Queue< Task* > tasks;
+
+				// locks all files of this lane
+				ibrcommon::Mutex mutex;
+
+				// fan-out directories known to exist
+				std::set<unsigned int> directories;
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				DataStorage &_storage;
+			};
+
+			// maximum number of tasks processed as one batch
+			static const size_t BATCH_LIMIT;
+
+			// number of files in a batch to sync the whole file-system instead of each file
+			static const size_t SYNCFS_THRESHOLD;
+
+			/**
+			 * Returns the fan-out directory number of a hash
+			 */
+			static unsigned int getBucket(const Hash &hash);
+
+			Lane& getLane(const Hash &hash);
+
+			/**
+			 * Returns the file of a hash in the fan-out directory layout
+			 */
+			ibrcommon::File getFile(const Hash &hash) const;
+
+			/**
+			 * Returns the existing file of a hash. Files stored in the
+			 * flat layout of previous versions are found as well.
+			 */
+			ibrcommon::File locate(const Hash &hash) const throw (DataNotAvailableException);
+
+			/**
+			 * Closes a file descriptor when it goes out of scope
+			 */
+			class FileGuard
+			{
+			public:
+				FileGuard(int fd);
+				virtual ~FileGuard();
+
+				/**
+				 * Hand over the descriptor to the caller
+				 */
+				int release();
+
+			private:
+				int _fd;
+			};
+
+			void process(Lane &lane) throw ();
+			int write(Lane &lane, StoreDataTask &task) throw (ibrcommon::Exception);
+			void sync(std::list<int> &fds) throw ();
+			void unlink(Lane &lane, std::list<RemoveDataTask*> &removals, Statistics &stats) throw ();
+
+			/**
+			 * Reads a share of the files during a parallel iteration
+			 */
+			class Reader : public ibrcommon::JoinableThread
+			{
+			public:
+				Reader(DataStorage &storage, const std::vector<ibrcommon::File> &files, size_t first, size_t step);
+				virtual ~Reader();
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				DataStorage &_storage;
+				const std::vector<ibrcommon::File> &_files;
+				const size_t _first;
+				const size_t _step;
+
+				// the files are not shared with the lanes while iterating
+				ibrcommon::Mutex _mutex;
+			};
+
+			void collect(const ibrcommon::File &path, std::vector<ibrcommon::File> &files) const;
+
+			void enqueue(const Hash &hash, Task *t);
+
 			Callback &_callback;
 			ibrcommon::File _path;
-			ibrcommon::Queue< Task* > _tasks;
+			std::vector<Lane*> _lanes;
 			ibrcommon::Semaphore _store_sem;
 			bool _store_limited;
 			bool _faulty;
+			const bool _sync;
+
+			// counts the tasks not completed yet
+			ibrcommon::Conditional _pending_cond;
+			Statistics _stats;
 
-			ibrcommon::Mutex _global_mutex;
+			// the statistics exported to the metrics registry
+			ibrcommon::Gauge &_queue_gauge;
+			ibrcommon::Histogram &_store_latency;
+			ibrcommon::Histogram &_remove_latency;
+			ibrcommon::Counter &_stored;
+			ibrcommon::Counter &_store_failed;
+			ibrcommon::Counter &_removed;
+			ibrcommon::Counter &_remove_failed;
+			ibrcommon::Counter &_batches;
+			ibrcommon::Counter &_syncs;
 		};
 	}
 }
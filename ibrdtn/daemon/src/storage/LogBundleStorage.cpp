@@ -0,0 +1,995 @@
+/*
+ * LogBundleStorage.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "storage/LogBundleStorage.h"
+#include "core/EventDispatcher.h"
+#include "core/BundleExpiredEvent.h"
+#include "core/BundleEvent.h"
+
+#include <ibrdtn/data/AgeBlock.h>
+#include <ibrdtn/data/BundleString.h>
+#include <ibrdtn/data/Serializer.h>
+#include <ibrdtn/utils/Clock.h>
+
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Logger.h>
+
+#include <sstream>
+#include <iomanip>
+#include <memory>
+#include <cstring>
+#include <cerrno>
+#include <stdio.h>
+
+namespace dtn
+{
+	namespace storage
+	{
+		const std::string LogBundleStorage::TAG = "LogBundleStorage";
+		const std::string LogBundleStorage::INDEX_MAGIC = "ibrdtn-log-index";
+		const dtn::data::Length LogBundleStorage::DEFAULT_SEGMENT_SIZE = 16 * 1024 * 1024;
+
+		LogBundleStorage::Location::Location()
+		 : segment(0), offset(0), length(0)
+		{
+		}
+
+		LogBundleStorage::Location::Location(unsigned int s, dtn::data::Length o, dtn::data::Length l)
+		 : segment(s), offset(o), length(l)
+		{
+		}
+
+		LogBundleStorage::Segment::Segment()
+		 : total(0), live(0), queued(false)
+		{
+		}
+
+		LogBundleStorage::LogBundleStorage(const ibrcommon::File &path, const dtn::data::Length &maxsize, const dtn::data::Length &segment_size)
+		 : BundleStorage(maxsize), _path(path), _segment_size((segment_size > 0) ? segment_size : DEFAULT_SEGMENT_SIZE),
+		   _metastore(this), _current_segment(0), _current_offset(0)
+		{
+		}
+
+		LogBundleStorage::~LogBundleStorage()
+		{
+			_tasks.abort();
+			join();
+
+			// delete all remaining tasks
+			try {
+				while (true)
+				{
+					Task *t = _tasks.take();
+					delete t;
+				}
+			} catch (const ibrcommon::QueueUnblockedException&) {
+				// exit
+			}
+		}
+
+		const std::string LogBundleStorage::getName() const
+		{
+			return LogBundleStorage::TAG;
+		}
+
+		void LogBundleStorage::componentUp() throw ()
+		{
+			// routine checked for throw() on 15.02.2013
+			_tasks.reset();
+
+			{
+				ibrcommon::MutexLock l(_global_lock);
+				load();
+
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, info) << _metastore.size() << " Bundles restored." << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			dtn::core::EventDispatcher<dtn::core::TimeEvent>::add(this);
+		}
+
+		void LogBundleStorage::componentRun() throw ()
+		{
+			// loop until aborted
+			try {
+				while (true)
+				{
+					_tasks.wait(ibrcommon::Queue<Task*>::QUEUE_NOT_EMPTY);
+					Task *t = _tasks.front();
+
+					try {
+						t->run(*this);
+					} catch (const std::exception &ex) {
+						IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "task failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					};
+
+					delete t;
+					_tasks.pop();
+				}
+			} catch (const ibrcommon::QueueUnblockedException&) {
+				// we are aborted
+			}
+		}
+
+		void LogBundleStorage::componentDown() throw ()
+		{
+			// routine checked for throw() on 15.02.2013
+			dtn::core::EventDispatcher<dtn::core::TimeEvent>::remove(this);
+
+			stop();
+			join();
+
+			// delete all remaining tasks
+			try {
+				while (true)
+				{
+					Task *t = _tasks.take();
+					delete t;
+				}
+			} catch (const ibrcommon::QueueUnblockedException&) {
+				// exit
+			}
+
+			ibrcommon::MutexLock l(_global_lock);
+
+			// write the index to speed-up the next startup
+			__checkpoint();
+			_writer.close();
+
+			// clear all data structures
+			_metastore.clear();
+			_locations.clear();
+			_segments.clear();
+			clearSpace();
+		}
+
+		void LogBundleStorage::__cancellation() throw ()
+		{
+			_tasks.abort();
+		}
+
+		void LogBundleStorage::wait()
+		{
+			_tasks.wait(ibrcommon::Queue<Task*>::QUEUE_EMPTY);
+		}
+
+		void LogBundleStorage::checkpoint()
+		{
+			_tasks.push(new TaskCheckpoint());
+		}
+
+		void LogBundleStorage::compact()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+
+			for (segment_map::iterator it = _segments.begin(); it != _segments.end(); ++it)
+			{
+				Segment &s = (*it).second;
+				if (((*it).first == _current_segment) || s.queued || (s.live == s.total)) continue;
+
+				s.queued = true;
+				_tasks.push(new TaskCompact((*it).first));
+			}
+		}
+
+		dtn::data::Size LogBundleStorage::getSegmentCount()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _segments.size();
+		}
+
+		void LogBundleStorage::raiseEvent(const dtn::core::TimeEvent &time) throw ()
+		{
+			if (time.getAction() == dtn::core::TIME_SECOND_TICK)
+			{
+				ibrcommon::MutexLock l(_global_lock);
+
+				// collects expired bundles in _expired
+				_metastore.expire(time.getTimestamp());
+
+				for (std::list<dtn::data::MetaBundle>::const_iterator it = _expired.begin(); it != _expired.end(); ++it)
+				{
+					const dtn::data::MetaBundle &meta = (*it);
+
+					__remove(meta);
+
+					// raise bundle event
+					dtn::core::BundleEvent::raise( meta, dtn::core::BUNDLE_DELETED, dtn::data::StatusReportBlock::LIFETIME_EXPIRED);
+
+					// raise an event
+					dtn::core::BundleExpiredEvent::raise( meta );
+
+					// raise bundle removed event
+					eventBundleRemoved(meta);
+				}
+
+				_expired.clear();
+			}
+		}
+
+		void LogBundleStorage::eventBundleExpired(const dtn::data::MetaBundle &b) throw ()
+		{
+			// the bundle list is iterated right now, remove the bundle later
+			_expired.push_back(b);
+		}
+
+		bool LogBundleStorage::empty()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _metastore.empty();
+		}
+
+		dtn::data::Size LogBundleStorage::count()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _metastore.size();
+		}
+
+		void LogBundleStorage::releaseCustody(const dtn::data::EID&, const dtn::data::BundleID&)
+		{
+			// custody is successful transferred to another node.
+			// it is safe to delete this bundle now. (depending on the routing algorithm.)
+		}
+
+		bool LogBundleStorage::contains(const dtn::data::BundleID &id)
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _metastore.contains(id);
+		}
+
+		dtn::data::MetaBundle LogBundleStorage::info(const dtn::data::BundleID &id)
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _metastore.find(dtn::data::MetaBundle::create(id));
+		}
+
+		void LogBundleStorage::get(const BundleSelector &cb, BundleResult &result) throw (NoBundleFoundException, BundleSelectorException)
+		{
+			ibrcommon::Histogram::Timer timer(_search_latency);
+
+			size_t items_added = 0;
+
+			// we have to iterate through all bundles
+			ibrcommon::MutexLock l(_global_lock);
+
+			for (MetaStorage::const_iterator iter = _metastore.begin(); (iter != _metastore.end()) && ((cb.limit() == 0) || (items_added < cb.limit())); ++iter)
+			{
+				const dtn::data::MetaBundle &meta = (*iter);
+
+				// skip expired bundles
+				if ( dtn::utils::Clock::isExpired( meta ) ) continue;
+
+				if ( cb.shouldAdd(meta) )
+				{
+					result.put(meta);
+					items_added++;
+				}
+			}
+
+			if (items_added == 0) throw NoBundleFoundException();
+		}
+
+		const LogBundleStorage::eid_set LogBundleStorage::getDistinctDestinations()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+			return _metastore.getDistinctDestinations();
+		}
+
+		dtn::data::Bundle LogBundleStorage::get(const dtn::data::BundleID &id)
+		{
+			ibrcommon::Histogram::Timer timer(_get_latency);
+
+			try {
+				std::ifstream stream;
+				Location loc;
+
+				{
+					ibrcommon::MutexLock l(_global_lock);
+
+					// faulty mechanism for unit-testing
+					if (_faulty) {
+						throw dtn::SerializationFailedException("bundle get failed due to faulty setting");
+					}
+
+					location_map::const_iterator it = _locations.find(id);
+					if (it == _locations.end()) throw NoBundleFoundException();
+					loc = (*it).second;
+
+					// open the segment while it can not be deleted by the compaction
+					stream.open(getSegmentFile(loc.segment).getPath().c_str(), std::ios::in | std::ios::binary);
+				}
+
+				stream.seekg(static_cast<std::streamoff>(loc.offset));
+
+				char type = 0;
+				dtn::data::Number length, stored;
+				stream.get(type);
+				stream >> length >> stored;
+
+				if (!stream.good() || (type != RECORD_BUNDLE))
+				{
+					throw dtn::SerializationFailedException("invalid record in segment");
+				}
+
+				dtn::data::Bundle bundle;
+
+				// load the bundle from the segment
+				try {
+					dtn::data::DefaultDeserializer(stream) >> bundle;
+				} catch (const std::exception &ex) {
+					throw dtn::SerializationFailedException(ex.what());
+				}
+
+				try {
+					dtn::data::AgeBlock &agebl = bundle.find<dtn::data::AgeBlock>();
+
+					// add the time spent in the storage
+					const dtn::data::Timestamp now = dtn::utils::Clock::getTime();
+					if ((stored > 0) && (now > stored.get<dtn::data::Timestamp>()))
+					{
+						agebl.addSeconds(now - stored.get<dtn::data::Timestamp>());
+					}
+				} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
+
+				return bundle;
+			} catch (const dtn::SerializationFailedException &ex) {
+				// bundle loading failed
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "failed to load bundle: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+
+				// the bundle is broken, delete it
+				remove(id);
+
+				throw BundleStorage::BundleLoadException(ex.what());
+			}
+		}
+
+		void LogBundleStorage::store(const dtn::data::Bundle &bundle)
+		{
+			ibrcommon::Histogram::Timer timer(_store_latency);
+
+			// get the bundle size
+			dtn::data::DefaultSerializer s(std::cout);
+			const dtn::data::Length bundle_size = s.getLength(bundle);
+
+			ibrcommon::MutexLock l(_global_lock);
+
+			if (_metastore.contains(bundle))
+			{
+				IBRCOMMON_LOGGER_DEBUG_TAG(LogBundleStorage::TAG, 5) << "got bundle duplicate " << bundle.toString() << IBRCOMMON_LOGGER_ENDL;
+				return;
+			}
+
+			// allocate space for the bundle
+			allocSpace(bundle_size);
+
+			// container for the custody accepted bundle
+			dtn::data::Bundle ca_bundle = bundle;
+
+			// accept custody if requested
+			try {
+				ca_bundle.custodian = BundleStorage::acceptCustody(dtn::data::MetaBundle::create(bundle));
+			} catch (const ibrcommon::Exception&) {
+				// no custody has been requested
+			}
+
+			try {
+				// faulty mechanism for unit-testing
+				if (_faulty) {
+					throw ibrcommon::IOException("bundle store failed due to faulty setting");
+				}
+
+				const Location loc = appendBundle(ca_bundle, bundle_size);
+				const dtn::data::MetaBundle meta = dtn::data::MetaBundle::create(ca_bundle);
+
+				_locations[meta] = loc;
+				_metastore.store(meta, bundle_size);
+
+				// raise bundle added event
+				eventBundleAdded(meta);
+			} catch (const ibrcommon::IOException &ex) {
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "store of bundle " << bundle.toString() << " failed: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+
+				// release the allocated space
+				freeSpace(bundle_size);
+			}
+		}
+
+		void LogBundleStorage::remove(const dtn::data::BundleID &id)
+		{
+			ibrcommon::MutexLock l(_global_lock);
+
+			// copy the meta data, the reference is invalid after removal
+			const dtn::data::MetaBundle meta = _metastore.find(dtn::data::MetaBundle::create(id));
+
+			__remove(meta);
+
+			// raise bundle removed event
+			eventBundleRemoved(meta);
+		}
+
+		void LogBundleStorage::clear()
+		{
+			ibrcommon::MutexLock l(_global_lock);
+
+			for (MetaStorage::const_iterator iter = _metastore.begin(); iter != _metastore.end(); ++iter)
+			{
+				// raise bundle removed event
+				eventBundleRemoved(*iter);
+			}
+
+			_metastore.clear();
+			_locations.clear();
+			clearSpace();
+
+			// delete the whole log and start again
+			const bool active = _writer.is_open();
+			_writer.close();
+
+			for (segment_map::const_iterator it = _segments.begin(); it != _segments.end(); ++it)
+			{
+				getSegmentFile((*it).first).remove();
+			}
+
+			_segments.clear();
+
+			ibrcommon::File index = _path.get("index");
+			if (index.exists()) index.remove();
+
+			if (active)
+			{
+				try {
+					rotate();
+				} catch (const ibrcommon::IOException &ex) {
+					IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				}
+			}
+		}
+
+		void LogBundleStorage::__remove(const dtn::data::MetaBundle &meta)
+		{
+			location_map::iterator it = _locations.find(meta);
+
+			if (it != _locations.end())
+			{
+				const Location loc = (*it).second;
+				_locations.erase(it);
+
+				// mark the record as deleted in the log
+				appendTombstone(loc);
+				release(loc);
+			}
+
+			// remove bundle and decrement the storage size
+			freeSpace( _metastore.remove(meta) );
+		}
+
+		void LogBundleStorage::release(const Location &loc)
+		{
+			segment_map::iterator it = _segments.find(loc.segment);
+			if (it == _segments.end()) return;
+
+			Segment &s = (*it).second;
+			s.live -= loc.length;
+
+			// compact sealed segments if less than half of it is in use
+			if ((loc.segment != _current_segment) && !s.queued && ((s.live * 2) < s.total))
+			{
+				s.queued = true;
+				_tasks.push(new TaskCompact(loc.segment));
+			}
+		}
+
+		ibrcommon::File LogBundleStorage::getSegmentFile(unsigned int segment) const
+		{
+			std::stringstream ss;
+			ss << "segment." << std::setw(8) << std::setfill('0') << segment;
+			return _path.get(ss.str());
+		}
+
+		void LogBundleStorage::rotate() throw (ibrcommon::IOException)
+		{
+			const bool sealed = _writer.is_open();
+			_writer.close();
+			_writer.clear();
+
+			if (sealed)
+			{
+				// check if the completed segment is already sparse
+				Segment &s = _segments[_current_segment];
+				if (!s.queued && ((s.live * 2) < s.total))
+				{
+					s.queued = true;
+					_tasks.push(new TaskCompact(_current_segment));
+				}
+
+				// update the index with each completed segment
+				_tasks.push(new TaskCheckpoint());
+			}
+
+			// the next segment follows the latest one
+			_current_segment = _segments.empty() ? 0 : ((*_segments.rbegin()).first + 1);
+			_current_offset = 0;
+
+			_writer.open(getSegmentFile(_current_segment).getPath().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+			if (!_writer.good())
+			{
+				std::stringstream ss; ss << "unable to open segment [" << std::strerror(errno) << "]";
+				throw ibrcommon::IOException(ss.str());
+			}
+
+			_segments[_current_segment] = Segment();
+		}
+
+		LogBundleStorage::Location LogBundleStorage::appendBundle(const dtn::data::Bundle &bundle, const dtn::data::Length &space) throw (ibrcommon::IOException)
+		{
+			const dtn::data::Number stored(dtn::utils::Clock::getTime());
+			const dtn::data::Number length(stored.getLength() + space);
+			const dtn::data::Length size = 1 + length.getLength() + length.get<dtn::data::Length>();
+
+			// start a new segment if this one is full
+			if (!_writer.is_open() || ((_current_offset > 0) && ((_current_offset + size) > _segment_size)))
+			{
+				rotate();
+			}
+
+			const Location loc(_current_segment, _current_offset, size);
+
+			_writer.put(static_cast<char>(RECORD_BUNDLE));
+			_writer << length << stored;
+			dtn::data::DefaultSerializer(_writer) << bundle;
+			_writer.flush();
+
+			if (!_writer.good())
+			{
+				std::stringstream ss; ss << "unable to write to segment [" << std::strerror(errno) << "]";
+
+				// continue with a new segment, the broken record is skipped on replay
+				_segments[_current_segment].total += size;
+				rotate();
+
+				throw ibrcommon::IOException(ss.str());
+			}
+
+			_current_offset += size;
+
+			Segment &s = _segments[_current_segment];
+			s.total += size;
+			s.live += size;
+
+			return loc;
+		}
+
+		void LogBundleStorage::appendTombstone(const Location &loc) throw ()
+		{
+			// not required if the segment is already gone
+			if (!_writer.is_open() || (_segments.find(loc.segment) == _segments.end())) return;
+
+			std::stringstream data;
+			data << dtn::data::Number(loc.segment) << dtn::data::Number(loc.offset);
+
+			const dtn::data::Number length(data.str().length());
+			const dtn::data::Length size = 1 + length.getLength() + data.str().length();
+
+			_writer.put(static_cast<char>(RECORD_TOMBSTONE));
+			_writer << length << data.str();
+			_writer.flush();
+
+			_current_offset += size;
+			_segments[_current_segment].total += size;
+
+			if (!_writer.good())
+			{
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "unable to write tombstone [" << std::strerror(errno) << "]" << IBRCOMMON_LOGGER_ENDL;
+
+				try {
+					rotate();
+				} catch (const ibrcommon::IOException &ex) {
+					IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				}
+			}
+		}
+
+		void LogBundleStorage::__checkpoint() throw ()
+		{
+			ibrcommon::File tmp = _path.get("index.tmp");
+			ibrcommon::File index = _path.get("index");
+
+			std::ofstream stream(tmp.getPath().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+			// all records in front of the append position are covered by the index
+			stream << dtn::data::BundleString(INDEX_MAGIC);
+			stream << dtn::data::Number(_current_segment) << dtn::data::Number(_current_offset);
+			stream << dtn::data::Number(_locations.size());
+
+			for (location_map::const_iterator it = _locations.begin(); it != _locations.end(); ++it)
+			{
+				const Location &loc = (*it).second;
+
+				try {
+					const dtn::data::MetaBundle &meta = _metastore.find(dtn::data::MetaBundle::create((*it).first));
+					stream << dtn::data::Number(loc.segment) << dtn::data::Number(loc.offset) << dtn::data::Number(loc.length);
+					stream << dtn::data::Number(_metastore.getSize(meta));
+					MetaStorage::write(stream, meta);
+				} catch (const NoBundleFoundException&) {
+					// write an empty entry to keep the number of entries
+					stream << dtn::data::Number(0) << dtn::data::Number(0) << dtn::data::Number(0) << dtn::data::Number(0);
+					MetaStorage::write(stream, dtn::data::MetaBundle());
+				}
+			}
+
+			stream << dtn::data::BundleString(INDEX_MAGIC);
+			stream.close();
+
+			if (stream.fail())
+			{
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "unable to write index [" << std::strerror(errno) << "]" << IBRCOMMON_LOGGER_ENDL;
+				tmp.remove();
+				return;
+			}
+
+			// replace the index atomically
+			if (::rename(tmp.getPath().c_str(), index.getPath().c_str()) != 0)
+			{
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "unable to replace index [" << std::strerror(errno) << "]" << IBRCOMMON_LOGGER_ENDL;
+				return;
+			}
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(LogBundleStorage::TAG, 25) << "index written with " << _locations.size() << " bundles" << IBRCOMMON_LOGGER_ENDL;
+		}
+
+		bool LogBundleStorage::loadIndex(entry_map &entries, unsigned int &segment, dtn::data::Length &offset) throw ()
+		{
+			ibrcommon::File index = _path.get("index");
+			if (!index.exists()) return false;
+
+			std::ifstream stream(index.getPath().c_str(), std::ios::in | std::ios::binary);
+
+			try {
+				dtn::data::BundleString magic;
+				dtn::data::Number s, o, count;
+
+				stream >> magic;
+				if (magic != INDEX_MAGIC) throw ibrcommon::IOException("invalid index header");
+
+				stream >> s >> o >> count;
+
+				for (dtn::data::Size i = 0; (i < count.get<dtn::data::Size>()) && stream.good(); ++i)
+				{
+					dtn::data::Number seg, off, len, space;
+					Entry e;
+
+					stream >> seg >> off >> len >> space;
+					MetaStorage::read(stream, e.meta);
+
+					// skip empty entries
+					if (len == 0) continue;
+
+					e.location = Location(seg.get<unsigned int>(), off.get<dtn::data::Length>(), len.get<dtn::data::Length>());
+					e.space = space.get<dtn::data::Length>();
+					entries[e.meta] = e;
+				}
+
+				stream >> magic;
+				if (!stream.good() || (magic != INDEX_MAGIC)) throw ibrcommon::IOException("index is truncated");
+
+				segment = s.get<unsigned int>();
+				offset = o.get<dtn::data::Length>();
+				return true;
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, warning) << "index not usable, reading all segments: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			entries.clear();
+			return false;
+		}
+
+		dtn::data::Size LogBundleStorage::replay(entry_map &entries, unsigned int segment, dtn::data::Length offset) throw ()
+		{
+			dtn::data::Size records = 0;
+
+			// reverse lookup for tombstones
+			typedef std::map<std::pair<unsigned int, dtn::data::Length>, dtn::data::BundleID> position_map;
+			position_map positions;
+
+			for (entry_map::const_iterator it = entries.begin(); it != entries.end(); ++it)
+			{
+				const Location &loc = (*it).second.location;
+				positions[std::make_pair(loc.segment, loc.offset)] = (*it).first;
+			}
+
+			for (segment_map::const_iterator it = _segments.lower_bound(segment); it != _segments.end(); ++it)
+			{
+				const unsigned int seg = (*it).first;
+				const dtn::data::Length total = (*it).second.total;
+				dtn::data::Length pos = (seg == segment) ? offset : 0;
+
+				std::ifstream stream(getSegmentFile(seg).getPath().c_str(), std::ios::in | std::ios::binary);
+
+				while (pos < total)
+				{
+					stream.seekg(static_cast<std::streamoff>(pos));
+
+					char type = 0;
+					dtn::data::Number length;
+
+					try {
+						stream.get(type);
+						stream >> length;
+					} catch (const std::exception&) {
+						break;
+					}
+
+					const dtn::data::Length size = 1 + length.getLength() + length.get<dtn::data::Length>();
+
+					// stop at the end of valid data
+					if (!stream.good() || ((pos + size) > total)) break;
+
+					try {
+						if (type == RECORD_BUNDLE)
+						{
+							dtn::data::Number stored;
+							dtn::data::Bundle bundle;
+
+							stream >> stored;
+							dtn::data::DefaultDeserializer(stream) >> bundle;
+
+							Entry e;
+							e.location = Location(seg, pos, size);
+							e.meta = dtn::data::MetaBundle::create(bundle);
+							e.space = length.get<dtn::data::Length>() - stored.getLength();
+
+							// a copy made by the compaction replaces the previous location
+							entry_map::iterator prev = entries.find(e.meta);
+							if (prev != entries.end())
+							{
+								const Location &l = (*prev).second.location;
+								positions.erase(std::make_pair(l.segment, l.offset));
+							}
+
+							entries[e.meta] = e;
+							positions[std::make_pair(seg, pos)] = e.meta;
+						}
+						else if (type == RECORD_TOMBSTONE)
+						{
+							dtn::data::Number s, o;
+							stream >> s >> o;
+
+							position_map::iterator p = positions.find(std::make_pair(s.get<unsigned int>(), o.get<dtn::data::Length>()));
+							if (p != positions.end())
+							{
+								entries.erase((*p).second);
+								positions.erase(p);
+							}
+						}
+						else
+						{
+							break;
+						}
+					} catch (const std::exception &ex) {
+						IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, warning) << "unable to read record at " << pos << " in segment " << seg << ": " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					}
+
+					pos += size;
+					records++;
+				}
+			}
+
+			return records;
+		}
+
+		void LogBundleStorage::load() throw ()
+		{
+			try {
+				if (!_path.exists()) ibrcommon::File::createDirectory(_path);
+			} catch (const ibrcommon::Exception &ex) {
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			// look for existing segments
+			std::list<ibrcommon::File> files;
+			_path.getFiles(files);
+
+			for (std::list<ibrcommon::File>::iterator it = files.begin(); it != files.end(); ++it)
+			{
+				ibrcommon::File &file = (*it);
+				const std::string name = file.getBasename();
+
+				if (name.compare(0, 8, "segment.") != 0) continue;
+
+				// delete empty segments
+				if (file.size() == 0)
+				{
+					file.remove();
+					continue;
+				}
+
+				std::stringstream ss(name.substr(8));
+				unsigned int seg = 0;
+				if (!(ss >> seg)) continue;
+
+				_segments[seg].total = file.size();
+			}
+
+			entry_map entries;
+			unsigned int segment = 0;
+			dtn::data::Length offset = 0;
+
+			if (!loadIndex(entries, segment, offset))
+			{
+				// read all segments
+				segment = 0;
+				offset = 0;
+			}
+
+			const dtn::data::Size records = replay(entries, segment, offset);
+
+			for (entry_map::const_iterator it = entries.begin(); it != entries.end(); ++it)
+			{
+				const Entry &e = (*it).second;
+
+				// the segment of this entry has been deleted
+				segment_map::iterator s = _segments.find(e.location.segment);
+				if (s == _segments.end()) continue;
+
+				try {
+					allocSpace(e.space);
+				} catch (const StorageSizeExeededException&) {
+					IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "storage is full, unable to restore bundle " << e.meta.toString() << IBRCOMMON_LOGGER_ENDL;
+					continue;
+				}
+
+				(*s).second.live += e.location.length;
+				_locations[e.meta] = e.location;
+				_metastore.store(e.meta, e.space);
+
+				// raise bundle added event
+				eventBundleAdded(e.meta);
+
+				IBRCOMMON_LOGGER_DEBUG_TAG(LogBundleStorage::TAG, 10) << "bundle restored " << e.meta.toString() << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			// append to a new segment
+			try {
+				rotate();
+			} catch (const ibrcommon::IOException &ex) {
+				IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
+
+			// compact all sparse segments
+			for (segment_map::iterator it = _segments.begin(); it != _segments.end(); ++it)
+			{
+				Segment &s = (*it).second;
+				if (((*it).first == _current_segment) || s.queued || ((s.live * 2) >= s.total)) continue;
+
+				s.queued = true;
+				_tasks.push(new TaskCompact((*it).first));
+			}
+
+			// write the index if records have been replayed
+			if (records > 0) _tasks.push(new TaskCheckpoint());
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(LogBundleStorage::TAG, 10) << records << " records replayed in " << _segments.size() << " segments" << IBRCOMMON_LOGGER_ENDL;
+		}
+
+		void LogBundleStorage::__compact(unsigned int segment) throw ()
+		{
+			typedef std::map<dtn::data::Length, dtn::data::BundleID> offset_map;
+			offset_map live;
+
+			{
+				ibrcommon::MutexLock l(_global_lock);
+
+				segment_map::iterator it = _segments.find(segment);
+				if ((it == _segments.end()) || (segment == _current_segment)) return;
+
+				// collect all bundles still stored in this segment
+				for (location_map::const_iterator it = _locations.begin(); it != _locations.end(); ++it)
+				{
+					if ((*it).second.segment == segment) live[(*it).second.offset] = (*it).first;
+				}
+			}
+
+			// sealed segments are not modified anymore
+			std::ifstream stream(getSegmentFile(segment).getPath().c_str(), std::ios::in | std::ios::binary);
+			dtn::data::Size moved = 0;
+			char buf[4096];
+
+			for (offset_map::const_iterator it = live.begin(); it != live.end(); ++it)
+			{
+				ibrcommon::MutexLock l(_global_lock);
+
+				// skip the bundle if it has been removed in the meantime
+				location_map::iterator loc_it = _locations.find((*it).second);
+				if ((loc_it == _locations.end()) || ((*loc_it).second.segment != segment) || ((*loc_it).second.offset != (*it).first)) continue;
+
+				const Location prev = (*loc_it).second;
+
+				// start a new segment if the current is full
+				try {
+					if ((_current_offset > 0) && ((_current_offset + prev.length) > _segment_size)) rotate();
+				} catch (const ibrcommon::IOException &ex) {
+					IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+					return;
+				}
+
+				// copy the whole record
+				stream.seekg(static_cast<std::streamoff>(prev.offset));
+				dtn::data::Length remain = prev.length;
+
+				while ((remain > 0) && stream.good())
+				{
+					const std::streamsize chunk = static_cast<std::streamsize>(std::min(remain, static_cast<dtn::data::Length>(sizeof(buf))));
+					stream.read(buf, chunk);
+					_writer.write(buf, stream.gcount());
+					remain -= static_cast<dtn::data::Length>(stream.gcount());
+				}
+
+				_writer.flush();
+
+				if ((remain > 0) || !_writer.good())
+				{
+					IBRCOMMON_LOGGER_TAG(LogBundleStorage::TAG, error) << "compaction of segment " << segment << " failed" << IBRCOMMON_LOGGER_ENDL;
+
+					// start a new segment and give up, the partial copy is never referenced
+					_segments[_current_segment].total += (prev.length - remain);
+					try {
+						rotate();
+					} catch (const ibrcommon::IOException&) { }
+
+					_segments[segment].queued = false;
+					return;
+				}
+
+				const Location next(_current_segment, _current_offset, prev.length);
+				_current_offset += prev.length;
+
+				Segment &s = _segments[_current_segment];
+				s.total += prev.length;
+				s.live += prev.length;
+
+				_segments[segment].live -= prev.length;
+				(*loc_it).second = next;
+				moved++;
+			}
+
+			ibrcommon::MutexLock l(_global_lock);
+
+			// the index must not refer to the segment anymore before it is deleted
+			__checkpoint();
+
+			getSegmentFile(segment).remove();
+			_segments.erase(segment);
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(LogBundleStorage::TAG, 10) << "segment " << segment << " compacted, " << moved << " bundles moved" << IBRCOMMON_LOGGER_ENDL;
+		}
+
+		void LogBundleStorage::TaskCheckpoint::run(LogBundleStorage &storage)
+		{
+			ibrcommon::MutexLock l(storage._global_lock);
+			storage.__checkpoint();
+		}
+
+		void LogBundleStorage::TaskCompact::run(LogBundleStorage &storage)
+		{
+			storage.__compact(_segment);
+		}
+	}
+}
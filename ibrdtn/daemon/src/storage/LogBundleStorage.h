@@ -0,0 +1,324 @@
+/*
+ * LogBundleStorage.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOGBUNDLESTORAGE_H_
+#define LOGBUNDLESTORAGE_H_
+
+#include "Component.h"
+#include "storage/BundleStorage.h"
+#include "storage/MetaStorage.h"
+#include "core/EventReceiver.h"
+#include "core/TimeEvent.h"
+
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/BundleList.h>
+#include <ibrdtn/data/MetaBundle.h>
+
+#include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/thread/Queue.h>
+
+#include <fstream>
+#include <list>
+#include <map>
+#include <set>
+
+namespace dtn
+{
+	namespace storage
+	{
+		/**
+		 * This storage appends all bundles to large segment files. The
+		 * location and the meta data of each bundle is kept in memory and
+		 * written to an index file whenever a segment is completed, so
+		 * only the tail of the log has to be read on startup.
+		 * Removed and expired bundles are marked by small tombstone
+		 * records. A background task copies the remaining bundles of
+		 * sparse segments to the end of the log and deletes the segment.
+		 */
+		class LogBundleStorage : public BundleStorage, public dtn::core::EventReceiver<dtn::core::TimeEvent>, public dtn::daemon::IndependentComponent, public dtn::data::BundleList::Listener
+		{
+			static const std::string TAG;
+
+		public:
+			/**
+			 * Constructor
+			 * @param path Directory for the segment and index files.
+			 * @param maxsize Maximum size of the storage in bytes.
+			 * @param segment_size Size of a segment file before the next one is started.
+			 */
+			LogBundleStorage(const ibrcommon::File &path, const dtn::data::Length &maxsize = 0, const dtn::data::Length &segment_size = 0);
+
+			/**
+			 * Destructor
+			 */
+			virtual ~LogBundleStorage();
+
+			/**
+			 * Stores a bundle in the storage.
+			 * @param bundle The bundle to store.
+			 */
+			virtual void store(const dtn::data::Bundle &bundle);
+
+			/**
+			 * This method returns true if the requested bundle is
+			 * stored in the storage.
+			 */
+			virtual bool contains(const dtn::data::BundleID &id);
+
+			/**
+			 * Get meta data about a specific bundle ID
+			 */
+			virtual dtn::data::MetaBundle info(const dtn::data::BundleID &id);
+
+			/**
+			 * This method returns a specific bundle which is identified by
+			 * its id.
+			 * @param id The ID of the bundle to return.
+			 * @return A bundle object.
+			 */
+			virtual dtn::data::Bundle get(const dtn::data::BundleID &id);
+
+			/**
+			 * @see BundleSeeker::get(BundleSelector &cb, BundleResult &result)
+			 */
+			virtual void get(const BundleSelector &cb, BundleResult &result) throw (NoBundleFoundException, BundleSelectorException);
+
+			/**
+			 * @see BundleSeeker::getDistinctDestinations()
+			 */
+			virtual const eid_set getDistinctDestinations();
+
+			/**
+			 * This method deletes a specific bundle in the storage.
+			 * No reports will be generated here.
+			 * @param id The ID of the bundle to remove.
+			 */
+			void remove(const dtn::data::BundleID &id);
+
+			/**
+			 * @sa BundleStorage::clear()
+			 */
+			void clear();
+
+			/**
+			 * @sa BundleStorage::empty()
+			 */
+			bool empty();
+
+			/**
+			 * @sa BundleStorage::count()
+			 */
+			dtn::data::Size count();
+
+			/**
+			 * @sa BundleStorage::releaseCustody();
+			 */
+			void releaseCustody(const dtn::data::EID &custodian, const dtn::data::BundleID &id);
+
+			/**
+			 * This method is used to receive events.
+			 * @param evt
+			 */
+			void raiseEvent(const dtn::core::TimeEvent &evt) throw ();
+
+			/**
+			 * @see Component::getName()
+			 */
+			virtual const std::string getName() const;
+
+			/**
+			 * Returns the number of segment files in use
+			 */
+			dtn::data::Size getSegmentCount();
+
+			/*** BEGIN: methods for unit-testing ***/
+
+			/**
+			 * Wait until all background tasks are done
+			 */
+			virtual void wait();
+
+			/**
+			 * Write the index file now
+			 */
+			void checkpoint();
+
+			/**
+			 * Compact all sealed segments with unused space
+			 */
+			void compact();
+
+			/*** END: methods for unit-testing ***/
+
+		protected:
+			virtual void componentUp() throw ();
+			virtual void componentRun() throw ();
+			virtual void componentDown() throw ();
+			void __cancellation() throw ();
+
+			virtual void eventBundleExpired(const dtn::data::MetaBundle &b) throw ();
+
+		private:
+			class Task
+			{
+			public:
+				virtual ~Task() {};
+				virtual void run(LogBundleStorage &storage) = 0;
+			};
+
+			class TaskCheckpoint : public Task
+			{
+			public:
+				virtual ~TaskCheckpoint() {};
+				virtual void run(LogBundleStorage &storage);
+			};
+
+			class TaskCompact : public Task
+			{
+			public:
+				TaskCompact(unsigned int segment) : _segment(segment) { };
+				virtual ~TaskCompact() {};
+				virtual void run(LogBundleStorage &storage);
+
+			private:
+				const unsigned int _segment;
+			};
+
+			/**
+			 * Position of a bundle record in the log
+			 */
+			class Location
+			{
+			public:
+				Location();
+				Location(unsigned int segment, dtn::data::Length offset, dtn::data::Length length);
+
+				unsigned int segment;
+				dtn::data::Length offset;
+				dtn::data::Length length;
+			};
+
+			/**
+			 * Space accounting of a segment file
+			 */
+			class Segment
+			{
+			public:
+				Segment();
+
+				// bytes of all records
+				dtn::data::Length total;
+
+				// bytes of records still referenced
+				dtn::data::Length live;
+
+				// true, if a compaction of this segment has been queued
+				bool queued;
+			};
+
+			enum RecordType
+			{
+				RECORD_BUNDLE = 'B',
+				RECORD_TOMBSTONE = 'T'
+			};
+
+			typedef std::map<dtn::data::BundleID, Location> location_map;
+			typedef std::map<unsigned int, Segment> segment_map;
+
+			static const std::string INDEX_MAGIC;
+			static const dtn::data::Length DEFAULT_SEGMENT_SIZE;
+
+			ibrcommon::File getSegmentFile(unsigned int segment) const;
+
+			/**
+			 * Entry of the index while loading
+			 */
+			class Entry
+			{
+			public:
+				Location location;
+				dtn::data::MetaBundle meta;
+				dtn::data::Length space;
+			};
+
+			typedef std::map<dtn::data::BundleID, Entry> entry_map;
+
+			/**
+			 * Load the index file and read all records appended afterwards
+			 */
+			void load() throw ();
+			bool loadIndex(entry_map &entries, unsigned int &segment, dtn::data::Length &offset) throw ();
+			dtn::data::Size replay(entry_map &entries, unsigned int segment, dtn::data::Length offset) throw ();
+
+			/**
+			 * Append records to the current segment, the global lock has to be held
+			 */
+			Location appendBundle(const dtn::data::Bundle &bundle, const dtn::data::Length &space) throw (ibrcommon::IOException);
+			void appendTombstone(const Location &loc) throw ();
+
+			/**
+			 * Open a new segment for appending records
+			 */
+			void rotate() throw (ibrcommon::IOException);
+
+			/**
+			 * Remove a bundle from all index structures, the global lock has to be held
+			 */
+			void __remove(const dtn::data::MetaBundle &meta);
+
+			/**
+			 * Decrement the live bytes of a segment and queue a compaction if required
+			 */
+			void release(const Location &loc);
+
+			void __checkpoint() throw ();
+			void __compact(unsigned int segment) throw ();
+
+			ibrcommon::File _path;
+			const dtn::data::Length _segment_size;
+
+			// contains all jobs to do
+			ibrcommon::Queue<Task*> _tasks;
+
+			ibrcommon::Mutex _global_lock;
+
+			// stores all the meta data in memory
+			MetaStorage _metastore;
+
+			// position of each bundle in the log
+			location_map _locations;
+
+			// all existing segments
+			segment_map _segments;
+
+			// append position in the log
+			std::ofstream _writer;
+			unsigned int _current_segment;
+			dtn::data::Length _current_offset;
+
+			// bundles expired during the last expiration
+			std::list<dtn::data::MetaBundle> _expired;
+		};
+	}
+}
+
+#endif /* LOGBUNDLESTORAGE_H_ */
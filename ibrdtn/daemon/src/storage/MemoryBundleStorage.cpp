@@ -91,6 +91,8 @@ namespace dtn
 
 		void MemoryBundleStorage::get(const BundleSelector &cb, BundleResult &result) throw (NoBundleFoundException, BundleSelectorException)
 		{
+			ibrcommon::Histogram::Timer timer(_search_latency);
+
 			size_t items_added = 0;
 
 			// we have to iterate through all bundles
@@ -115,6 +117,8 @@ namespace dtn
 
 		dtn::data::Bundle MemoryBundleStorage::get(const dtn::data::BundleID &id)
 		{
+			ibrcommon::Histogram::Timer timer(_get_latency);
+
 			try {
 				ibrcommon::MutexLock l(_bundleslock);
 
@@ -160,6 +164,8 @@ namespace dtn
 
 		void MemoryBundleStorage::store(const dtn::data::Bundle &bundle)
 		{
+			ibrcommon::Histogram::Timer timer(_store_latency);
+
 			ibrcommon::MutexLock l(_bundleslock);
 
 			if (_faulty) return;
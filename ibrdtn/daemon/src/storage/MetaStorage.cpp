@@ -20,6 +20,7 @@
  */
 
 #include "storage/MetaStorage.h"
+#include <ibrdtn/data/BundleString.h>
 
 namespace dtn
 {
@@ -39,6 +40,13 @@ namespace dtn
 			return (_bundle_lengths.find(id) != _bundle_lengths.end());
 		}
 
+		dtn::data::Length MetaStorage::getSize(const dtn::data::BundleID &id) const throw ()
+		{
+			size_map::const_iterator it = _bundle_lengths.find(id);
+			if (it == _bundle_lengths.end()) return 0;
+			return (*it).second;
+		}
+
 		void MetaStorage::expire(const dtn::data::Timestamp &timestamp) throw ()
 		{
 			_list.expire(timestamp);
@@ -152,5 +160,42 @@ namespace dtn
 			_bundle_lengths.clear();
 			_removal_set.clear();
 		}
+
+		void MetaStorage::write(std::ostream &stream, const dtn::data::MetaBundle &meta)
+		{
+			stream << (const dtn::data::BundleID&)meta;
+			stream << dtn::data::Number(meta.getPayloadLength());
+			stream << meta.lifetime;
+			stream << dtn::data::BundleString(meta.destination.getString());
+			stream << dtn::data::BundleString(meta.reportto.getString());
+			stream << dtn::data::BundleString(meta.custodian.getString());
+			stream << meta.appdatalength;
+			stream << meta.procflags;
+			stream << meta.expiretime;
+			stream << meta.hopcount;
+			stream << dtn::data::Number(static_cast<uint32_t>(meta.net_priority.get<int>()));
+		}
+
+		void MetaStorage::read(std::istream &stream, dtn::data::MetaBundle &meta)
+		{
+			dtn::data::Number payloadlength, priority;
+			dtn::data::BundleString destination, reportto, custodian;
+
+			stream >> (dtn::data::BundleID&)meta;
+			stream >> payloadlength;
+			stream >> meta.lifetime;
+			stream >> destination >> reportto >> custodian;
+			stream >> meta.appdatalength;
+			stream >> meta.procflags;
+			stream >> meta.expiretime;
+			stream >> meta.hopcount;
+			stream >> priority;
+
+			meta.setPayloadLength(payloadlength.get<dtn::data::Length>());
+			meta.destination = dtn::data::EID(destination);
+			meta.reportto = dtn::data::EID(reportto);
+			meta.custodian = dtn::data::EID(custodian);
+			meta.net_priority = static_cast<int>(static_cast<uint32_t>(priority.get<dtn::data::Size>()));
+		}
 	} /* namespace storage */
 } /* namespace dtn */
@@ -98,6 +98,11 @@ namespace dtn
 
 			void store(const dtn::data::MetaBundle &meta, const dtn::data::Length &space) throw ();
 
+			/**
+			 * Returns the number of bytes allocated for a bundle
+			 */
+			dtn::data::Length getSize(const dtn::data::BundleID &id) const throw ();
+
 			/**
 			 * Remove a data entry completely and returns the number of
 			 * released bytes.
@@ -119,6 +124,17 @@ namespace dtn
 			 * Delete all bundles
 			 */
 			void clear() throw ();
+
+			/**
+			 * Write the meta data of a bundle to a stream. This is used to
+			 * persist the meta data in index and snapshot files.
+			 */
+			static void write(std::ostream &stream, const dtn::data::MetaBundle &meta);
+
+			/**
+			 * Read meta data written by write()
+			 */
+			static void read(std::istream &stream, dtn::data::MetaBundle &meta);
 		};
 	} /* namespace storage */
 } /* namespace dtn */
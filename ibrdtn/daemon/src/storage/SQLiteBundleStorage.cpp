@@ -45,6 +45,7 @@ namespace dtn
 	namespace storage
 	{
 		const std::string SQLiteBundleStorage::TAG = "SQLiteBundleStorage";
+		const size_t SQLiteBundleStorage::COPY_BUFFER_SIZE = 0x10000;
 
 		ibrcommon::Mutex SQLiteBundleStorage::TaskIdle::_mutex;
 		bool SQLiteBundleStorage::TaskIdle::_idle = false;
@@ -234,12 +235,16 @@ namespace dtn
 
 		void SQLiteBundleStorage::get(const BundleSelector &cb, BundleResult &result) throw (NoBundleFoundException, BundleSelectorException)
 		{
+			ibrcommon::Histogram::Timer timer(_search_latency);
+
 			ibrcommon::MutexLock l(_global_lock);
 			_database.get(cb, result);
 		}
 
 		dtn::data::Bundle SQLiteBundleStorage::get(const dtn::data::BundleID &id)
 		{
+			ibrcommon::Histogram::Timer timer(_get_latency);
+
 			SQLiteDatabase::blocklist blocks;
 			dtn::data::Bundle bundle;
 
@@ -277,21 +282,15 @@ namespace dtn
 							{
 								IBRCOMMON_LOGGER_DEBUG_TAG(SQLiteBundleStorage::TAG, 25) << "hard-link failed (" << errno << ") " << blob->_file.getPath() << " -> " << file.getPath() << IBRCOMMON_LOGGER_ENDL;
 
-								// copy the BLOB into a new file if hard-links are not supported
+								// copy the block file into the BLOB if hard-links are not supported
 								std::ofstream fout(blob->_file.getPath().c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
-
-								// open the filestream
-								ibrcommon::BLOB::iostream stream = ref.iostream();
-
-								const std::streamsize length = stream.size();
-								ibrcommon::BLOB::copy(fout, (*stream), length);
-							}
-							else
-							{
-								// update BLOB size
-								blob->update();
+								ibrcommon::BLOB::copy(fout, is, file.size(), COPY_BUFFER_SIZE);
+								fout.close();
 							}
 
+							// update BLOB size
+							blob->update();
+
 							// add payload block to the bundle
 							bundle.push_back(ref);
 						} catch (const ibrcommon::Exception &ex) {
@@ -339,6 +338,8 @@ namespace dtn
 
 		void SQLiteBundleStorage::store(const dtn::data::Bundle &bundle)
 		{
+			ibrcommon::Histogram::Timer timer(_store_latency);
+
 			IBRCOMMON_LOGGER_DEBUG_TAG(SQLiteBundleStorage::TAG, 25) << "store bundle " << bundle.toString() << IBRCOMMON_LOGGER_ENDL;
 
 			ibrcommon::RWLock l(_global_lock);
@@ -396,14 +397,14 @@ namespace dtn
 									std::ofstream fout(tmpfile.getPath().c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
 
 									const std::streamsize length = stream.size();
-									ibrcommon::BLOB::copy(fout, (*stream), length);
+									ibrcommon::BLOB::copy(fout, (*stream), length, COPY_BUFFER_SIZE);
 								}
 							} catch (const std::bad_cast&) {
 								// copy the BLOB into a new file this isn't a sqlite block object
 								std::ofstream fout(tmpfile.getPath().c_str(), std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
 
 								const std::streamsize length = stream.size();
-								ibrcommon::BLOB::copy(fout, (*stream), length);
+								ibrcommon::BLOB::copy(fout, (*stream), length, COPY_BUFFER_SIZE);
 							}
 						} catch (const std::bad_cast&) {
 							// remove the tmp file
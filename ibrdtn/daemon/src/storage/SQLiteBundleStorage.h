@@ -52,6 +52,9 @@ namespace dtn
 		{
 			static const std::string TAG;
 
+			// buffer size used to copy BLOBs if hard-links are not supported
+			static const size_t COPY_BUFFER_SIZE;
+
 		public:
 			/**
 			 * create a new BLOB object within this storage
@@ -25,6 +25,7 @@
 #include "core/BundleEvent.h"
 
 #include <ibrdtn/data/AgeBlock.h>
+#include <ibrdtn/data/BundleString.h>
 #include <ibrdtn/utils/Utils.h>
 #include <ibrdtn/utils/Clock.h>
 #include <ibrcommon/thread/RWLock.h>
@@ -38,15 +39,19 @@
 #include <fstream>
 #include <cstring>
 #include <cerrno>
+#include <stdio.h>
+#include <unistd.h>
 
 namespace dtn
 {
 	namespace storage
 	{
 		const std::string SimpleBundleStorage::TAG = "SimpleBundleStorage";
+		const std::string SimpleBundleStorage::SNAPSHOT_MAGIC = "ibrdtn-meta-snapshot";
 
-		SimpleBundleStorage::SimpleBundleStorage(const ibrcommon::File &workdir, const dtn::data::Length maxsize, const unsigned int buffer_limit)
-		 : BundleStorage(maxsize), _datastore(*this, workdir, buffer_limit), _metastore(this)
+		SimpleBundleStorage::SimpleBundleStorage(const ibrcommon::File &workdir, const dtn::data::Length maxsize, const unsigned int buffer_limit, const unsigned int lanes, const bool sync)
+		 : BundleStorage(maxsize), _datastore(*this, workdir, buffer_limit, false, lanes, sync), _metastore(this),
+		   _snapshot(workdir.get(".snapshot")), _validating(false), _validator(*this)
 		{
 		}
 
@@ -119,14 +124,39 @@ namespace dtn
 		}
 
 		void SimpleBundleStorage::iterateDataStorage(const dtn::storage::DataStorage::Hash &hash, dtn::storage::DataStorage::istream &stream)
+		{
+			dtn::data::Bundle bundle;
+			dtn::data::Length bundle_size = 0;
+
+			if (!__read(hash, stream, bundle, bundle_size)) return;
+
+			__restore(hash, bundle, bundle_size);
+		}
+
+		bool SimpleBundleStorage::__read(const DataStorage::Hash &hash, DataStorage::istream &stream, dtn::data::Bundle &bundle, dtn::data::Length &bundle_size)
 		{
 			try {
-				dtn::data::Bundle bundle;
 				dtn::data::DefaultDeserializer ds(*stream);
 
 				// load a bundle into the storage
 				ds >> bundle;
-				
+
+				bundle_size = static_cast<dtn::data::Length>( (*stream).tellg() );
+				return true;
+			} catch (const std::exception&) {
+				// report this error to the console
+				IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, error) << "Unable to restore bundle from file " << hash.value << IBRCOMMON_LOGGER_ENDL;
+
+				// error while reading file
+				_datastore.remove(hash);
+			}
+
+			return false;
+		}
+
+		bool SimpleBundleStorage::__restore(const DataStorage::Hash &hash, const dtn::data::Bundle &bundle, const dtn::data::Length &bundle_size)
+		{
+			try {
 				// extract meta data
 				const dtn::data::MetaBundle meta = dtn::data::MetaBundle::create(bundle);
 
@@ -134,17 +164,16 @@ namespace dtn
 				DataStorage::Hash hash2(BundleContainer::createId(meta));
 				if (hash != hash2)
 				{
-					// if hash does not match, remove old file
-					_datastore.remove(hash);
-
-					// and store bundle again
+					// if hash does not match, store bundle again
 					store(bundle);
 
-					return;
+					// and remove the old file
+					_datastore.remove(hash);
+
+					return true;
 				}
 
 				// allocate space for the bundle
-				const dtn::data::Length bundle_size = static_cast<dtn::data::Length>( (*stream).tellg() );
 				allocSpace(bundle_size);
 
 				// lock the bundle lists
@@ -157,13 +186,17 @@ namespace dtn
 				eventBundleAdded(meta);
 
 				IBRCOMMON_LOGGER_DEBUG_TAG(SimpleBundleStorage::TAG, 10) << "bundle restored " << bundle.toString() << IBRCOMMON_LOGGER_ENDL;
-			} catch (const std::exception&) {
+
+				return true;
+			} catch (const std::exception &ex) {
 				// report this error to the console
-				IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, error) << "Unable to restore bundle from file " << hash.value << IBRCOMMON_LOGGER_ENDL;
+				IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, error) << "Unable to restore bundle " << bundle.toString() << " from file " << hash.value << ": " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 
-				// error while reading file
+				// drop the data of the bundle
 				_datastore.remove(hash);
 			}
+
+			return false;
 		}
 
 		void SimpleBundleStorage::componentUp() throw ()
@@ -171,7 +204,10 @@ namespace dtn
 			// routine checked for throw() on 15.02.2013
 
 			// load persistent bundles
-			_datastore.iterateAll();
+			if (!loadSnapshot())
+			{
+				_datastore.iterateAll(getRecoveryThreads());
+			}
 
 			// some output
 			{
@@ -183,6 +219,9 @@ namespace dtn
 
 			try {
 				_datastore.start();
+
+				// validate the restored bundles in the background
+				if (_validating) _validator.start();
 			} catch (const ibrcommon::ThreadException &ex) {
 				IBRCOMMON_LOGGER_TAG("SimpleBundleStorage", error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
@@ -194,16 +233,30 @@ namespace dtn
 
 			dtn::core::EventDispatcher<dtn::core::TimeEvent>::remove(this);
 			try {
+				_validator.stop();
+				_validator.join();
+				_validator.reset();
+
 				_datastore.wait();
 				_datastore.stop();
 				_datastore.join();
 
+				const DataStorage::Statistics stats = _datastore.getStatistics();
+				IBRCOMMON_LOGGER_DEBUG_TAG(SimpleBundleStorage::TAG, 10) << stats.stored << " stored, " << stats.removed << " removed in " << stats.batches << " batches, max. queue depth: " << stats.queue_depth_max << IBRCOMMON_LOGGER_ENDL;
+
 				// reset datastore
 				_datastore.reset();
 
 				// clear all data structures
 				ibrcommon::RWLock l(_meta_lock);
+
+				// persist the meta data for a fast startup
+				saveSnapshot();
+
 				_metastore.clear();
+				_restored.clear();
+				_modified.clear();
+				_validating = false;
 				clearSpace();
 			} catch (const ibrcommon::Exception &ex) {
 				IBRCOMMON_LOGGER_TAG("SimpleBundleStorage", error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
@@ -255,6 +308,8 @@ namespace dtn
 
 		void SimpleBundleStorage::get(const BundleSelector &cb, BundleResult &result) throw (NoBundleFoundException, BundleSelectorException)
 		{
+			ibrcommon::Histogram::Timer timer(_search_latency);
+
 			size_t items_added = 0;
 
 			// we have to iterate through all bundles
@@ -279,6 +334,8 @@ namespace dtn
 
 		dtn::data::Bundle SimpleBundleStorage::get(const dtn::data::BundleID &id)
 		{
+			ibrcommon::Histogram::Timer timer(_get_latency);
+
 			try {
 				ibrcommon::MutexLock l(_meta_lock);
 
@@ -352,6 +409,8 @@ namespace dtn
 
 		void SimpleBundleStorage::store(const dtn::data::Bundle &bundle)
 		{
+			ibrcommon::Histogram::Timer timer(_store_latency);
+
 			// get the bundle size
 			dtn::data::DefaultSerializer s(std::cout);
 			const dtn::data::Length bundle_size = s.getLength(bundle);
@@ -399,7 +458,7 @@ namespace dtn
 
 		void SimpleBundleStorage::remove(const dtn::data::BundleID &id)
 		{
-			ibrcommon::MutexLock l(_meta_lock);
+			ibrcommon::RWLock l(_meta_lock);
 			const dtn::data::MetaBundle &meta = _metastore.find(dtn::data::MetaBundle::create(id));
 
 			// first check if the bundles is already marked as removed
@@ -410,6 +469,7 @@ namespace dtn
 
 				// create the hash for data storage removal
 				DataStorage::Hash hash(BundleContainer::createId(meta));
+				if (_validating) _modified.insert(hash);
 
 				// create a background task for removing the bundle
 				_datastore.remove(hash);
@@ -442,6 +502,8 @@ namespace dtn
 
 				// add the new bundles to the meta storage
 				_metastore.store(meta, bundle_size);
+
+				if (_validating) _modified.insert(hash);
 			}
 
 			// put the bundle into the data store
@@ -463,6 +525,7 @@ namespace dtn
 				const dtn::data::MetaBundle &meta = (*iter);
 
 				DataStorage::Hash hash(BundleContainer::createId(meta));
+				if (_validating) _modified.insert(hash);
 
 				// create a background task for removing the bundle
 				_datastore.remove(hash);
@@ -472,6 +535,7 @@ namespace dtn
 		void SimpleBundleStorage::eventBundleExpired(const dtn::data::MetaBundle &b) throw ()
 		{
 			DataStorage::Hash hash(BundleContainer::createId(b));
+			if (_validating) _modified.insert(hash);
 
 			// create a background task for removing the bundle
 			_datastore.remove(hash);
@@ -486,6 +550,208 @@ namespace dtn
 			eventBundleRemoved(b);
 		}
 
+		unsigned int SimpleBundleStorage::getRecoveryThreads()
+		{
+#ifdef _SC_NPROCESSORS_ONLN
+			const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+			if (cpus > 1) return static_cast<unsigned int>(cpus);
+#endif
+			return 1;
+		}
+
+		bool SimpleBundleStorage::loadSnapshot() throw ()
+		{
+			if (!_snapshot.exists()) return false;
+
+			// the snapshot has been written after this object was created
+			_snapshot.update();
+
+			typedef std::list<std::pair<dtn::data::MetaBundle, dtn::data::Length> > entry_list;
+			entry_list entries;
+
+			try {
+				std::ifstream stream(_snapshot.getPath().c_str(), std::ios::in | std::ios::binary);
+
+				dtn::data::BundleString magic;
+				dtn::data::Number count;
+
+				stream >> magic;
+				if (magic != SNAPSHOT_MAGIC) throw ibrcommon::IOException("invalid snapshot header");
+
+				stream >> count;
+
+				for (dtn::data::Size i = 0; (i < count.get<dtn::data::Size>()) && stream.good(); ++i)
+				{
+					dtn::data::Number space;
+					dtn::data::MetaBundle meta;
+
+					stream >> space;
+					MetaStorage::read(stream, meta);
+					entries.push_back(std::make_pair(meta, space.get<dtn::data::Length>()));
+				}
+
+				stream >> magic;
+				if (!stream.good() || (magic != SNAPSHOT_MAGIC)) throw ibrcommon::IOException("snapshot is truncated");
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, warning) << "snapshot not usable, reading all bundles: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				_snapshot.remove();
+				return false;
+			}
+
+			// the snapshot is outdated as soon as the first bundle is stored or removed
+			_snapshot.remove();
+
+			ibrcommon::RWLock l(_meta_lock);
+
+			for (entry_list::const_iterator it = entries.begin(); it != entries.end(); ++it)
+			{
+				const dtn::data::MetaBundle &meta = (*it).first;
+
+				// allocate space for the bundle
+				try {
+					allocSpace((*it).second);
+				} catch (const StorageSizeExeededException&) {
+					IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, error) << "storage is full, unable to restore bundle " << meta.toString() << IBRCOMMON_LOGGER_ENDL;
+					continue;
+				}
+
+				// add the bundle to the stored bundles
+				_metastore.store(meta, (*it).second);
+				_restored[DataStorage::Hash(BundleContainer::createId(meta))] = meta;
+
+				// raise bundle added event
+				eventBundleAdded(meta);
+			}
+
+			_validating = true;
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(SimpleBundleStorage::TAG, 10) << _restored.size() << " bundles restored from snapshot" << IBRCOMMON_LOGGER_ENDL;
+
+			return true;
+		}
+
+		void SimpleBundleStorage::saveSnapshot() throw ()
+		{
+			ibrcommon::File tmp = _snapshot.getParent().get(".snapshot.tmp");
+
+			std::ofstream stream(tmp.getPath().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+			// count the entries first, bundles marked as removed are not written
+			dtn::data::Size count = 0;
+			for (MetaStorage::const_iterator it = _metastore.begin(); it != _metastore.end(); ++it)
+			{
+				if (!_metastore.isRemoved(*it)) count++;
+			}
+
+			stream << dtn::data::BundleString(SNAPSHOT_MAGIC);
+			stream << dtn::data::Number(count);
+
+			for (MetaStorage::const_iterator it = _metastore.begin(); it != _metastore.end(); ++it)
+			{
+				const dtn::data::MetaBundle &meta = (*it);
+				if (_metastore.isRemoved(meta)) continue;
+
+				stream << dtn::data::Number(_metastore.getSize(meta));
+				MetaStorage::write(stream, meta);
+			}
+
+			stream << dtn::data::BundleString(SNAPSHOT_MAGIC);
+			stream.close();
+
+			if (stream.fail() || (::rename(tmp.getPath().c_str(), _snapshot.getPath().c_str()) != 0))
+			{
+				IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, error) << "unable to write snapshot [" << std::strerror(errno) << "]" << IBRCOMMON_LOGGER_ENDL;
+				tmp.remove();
+			}
+		}
+
+		SimpleBundleStorage::Validator::Validator(SimpleBundleStorage &storage)
+		 : _storage(storage), _abort(false)
+		{
+		}
+
+		SimpleBundleStorage::Validator::~Validator()
+		{
+			join();
+		}
+
+		void SimpleBundleStorage::Validator::__cancellation() throw ()
+		{
+			_abort = true;
+		}
+
+		void SimpleBundleStorage::Validator::run() throw ()
+		{
+			_abort = false;
+
+			std::set<DataStorage::Hash> stored;
+			_storage._datastore.list(stored);
+
+			dtn::data::Size missing = 0, recovered = 0;
+
+			// remove bundles without data
+			for (hash_map::const_iterator it = _storage._restored.begin(); (it != _storage._restored.end()) && !_abort; ++it)
+			{
+				const DataStorage::Hash &hash = (*it).first;
+				if (stored.find(hash) != stored.end()) continue;
+
+				ibrcommon::RWLock l(_storage._meta_lock);
+				if (_storage._modified.find(hash) != _storage._modified.end()) continue;
+
+				try {
+					const dtn::data::MetaBundle &meta = _storage._metastore.find(dtn::data::MetaBundle::create((*it).second));
+					if (_storage._metastore.isRemoved(meta)) continue;
+
+					IBRCOMMON_LOGGER_TAG(SimpleBundleStorage::TAG, warning) << "data of bundle " << meta.toString() << " is missing" << IBRCOMMON_LOGGER_ENDL;
+
+					_storage._metastore.markRemoved(meta);
+
+					// releases the meta data once done
+					_storage._datastore.remove(hash);
+
+					// raise bundle removed event
+					_storage.eventBundleRemoved(meta);
+					missing++;
+				} catch (const NoBundleFoundException&) { }
+			}
+
+			// restore data not contained in the snapshot
+			for (std::set<DataStorage::Hash>::const_iterator it = stored.begin(); (it != stored.end()) && !_abort; ++it)
+			{
+				const DataStorage::Hash &hash = (*it);
+				if (_storage._restored.find(hash) != _storage._restored.end()) continue;
+
+				{
+					ibrcommon::MutexLock l(_storage._meta_lock);
+					if (_storage._modified.find(hash) != _storage._modified.end()) continue;
+				}
+
+				dtn::data::Bundle bundle;
+				dtn::data::Length bundle_size = 0;
+
+				// the stream locks the lane of the file, it has to be closed before
+				// the bundle is stored again because store() may wait for the lane
+				try {
+					DataStorage::istream stream = _storage._datastore.retrieve(hash);
+					if (!_storage.__read(hash, stream, bundle, bundle_size)) continue;
+				} catch (const DataStorage::DataNotAvailableException&) {
+					continue;
+				}
+
+				if (_storage.__restore(hash, bundle, bundle_size)) recovered++;
+			}
+
+			ibrcommon::RWLock l(_storage._meta_lock);
+
+			if (_abort) return;
+
+			_storage._validating = false;
+			_storage._restored.clear();
+			_storage._modified.clear();
+
+			IBRCOMMON_LOGGER_DEBUG_TAG(SimpleBundleStorage::TAG, 10) << "snapshot validated, " << missing << " bundles missing, " << recovered << " bundles recovered" << IBRCOMMON_LOGGER_ENDL;
+		}
+
 		SimpleBundleStorage::BundleContainer::BundleContainer(const dtn::data::Bundle &b)
 		 : _bundle(b)
 		{ }
@@ -541,5 +807,10 @@ namespace dtn
 			// return the stream, this allows stacking
 			return stream;
 		}
+
+		size_t SimpleBundleStorage::BundleContainer::getSize() const
+		{
+			return dtn::data::DefaultSerializer(std::cout).getLength(_bundle);
+		}
 	}
 }
@@ -40,6 +40,7 @@
 #include <ibrdtn/data/Bundle.h>
 #include <ibrdtn/data/BundleList.h>
 #include <ibrcommon/thread/Queue.h>
+#include <ibrcommon/thread/Thread.h>
 
 #include <set>
 #include <map>
@@ -50,6 +51,10 @@ namespace dtn
 	{
 		/**
 		 * This storage holds all bundles and fragments in the system memory.
+		 * On shutdown the meta data of all bundles is written to a snapshot
+		 * file. The next startup restores the meta data from this snapshot
+		 * and validates it against the stored files in the background.
+		 * Without a snapshot all files are read by parallel threads.
 		 */
 		class SimpleBundleStorage : public DataStorage::Callback, public BundleStorage, public dtn::core::EventReceiver<dtn::core::TimeEvent>, public dtn::daemon::IntegratedComponent, public dtn::data::BundleList::Listener
 		{
@@ -58,8 +63,13 @@ namespace dtn
 		public:
 			/**
 			 * Constructor
+			 * @param workdir Directory to store the bundles in.
+			 * @param maxsize Maximum size of the storage in bytes.
+			 * @param buffer_limit Maximum number of bundles in the write buffer.
+			 * @param lanes Number of parallel I/O threads.
+			 * @param sync If true, bundles are flushed to the disk before they are reported as stored.
 			 */
-			SimpleBundleStorage(const ibrcommon::File &workdir, const dtn::data::Length maxsize = 0, const unsigned int buffer_limit = 0);
+			SimpleBundleStorage(const ibrcommon::File &workdir, const dtn::data::Length maxsize = 0, const unsigned int buffer_limit = 0, const unsigned int lanes = 1, const bool sync = false);
 
 			/**
 			 * Destructor
@@ -187,10 +197,65 @@ namespace dtn
 				 */
 				std::ostream& serialize(std::ostream &stream);
 
+				/**
+				 * get the serialized length of the bundle
+				 */
+				size_t getSize() const;
+
 			private:
 				const dtn::data::Bundle _bundle;
 			};
 
+			/**
+			 * Compares the meta data restored from a snapshot with
+			 * the stored files
+			 */
+			class Validator : public ibrcommon::JoinableThread
+			{
+			public:
+				Validator(SimpleBundleStorage &storage);
+				virtual ~Validator();
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				SimpleBundleStorage &_storage;
+				bool _abort;
+			};
+
+			static const std::string SNAPSHOT_MAGIC;
+
+			/**
+			 * Returns the number of threads used to read all files
+			 */
+			static unsigned int getRecoveryThreads();
+
+			/**
+			 * Restore the meta data of all bundles from the snapshot file
+			 * @return True, if the snapshot has been loaded
+			 */
+			bool loadSnapshot() throw ();
+
+			/**
+			 * Write the meta data of all bundles to the snapshot file
+			 */
+			void saveSnapshot() throw ();
+
+			/**
+			 * Read a stored bundle, the data is removed if it is not readable
+			 * @return False, if the bundle could not be read
+			 */
+			bool __read(const DataStorage::Hash &hash, DataStorage::istream &stream, dtn::data::Bundle &bundle, dtn::data::Length &bundle_size);
+
+			/**
+			 * Add a bundle read from the data storage to the meta data,
+			 * or store it again if its hash has changed
+			 * @return False, if the bundle could not be restored and its data has been removed
+			 */
+			bool __restore(const DataStorage::Hash &hash, const dtn::data::Bundle &bundle, const dtn::data::Length &bundle_size);
+
 			void __remove(const dtn::data::MetaBundle &meta);
 			void __store(const dtn::data::Bundle &bundle, const dtn::data::Length &bundle_size);
 
@@ -204,6 +269,19 @@ namespace dtn
 			// stores all the meta data in memory
 			ibrcommon::RWMutex _meta_lock;
 			MetaStorage _metastore;
+
+			// snapshot of the meta data
+			ibrcommon::File _snapshot;
+
+			// bundles restored from the snapshot and not validated yet
+			typedef std::map<DataStorage::Hash, dtn::data::BundleID> hash_map;
+			hash_map _restored;
+
+			// data stored or removed while validating, locked by _meta_lock
+			std::set<DataStorage::Hash> _modified;
+			bool _validating;
+
+			Validator _validator;
 		};
 	}
 }
@@ -0,0 +1,85 @@
+/*
+ * BenchmarkModule.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef BENCHMARKMODULE_H_
+#define BENCHMARKMODULE_H_
+
+#include <ibrcommon/TimeMeasurement.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+
+/**
+ * A benchmark module runs a set of workloads and reports the
+ * results as tab-separated lines of the form
+ * <module> <workload> <metric> <value> <unit>
+ */
+class BenchmarkModule
+{
+public:
+	BenchmarkModule(const std::string &name) : _name(name) {};
+	virtual ~BenchmarkModule() {};
+
+	const std::string& getName() const { return _name; };
+
+	virtual void run() = 0;
+
+	/**
+	 * Returns false if the benchmark detected an inconsistent result
+	 */
+	virtual bool check() = 0;
+
+protected:
+	void report(const std::string &workload, const std::string &metric, const double value, const std::string &unit) const
+	{
+		std::cout << _name << "\t" << workload << "\t" << metric << "\t" << value << "\t" << unit << std::endl;
+	}
+
+	void report(const std::string &workload, const size_t count, const ibrcommon::TimeMeasurement &tm) const
+	{
+		const double ms = tm.getMilliseconds();
+		report(workload, "time", ms, "ms");
+		if (ms > 0) report(workload, "rate", (double)count / (ms / 1000.0), "ops/s");
+	}
+
+	/**
+	 * Returns the number of bytes written by this process so far
+	 * or zero if this information is not available.
+	 */
+	static size_t getWrittenBytes()
+	{
+		std::ifstream io("/proc/self/io");
+		std::string key;
+		size_t value = 0;
+
+		while (io >> key >> value)
+		{
+			if (key == "wchar:") return value;
+		}
+
+		return 0;
+	}
+
+private:
+	const std::string _name;
+};
+
+#endif /* BENCHMARKMODULE_H_ */
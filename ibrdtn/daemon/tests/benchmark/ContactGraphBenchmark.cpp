@@ -0,0 +1,222 @@
+/*
+ * ContactGraphBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "ContactGraphBenchmark.h"
+#include <ibrcommon/TimeMeasurement.h>
+#include <sstream>
+#include <cstdlib>
+
+// length of the contact plan in seconds
+static const size_t PLAN_DURATION = 86400;
+
+// shortest and longest contact in seconds
+static const size_t MIN_CONTACT = 60;
+static const size_t MAX_CONTACT = 1800;
+
+// number of route tables to compute
+static const size_t TABLES = 20;
+
+// number of bundles routed with a search each
+static const size_t SEARCHES = 100;
+
+ContactGraphBenchmark::ContactGraphBenchmark(const size_t nodes, const size_t contacts, const size_t bundles)
+ : BenchmarkModule("ContactGraph"), _num_nodes(nodes), _num_contacts(contacts), _num_bundles(bundles), _failed(false)
+{
+	// use a fixed seed to get reproducible workloads
+	srand(42);
+
+	for (size_t i = 0; i < _num_nodes; ++i)
+	{
+		std::stringstream ss;
+		ss << "dtn://node-" << i;
+		_nodes.push_back(dtn::data::EID(ss.str()));
+	}
+
+	for (size_t i = 0; i < _num_contacts; ++i)
+	{
+		const size_t from = rand() % _num_nodes;
+		size_t to = rand() % _num_nodes;
+		if (to == from) to = (to + 1) % _num_nodes;
+
+		const size_t start = rand() % PLAN_DURATION;
+		const size_t end = start + MIN_CONTACT + (rand() % (MAX_CONTACT - MIN_CONTACT));
+
+		// the propagation delay is a property of the link
+		const size_t delay = (from + to) % 3;
+
+		_plan.add(dtn::routing::Contact(_nodes[from], _nodes[to], start, end, delay));
+		_from.push_back(from);
+		_to.push_back(to);
+	}
+}
+
+ContactGraphBenchmark::~ContactGraphBenchmark()
+{
+}
+
+bool ContactGraphBenchmark::verify(const size_t source, const dtn::data::Timestamp &now, const dtn::routing::ContactGraph::RouteTable &table) const
+{
+	const dtn::routing::ContactPlan::contact_list &contacts = _plan.getContacts();
+
+	std::vector<dtn::data::Timestamp> arrival(_num_nodes, dtn::data::Timestamp::max());
+	arrival[source] = now;
+
+	// relax all contacts until the arrival times are stable
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		for (size_t i = 0; i < contacts.size(); ++i)
+		{
+			const dtn::routing::Contact &c = contacts[i];
+			const dtn::data::Timestamp &a = arrival[_from[i]];
+
+			if ((a == dtn::data::Timestamp::max()) || (c.end < a)) continue;
+
+			const dtn::data::Timestamp t = ((a < c.start) ? c.start : a) + c.delay;
+			if (t < arrival[_to[i]])
+			{
+				arrival[_to[i]] = t;
+				changed = true;
+			}
+		}
+	}
+
+	for (size_t v = 0; v < _num_nodes; ++v)
+	{
+		if (v == source) continue;
+
+		const dtn::routing::ContactGraph::Route *route = table.find(_nodes[v]);
+
+		if (arrival[v] == dtn::data::Timestamp::max())
+		{
+			if (route != NULL) return false;
+		}
+		else
+		{
+			if ((route == NULL) || (route->arrival != arrival[v])) return false;
+		}
+	}
+
+	return true;
+}
+
+void ContactGraphBenchmark::run()
+{
+	dtn::routing::ContactGraph graph;
+
+	// compile the contact plan
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		graph.build(_plan);
+
+		tm.stop();
+		report("build", "time", tm.getMilliseconds(), "ms");
+		report("build", "nodes", (double)graph.getNodes(), "nodes");
+		report("build", "contacts", (double)graph.getContacts(), "contacts");
+	}
+
+	// compute route tables for different sources and points in time
+	std::vector<dtn::routing::ContactGraph::RouteTable> tables(TABLES);
+	{
+		size_t routes = 0;
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < TABLES; ++i)
+		{
+			graph.compute(_nodes[i % _num_nodes], (PLAN_DURATION / TABLES) * i, tables[i]);
+			routes += tables[i].size();
+		}
+
+		tm.stop();
+		report("compute", TABLES, tm);
+		report("compute", "routes", (double)routes / (double)TABLES, "routes/table");
+	}
+
+	for (size_t i = 0; i < TABLES; ++i)
+	{
+		if (!verify(i % _num_nodes, (PLAN_DURATION / TABLES) * i, tables[i])) _failed = true;
+	}
+
+	// destinations of the routed bundles
+	std::vector<size_t> destinations;
+	destinations.reserve(_num_bundles);
+	for (size_t i = 0; i < _num_bundles; ++i)
+	{
+		destinations.push_back(rand() % _num_nodes);
+	}
+
+	// one lookup in the route table per bundle
+	size_t lookup_routes = 0;
+	{
+		const dtn::routing::ContactGraph::RouteTable &table = tables[0];
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < _num_bundles; ++i)
+		{
+			if (table.find(_nodes[destinations[i]]) != NULL) lookup_routes++;
+		}
+
+		tm.stop();
+		report("lookup", _num_bundles, tm);
+	}
+
+	// one route search per bundle
+	{
+		size_t search_routes = 0;
+		dtn::routing::ContactGraph::RouteTable table;
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < SEARCHES; ++i)
+		{
+			graph.compute(_nodes[0], 0, table);
+			if (table.find(_nodes[destinations[i]]) != NULL) search_routes++;
+		}
+
+		tm.stop();
+		report("search", SEARCHES, tm);
+
+		// both methods have to find the same routes
+		size_t expected = 0;
+		for (size_t i = 0; i < SEARCHES; ++i)
+		{
+			if (tables[0].find(_nodes[destinations[i]]) != NULL) expected++;
+		}
+		if (expected != search_routes) _failed = true;
+	}
+
+	report("lookup", "routes", (double)lookup_routes, "routes");
+}
+
+bool ContactGraphBenchmark::check()
+{
+	return !_failed;
+}
@@ -0,0 +1,73 @@
+/*
+ * ContactGraphBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef CONTACTGRAPHBENCHMARK_H_
+#define CONTACTGRAPHBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include "routing/contactgraph/ContactPlan.h"
+#include "routing/contactgraph/ContactGraph.h"
+#include <ibrdtn/data/EID.h>
+#include <vector>
+
+/**
+ * Measures the contact graph routing on a random contact plan: the
+ * compilation of the plan, the computation of the route table and the
+ * per-bundle lookup compared to a route search for each bundle. The
+ * computed routes are verified against a Bellman-Ford relaxation over
+ * the plain list of contacts.
+ */
+class ContactGraphBenchmark : public BenchmarkModule
+{
+public:
+	/**
+	 * @param nodes Number of nodes in the contact plan
+	 * @param contacts Number of contacts in the contact plan
+	 * @param bundles Number of bundles to route
+	 */
+	ContactGraphBenchmark(const size_t nodes = 1000, const size_t contacts = 100000, const size_t bundles = 1000000);
+	virtual ~ContactGraphBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Compare the routes of a table with the earliest arrival
+	 * times of a Bellman-Ford relaxation
+	 */
+	bool verify(const size_t source, const dtn::data::Timestamp &now, const dtn::routing::ContactGraph::RouteTable &table) const;
+
+	const size_t _num_nodes;
+	const size_t _num_contacts;
+	const size_t _num_bundles;
+
+	std::vector<dtn::data::EID> _nodes;
+	dtn::routing::ContactPlan _plan;
+
+	// contacts as node indices for the reference computation
+	std::vector<size_t> _from;
+	std::vector<size_t> _to;
+
+	bool _failed;
+};
+
+#endif /* CONTACTGRAPHBENCHMARK_H_ */
@@ -0,0 +1,357 @@
+/*
+ * EmulatedDatagramService.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "EmulatedDatagramService.h"
+#include <ibrdtn/utils/Utils.h>
+#include <ibrcommon/net/socket.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Metrics.h>
+#include <sstream>
+#include <cstdlib>
+#include <string.h>
+
+EmulatedDatagramService::LinkModel::LinkModel()
+ : bandwidth(10000000), delay(10000), loss(0.0), period(0), uptime(0)
+{
+}
+
+EmulatedDatagramService::LinkModel::~LinkModel()
+{
+}
+
+EmulatedDatagramService::Frame::Frame()
+ : peer(0)
+{
+}
+
+EmulatedDatagramService::Frame::~Frame()
+{
+}
+
+EmulatedDatagramService::DelayLine::DelayLine(EmulatedDatagramService &service)
+ : _service(service), _running(true)
+{
+}
+
+EmulatedDatagramService::DelayLine::~DelayLine()
+{
+	join();
+}
+
+void EmulatedDatagramService::DelayLine::push(const uint64_t due, const Frame &frame)
+{
+	ibrcommon::MutexLock l(_cond);
+	_frames.insert(std::make_pair(due, frame));
+	_cond.signal(true);
+}
+
+void EmulatedDatagramService::DelayLine::run() throw ()
+{
+	while (true)
+	{
+		Frame frame;
+
+		try {
+			ibrcommon::MutexLock l(_cond);
+
+			while (true)
+			{
+				if (!_running) return;
+
+				if (_frames.empty())
+				{
+					_cond.wait();
+					continue;
+				}
+
+				const uint64_t now = ibrcommon::Histogram::now();
+				std::multimap<uint64_t, Frame>::iterator it = _frames.begin();
+
+				if ((*it).first > now)
+				{
+					// wait until the next frame is due, at least one millisecond
+					const uint64_t ms = ((*it).first - now) / 1000;
+
+					try {
+						_cond.wait((ms > 0) ? ms : 1);
+					} catch (const ibrcommon::Conditional::ConditionalAbortException &ex) {
+						if (ex.reason != ibrcommon::Conditional::ConditionalAbortException::COND_TIMEOUT) throw;
+					}
+					continue;
+				}
+
+				frame = (*it).second;
+				_frames.erase(it);
+				break;
+			}
+		} catch (const ibrcommon::Conditional::ConditionalAbortException&) {
+			return;
+		}
+
+		// hand the frame to the socket without holding the lock
+		_service.deliver(frame);
+	}
+}
+
+void EmulatedDatagramService::DelayLine::__cancellation() throw ()
+{
+	ibrcommon::MutexLock l(_cond);
+	_running = false;
+	_cond.abort();
+}
+
+EmulatedDatagramService::EmulatedDatagramService(const size_t index, const size_t nodes, const TOPOLOGY topology, const LinkModel &model, const int base_port, const uint64_t epoch)
+ : _index(index), _nodes(nodes), _topology(topology), _model(model), _base_port(base_port), _epoch(epoch),
+   _iface("lo"), _sock(NULL), _busy_until(nodes, 0), _seed(static_cast<unsigned int>(index + 1)),
+   _frames_sent(0), _frames_dropped(0), _delay_line(*this)
+{
+	_params.max_msg_length = 1400 - HEADER_LENGTH;
+	_params.max_seq_numbers = 16;
+	_params.flowcontrol = DatagramService::FLOW_SLIDING_WINDOW;
+	_params.retry_limit = 5;
+
+	// the retransmission timeout has to cover the round-trip time
+	// and the transmission of a whole window
+	size_t window_time = 0;
+	if (_model.bandwidth > 0)
+	{
+		window_time = (_params.max_seq_numbers * 1400 * 8 * 1000) / _model.bandwidth;
+	}
+	_params.initial_timeout = 50 + (2 * _model.delay / 1000) + window_time;
+}
+
+EmulatedDatagramService::~EmulatedDatagramService()
+{
+	_delay_line.stop();
+	_delay_line.join();
+	_vsocket.destroy();
+}
+
+void EmulatedDatagramService::bind() throw (dtn::net::DatagramException)
+{
+	_vsocket.destroy();
+
+	try {
+		_sock = new ibrcommon::udpsocket(ibrcommon::vaddress("127.0.0.1", _base_port + static_cast<int>(_index), AF_INET));
+		_vsocket.add(_sock);
+		_vsocket.up();
+	} catch (const ibrcommon::Exception&) {
+		throw dtn::net::DatagramException("bind failed");
+	}
+
+	_delay_line.start();
+}
+
+void EmulatedDatagramService::shutdown()
+{
+	_vsocket.down();
+	_delay_line.stop();
+}
+
+void EmulatedDatagramService::send(const char &type, const char &flags, const unsigned int &seqno, const std::string &address, const char *buf, size_t length) throw (dtn::net::DatagramException)
+{
+	const size_t peer = decode(address);
+	if (peer >= _nodes) throw dtn::net::DatagramException("unknown address");
+
+	transmit(peer, type, flags, seqno, buf, length);
+}
+
+void EmulatedDatagramService::send(const char &type, const char &flags, const unsigned int &seqno, const char *buf, size_t length) throw (dtn::net::DatagramException)
+{
+	// a broadcast reaches all nodes in contact
+	for (size_t peer = 0; peer < _nodes; ++peer)
+	{
+		if (peer == _index) continue;
+		transmit(peer, type, flags, seqno, buf, length);
+	}
+}
+
+void EmulatedDatagramService::transmit(const size_t peer, const char &type, const char &flags, const unsigned int &seqno, const char *buf, size_t length)
+{
+	const uint64_t now = ibrcommon::Histogram::now();
+
+	// there is no link to this node in the topology
+	if (_topology == TOPOLOGY_CHAIN && (peer + 1 != _index) && (_index + 1 != peer)) return;
+
+	Frame frame;
+	frame.peer = peer;
+	frame.data.resize(length + HEADER_LENGTH);
+
+	frame.data[0] = type;
+	frame.data[1] = flags;
+	frame.data[2] = static_cast<char>((seqno >> 24) & 0xff);
+	frame.data[3] = static_cast<char>((seqno >> 16) & 0xff);
+	frame.data[4] = static_cast<char>((seqno >> 8) & 0xff);
+	frame.data[5] = static_cast<char>(seqno & 0xff);
+	frame.data[6] = static_cast<char>((_index >> 8) & 0xff);
+	frame.data[7] = static_cast<char>(_index & 0xff);
+	if (length > 0) ::memcpy(&frame.data[HEADER_LENGTH], buf, length);
+
+	uint64_t due = now;
+
+	{
+		ibrcommon::MutexLock l(_link_lock);
+		_frames_sent++;
+
+		if (!isConnected(peer, now) || (((double)rand_r(&_seed) / (double)RAND_MAX) < _model.loss))
+		{
+			_frames_dropped++;
+			return;
+		}
+
+		// frames on the same link are serialized according to the bandwidth
+		if (_model.bandwidth > 0)
+		{
+			const uint64_t start = (_busy_until[peer] > now) ? _busy_until[peer] : now;
+			_busy_until[peer] = start + (frame.data.size() * 8 * 1000000) / _model.bandwidth;
+			due = _busy_until[peer];
+		}
+	}
+
+	_delay_line.push(due + _model.delay, frame);
+}
+
+void EmulatedDatagramService::deliver(const Frame &frame)
+{
+	// drop frames of links disrupted during the propagation
+	if (!isConnected(frame.peer, ibrcommon::Histogram::now()))
+	{
+		ibrcommon::MutexLock l(_link_lock);
+		_frames_dropped++;
+		return;
+	}
+
+	try {
+		_sock->sendto(&frame.data[0], frame.data.size(), 0, ibrcommon::vaddress("127.0.0.1", _base_port + static_cast<int>(frame.peer), AF_INET));
+	} catch (const ibrcommon::Exception&) {
+		ibrcommon::MutexLock l(_link_lock);
+		_frames_dropped++;
+	}
+}
+
+size_t EmulatedDatagramService::recvfrom(char *buf, size_t length, char &type, char &flags, unsigned int &seqno, std::string &address) throw (dtn::net::DatagramException)
+{
+	try {
+		ibrcommon::socketset readfds;
+		_vsocket.select(&readfds, NULL, NULL, NULL);
+
+		for (ibrcommon::socketset::iterator iter = readfds.begin(); iter != readfds.end(); ++iter)
+		{
+			ibrcommon::udpsocket &sock = dynamic_cast<ibrcommon::udpsocket&>(**iter);
+
+			std::vector<char> tmp(length + HEADER_LENGTH);
+			ibrcommon::vaddress peeraddr;
+			const ssize_t ret = sock.recvfrom(&tmp[0], tmp.size(), 0, peeraddr);
+			if (ret < static_cast<ssize_t>(HEADER_LENGTH)) continue;
+
+			type = tmp[0];
+			flags = tmp[1];
+			seqno = (static_cast<unsigned char>(tmp[2]) << 24) | (static_cast<unsigned char>(tmp[3]) << 16)
+					| (static_cast<unsigned char>(tmp[4]) << 8) | static_cast<unsigned char>(tmp[5]);
+			address = encode((static_cast<unsigned char>(tmp[6]) << 8) | static_cast<unsigned char>(tmp[7]));
+
+			const size_t len = ret - HEADER_LENGTH;
+			if (len > 0) ::memcpy(buf, &tmp[HEADER_LENGTH], len);
+
+			return len;
+		}
+	} catch (const std::bad_cast&) {
+	} catch (const ibrcommon::Exception&) {
+		throw dtn::net::DatagramException("receive failed");
+	}
+
+	return 0;
+}
+
+bool EmulatedDatagramService::isConnected(const size_t peer, const uint64_t now) const
+{
+	if (_model.period == 0) return true;
+
+	// all links are up until the schedule starts
+	if (now < _epoch) return true;
+
+	const size_t a = (peer < _index) ? peer : _index;
+	const size_t b = (peer < _index) ? _index : peer;
+
+	// neighboring links of a chain are up one after another,
+	// the links of a mesh get an arbitrary but fixed phase
+	size_t phase = 0;
+	if (_topology == TOPOLOGY_CHAIN)
+		phase = (_nodes > 1) ? (a * _model.period) / (_nodes - 1) : 0;
+	else
+		phase = (a * _nodes + b) % _model.period;
+
+	const uint64_t seconds = (now - _epoch) / 1000000;
+	return ((seconds + _model.period - phase) % _model.period) < _model.uptime;
+}
+
+size_t EmulatedDatagramService::getFramesSent() const
+{
+	return _frames_sent;
+}
+
+size_t EmulatedDatagramService::getFramesDropped() const
+{
+	return _frames_dropped;
+}
+
+const std::string EmulatedDatagramService::getServiceDescription() const
+{
+	return encode(_index);
+}
+
+const ibrcommon::vinterface& EmulatedDatagramService::getInterface() const
+{
+	return _iface;
+}
+
+dtn::core::Node::Protocol EmulatedDatagramService::getProtocol() const
+{
+	return dtn::core::Node::CONN_DGRAM_UDP;
+}
+
+const dtn::net::DatagramService::Parameter& EmulatedDatagramService::getParameter() const
+{
+	return _params;
+}
+
+const std::string EmulatedDatagramService::encode(const size_t index)
+{
+	std::stringstream ss;
+	ss << "node=" << index << ";";
+	return ss.str();
+}
+
+size_t EmulatedDatagramService::decode(const std::string &address)
+{
+	std::vector<std::string> parameters = dtn::utils::Utils::tokenize(";", address);
+
+	for (std::vector<std::string>::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
+	{
+		std::vector<std::string> p = dtn::utils::Utils::tokenize("=", (*it));
+		if ((p.size() == 2) && (p[0] == "node"))
+		{
+			return static_cast<size_t>(::atoi(p[1].c_str()));
+		}
+	}
+
+	return static_cast<size_t>(-1);
+}
@@ -0,0 +1,184 @@
+/*
+ * EmulatedDatagramService.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef EMULATEDDATAGRAMSERVICE_H_
+#define EMULATEDDATAGRAMSERVICE_H_
+
+#include "net/DatagramService.h"
+#include <ibrcommon/net/vinterface.h>
+#include <ibrcommon/net/vsocket.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <stdint.h>
+#include <vector>
+#include <map>
+
+/**
+ * A datagram service connecting the nodes of an emulated network. Each
+ * node sends and receives frames through a UDP socket on the loopback
+ * interface, the properties of the links (bandwidth, delay, loss and
+ * contact schedule) are applied by the sender before a frame is handed
+ * to the socket.
+ */
+class EmulatedDatagramService : public dtn::net::DatagramService
+{
+public:
+	/**
+	 * Properties of all emulated links. Links only differ in the phase
+	 * of their contact schedule.
+	 */
+	class LinkModel
+	{
+	public:
+		LinkModel();
+		virtual ~LinkModel();
+
+		// bandwidth in bit/s of each direction, zero for unlimited
+		size_t bandwidth;
+
+		// propagation delay in microseconds
+		size_t delay;
+
+		// probability to lose a frame
+		double loss;
+
+		// each link is up for 'uptime' seconds of every 'period' seconds,
+		// a period of zero keeps all links up
+		size_t period;
+		size_t uptime;
+	};
+
+	enum TOPOLOGY
+	{
+		TOPOLOGY_CHAIN = 0,
+		TOPOLOGY_MESH = 1
+	};
+
+	/**
+	 * @param index Index of the local node
+	 * @param nodes Number of nodes in the network
+	 * @param topology Arrangement of the links between the nodes
+	 * @param model Properties of the links
+	 * @param base_port UDP port of the first node, node i uses base_port + i
+	 * @param epoch Monotonic time in microseconds all contact schedules refer to
+	 */
+	EmulatedDatagramService(const size_t index, const size_t nodes, const TOPOLOGY topology, const LinkModel &model, const int base_port, const uint64_t epoch);
+	virtual ~EmulatedDatagramService();
+
+	void bind() throw (dtn::net::DatagramException);
+
+	void shutdown();
+
+	void send(const char &type, const char &flags, const unsigned int &seqno, const std::string &address, const char *buf, size_t length) throw (dtn::net::DatagramException);
+
+	void send(const char &type, const char &flags, const unsigned int &seqno, const char *buf, size_t length) throw (dtn::net::DatagramException);
+
+	size_t recvfrom(char *buf, size_t length, char &type, char &flags, unsigned int &seqno, std::string &address) throw (dtn::net::DatagramException);
+
+	const std::string getServiceDescription() const;
+
+	const ibrcommon::vinterface& getInterface() const;
+
+	dtn::core::Node::Protocol getProtocol() const;
+
+	const dtn::net::DatagramService::Parameter& getParameter() const;
+
+	/**
+	 * Returns true if the link to the given peer exists and is
+	 * up at the given time
+	 */
+	bool isConnected(const size_t peer, const uint64_t now) const;
+
+	/**
+	 * Number of frames passed to the links
+	 */
+	size_t getFramesSent() const;
+
+	/**
+	 * Number of frames dropped due to loss or a disrupted link
+	 */
+	size_t getFramesDropped() const;
+
+	static const std::string encode(const size_t index);
+	static size_t decode(const std::string &address);
+
+private:
+	static const size_t HEADER_LENGTH = 8;
+
+	class Frame
+	{
+	public:
+		Frame();
+		virtual ~Frame();
+
+		size_t peer;
+		std::vector<char> data;
+	};
+
+	/**
+	 * Holds frames back until their propagation delay is over
+	 */
+	class DelayLine : public ibrcommon::JoinableThread
+	{
+	public:
+		DelayLine(EmulatedDatagramService &service);
+		virtual ~DelayLine();
+
+		void push(const uint64_t due, const Frame &frame);
+
+	protected:
+		void run() throw ();
+		void __cancellation() throw ();
+
+	private:
+		EmulatedDatagramService &_service;
+		ibrcommon::Conditional _cond;
+		std::multimap<uint64_t, Frame> _frames;
+		bool _running;
+	};
+
+	void transmit(const size_t peer, const char &type, const char &flags, const unsigned int &seqno, const char *buf, size_t length);
+
+	void deliver(const Frame &frame);
+
+	const size_t _index;
+	const size_t _nodes;
+	const TOPOLOGY _topology;
+	const LinkModel _model;
+	const int _base_port;
+	const uint64_t _epoch;
+
+	dtn::net::DatagramService::Parameter _params;
+	const ibrcommon::vinterface _iface;
+
+	ibrcommon::vsocket _vsocket;
+	ibrcommon::udpsocket *_sock;
+
+	ibrcommon::Mutex _link_lock;
+	std::vector<uint64_t> _busy_until;
+	unsigned int _seed;
+	size_t _frames_sent;
+	size_t _frames_dropped;
+
+	DelayLine _delay_line;
+};
+
+#endif /* EMULATEDDATAGRAMSERVICE_H_ */
@@ -0,0 +1,178 @@
+/*
+ * FragmentationBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "config.h"
+#include "FragmentationBenchmark.h"
+#include "core/FragmentManager.h"
+
+#include <ibrdtn/data/PayloadBlock.h>
+#include <algorithm>
+#include <vector>
+
+FragmentationBenchmark::FragmentationBenchmark(const size_t payload_size, const size_t fragment_size)
+ : BenchmarkModule("Fragmentation"), _payload_size(payload_size), _fragment_size(fragment_size), _failed(false)
+{
+}
+
+FragmentationBenchmark::~FragmentationBenchmark()
+{
+}
+
+void FragmentationBenchmark::split_copy(const dtn::data::Bundle &bundle, const size_t fragment_size, std::list<dtn::data::Bundle> &fragments)
+{
+	const dtn::data::PayloadBlock &payload = bundle.find<dtn::data::PayloadBlock>();
+	ibrcommon::BLOB::Reference ref = payload.getBLOB();
+	ibrcommon::BLOB::iostream in = ref.iostream();
+
+	const size_t length = in.size();
+	std::vector<char> buf(0x10000);
+
+	for (size_t offset = 0; offset < length; offset += fragment_size)
+	{
+		dtn::data::Bundle fragment;
+		static_cast<dtn::data::PrimaryBlock&>(fragment) = bundle;
+		fragment.set(dtn::data::PrimaryBlock::FRAGMENT, true);
+		fragment.appdatalength = length;
+		fragment.fragmentoffset = offset;
+
+		ibrcommon::BLOB::Reference fragment_ref = ibrcommon::BLOB::create();
+		{
+			ibrcommon::BLOB::iostream out = fragment_ref.iostream();
+
+			(*in).seekg(offset, std::ios::beg);
+			for (size_t remain = std::min(fragment_size, length - offset); remain > 0;)
+			{
+				const size_t len = std::min(buf.size(), remain);
+				(*in).read(&buf[0], len);
+				(*out).write(&buf[0], len);
+				remain -= len;
+			}
+		}
+
+		fragment.push_back(fragment_ref);
+		fragments.push_back(fragment);
+	}
+}
+
+bool FragmentationBenchmark::verify(const dtn::data::Bundle &bundle, const std::list<dtn::data::Bundle> &fragments)
+{
+	ibrcommon::BLOB::Reference ref = bundle.find<dtn::data::PayloadBlock>().getBLOB();
+	std::vector<char> origin, data;
+	size_t offset = 0;
+
+	for (std::list<dtn::data::Bundle>::const_iterator iter = fragments.begin(); iter != fragments.end(); ++iter)
+	{
+		const dtn::data::Bundle &fragment = (*iter);
+		if (fragment.fragmentoffset.get<size_t>() != offset) return false;
+
+		// a view locks its origin while it is open, thus the
+		// fragment payload is read completely before the origin
+		ibrcommon::BLOB::Reference fragment_ref = fragment.find<dtn::data::PayloadBlock>().getBLOB();
+		{
+			ibrcommon::BLOB::iostream in = fragment_ref.iostream();
+			data.resize(in.size());
+			(*in).read(&data[0], data.size());
+			if ((*in).gcount() != (std::streamsize)data.size()) return false;
+		}
+
+		{
+			ibrcommon::BLOB::iostream in = ref.iostream();
+			origin.resize(data.size());
+			(*in).seekg(offset, std::ios::beg);
+			(*in).read(&origin[0], origin.size());
+		}
+
+		if (data != origin) return false;
+
+		offset += data.size();
+	}
+
+	return (offset == (size_t)ref.size());
+}
+
+void FragmentationBenchmark::run()
+{
+	ibrcommon::File blob_path("./tmp/blobs");
+	if (!blob_path.exists()) ibrcommon::File::createDirectory(blob_path);
+	ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://sender/benchmark");
+	b.destination = dtn::data::EID("dtn://receiver/benchmark");
+	b.lifetime = 3600;
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	b.push_back(ref);
+
+	// fill the payload with a pattern to detect misplaced ranges
+	{
+		std::vector<char> data(0x10000);
+		ibrcommon::BLOB::iostream io = ref.iostream();
+		for (size_t written = 0; written < _payload_size; written += data.size())
+		{
+			for (size_t i = 0; i < data.size(); ++i) data[i] = (char)((written + i) % 251);
+			const size_t len = std::min(data.size(), _payload_size - written);
+			(*io).write(&data[0], len);
+		}
+	}
+
+	const size_t count = (_payload_size + _fragment_size - 1) / _fragment_size;
+
+	{
+		std::list<dtn::data::Bundle> fragments;
+		const size_t written_start = getWrittenBytes();
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+		split_copy(b, _fragment_size, fragments);
+		tm.stop();
+
+		const size_t written = getWrittenBytes() - written_start;
+
+		report("copy", count, tm);
+		report("copy", "written", (double)written, "bytes");
+
+		if (fragments.size() != count || !verify(b, fragments)) _failed = true;
+	}
+
+	{
+		std::list<dtn::data::Bundle> fragments;
+		const size_t written_start = getWrittenBytes();
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+		dtn::core::FragmentManager::split(b, _fragment_size, fragments);
+		tm.stop();
+
+		const size_t written = getWrittenBytes() - written_start;
+
+		report("view", count, tm);
+		report("view", "written", (double)written, "bytes");
+
+		if (fragments.size() != count || !verify(b, fragments)) _failed = true;
+	}
+}
+
+bool FragmentationBenchmark::check()
+{
+	return !_failed;
+}
@@ -0,0 +1,63 @@
+/*
+ * FragmentationBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef FRAGMENTATIONBENCHMARK_H_
+#define FRAGMENTATIONBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrcommon/data/BLOB.h>
+#include <list>
+
+/**
+ * Measures the time and the amount of data written to split one
+ * large bundle into fragments. The fragments created by the
+ * FragmentManager are compared to fragments with copied payloads.
+ */
+class FragmentationBenchmark : public BenchmarkModule
+{
+public:
+	FragmentationBenchmark(const size_t payload_size = 256 * 1024 * 1024, const size_t fragment_size = 1024 * 1024);
+	virtual ~FragmentationBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Split the bundle by copying the payload of each fragment
+	 * into a new BLOB
+	 */
+	static void split_copy(const dtn::data::Bundle &bundle, const size_t fragment_size, std::list<dtn::data::Bundle> &fragments);
+
+	/**
+	 * Returns true if the payload of the fragments matches the
+	 * payload of the original bundle
+	 */
+	static bool verify(const dtn::data::Bundle &bundle, const std::list<dtn::data::Bundle> &fragments);
+
+	const size_t _payload_size;
+	const size_t _fragment_size;
+	bool _failed;
+};
+
+#endif /* FRAGMENTATIONBENCHMARK_H_ */
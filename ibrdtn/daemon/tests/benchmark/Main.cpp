@@ -0,0 +1,85 @@
+/*
+ * Main.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "BenchmarkModule.h"
+#include "StaticRouteTableBenchmark.h"
+#include "ReceptionBenchmark.h"
+#include "FragmentationBenchmark.h"
+#include "SigningBenchmark.h"
+#include "TLSBenchmark.h"
+#include "StorageBenchmark.h"
+#include "NetworkEmulatorBenchmark.h"
+#include "ContactGraphBenchmark.h"
+
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/data/File.h>
+#include <list>
+#include <set>
+
+int main(int argc, char *argv[])
+{
+	ibrcommon::File tmppath("./tmp");
+	if (!tmppath.exists()) ibrcommon::File::createDirectory( tmppath );
+
+	ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(tmppath), true);
+
+	// only run the modules named on the command line
+	std::set<std::string> selection;
+	for (int i = 1; i < argc; ++i) selection.insert(argv[i]);
+
+	std::list<BenchmarkModule*> list;
+	list.push_back(new StaticRouteTableBenchmark());
+	list.push_back(new ReceptionBenchmark());
+	list.push_back(new FragmentationBenchmark());
+#ifdef IBRDTN_SUPPORT_BSP
+	list.push_back(new SigningBenchmark());
+#endif
+#ifdef WITH_TLS
+	list.push_back(new TLSBenchmark());
+#endif
+	list.push_back(new StorageBenchmark());
+	list.push_back(new NetworkEmulatorBenchmark());
+	list.push_back(new ContactGraphBenchmark());
+
+	bool err = false;
+	for (std::list<BenchmarkModule*>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+	{
+		BenchmarkModule &module = (**iter);
+		if (!selection.empty() && (selection.find(module.getName()) == selection.end())) continue;
+
+		module.run();
+		if (!module.check())
+		{
+			std::cerr << "ERROR: benchmark " << module.getName() << " returned inconsistent results" << std::endl;
+			err = true;
+		}
+	}
+
+	for (std::list<BenchmarkModule*>::const_iterator iter = list.begin(); iter != list.end(); ++iter)
+	{
+		delete (*iter);
+	}
+
+	if (err) return -1;
+
+	return 0;
+}
@@ -0,0 +1,407 @@
+/*
+ * NetworkEmulatorBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "NetworkEmulatorBenchmark.h"
+#include "NativeDaemon.h"
+#include "Configuration.h"
+#include "core/BundleCore.h"
+#include "core/EventDispatcher.h"
+#include "net/DatagramConvergenceLayer.h"
+
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <ibrcommon/Metrics.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+
+// seconds to bring up all nodes and discover the neighbors
+static const size_t WARMUP_TIME = 3;
+
+// seconds to wait for bundles in transit after the traffic generation
+static const size_t DRAIN_TIME = 10;
+
+// UDP port of the first emulated node
+static const int BASE_PORT = 42000;
+
+NetworkEmulatorBenchmark::Result::Result()
+ : sent(0), delivered(0), duplicates(0), frames(0), dropped(0), cpu(0), memory(0)
+{
+}
+
+NetworkEmulatorBenchmark::Result::~Result()
+{
+}
+
+std::ostream &operator<<(std::ostream &stream, const NetworkEmulatorBenchmark::Result &obj)
+{
+	stream << obj.sent << " " << obj.delivered << " " << obj.duplicates << " " << obj.frames << " "
+			<< obj.dropped << " " << obj.cpu << " " << obj.memory << " " << obj.latencies.size();
+
+	for (std::vector<uint64_t>::const_iterator it = obj.latencies.begin(); it != obj.latencies.end(); ++it)
+	{
+		stream << " " << (*it);
+	}
+
+	return stream;
+}
+
+std::istream &operator>>(std::istream &stream, NetworkEmulatorBenchmark::Result &obj)
+{
+	size_t count = 0;
+	stream >> obj.sent >> obj.delivered >> obj.duplicates >> obj.frames >> obj.dropped >> obj.cpu >> obj.memory >> count;
+
+	obj.latencies.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		stream >> obj.latencies[i];
+	}
+
+	return stream;
+}
+
+NetworkEmulatorBenchmark::Sink::Sink()
+{
+	dtn::core::EventDispatcher<dtn::net::BundleReceivedEvent>::add(this);
+}
+
+NetworkEmulatorBenchmark::Sink::~Sink()
+{
+	dtn::core::EventDispatcher<dtn::net::BundleReceivedEvent>::remove(this);
+}
+
+void NetworkEmulatorBenchmark::Sink::raiseEvent(const dtn::net::BundleReceivedEvent &evt) throw ()
+{
+	if (evt.fromlocal) return;
+	if (evt.bundle.destination.getNode() != dtn::core::BundleCore::local) return;
+	if (!evt.bundle.destination.isApplication("sink")) return;
+
+	const uint64_t now = ibrcommon::Histogram::now();
+
+	ibrcommon::MutexLock l(_lock);
+
+	if (!_seen.insert(evt.bundle).second)
+	{
+		_result.duplicates++;
+		return;
+	}
+
+	try {
+		// the payload starts with the time of the generation
+		const dtn::data::PayloadBlock &p = evt.bundle.find<dtn::data::PayloadBlock>();
+		ibrcommon::BLOB::Reference ref = p.getBLOB();
+		ibrcommon::BLOB::iostream io = ref.iostream();
+
+		uint64_t created = 0;
+		(*io) >> created;
+
+		_result.delivered++;
+		_result.latencies.push_back((now > created) ? (now - created) : 0);
+	} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { }
+}
+
+void NetworkEmulatorBenchmark::Sink::collect(Result &result)
+{
+	ibrcommon::MutexLock l(_lock);
+	result.delivered = _result.delivered;
+	result.duplicates = _result.duplicates;
+	result.latencies = _result.latencies;
+}
+
+NetworkEmulatorBenchmark::NetworkEmulatorBenchmark(const size_t nodes, const size_t duration, const size_t rate, const size_t payload_size)
+ : BenchmarkModule("NetworkEmulator"), _nodes(nodes), _duration(duration), _rate(rate), _payload_size(payload_size),
+   _workdir("./tmp/emulator"), _topology(EmulatedDatagramService::TOPOLOGY_CHAIN), _failed(false)
+{
+	// 10 Mbit/s links with 10 ms delay and 1% loss, each link
+	// is up for eight seconds of every twelve seconds
+	_model.bandwidth = 10000000;
+	_model.delay = 10000;
+	_model.loss = 0.01;
+	_model.period = 12;
+	_model.uptime = 8;
+}
+
+NetworkEmulatorBenchmark::~NetworkEmulatorBenchmark()
+{
+	if (_workdir.exists()) ibrcommon::File(_workdir).remove(true);
+}
+
+void NetworkEmulatorBenchmark::node(const std::string &routing, const std::string &storage, const size_t index, const uint64_t epoch, int fd)
+{
+	std::stringstream name;
+	name << "node-" << index;
+
+	ibrcommon::File path = _workdir.get(name.str());
+	ibrcommon::File::createDirectory(path);
+
+	ibrcommon::File storage_path = path.get("storage");
+	ibrcommon::File::createDirectory(storage_path);
+
+	ibrcommon::File blob_path = path.get("blobs");
+	ibrcommon::File::createDirectory(blob_path);
+
+	const ibrcommon::File config = path.get("ibrdtnd.conf");
+	{
+		std::ofstream conf(config.getPath().c_str(), std::ios::out | std::ios::trunc);
+		conf << "local_uri = dtn://" << name.str() << std::endl;
+		conf << "routing = " << routing << std::endl;
+		if (storage == "memory")
+		{
+			// the default storage keeps all bundles in memory without a storage path
+			conf << "storage = default" << std::endl;
+		}
+		else
+		{
+			conf << "storage = " << storage << std::endl;
+			conf << "storage_path = " << storage_path.getPath() << std::endl;
+		}
+		conf << "blob_path = " << blob_path.getPath() << std::endl;
+
+		// detect the end of a contact within two beacon intervals
+		conf << "discovery_timeout = 2" << std::endl;
+	}
+
+	Result result;
+
+	dtn::daemon::NativeDaemon daemon;
+	daemon.setConfigFile(config.getPath());
+
+	// disable the API and the IP neighbor discovery
+	char arg0[] = "benchmark", arg1[] = "--noapi", arg2[] = "--nodiscovery";
+	char *argv[] = { arg0, arg1, arg2 };
+	dtn::daemon::Configuration::getInstance().params(3, argv);
+
+	daemon.init(dtn::daemon::RUNLEVEL_ROUTING_EXTENSIONS);
+
+	Sink sink;
+
+	EmulatedDatagramService *service = new EmulatedDatagramService(index, _nodes, _topology, _model, BASE_PORT, epoch);
+	dtn::net::DatagramConvergenceLayer *cl = new dtn::net::DatagramConvergenceLayer(service);
+	cl->initialize();
+	cl->startup();
+	dtn::core::BundleCore::getInstance().getConnectionManager().add(cl);
+
+	// use a fixed seed per node to get reproducible workloads
+	unsigned int seed = static_cast<unsigned int>(index + 1);
+
+	const uint64_t interval = 1000000 / _rate;
+	const uint64_t end = epoch + (_duration * 1000000);
+
+	for (uint64_t next = epoch; next < end; next += interval)
+	{
+		uint64_t now = ibrcommon::Histogram::now();
+		if (next > now) ::usleep(static_cast<useconds_t>(next - now));
+
+		size_t peer = static_cast<size_t>(rand_r(&seed)) % (_nodes - 1);
+		if (peer >= index) peer++;
+
+		std::stringstream destination;
+		destination << "dtn://node-" << peer << "/sink";
+
+		dtn::data::Bundle b;
+		b.source = dtn::core::BundleCore::local;
+		b.source.setApplication("source");
+		b.destination = dtn::data::EID(destination.str());
+		b.lifetime = WARMUP_TIME + _duration + DRAIN_TIME;
+
+		ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+		{
+			ibrcommon::BLOB::iostream io = ref.iostream();
+			(*io) << ibrcommon::Histogram::now() << " ";
+
+			const std::string padding(_payload_size, 'x');
+			(*io) << padding;
+		}
+		b.push_back(ref);
+
+		dtn::core::BundleCore::inject(b.source, b);
+		result.sent++;
+	}
+
+	::sleep(static_cast<unsigned int>(DRAIN_TIME));
+
+	struct rusage usage;
+	::getrusage(RUSAGE_SELF, &usage);
+
+	result.cpu = (static_cast<uint64_t>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+	result.memory = usage.ru_maxrss;
+	result.frames = service->getFramesSent();
+	result.dropped = service->getFramesDropped();
+	sink.collect(result);
+
+	std::stringstream ss;
+	ss << result;
+
+	const std::string data = ss.str();
+	for (size_t written = 0; written < data.length();)
+	{
+		const ssize_t ret = ::write(fd, data.c_str() + written, data.length() - written);
+		if (ret <= 0) break;
+		written += ret;
+	}
+
+	// the process exits without shutting down the daemon
+	// since only the results are of interest
+}
+
+void NetworkEmulatorBenchmark::emulate(const std::string &routing, const std::string &storage)
+{
+	const std::string workload = routing + "-" + storage;
+
+	if (_workdir.exists()) ibrcommon::File(_workdir).remove(true);
+	ibrcommon::File path = _workdir;
+	ibrcommon::File::createDirectory(path);
+
+	// all nodes start the traffic generation and the contact schedule at the same time
+	const uint64_t epoch = ibrcommon::Histogram::now() + (WARMUP_TIME * 1000000);
+
+	std::vector<pid_t> pids(_nodes, 0);
+	std::vector<int> fds(_nodes, -1);
+
+	// do not duplicate buffered output in the forked processes
+	std::cout.flush();
+
+	for (size_t i = 0; i < _nodes; ++i)
+	{
+		int p[2];
+		if (::pipe(p) != 0)
+		{
+			_failed = true;
+			break;
+		}
+
+		const pid_t pid = ::fork();
+
+		if (pid == 0)
+		{
+			::close(p[0]);
+
+			// only the results of the other nodes are of interest to the parent
+			for (size_t j = 0; j < i; ++j) ::close(fds[j]);
+
+			node(routing, storage, i, epoch, p[1]);
+			::close(p[1]);
+			::_exit(0);
+		}
+
+		::close(p[1]);
+
+		if (pid < 0)
+		{
+			::close(p[0]);
+			_failed = true;
+			break;
+		}
+
+		pids[i] = pid;
+		fds[i] = p[0];
+	}
+
+	Result total;
+	ibrcommon::Histogram latency;
+	size_t reports = 0;
+
+	for (size_t i = 0; i < _nodes; ++i)
+	{
+		if (pids[i] <= 0) continue;
+
+		std::string data;
+		char buf[4096];
+		ssize_t len = 0;
+		while ((len = ::read(fds[i], buf, sizeof(buf))) > 0) data.append(buf, len);
+		::close(fds[i]);
+
+		int status = 0;
+		::waitpid(pids[i], &status, 0);
+
+		std::stringstream ss(data);
+		Result r;
+		if (data.empty() || !(ss >> r) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+		{
+			std::cerr << "ERROR: node " << i << " of workload " << workload << " failed" << std::endl;
+			_failed = true;
+			continue;
+		}
+
+		total.sent += r.sent;
+		total.delivered += r.delivered;
+		total.duplicates += r.duplicates;
+		total.frames += r.frames;
+		total.dropped += r.dropped;
+		total.cpu += r.cpu;
+		total.memory += r.memory;
+
+		for (std::vector<uint64_t>::const_iterator it = r.latencies.begin(); it != r.latencies.end(); ++it)
+		{
+			latency.record(*it);
+		}
+
+		reports++;
+	}
+
+	if (reports == 0) return;
+
+	const ibrcommon::Histogram::Snapshot s = latency.snapshot();
+
+	report(workload, "sent", (double)total.sent, "bundles");
+	report(workload, "delivered", (double)total.delivered, "bundles");
+	report(workload, "delivery-ratio", (total.sent > 0) ? (double)total.delivered / (double)total.sent : 0.0, "ratio");
+	report(workload, "duplicates", (double)total.duplicates, "bundles");
+	report(workload, "latency-p50", (double)s.quantile(0.5) / 1000.0, "ms");
+	report(workload, "latency-p90", (double)s.quantile(0.9) / 1000.0, "ms");
+	report(workload, "latency-p99", (double)s.quantile(0.99) / 1000.0, "ms");
+	report(workload, "cpu-per-bundle", (total.sent > 0) ? (double)total.cpu / 1000.0 / (double)total.sent : 0.0, "ms");
+	report(workload, "memory-per-node", (double)total.memory / (double)reports, "KiB");
+	report(workload, "frame-loss", (total.frames > 0) ? (double)total.dropped / (double)total.frames : 0.0, "ratio");
+}
+
+void NetworkEmulatorBenchmark::run()
+{
+	if (_nodes < 2) return;
+
+	// compare the routing extensions on the same storage
+	emulate("default", "memory");
+	emulate("flooding", "memory");
+	emulate("epidemic", "memory");
+	emulate("prophet", "memory");
+
+	// compare the storage backends with the same routing
+	emulate("epidemic", "simple");
+	emulate("epidemic", "log");
+#ifdef HAVE_SQLITE
+	emulate("epidemic", "sqlite");
+#endif
+}
+
+bool NetworkEmulatorBenchmark::check()
+{
+	return !_failed;
+}
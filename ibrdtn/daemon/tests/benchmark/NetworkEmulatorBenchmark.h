@@ -0,0 +1,126 @@
+/*
+ * NetworkEmulatorBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef NETWORKEMULATORBENCHMARK_H_
+#define NETWORKEMULATORBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include "EmulatedDatagramService.h"
+#include "core/EventReceiver.h"
+#include "net/BundleReceivedEvent.h"
+#include <ibrdtn/data/BundleID.h>
+#include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <stdint.h>
+#include <vector>
+#include <set>
+
+/**
+ * Runs a network of daemons connected through emulated links and
+ * measures the delivery ratio, the latency, the CPU time per bundle and
+ * the memory per node for each routing extension and storage backend.
+ * Since the core of the daemon is a singleton, every node runs in its
+ * own process forked off the benchmark.
+ */
+class NetworkEmulatorBenchmark : public BenchmarkModule
+{
+public:
+	/**
+	 * @param nodes Number of nodes in the network
+	 * @param duration Seconds of traffic generation
+	 * @param rate Bundles generated per second and node
+	 * @param payload_size Size of the payload of each bundle
+	 */
+	NetworkEmulatorBenchmark(const size_t nodes = 10, const size_t duration = 10, const size_t rate = 2, const size_t payload_size = 4096);
+	virtual ~NetworkEmulatorBenchmark();
+
+	void run();
+	bool check();
+
+	/**
+	 * Counters collected by each node
+	 */
+	class Result
+	{
+	public:
+		Result();
+		virtual ~Result();
+
+		size_t sent;
+		size_t delivered;
+		size_t duplicates;
+		size_t frames;
+		size_t dropped;
+		uint64_t cpu;
+		uint64_t memory;
+		std::vector<uint64_t> latencies;
+
+		friend std::ostream &operator<<(std::ostream &stream, const Result &obj);
+		friend std::istream &operator>>(std::istream &stream, Result &obj);
+	};
+
+private:
+	/**
+	 * Records the bundles arriving at their destination
+	 */
+	class Sink : public dtn::core::EventReceiver<dtn::net::BundleReceivedEvent>
+	{
+	public:
+		Sink();
+		virtual ~Sink();
+
+		void raiseEvent(const dtn::net::BundleReceivedEvent &evt) throw ();
+
+		/**
+		 * Copy the delivery statistics into the given result
+		 */
+		void collect(Result &result);
+
+	private:
+		ibrcommon::Mutex _lock;
+		Result _result;
+		std::set<dtn::data::BundleID> _seen;
+	};
+
+	/**
+	 * Runs one network with the given routing extension and storage and
+	 * reports the aggregated results of all nodes
+	 */
+	void emulate(const std::string &routing, const std::string &storage);
+
+	/**
+	 * Runs a single node, executed in the forked process
+	 */
+	void node(const std::string &routing, const std::string &storage, const size_t index, const uint64_t epoch, int fd);
+
+	const size_t _nodes;
+	const size_t _duration;
+	const size_t _rate;
+	const size_t _payload_size;
+
+	const ibrcommon::File _workdir;
+	EmulatedDatagramService::LinkModel _model;
+	EmulatedDatagramService::TOPOLOGY _topology;
+
+	bool _failed;
+};
+
+#endif /* NETWORKEMULATORBENCHMARK_H_ */
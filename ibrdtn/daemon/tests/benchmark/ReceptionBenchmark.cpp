@@ -0,0 +1,168 @@
+/*
+ * ReceptionBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "ReceptionBenchmark.h"
+#include "../tools/EventSwitchLoop.h"
+#include "storage/SimpleBundleStorage.h"
+
+#ifdef HAVE_SQLITE
+#include "storage/SQLiteBundleStorage.h"
+#endif
+
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrdtn/data/Serializer.h>
+#include <ibrcommon/data/BLOB.h>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+
+ReceptionBenchmark::ReceptionBenchmark(const size_t payload_size)
+ : BenchmarkModule("Reception"), _payload_size(payload_size), _workdir("./tmp/reception"), _bundle_file("./tmp/reception.bundle"), _failed(false)
+{
+}
+
+ReceptionBenchmark::~ReceptionBenchmark()
+{
+	ibrcommon::File(_bundle_file).remove();
+	if (_workdir.exists()) ibrcommon::File(_workdir).remove(true);
+}
+
+void ReceptionBenchmark::prepare()
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://sender/benchmark");
+	b.destination = dtn::data::EID("dtn://receiver/benchmark");
+	b.lifetime = 3600;
+
+	std::ofstream out(_bundle_file.getPath().c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+	dtn::data::DefaultSerializer s(out);
+
+	// write the primary block and the payload header
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	dtn::data::PayloadBlock &payload = b.push_back(ref);
+	payload.set(dtn::data::Block::LAST_BLOCK, true);
+
+	// the payload is written block-wise to keep the memory footprint low
+	std::vector<char> data(0x10000, 'x');
+	{
+		ibrcommon::BLOB::iostream io = ref.iostream();
+		for (size_t written = 0; written < _payload_size; written += data.size())
+		{
+			const size_t len = std::min(data.size(), _payload_size - written);
+			(*io).write(&data[0], len);
+		}
+	}
+
+	s << b;
+	out.close();
+}
+
+void ReceptionBenchmark::receive(const std::string &workload, dtn::storage::BundleStorage &storage)
+{
+	dtn::daemon::Component &c = dynamic_cast<dtn::daemon::Component&>(storage);
+	c.initialize();
+	c.startup();
+
+	const size_t written_start = getWrittenBytes();
+
+	ibrcommon::TimeMeasurement tm;
+	tm.start();
+
+	{
+		dtn::data::Bundle b;
+
+		std::ifstream in(_bundle_file.getPath().c_str(), std::ios::in | std::ios::binary);
+		dtn::data::DefaultDeserializer(in) >> b;
+
+		storage.store(b);
+		storage.wait();
+	}
+
+	tm.stop();
+
+	const size_t written = getWrittenBytes() - written_start;
+
+	report(workload, 1, tm);
+	report(workload, "throughput", (double)_payload_size / 1048576.0 / (tm.getMilliseconds() / 1000.0), "MiB/s");
+	report(workload, "written", (double)written, "bytes");
+	report(workload, "amplification", (double)written / (double)_payload_size, "ratio");
+
+	if (storage.count() != 1) _failed = true;
+
+	storage.clear();
+	c.terminate();
+}
+
+void ReceptionBenchmark::run()
+{
+	ibrtest::EventSwitchLoop esl;
+	esl.start();
+
+	ibrcommon::File blob_path("./tmp/blobs");
+	if (!blob_path.exists()) ibrcommon::File::createDirectory(blob_path);
+	ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+
+	prepare();
+
+	{
+		ibrcommon::File path = _workdir.get("simple");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
+
+		dtn::storage::SimpleBundleStorage storage(path);
+		receive("simple", storage);
+	}
+
+#ifdef HAVE_SQLITE
+	{
+		ibrcommon::File path = _workdir.get("sqlite-fileblob");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
+
+		// payload is received into a BLOB outside of the storage
+		dtn::storage::SQLiteBundleStorage storage(path, 0);
+		ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+		receive("sqlite-fileblob", storage);
+	}
+
+	{
+		ibrcommon::File path = _workdir.get("sqlite");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
+
+		// the storage provides the BLOBs for the payload
+		dtn::storage::SQLiteBundleStorage storage(path, 0);
+		receive("sqlite", storage);
+
+		ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+	}
+#endif
+
+	esl.stop();
+	esl.join();
+}
+
+bool ReceptionBenchmark::check()
+{
+	return !_failed;
+}
@@ -0,0 +1,59 @@
+/*
+ * ReceptionBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef RECEPTIONBENCHMARK_H_
+#define RECEPTIONBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include "storage/BundleStorage.h"
+#include <ibrcommon/data/File.h>
+
+/**
+ * Measures the time and the amount of data written to receive
+ * one large bundle from a stream and put it into a storage.
+ */
+class ReceptionBenchmark : public BenchmarkModule
+{
+public:
+	ReceptionBenchmark(const size_t payload_size = 1024 * 1024 * 1024);
+	virtual ~ReceptionBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Create a file containing one serialized bundle
+	 */
+	void prepare();
+
+	/**
+	 * Deserialize the prepared bundle and store it into the given storage
+	 */
+	void receive(const std::string &workload, dtn::storage::BundleStorage &storage);
+
+	const size_t _payload_size;
+	const ibrcommon::File _workdir;
+	const ibrcommon::File _bundle_file;
+	bool _failed;
+};
+
+#endif /* RECEPTIONBENCHMARK_H_ */
@@ -0,0 +1,143 @@
+/*
+ * SigningBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "config.h"
+#include "SigningBenchmark.h"
+
+#ifdef IBRDTN_SUPPORT_BSP
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/security/PayloadIntegrityBlock.h>
+#include <ibrcommon/data/BLOB.h>
+
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <stdio.h>
+
+SigningBenchmark::SigningBenchmark(const size_t bundles, const size_t payload_size)
+ : BenchmarkModule("Signing"), _bundles(bundles), _payload_size(payload_size),
+   _private_file("./tmp/signing.pkey"), _public_file("./tmp/signing.pub"), _failed(false)
+{
+}
+
+SigningBenchmark::~SigningBenchmark()
+{
+	ibrcommon::File(_private_file.getPath()).remove();
+	ibrcommon::File(_public_file.getPath()).remove();
+}
+
+void SigningBenchmark::prepare()
+{
+	RSA* rsa = RSA_new();
+	BIGNUM* e = BN_new();
+	BN_set_word(e, 65537);
+	RSA_generate_key_ex(rsa, 2048, e, NULL);
+	BN_free(e);
+
+	FILE *f = fopen(_private_file.getPath().c_str(), "w");
+	PEM_write_RSAPrivateKey(f, rsa, NULL, NULL, 0, NULL, NULL);
+	fclose(f);
+
+	f = fopen(_public_file.getPath().c_str(), "w");
+	PEM_write_RSA_PUBKEY(f, rsa);
+	fclose(f);
+
+	RSA_free(rsa);
+}
+
+void SigningBenchmark::run()
+{
+	ibrcommon::BLOB::changeProvider(new ibrcommon::MemoryBLOBProvider(), true);
+
+	prepare();
+
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://sender/benchmark");
+	b.destination = dtn::data::EID("dtn://receiver/benchmark");
+	b.lifetime = 3600;
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream io = ref.iostream();
+		(*io) << std::string(_payload_size, 'x');
+	}
+	b.push_back(ref);
+
+	dtn::security::SecurityKey pkey;
+	pkey.reference = dtn::data::EID("dtn://sender");
+	pkey.type = dtn::security::SecurityKey::KEY_PRIVATE;
+	pkey.file = _private_file;
+
+	// load the key for each bundle, like before the key material was shared
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < _bundles; ++i)
+		{
+			dtn::security::SecurityKey key;
+			key.reference = pkey.reference;
+			key.type = pkey.type;
+			key.file = pkey.file;
+
+			dtn::data::Bundle signed_bundle = b;
+			dtn::security::PayloadIntegrityBlock::sign(signed_bundle, key, b.destination);
+		}
+
+		tm.stop();
+		report("reload", _bundles, tm);
+	}
+
+	// use the same key for all bundles
+	dtn::data::Bundle last = b;
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < _bundles; ++i)
+		{
+			last = b;
+			dtn::security::PayloadIntegrityBlock::sign(last, pkey, b.destination);
+		}
+
+		tm.stop();
+		report("shared", _bundles, tm);
+	}
+
+	// the signature has to be valid
+	dtn::security::SecurityKey pubkey;
+	pubkey.reference = pkey.reference;
+	pubkey.type = dtn::security::SecurityKey::KEY_PUBLIC;
+	pubkey.file = _public_file;
+
+	try {
+		dtn::security::PayloadIntegrityBlock::verify(last, pubkey);
+	} catch (const ibrcommon::Exception&) {
+		_failed = true;
+	}
+}
+
+bool SigningBenchmark::check()
+{
+	return !_failed;
+}
+
+#endif
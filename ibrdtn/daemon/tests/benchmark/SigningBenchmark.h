@@ -0,0 +1,60 @@
+/*
+ * SigningBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef SIGNINGBENCHMARK_H_
+#define SIGNINGBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include <ibrdtn/ibrdtn.h>
+
+#ifdef IBRDTN_SUPPORT_BSP
+#include <ibrdtn/security/SecurityKey.h>
+#include <ibrcommon/data/File.h>
+
+/**
+ * Measures the throughput of signing bundles with a payload integrity
+ * block if the key is loaded for each bundle or shared between them.
+ */
+class SigningBenchmark : public BenchmarkModule
+{
+public:
+	SigningBenchmark(const size_t bundles = 2000, const size_t payload_size = 1024);
+	virtual ~SigningBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Create a fresh RSA key pair
+	 */
+	void prepare();
+
+	const size_t _bundles;
+	const size_t _payload_size;
+	const ibrcommon::File _private_file;
+	const ibrcommon::File _public_file;
+	bool _failed;
+};
+
+#endif
+#endif /* SIGNINGBENCHMARK_H_ */
@@ -0,0 +1,152 @@
+/*
+ * StaticRouteTableBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "StaticRouteTableBenchmark.h"
+#include "routing/StaticRouteTable.h"
+#include "routing/StaticEIDRoute.h"
+
+#ifdef HAVE_REGEX_H
+#include "routing/StaticRegexRoute.h"
+#endif
+
+#include <ibrcommon/TimeMeasurement.h>
+#include <sstream>
+#include <cstdlib>
+
+StaticRouteTableBenchmark::StaticRouteTableBenchmark(const size_t routes, const size_t destinations)
+ : BenchmarkModule("StaticRouteTable"), _num_routes(routes), _num_destinations(destinations), _linear_matches(0), _table_matches(0)
+{
+	// use a fixed seed to get reproducible workloads
+	srand(42);
+
+	for (size_t i = 0; i < _num_destinations; ++i)
+	{
+		std::stringstream ss;
+
+		// one out of ten destinations is covered by a regex route, the others
+		// are distributed over twice as much hosts as there are host routes
+		if ((i % 10) == 0)
+			ss << "dtn://region-" << (rand() % 20) << "/node-" << i << "/app";
+		else
+			ss << "dtn://node-" << (rand() % (_num_routes * 2)) << "/app-" << (i % 100);
+
+		_destinations.push_back(dtn::data::EID(ss.str()));
+	}
+}
+
+StaticRouteTableBenchmark::~StaticRouteTableBenchmark()
+{
+}
+
+dtn::routing::StaticRoute* StaticRouteTableBenchmark::createRoute(const size_t index) const
+{
+	std::stringstream nexthop;
+	nexthop << "dtn://gateway-" << (index % 20);
+
+#ifdef HAVE_REGEX_H
+	// every tenth route is a regular expression
+	if ((index % 10) == 0)
+	{
+		std::stringstream regex;
+		regex << "^dtn://region-" << (index / 10) << "/.*";
+		return new dtn::routing::StaticRegexRoute(regex.str(), dtn::data::EID(nexthop.str()));
+	}
+#endif
+
+	std::stringstream match;
+	match << "dtn://node-" << index;
+	return new dtn::routing::StaticEIDRoute(dtn::data::EID(match.str()), dtn::data::EID(nexthop.str()));
+}
+
+void StaticRouteTableBenchmark::run()
+{
+	std::list<dtn::routing::StaticRoute*> routes;
+	dtn::routing::StaticRouteTable table;
+
+	for (size_t i = 0; i < _num_routes; ++i)
+	{
+		routes.push_back(createRoute(i));
+		table.add(createRoute(i));
+	}
+
+	// linear evaluation of all routes, as done before the route table
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (std::vector<dtn::data::EID>::const_iterator it = _destinations.begin(); it != _destinations.end(); ++it)
+		{
+			for (std::list<dtn::routing::StaticRoute*>::const_iterator rit = routes.begin(); rit != routes.end(); ++rit)
+			{
+				if ((*rit)->match(*it)) _linear_matches++;
+			}
+		}
+
+		tm.stop();
+		report("linear", _destinations.size(), tm);
+	}
+
+	// lookup of distinct destinations
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (std::vector<dtn::data::EID>::const_iterator it = _destinations.begin(); it != _destinations.end(); ++it)
+		{
+			_table_matches += table.match(*it).size();
+		}
+
+		tm.stop();
+		report("table", _destinations.size(), tm);
+	}
+
+	// repeated lookup of a small set of destinations served by the cache
+	{
+		const size_t hot = 1000;
+		size_t matches = 0;
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < _destinations.size(); ++i)
+		{
+			matches += table.match(_destinations[i % hot]).size();
+		}
+
+		tm.stop();
+		report("table-cached", _destinations.size(), tm);
+		report("table-cached", "matches", (double)matches, "routes");
+	}
+
+	report("linear", "matches", (double)_linear_matches, "routes");
+	report("table", "matches", (double)_table_matches, "routes");
+
+	for (std::list<dtn::routing::StaticRoute*>::const_iterator rit = routes.begin(); rit != routes.end(); ++rit)
+	{
+		delete (*rit);
+	}
+}
+
+bool StaticRouteTableBenchmark::check()
+{
+	return (_linear_matches == _table_matches);
+}
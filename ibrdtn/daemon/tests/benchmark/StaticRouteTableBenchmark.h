@@ -0,0 +1,55 @@
+/*
+ * StaticRouteTableBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef STATICROUTETABLEBENCHMARK_H_
+#define STATICROUTETABLEBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include "routing/StaticRoute.h"
+#include <ibrdtn/data/EID.h>
+#include <list>
+#include <vector>
+
+/**
+ * Compares the lookup of static routes in the StaticRouteTable
+ * with a linear evaluation of all routes.
+ */
+class StaticRouteTableBenchmark : public BenchmarkModule
+{
+public:
+	StaticRouteTableBenchmark(const size_t routes = 1000, const size_t destinations = 100000);
+	virtual ~StaticRouteTableBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	dtn::routing::StaticRoute* createRoute(const size_t index) const;
+
+	const size_t _num_routes;
+	const size_t _num_destinations;
+
+	std::vector<dtn::data::EID> _destinations;
+	size_t _linear_matches;
+	size_t _table_matches;
+};
+
+#endif /* STATICROUTETABLEBENCHMARK_H_ */
@@ -0,0 +1,377 @@
+/*
+ * StorageBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "StorageBenchmark.h"
+#include "../tools/EventSwitchLoop.h"
+#include "Component.h"
+#include "core/TimeEvent.h"
+#include "storage/MemoryBundleStorage.h"
+#include "storage/SimpleBundleStorage.h"
+#include "storage/LogBundleStorage.h"
+
+#ifdef HAVE_SQLITE
+#include "storage/SQLiteBundleStorage.h"
+#endif
+
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrdtn/utils/Clock.h>
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/TimeMeasurement.h>
+#include <sstream>
+#include <fstream>
+#include <unistd.h>
+
+// lifetime of the stored bundles, long enough to survive the benchmark
+static const size_t BUNDLE_LIFETIME = 3600;
+
+// number of scans over the whole storage
+static const size_t SCAN_ITERATIONS = 10;
+
+// number of distinct destinations of the stored bundles
+static const size_t DESTINATIONS = 10;
+
+// milliseconds to wait for deferred operations of a storage
+static const size_t AWAIT_TIMEOUT = 60000;
+
+/**
+ * Visits all bundles of the storage and selects
+ * the bundles of one destination
+ */
+class ScanSelector : public dtn::storage::BundleSelector
+{
+public:
+	ScanSelector() : visited(0), _destination("dtn://node-0/app") { };
+	virtual ~ScanSelector() { };
+
+	dtn::data::Size limit() const throw () { return 0; };
+
+	bool shouldAdd(const dtn::data::MetaBundle &meta) const throw (dtn::storage::BundleSelectorException)
+	{
+		visited++;
+		return (meta.destination == _destination);
+	};
+
+	mutable size_t visited;
+
+private:
+	const dtn::data::EID _destination;
+};
+
+StorageBenchmark::StorageBenchmark(const size_t bundles, const size_t max_volume)
+ : BenchmarkModule("Storage"), _bundles(bundles), _max_volume(max_volume), _workdir("./tmp/storage"), _failed(false)
+{
+	_payload_sizes.push_back(64);
+	_payload_sizes.push_back(4096);
+	_payload_sizes.push_back(65536);
+	_payload_sizes.push_back(1048576);
+}
+
+StorageBenchmark::~StorageBenchmark()
+{
+	if (_workdir.exists()) ibrcommon::File(_workdir).remove(true);
+}
+
+dtn::storage::BundleStorage* StorageBenchmark::create(const std::string &name, const ibrcommon::File &path) const
+{
+	dtn::storage::BundleStorage *storage = NULL;
+
+	if (name == "memory")
+	{
+		storage = new dtn::storage::MemoryBundleStorage();
+	}
+	else if (name == "simple")
+	{
+		storage = new dtn::storage::SimpleBundleStorage(path);
+	}
+	else if (name == "log")
+	{
+		storage = new dtn::storage::LogBundleStorage(path);
+	}
+#ifdef HAVE_SQLITE
+	else if (name == "sqlite")
+	{
+		storage = new dtn::storage::SQLiteBundleStorage(path, 0);
+	}
+#endif
+
+	if (storage == NULL) return NULL;
+
+	dtn::daemon::Component &c = dynamic_cast<dtn::daemon::Component&>(*storage);
+	c.initialize();
+	c.startup();
+
+	return storage;
+}
+
+void StorageBenchmark::destroy(dtn::storage::BundleStorage *storage) const
+{
+	dtn::daemon::Component &c = dynamic_cast<dtn::daemon::Component&>(*storage);
+	c.terminate();
+	delete storage;
+}
+
+void StorageBenchmark::prepare(std::vector<dtn::data::Bundle> &bundles, const size_t count, const size_t payload_size) const
+{
+	const std::string data(payload_size, 'x');
+
+	bundles.clear();
+	bundles.reserve(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		// every new bundle gets its own sequence number
+		bundles.push_back(dtn::data::Bundle());
+		dtn::data::Bundle &b = bundles.back();
+
+		std::stringstream destination;
+		destination << "dtn://node-" << (i % DESTINATIONS) << "/app";
+
+		b.source = dtn::data::EID("dtn://benchmark/source");
+		b.destination = dtn::data::EID(destination.str());
+		b.lifetime = BUNDLE_LIFETIME;
+
+		ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+		(*ref.iostream()) << data;
+		b.push_back(ref);
+	}
+}
+
+bool StorageBenchmark::await(dtn::storage::BundleStorage &storage, const size_t count, const size_t timeout) const
+{
+	for (size_t waited = 0; waited < timeout; ++waited)
+	{
+		storage.wait();
+		if (storage.count() == count) return true;
+		ibrcommon::Thread::sleep(1);
+	}
+
+	return false;
+}
+
+void StorageBenchmark::benchmark(const std::string &name, const size_t payload_size)
+{
+	std::stringstream ss;
+	ss << name << "/" << payload_size;
+	const std::string workload = ss.str();
+
+	ibrcommon::File path = _workdir.get(name);
+	if (path.exists()) path.remove(true);
+	ibrcommon::File::createDirectory(path);
+
+	size_t count = _bundles;
+	if ((count * payload_size) > _max_volume) count = _max_volume / payload_size;
+	if (count < 2) count = 2;
+
+	const double volume = (double)count * (double)payload_size;
+
+	// the sqlite storage replaces the BLOB provider, restore the default one
+	ibrcommon::File blob_path = _workdir.get("blobs");
+	if (!blob_path.exists()) ibrcommon::File::createDirectory(blob_path);
+	ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
+
+	std::vector<dtn::data::Bundle> bundles;
+	prepare(bundles, count, payload_size);
+
+	dtn::storage::BundleStorage *storage = create(name, path);
+	if (storage == NULL) return;
+
+	// ingest all bundles
+	{
+		const size_t written_start = getWrittenBytes();
+		const size_t memory_start = getResidentMemory();
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (std::vector<dtn::data::Bundle>::const_iterator it = bundles.begin(); it != bundles.end(); ++it)
+		{
+			storage->store(*it);
+		}
+		storage->wait();
+
+		tm.stop();
+
+		const size_t written = getWrittenBytes() - written_start;
+		const size_t memory = getResidentMemory();
+		const double seconds = tm.getMilliseconds() / 1000.0;
+
+		report(workload, "ingest-time", tm.getMilliseconds(), "ms");
+		if (seconds > 0)
+		{
+			report(workload, "ingest-rate", (double)count / seconds, "bundles/s");
+			report(workload, "ingest-throughput", volume / 1048576.0 / seconds, "MiB/s");
+		}
+		report(workload, "write-amplification", (double)written / volume, "ratio");
+		report(workload, "disk-amplification", (double)getDiskUsage(path) / volume, "ratio");
+		report(workload, "memory-per-bundle", (memory > memory_start) ? (double)(memory - memory_start) / (double)count : 0.0, "bytes");
+
+		if (storage->count() != count) _failed = true;
+	}
+
+	// scan all bundles with a selector
+	{
+		size_t visited = 0;
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < SCAN_ITERATIONS; ++i)
+		{
+			ScanSelector selector;
+			dtn::storage::BundleResultList result;
+
+			try {
+				storage->get(selector, result);
+			} catch (const dtn::storage::NoBundleFoundException&) { }
+
+			visited += selector.visited;
+			if (result.size() != (count + DESTINATIONS - 1) / DESTINATIONS) _failed = true;
+		}
+
+		tm.stop();
+
+		const double seconds = tm.getMilliseconds() / 1000.0;
+		if (seconds > 0)
+		{
+			report(workload, "scan-rate", (double)SCAN_ITERATIONS / seconds, "scans/s");
+			report(workload, "scan-throughput", (double)visited / seconds, "bundles/s");
+		}
+	}
+
+	// restart persistent storages and wait until all bundles are restored
+	if (name != "memory")
+	{
+		destroy(storage);
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		storage = create(name, path);
+		if (!await(*storage, count, AWAIT_TIMEOUT)) _failed = true;
+
+		tm.stop();
+
+		report(workload, "restart-time", tm.getMilliseconds(), "ms");
+	}
+
+	// remove every second bundle
+	{
+		size_t removed = 0;
+
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		for (size_t i = 0; i < count; i += 2)
+		{
+			storage->remove(bundles[i]);
+			removed++;
+		}
+		storage->wait();
+
+		tm.stop();
+
+		const double seconds = tm.getMilliseconds() / 1000.0;
+		if (seconds > 0) report(workload, "remove-rate", (double)removed / seconds, "bundles/s");
+
+		if (storage->count() != (count - removed)) _failed = true;
+	}
+
+	// expire the remaining bundles
+	{
+		ibrcommon::TimeMeasurement tm;
+		tm.start();
+
+		dtn::core::TimeEvent::raise(dtn::utils::Clock::getTime() + BUNDLE_LIFETIME + 1, dtn::core::TIME_SECOND_TICK);
+		if (!await(*storage, 0, AWAIT_TIMEOUT)) _failed = true;
+
+		tm.stop();
+
+		report(workload, "expire-time", tm.getMilliseconds(), "ms");
+	}
+
+	storage->clear();
+	destroy(storage);
+	bundles.clear();
+
+	path.remove(true);
+}
+
+void StorageBenchmark::run()
+{
+	ibrtest::EventSwitchLoop esl;
+	esl.start();
+
+	std::list<std::string> storages;
+	storages.push_back("memory");
+	storages.push_back("simple");
+	storages.push_back("log");
+#ifdef HAVE_SQLITE
+	storages.push_back("sqlite");
+#endif
+
+	for (std::list<std::string>::const_iterator it = storages.begin(); it != storages.end(); ++it)
+	{
+		for (std::list<size_t>::const_iterator sit = _payload_sizes.begin(); sit != _payload_sizes.end(); ++sit)
+		{
+			benchmark(*it, *sit);
+		}
+	}
+
+	esl.stop();
+	esl.join();
+}
+
+bool StorageBenchmark::check()
+{
+	return !_failed;
+}
+
+size_t StorageBenchmark::getDiskUsage(const ibrcommon::File &path)
+{
+	if (!path.isDirectory()) return path.size();
+
+	size_t ret = 0;
+	std::list<ibrcommon::File> files;
+	path.getFiles(files);
+
+	for (std::list<ibrcommon::File>::const_iterator it = files.begin(); it != files.end(); ++it)
+	{
+		if ((*it).isSystem()) continue;
+		ret += getDiskUsage(*it);
+	}
+
+	return ret;
+}
+
+size_t StorageBenchmark::getResidentMemory()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t pages = 0, resident = 0;
+
+	if (statm >> pages >> resident)
+	{
+		return resident * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	}
+
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * StorageBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef STORAGEBENCHMARK_H_
+#define STORAGEBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+#include "storage/BundleStorage.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrcommon/data/File.h>
+#include <vector>
+#include <list>
+
+/**
+ * Runs the same workloads against every bundle storage: ingest of
+ * bundles with different payload sizes, scans with a bundle selector,
+ * removal and expiration of bundles and the recovery of persistent
+ * storages after a restart. The workload of each storage is named
+ * <storage>/<payload size>.
+ */
+class StorageBenchmark : public BenchmarkModule
+{
+public:
+	/**
+	 * @param bundles Number of bundles per workload
+	 * @param max_volume Upper bound for the payload volume of a workload,
+	 *   the number of bundles is reduced for large payloads
+	 */
+	StorageBenchmark(const size_t bundles = 2000, const size_t max_volume = 64 * 1024 * 1024);
+	virtual ~StorageBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Create, initialize and start-up the storage with the given name
+	 * @param name One of memory, simple, log or sqlite
+	 * @param path Working directory of the storage
+	 */
+	dtn::storage::BundleStorage* create(const std::string &name, const ibrcommon::File &path) const;
+
+	/**
+	 * Terminate and delete a storage
+	 */
+	void destroy(dtn::storage::BundleStorage *storage) const;
+
+	/**
+	 * Run all workloads on one storage with the given payload size
+	 */
+	void benchmark(const std::string &name, const size_t payload_size);
+
+	/**
+	 * Create the bundles to store before the measurement starts
+	 */
+	void prepare(std::vector<dtn::data::Bundle> &bundles, const size_t count, const size_t payload_size) const;
+
+	/**
+	 * Wait until the storage contains the given number of bundles
+	 * @return False, if the number has not been reached within the timeout
+	 */
+	bool await(dtn::storage::BundleStorage &storage, const size_t count, const size_t timeout) const;
+
+	/**
+	 * Returns the number of bytes used by all files below the given path
+	 */
+	static size_t getDiskUsage(const ibrcommon::File &path);
+
+	/**
+	 * Returns the resident memory of this process in bytes
+	 */
+	static size_t getResidentMemory();
+
+	const size_t _bundles;
+	const size_t _max_volume;
+	const ibrcommon::File _workdir;
+	std::list<size_t> _payload_sizes;
+	bool _failed;
+};
+
+#endif /* STORAGEBENCHMARK_H_ */
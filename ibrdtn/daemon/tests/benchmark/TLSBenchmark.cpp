@@ -0,0 +1,289 @@
+/*
+ * TLSBenchmark.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "config.h"
+#include "TLSBenchmark.h"
+
+#ifdef WITH_TLS
+#include <ibrcommon/ssl/TLSStream.h>
+#include <ibrcommon/net/socket.h>
+#include <ibrcommon/net/socketstream.h>
+#include <ibrcommon/net/vsocket.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/TimeMeasurement.h>
+
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <vector>
+
+/**
+ * Accepts TLS connections, reads the announced number of bytes
+ * and answers with a single byte.
+ */
+class TLSBenchmarkServer : public ibrcommon::JoinableThread
+{
+public:
+	TLSBenchmarkServer(const int port) : failed(false), _running(true)
+	{
+		_sock.add(new ibrcommon::tcpserversocket(ibrcommon::vaddress("127.0.0.1", port)));
+		_sock.up();
+	}
+
+	virtual ~TLSBenchmarkServer()
+	{
+		join();
+		_sock.destroy();
+	}
+
+	bool failed;
+
+protected:
+	void run() throw ()
+	{
+		std::vector<char> buf(ibrcommon::TLSStream::BUFF_SIZE);
+
+		while (_running)
+		{
+			try {
+				ibrcommon::socketset fds;
+				_sock.select(&fds, NULL, NULL, NULL);
+
+				for (ibrcommon::socketset::iterator iter = fds.begin(); iter != fds.end(); ++iter)
+				{
+					ibrcommon::serversocket &srv = dynamic_cast<ibrcommon::serversocket&>(**iter);
+					ibrcommon::vaddress source;
+
+					ibrcommon::clientsocket *sock = srv.accept(source);
+					sock->set(ibrcommon::clientsocket::NO_DELAY, true);
+
+					ibrcommon::socketstream stream(sock);
+					ibrcommon::TLSStream tls(&stream);
+					tls.setServer(true);
+
+					X509 *peer = tls.activate();
+					if (peer == NULL) failed = true;
+
+					uint32_t length = 0;
+					tls.read((char*)&length, sizeof(length));
+					length = ntohl(length);
+
+					while (length > 0 && tls.good())
+					{
+						const size_t chunk = (length > buf.size()) ? buf.size() : length;
+						tls.read(&buf[0], chunk);
+						length -= static_cast<uint32_t>(chunk);
+					}
+
+					if (!tls.good()) failed = true;
+
+					tls.put('k');
+					tls.flush();
+					tls.close();
+					stream.close();
+				}
+			} catch (const ibrcommon::vsocket_interrupt&) {
+				// regular interrupt
+				return;
+			} catch (const ibrcommon::Exception &ex) {
+				std::cerr << "TLS server error: " << ex.what() << std::endl;
+				failed = true;
+			}
+		}
+	}
+
+	void __cancellation() throw ()
+	{
+		_running = false;
+		_sock.down();
+	}
+
+private:
+	ibrcommon::vsocket _sock;
+	bool _running;
+};
+
+TLSBenchmark::TLSBenchmark(const size_t handshakes, const size_t bulk_size, const int port)
+ : BenchmarkModule("TLS"), _handshakes(handshakes), _bulk_size(bulk_size), _port(port),
+   _ca_path("./tmp/tls-ca"), _cert(NULL), _pkey(NULL), _failed(false)
+{
+}
+
+TLSBenchmark::~TLSBenchmark()
+{
+	ibrcommon::TLSStream::flushInitialization();
+	if (_ca_path.exists()) ibrcommon::File(_ca_path.getPath()).remove(true);
+	if (_cert != NULL) X509_free(_cert);
+	if (_pkey != NULL) EVP_PKEY_free(_pkey);
+}
+
+void TLSBenchmark::prepare()
+{
+	RSA* rsa = RSA_new();
+	BIGNUM* e = BN_new();
+	BN_set_word(e, 65537);
+	RSA_generate_key_ex(rsa, 2048, e, NULL);
+	BN_free(e);
+
+	_pkey = EVP_PKEY_new();
+	EVP_PKEY_assign_RSA(_pkey, rsa);
+
+	_cert = X509_new();
+	X509_set_version(_cert, 0);
+	ASN1_INTEGER_set(X509_get_serialNumber(_cert), 1);
+	X509_gmtime_adj(X509_get_notBefore(_cert), 0);
+	X509_gmtime_adj(X509_get_notAfter(_cert), 3600);
+	X509_set_pubkey(_cert, _pkey);
+
+	X509_NAME *name = X509_get_subject_name(_cert);
+	X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*)"benchmark", -1, -1, 0);
+	X509_set_issuer_name(_cert, name);
+	X509_sign(_cert, _pkey, EVP_sha256());
+
+	// store the certificate under its hashed name to trust it
+	ibrcommon::File ca_path = _ca_path;
+	if (!ca_path.exists()) ibrcommon::File::createDirectory(ca_path);
+
+	char hash[16];
+	snprintf(hash, sizeof(hash), "%08lx.0", X509_subject_name_hash(_cert));
+
+	FILE *f = fopen(ca_path.get(hash).getPath().c_str(), "w");
+	PEM_write_X509(f, _cert);
+	fclose(f);
+}
+
+bool TLSBenchmark::transfer(const std::string &peer, const size_t bytes)
+{
+	ibrcommon::clientsocket *sock = new ibrcommon::tcpsocket(ibrcommon::vaddress("127.0.0.1", _port));
+	ibrcommon::socketstream stream(sock);
+
+	// use the default socket options of the TCP convergence layer,
+	// the socket is connected by the stream
+	sock->set(ibrcommon::clientsocket::NO_DELAY, true);
+	ibrcommon::TLSStream tls(&stream);
+	tls.setPeerId(peer);
+	tls.activate();
+
+	const uint32_t length = htonl(static_cast<uint32_t>(bytes));
+	tls.write((const char*)&length, sizeof(length));
+
+	std::vector<char> buf(ibrcommon::TLSStream::BUFF_SIZE, 'x');
+	for (size_t remain = bytes; remain > 0;)
+	{
+		const size_t chunk = (remain > buf.size()) ? buf.size() : remain;
+		tls.write(&buf[0], chunk);
+		remain -= chunk;
+	}
+	tls.flush();
+
+	// wait for the answer, this also receives new session tickets
+	char ack = 0;
+	tls.get(ack);
+	if (ack != 'k') _failed = true;
+
+	const bool resumed = tls.isResumed();
+
+	tls.close();
+	stream.close();
+
+	return resumed;
+}
+
+void TLSBenchmark::run()
+{
+	prepare();
+
+	// the type of the path is determined on construction, so refresh it
+	ibrcommon::TLSStream::init(_cert, _pkey, ibrcommon::File(_ca_path.getPath()), true);
+
+	TLSBenchmarkServer srv(_port);
+	srv.start();
+
+	try {
+		// establish a full handshake on each connection
+		{
+			ibrcommon::TimeMeasurement tm;
+			tm.start();
+
+			for (size_t i = 0; i < _handshakes; ++i)
+			{
+				if (transfer("", 1)) _failed = true;
+			}
+
+			tm.stop();
+			report("full-handshake", _handshakes, tm);
+		}
+
+		// resume the session of the first connection
+		{
+			transfer("dtn://benchmark", 1);
+
+			size_t resumed = 0;
+
+			ibrcommon::TimeMeasurement tm;
+			tm.start();
+
+			for (size_t i = 0; i < _handshakes; ++i)
+			{
+				if (transfer("dtn://benchmark", 1)) ++resumed;
+			}
+
+			tm.stop();
+			report("resumed-handshake", _handshakes, tm);
+			report("resumed-handshake", "resumed", (double)resumed, "connections");
+
+			if (resumed == 0) _failed = true;
+		}
+
+		// bulk transfer on a single connection
+		{
+			ibrcommon::TimeMeasurement tm;
+			tm.start();
+
+			transfer("dtn://benchmark", _bulk_size);
+
+			tm.stop();
+			report("bulk", "time", tm.getMilliseconds(), "ms");
+			if (tm.getMilliseconds() > 0)
+				report("bulk", "throughput", ((double)_bulk_size / 1048576.0) / (tm.getMilliseconds() / 1000.0), "MiB/s");
+		}
+	} catch (const ibrcommon::Exception &ex) {
+		std::cerr << "TLS client error: " << ex.what() << std::endl;
+		_failed = true;
+	}
+
+	srv.stop();
+	srv.join();
+
+	if (srv.failed) _failed = true;
+
+	ibrcommon::TLSStream::flushSessions();
+}
+
+bool TLSBenchmark::check()
+{
+	return !_failed;
+}
+
+#endif
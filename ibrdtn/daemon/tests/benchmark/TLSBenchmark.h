@@ -0,0 +1,70 @@
+/*
+ * TLSBenchmark.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef TLSBENCHMARK_H_
+#define TLSBENCHMARK_H_
+
+#include "BenchmarkModule.h"
+
+#ifdef WITH_TLS
+#include <ibrcommon/data/File.h>
+#include <openssl/ssl.h>
+
+/**
+ * Measures the rate of TLS handshakes between two streams connected
+ * through the loopback interface with and without session resumption
+ * and the bulk throughput of an established TLS stream.
+ */
+class TLSBenchmark : public BenchmarkModule
+{
+public:
+	TLSBenchmark(const size_t handshakes = 200, const size_t bulk_size = 64 * 1024 * 1024, const int port = 4557);
+	virtual ~TLSBenchmark();
+
+	void run();
+	bool check();
+
+private:
+	/**
+	 * Create a self-signed certificate and store it in the trusted path
+	 */
+	void prepare();
+
+	/**
+	 * Connect to the server, establish a TLS session and send
+	 * the given number of bytes.
+	 * @return true if the session has been resumed
+	 */
+	bool transfer(const std::string &peer, const size_t bytes);
+
+	const size_t _handshakes;
+	const size_t _bulk_size;
+	const int _port;
+	const ibrcommon::File _ca_path;
+
+	X509 *_cert;
+	EVP_PKEY *_pkey;
+	bool _failed;
+};
+
+#endif
+#endif /* TLSBENCHMARK_H_ */
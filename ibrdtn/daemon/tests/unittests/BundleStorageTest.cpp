@@ -50,6 +50,7 @@
 
 #include "storage/SimpleBundleStorage.h"
 #include "storage/MemoryBundleStorage.h"
+#include "storage/LogBundleStorage.h"
 
 #ifdef HAVE_SQLITE
 #include "storage/SQLiteBundleStorage.h"
@@ -81,40 +82,44 @@ void BundleStorageTest::setUp()
 
 	// enable the blob provider
 	ibrcommon::BLOB::changeProvider(new ibrcommon::FileBLOBProvider(blob_path), true);
-	switch (testCounter++)
-	{
-	case 0:
-		{
-			// add standard memory base storage
-			_storage = new dtn::storage::MemoryBundleStorage();
-			break;
-		}
+	const std::string &name = _storage_names[testCounter++];
 
-	case 1:
-		{
-			// prepare path for the disk based storage
-			ibrcommon::File path("/tmp/bundle-disk-test");
-			if (path.exists()) path.remove(true);
-			ibrcommon::File::createDirectory(path);
-
-			// add disk based storage
-			_storage = new dtn::storage::SimpleBundleStorage(path);
-			break;
-		}
+	if (name == "MemoryBundleStorage")
+	{
+		// add standard memory base storage
+		_storage = new dtn::storage::MemoryBundleStorage();
+	}
+	else if (name == "SimpleBundleStorage")
+	{
+		// prepare path for the disk based storage
+		ibrcommon::File path("/tmp/bundle-disk-test");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
 
+		// add disk based storage
+		_storage = new dtn::storage::SimpleBundleStorage(path);
+	}
 #ifdef HAVE_SQLITE
-	case 2:
-		{
-			// prepare path for the sqlite based storage
-			ibrcommon::File path("/tmp/bundle-sqlite-test");
-			if (path.exists()) path.remove(true);
-			ibrcommon::File::createDirectory(path);
-
-			// prepare a sqlite database
-			_storage = new dtn::storage::SQLiteBundleStorage(path, 0);
-			break;
-		}
+	else if (name == "SQLiteBundleStorage")
+	{
+		// prepare path for the sqlite based storage
+		ibrcommon::File path("/tmp/bundle-sqlite-test");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
+
+		// prepare a sqlite database
+		_storage = new dtn::storage::SQLiteBundleStorage(path, 0);
+	}
 #endif
+	else if (name == "LogBundleStorage")
+	{
+		// prepare path for the log based storage
+		ibrcommon::File path("/tmp/bundle-log-test");
+		if (path.exists()) path.remove(true);
+		ibrcommon::File::createDirectory(path);
+
+		// add log based storage
+		_storage = new dtn::storage::LogBundleStorage(path);
 	}
 
 	if (testCounter >= _storage_names.size()) testCounter = 0;
@@ -97,6 +97,8 @@ class BundleStorageTest : public CppUnit::TestFixture {
 		_storage_names.push_back("SQLiteBundleStorage");
 #endif
 
+		_storage_names.push_back("LogBundleStorage");
+
 		CPPUNIT_TEST_ALL_STORAGES(testStore);
 		CPPUNIT_TEST_ALL_STORAGES(testRemove);
 		CPPUNIT_TEST_ALL_STORAGES(testAgeBlock);
@@ -0,0 +1,233 @@
+/*
+ * ContactGraphTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "ContactGraphTest.h"
+#include "routing/contactgraph/ContactPlan.h"
+#include "routing/contactgraph/ContactGraph.h"
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ContactGraphTest);
+
+using namespace dtn::routing;
+
+static const dtn::data::EID node_a("dtn://node-a");
+static const dtn::data::EID node_b("dtn://node-b");
+static const dtn::data::EID node_c("dtn://node-c");
+
+void ContactGraphTest::setUp()
+{
+}
+
+void ContactGraphTest::tearDown()
+{
+}
+
+void ContactGraphTest::testParse()
+{
+	std::stringstream ss;
+	ss << "# start end from to delay" << std::endl;
+	ss << std::endl;
+	ss << "100 200 dtn://node-a/app dtn://node-b" << std::endl;
+	ss << "+10 +20 dtn://node-b dtn://node-c 2" << std::endl;
+
+	ContactPlan plan;
+	plan.load(ss, 1000);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, plan.size());
+
+	const Contact &c1 = plan.getContacts()[0];
+	CPPUNIT_ASSERT(c1.from == node_a);
+	CPPUNIT_ASSERT(c1.to == node_b);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(100), c1.start);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(200), c1.end);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(0), c1.delay);
+
+	// relative times are based on the reference
+	const Contact &c2 = plan.getContacts()[1];
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(1010), c2.start);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(1020), c2.end);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(2), c2.delay);
+}
+
+void ContactGraphTest::testParseError()
+{
+	ContactPlan plan;
+
+	std::stringstream missing("100 200 dtn://node-a");
+	CPPUNIT_ASSERT_THROW(plan.load(missing, 0), ContactPlan::ParseException);
+
+	std::stringstream reversed("200 100 dtn://node-a dtn://node-b");
+	CPPUNIT_ASSERT_THROW(plan.load(reversed, 0), ContactPlan::ParseException);
+
+	std::stringstream garbage("1x0 200 dtn://node-a dtn://node-b");
+	CPPUNIT_ASSERT_THROW(plan.load(garbage, 0), ContactPlan::ParseException);
+}
+
+void ContactGraphTest::testParseErrorPartial()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_a, node_b, 10, 20));
+
+	// a plan with an error is not added in parts
+	std::stringstream ss;
+	ss << "100 200 dtn://node-a dtn://node-c" << std::endl;
+	ss << "200 100 dtn://node-a dtn://node-b" << std::endl;
+	CPPUNIT_ASSERT_THROW(plan.load(ss, 0), ContactPlan::ParseException);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)1, plan.size());
+}
+
+void ContactGraphTest::testEarliestArrival()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_a, node_b, 10, 20, 1));
+	plan.add(Contact(node_b, node_c, 30, 40, 1));
+	plan.add(Contact(node_a, node_c, 100, 200));
+
+	ContactGraph graph;
+	graph.build(plan);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)3, graph.getNodes());
+	CPPUNIT_ASSERT_EQUAL((size_t)3, graph.getContacts());
+
+	ContactGraph::RouteTable table;
+	graph.compute(node_a, 0, table);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.size());
+
+	// two hops over node-b arrive earlier than the direct contact
+	const ContactGraph::Route *route = table.find(node_c);
+	CPPUNIT_ASSERT(route != NULL);
+	CPPUNIT_ASSERT(route->nexthop == node_b);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(10), route->departure);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(31), route->arrival);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(20), route->expires);
+	CPPUNIT_ASSERT_EQUAL((size_t)2, route->hops);
+
+	// the table expires with the first contact used by a route
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(20), table.getExpiration());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.getNexthops().size());
+}
+
+void ContactGraphTest::testWindows()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_a, node_b, 0, 5));
+	plan.add(Contact(node_a, node_b, 50, 60));
+	plan.add(Contact(node_a, node_c, 0, 100));
+	plan.add(Contact(node_a, node_c, 10, 20));
+
+	ContactGraph graph;
+	graph.build(plan);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)4, graph.getContacts());
+
+	ContactGraph::RouteTable table;
+	graph.compute(node_a, 30, table);
+
+	// wait for the next window
+	const ContactGraph::Route *rb = table.find(node_b);
+	CPPUNIT_ASSERT(rb != NULL);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(50), rb->departure);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(60), rb->expires);
+
+	// the long window is still open after the short one is over
+	const ContactGraph::Route *rc = table.find(node_c);
+	CPPUNIT_ASSERT(rc != NULL);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(30), rc->departure);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(100), rc->expires);
+}
+
+void ContactGraphTest::testExpiration()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_a, node_b, 10, 20, 1));
+	plan.add(Contact(node_b, node_c, 30, 40, 1));
+	plan.add(Contact(node_a, node_c, 100, 200));
+
+	ContactGraph graph;
+	graph.build(plan);
+
+	// the contact to node-b is over, the direct contact remains
+	ContactGraph::RouteTable table;
+	graph.compute(node_a, 21, table);
+
+	CPPUNIT_ASSERT(table.find(node_b) == NULL);
+
+	const ContactGraph::Route *route = table.find(node_c);
+	CPPUNIT_ASSERT(route != NULL);
+	CPPUNIT_ASSERT(route->nexthop == node_c);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(100), route->arrival);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, route->hops);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(21), table.getTime());
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(200), table.getExpiration());
+}
+
+void ContactGraphTest::testUnreachable()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_b, node_a, 10, 20));
+	plan.add(Contact(node_b, node_c, 10, 20));
+
+	ContactGraph graph;
+	graph.build(plan);
+
+	// contacts lead towards node-a only
+	ContactGraph::RouteTable table;
+	graph.compute(node_a, 0, table);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.size());
+	CPPUNIT_ASSERT(table.find(node_c) == NULL);
+
+	// the source is not part of the plan
+	graph.compute(dtn::data::EID("dtn://node-x"), 0, table);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.size());
+}
+
+void ContactGraphTest::testMixedDelays()
+{
+	ContactPlan plan;
+	plan.add(Contact(node_a, node_b, 0, 100, 50));
+	plan.add(Contact(node_a, node_b, 10, 20, 1));
+
+	ContactGraph graph;
+	graph.build(plan);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, graph.getContacts());
+
+	// waiting for the short window with the small delay arrives earlier
+	ContactGraph::RouteTable table;
+	graph.compute(node_a, 0, table);
+
+	const ContactGraph::Route *route = table.find(node_b);
+	CPPUNIT_ASSERT(route != NULL);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(10), route->departure);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(11), route->arrival);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(20), route->expires);
+
+	// after the short window only the long one is left
+	graph.compute(node_a, 30, table);
+
+	route = table.find(node_b);
+	CPPUNIT_ASSERT(route != NULL);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(30), route->departure);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(80), route->arrival);
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(100), route->expires);
+}
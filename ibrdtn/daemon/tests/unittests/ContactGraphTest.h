@@ -0,0 +1,55 @@
+/*
+ * ContactGraphTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef CONTACTGRAPHTEST_H_
+#define CONTACTGRAPHTEST_H_
+
+class ContactGraphTest : public CppUnit::TestFixture
+{
+public:
+	void testParse();
+	void testParseError();
+	void testParseErrorPartial();
+	void testEarliestArrival();
+	void testWindows();
+	void testMixedDelays();
+	void testExpiration();
+	void testUnreachable();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(ContactGraphTest);
+	CPPUNIT_TEST(testParse);
+	CPPUNIT_TEST(testParseError);
+	CPPUNIT_TEST(testParseErrorPartial);
+	CPPUNIT_TEST(testEarliestArrival);
+	CPPUNIT_TEST(testWindows);
+	CPPUNIT_TEST(testMixedDelays);
+	CPPUNIT_TEST(testExpiration);
+	CPPUNIT_TEST(testUnreachable);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* CONTACTGRAPHTEST_H_ */
@@ -381,6 +381,157 @@ void DataStorageTest::testStressTest()
 //	}
 }
 
+void DataStorageTest::testLanesTest()
+{
+	class DataContainer : public dtn::storage::DataStorage::Container
+	{
+	public:
+		DataContainer(size_t id, size_t size)
+		 : _id(id), _size(size)
+		{ };
+
+		~DataContainer() {};
+
+		std::string getId() const
+		{
+			std::stringstream ss; ss << "lane-" << _id;
+			return ss.str();
+		}
+
+		std::ostream& serialize(std::ostream &stream)
+		{
+			// write less than announced for every second container
+			const size_t written = (_id % 2 == 0) ? _size : _size / 2;
+			stream << std::string(written, 'a' + static_cast<char>(_id % 26));
+			return stream;
+		}
+
+		size_t getSize() const
+		{
+			return _size;
+		}
+
+	private:
+		const size_t _id;
+		const size_t _size;
+	};
+
+	DataCallbackDummy callback;
+	ibrcommon::File datapath("/tmp/datastorage");
+	dtn::storage::DataStorage storage(callback, datapath, 16, true, 4, true);
+	storage.start();
+
+	const size_t items = 200;
+	std::list<dtn::storage::DataStorage::Hash> hashes;
+
+	for (size_t i = 0; i < items; ++i)
+	{
+		hashes.push_back( storage.store(new DataContainer(i, 100 + i)) );
+	}
+
+	// wait until all data is stored
+	storage.wait();
+
+	size_t i = 0;
+	for (std::list<dtn::storage::DataStorage::Hash>::const_iterator iter = hashes.begin(); iter != hashes.end(); ++iter, ++i)
+	{
+		dtn::storage::DataStorage::istream stream = storage.retrieve(*iter);
+		std::stringstream ss; ss << (*stream).rdbuf();
+
+		const size_t written = (i % 2 == 0) ? (100 + i) : (100 + i) / 2;
+		CPPUNIT_ASSERT_EQUAL(std::string(written, 'a' + static_cast<char>(i % 26)), ss.str());
+
+		storage.remove(*iter);
+	}
+
+	// wait until all data is removed
+	storage.wait();
+
+	for (std::list<dtn::storage::DataStorage::Hash>::const_iterator iter = hashes.begin(); iter != hashes.end(); ++iter)
+	{
+		CPPUNIT_ASSERT_THROW(storage.retrieve(*iter), dtn::storage::DataStorage::DataNotAvailableException);
+	}
+
+	const dtn::storage::DataStorage::Statistics stats = storage.getStatistics();
+	CPPUNIT_ASSERT_EQUAL(items, stats.stored);
+	CPPUNIT_ASSERT_EQUAL(items, stats.removed);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, stats.store_failed);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, stats.queue_depth);
+	CPPUNIT_ASSERT(stats.queue_depth_max > 0);
+	CPPUNIT_ASSERT(stats.syncs > 0);
+
+	dtn::data::Size latencies = 0;
+	for (size_t b = 0; b < dtn::storage::DataStorage::Statistics::LATENCY_BUCKETS; ++b)
+	{
+		latencies += stats.store_latency[b];
+	}
+	CPPUNIT_ASSERT_EQUAL(items, latencies);
+}
+
+void DataStorageTest::testFlatLayoutTest()
+{
+	class DataCallback : public DataCallbackDummy
+	{
+	public:
+		DataCallback() : iterated(0) {};
+		virtual ~DataCallback() {};
+
+		void iterateDataStorage(const dtn::storage::DataStorage::Hash&, dtn::storage::DataStorage::istream&)
+		{
+			iterated++;
+		};
+
+		int iterated;
+	};
+
+	class DataContainer : public dtn::storage::DataStorage::Container
+	{
+	public:
+		DataContainer() {};
+		~DataContainer() {};
+
+		std::string getId() const
+		{
+			return "fan-out";
+		}
+
+		std::ostream& serialize(std::ostream &stream)
+		{
+			stream << "data";
+			return stream;
+		}
+	};
+
+	// put a file into the path like previous versions did
+	ibrcommon::File datapath("/tmp/datastorage");
+	{
+		std::ofstream legacy(datapath.get("flat").getPath().c_str(), ios::out | ios::binary | ios::trunc);
+		legacy << "legacy";
+	}
+
+	DataCallback callback;
+	dtn::storage::DataStorage storage(callback, datapath);
+	storage.start();
+
+	storage.store(new DataContainer());
+	storage.wait();
+
+	// the legacy file is still accessible
+	{
+		dtn::storage::DataStorage::istream s = storage.retrieve(dtn::storage::DataStorage::Hash("flat"));
+		std::stringstream ss; ss << (*s).rdbuf();
+		CPPUNIT_ASSERT_EQUAL(std::string("legacy"), ss.str());
+	}
+
+	// both layouts are restored
+	storage.iterateAll();
+	CPPUNIT_ASSERT_EQUAL(2, callback.iterated);
+
+	storage.remove(dtn::storage::DataStorage::Hash("flat"));
+	storage.wait();
+	CPPUNIT_ASSERT(!datapath.get("flat").exists());
+}
+
 void DataStorageTest::setUp()
 {
 	// create temporary directory for data storage
@@ -33,6 +33,8 @@ public:
 	void testStoreTest();
 	void testRemoveTest();
 	void testStressTest();
+	void testLanesTest();
+	void testFlatLayoutTest();
 
 	void setUp();
 	void tearDown();
@@ -42,6 +44,8 @@ public:
 	CPPUNIT_TEST(testStoreTest);
 	CPPUNIT_TEST(testRemoveTest);
 	CPPUNIT_TEST(testStressTest);
+	CPPUNIT_TEST(testLanesTest);
+	CPPUNIT_TEST(testFlatLayoutTest);
 	CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -0,0 +1,192 @@
+/*
+ * LogBundleStorageTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "LogBundleStorageTest.h"
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrdtn/utils/Clock.h>
+#include <ibrcommon/data/BLOB.h>
+#include <sstream>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LogBundleStorageTest);
+
+// creation time of all test bundles
+static dtn::data::Timestamp test_timestamp = 0;
+
+void LogBundleStorageTest::setUp()
+{
+	_path = ibrcommon::File("/tmp/bundle-log-unittest");
+	if (_path.exists()) _path.remove(true);
+	ibrcommon::File::createDirectory(_path);
+
+	test_timestamp = dtn::utils::Clock::getTime();
+}
+
+void LogBundleStorageTest::tearDown()
+{
+	_path.remove(true);
+}
+
+dtn::data::Bundle LogBundleStorageTest::createBundle(int num)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+	b.lifetime = 3600;
+	b.timestamp = test_timestamp;
+	b.sequencenumber = num;
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		(*stream) << "bundle-" << num << std::endl;
+
+		// fill up the payload to 1000 bytes
+		(*stream) << std::string(1000 - stream.size(), 'x');
+	}
+	b.push_back(ref);
+
+	return b;
+}
+
+std::string LogBundleStorageTest::getPayload(const dtn::data::Bundle &b)
+{
+	const dtn::data::PayloadBlock &p = b.find<dtn::data::PayloadBlock>();
+	ibrcommon::BLOB::Reference ref = p.getBLOB();
+	ibrcommon::BLOB::iostream stream = ref.iostream();
+
+	std::string line;
+	std::getline(*stream, line);
+	return line;
+}
+
+void LogBundleStorageTest::testSegments()
+{
+	dtn::storage::LogBundleStorage storage(_path, 0, 4096);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 40; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	// four bundles fit into one segment
+	CPPUNIT_ASSERT(storage.getSegmentCount() >= 10);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)40, storage.count());
+
+	for (int i = 0; i < 40; ++i)
+	{
+		dtn::data::BundleID id = createBundle(i);
+		std::stringstream ss; ss << "bundle-" << i;
+		CPPUNIT_ASSERT_EQUAL(ss.str(), getPayload(storage.get(id)));
+	}
+
+	storage.terminate();
+}
+
+void LogBundleStorageTest::testCompaction()
+{
+	dtn::storage::LogBundleStorage storage(_path, 0, 4096);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 40; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	const dtn::data::Size segments = storage.getSegmentCount();
+
+	// remove three of four bundles
+	for (int i = 0; i < 40; ++i)
+	{
+		if ((i % 4) == 0) continue;
+		storage.remove(createBundle(i));
+	}
+
+	storage.compact();
+	storage.wait();
+
+	// the remaining bundles have been moved into fewer segments
+	CPPUNIT_ASSERT(storage.getSegmentCount() < segments);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)10, storage.count());
+
+	for (int i = 0; i < 40; i += 4)
+	{
+		dtn::data::BundleID id = createBundle(i);
+		std::stringstream ss; ss << "bundle-" << i;
+		CPPUNIT_ASSERT_EQUAL(ss.str(), getPayload(storage.get(id)));
+	}
+
+	// restart with the index written on shutdown
+	storage.terminate();
+	storage.initialize();
+	storage.startup();
+
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)10, storage.count());
+
+	for (int i = 0; i < 40; i += 4)
+	{
+		dtn::data::BundleID id = createBundle(i);
+		std::stringstream ss; ss << "bundle-" << i;
+		CPPUNIT_ASSERT_EQUAL(ss.str(), getPayload(storage.get(id)));
+	}
+
+	storage.terminate();
+}
+
+void LogBundleStorageTest::testReplay()
+{
+	dtn::storage::LogBundleStorage storage(_path, 0, 16384);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 20; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	// remove some bundles
+	for (int i = 0; i < 20; i += 5)
+	{
+		storage.remove(createBundle(i));
+	}
+
+	storage.terminate();
+
+	// drop the index to force a replay of all segments
+	_path.get("index").remove();
+
+	storage.initialize();
+	storage.startup();
+
+	// removed bundles are not restored
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)16, storage.count());
+
+	for (int i = 0; i < 20; ++i)
+	{
+		dtn::data::BundleID id = createBundle(i);
+		CPPUNIT_ASSERT_EQUAL((i % 5) != 0, storage.contains(id));
+	}
+
+	storage.terminate();
+}
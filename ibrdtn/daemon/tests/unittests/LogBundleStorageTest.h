@@ -0,0 +1,53 @@
+/*
+ * LogBundleStorageTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "storage/LogBundleStorage.h"
+#include <ibrdtn/data/Bundle.h>
+
+#ifndef LOGBUNDLESTORAGETEST_H_
+#define LOGBUNDLESTORAGETEST_H_
+
+class LogBundleStorageTest : public CppUnit::TestFixture
+{
+public:
+	void testSegments();
+	void testCompaction();
+	void testReplay();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(LogBundleStorageTest);
+	CPPUNIT_TEST(testSegments);
+	CPPUNIT_TEST(testCompaction);
+	CPPUNIT_TEST(testReplay);
+	CPPUNIT_TEST_SUITE_END();
+
+private:
+	static dtn::data::Bundle createBundle(int num);
+	static std::string getPayload(const dtn::data::Bundle &b);
+
+	ibrcommon::File _path;
+};
+
+#endif /* LOGBUNDLESTORAGETEST_H_ */
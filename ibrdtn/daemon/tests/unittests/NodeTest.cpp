@@ -32,6 +32,7 @@
 
 #include "NodeTest.hh"
 #include "core/Node.h"
+#include "net/NeighborSnapshot.h"
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(NodeTest);
@@ -147,6 +148,32 @@ void NodeTest::testGetProtocol()
 
 /*=== END   tests for class 'Node' ===*/
 
+void NodeTest::testNeighborSnapshot()
+{
+	const dtn::net::NeighborSnapshot::Reference empty(new dtn::net::NeighborSnapshot());
+	CPPUNIT_ASSERT(empty->empty());
+	CPPUNIT_ASSERT(!empty->contains(dtn::data::EID("dtn://node-one")));
+
+	std::set<dtn::core::Node> nodes;
+	nodes.insert(dtn::core::Node(dtn::data::EID("dtn://node-one")));
+	nodes.insert(dtn::core::Node(dtn::data::EID("dtn://node-two")));
+
+	const dtn::net::NeighborSnapshot::Reference snapshot(new dtn::net::NeighborSnapshot(nodes, 42));
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)2, snapshot->size());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)42, snapshot->getVersion());
+	CPPUNIT_ASSERT(snapshot->contains(dtn::data::EID("dtn://node-one")));
+	CPPUNIT_ASSERT(snapshot->contains(dtn::data::EID("dtn://node-two")));
+	CPPUNIT_ASSERT(!snapshot->contains(dtn::data::EID("dtn://node-three")));
+
+	// the node data is not affected by the origin set
+	nodes.clear();
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)2, snapshot->getNodes().size());
+
+	// a copied reference points to the same snapshot
+	const dtn::net::NeighborSnapshot::Reference copy = snapshot;
+	CPPUNIT_ASSERT(&(*copy) == &(*snapshot));
+}
+
 void NodeTest::setUp()
 {
 }
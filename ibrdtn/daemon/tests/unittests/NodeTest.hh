@@ -37,6 +37,8 @@ class NodeTest : public CppUnit::TestFixture {
 //		void testToString();
 		/*=== END   tests for class 'Node' ===*/
 
+		void testNeighborSnapshot();
+
 		void setUp();
 		void tearDown();
 
@@ -56,6 +58,7 @@ class NodeTest : public CppUnit::TestFixture {
 //			CPPUNIT_TEST(testOperatorEqual);
 //			CPPUNIT_TEST(testOperatorLessThan);
 //			CPPUNIT_TEST(testToString);
+			CPPUNIT_TEST(testNeighborSnapshot);
 		CPPUNIT_TEST_SUITE_END();
 };
 #endif /* NODETEST_HH */
@@ -0,0 +1,119 @@
+/*
+ * RegistrationIndexTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "RegistrationIndexTest.h"
+#include "api/Registration.h"
+#include "api/RegistrationIndex.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/MetaBundle.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RegistrationIndexTest);
+
+static dtn::data::MetaBundle create(const std::string &source, const std::string &destination)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID(source);
+	b.destination = dtn::data::EID(destination);
+	b.lifetime = 3600;
+	return dtn::data::MetaBundle::create(b);
+}
+
+void RegistrationIndexTest::setUp()
+{
+}
+
+void RegistrationIndexTest::tearDown()
+{
+}
+
+void RegistrationIndexTest::testDeliver()
+{
+	dtn::api::Registration app;
+	dtn::api::Registration group;
+	dtn::api::Registration mirror;
+	dtn::api::Registration idle;
+
+	app.subscribe(dtn::data::EID("dtn://gateway/app"));
+	group.subscribe(dtn::data::EID("dtn://group/news"));
+	mirror.subscribe(dtn::data::EID("dtn://gateway/app"));
+	idle.subscribe(dtn::data::EID("dtn://gateway/idle"));
+
+	const dtn::data::MetaBundle b1 = create("dtn://remote/app", "dtn://gateway/app");
+	const dtn::data::MetaBundle b2 = create("dtn://remote/app", "dtn://group/news");
+
+	// the bundle is queued for both subscriptions of its destination
+	CPPUNIT_ASSERT_EQUAL((size_t)2, dtn::api::RegistrationIndex::deliver(b1));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, dtn::api::RegistrationIndex::deliver(b2));
+
+	// a bundle is never queued twice
+	CPPUNIT_ASSERT_EQUAL((size_t)0, dtn::api::RegistrationIndex::deliver(b1));
+
+	// queued bundles are received without a query of the storage
+	CPPUNIT_ASSERT(app.receiveMetaBundle() == b1);
+	CPPUNIT_ASSERT(group.receiveMetaBundle() == b2);
+	CPPUNIT_ASSERT(mirror.receiveMetaBundle() == b1);
+
+	// own bundles are not delivered back
+	mirror.subscribe(dtn::data::EID("dtn://mirror/app"));
+	const dtn::data::MetaBundle b3 = create("dtn://mirror/app", "dtn://gateway/app");
+	CPPUNIT_ASSERT_EQUAL((size_t)1, dtn::api::RegistrationIndex::deliver(b3));
+	CPPUNIT_ASSERT(app.receiveMetaBundle() == b3);
+}
+
+void RegistrationIndexTest::testUnsubscribe()
+{
+	const dtn::data::EID endpoint("dtn://gateway/unsubscribe");
+
+	{
+		dtn::api::Registration reg;
+		reg.subscribe(endpoint);
+
+		CPPUNIT_ASSERT_EQUAL((size_t)1, dtn::api::RegistrationIndex::deliver(create("dtn://remote/app", endpoint.getString())));
+
+		reg.unsubscribe(endpoint);
+		CPPUNIT_ASSERT_EQUAL((size_t)0, dtn::api::RegistrationIndex::deliver(create("dtn://remote/app", endpoint.getString())));
+
+		reg.subscribe(endpoint);
+	}
+
+	// destroyed registrations are removed from the index
+	CPPUNIT_ASSERT_EQUAL((size_t)0, dtn::api::RegistrationIndex::deliver(create("dtn://remote/app", endpoint.getString())));
+}
+
+void RegistrationIndexTest::testDetached()
+{
+	const dtn::data::EID endpoint("dtn://gateway/detached");
+
+	dtn::api::Registration reg;
+	reg.subscribe(endpoint);
+
+	// the queue of a detached registration does not grow
+	reg.detach();
+	for (int i = 0; i < 10; ++i)
+	{
+		CPPUNIT_ASSERT_EQUAL((size_t)0, dtn::api::RegistrationIndex::deliver(create("dtn://remote/app", endpoint.getString())));
+	}
+
+	// bundles are queued again once a client is attached
+	reg.attach();
+	CPPUNIT_ASSERT_EQUAL((size_t)1, dtn::api::RegistrationIndex::deliver(create("dtn://remote/app", endpoint.getString())));
+}
@@ -0,0 +1,45 @@
+/*
+ * RegistrationIndexTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef REGISTRATIONINDEXTEST_H_
+#define REGISTRATIONINDEXTEST_H_
+
+class RegistrationIndexTest : public CppUnit::TestFixture
+{
+public:
+	void testDeliver();
+	void testUnsubscribe();
+	void testDetached();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(RegistrationIndexTest);
+	CPPUNIT_TEST(testDeliver);
+	CPPUNIT_TEST(testUnsubscribe);
+	CPPUNIT_TEST(testDetached);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* REGISTRATIONINDEXTEST_H_ */
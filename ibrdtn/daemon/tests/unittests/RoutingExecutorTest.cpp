@@ -0,0 +1,410 @@
+/*
+ * RoutingExecutorTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "RoutingExecutorTest.h"
+#include "routing/RoutingExecutor.h"
+#include "routing/RoutingExtension.h"
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <string>
+#include <vector>
+#include <set>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RoutingExecutorTest);
+
+// milliseconds to wait for the workers
+static const size_t WAIT_TIMEOUT = 5000;
+
+class TestTask : public dtn::routing::RoutingExecutor::Task
+{
+public:
+	TestTask(const std::string &name, const dtn::data::EID &peer, bool coalescable = false)
+	 : dtn::routing::RoutingExecutor::Task(peer), name(name), _coalescable(coalescable) { };
+
+	// creates an exclusive task
+	TestTask(const std::string &name)
+	 : name(name), _coalescable(false) { };
+
+	virtual ~TestTask() { };
+
+	std::string toString() { return name; };
+	bool isCoalescable() const { return _coalescable; };
+
+	const std::string name;
+
+private:
+	const bool _coalescable;
+};
+
+/**
+ * Records the processed tasks and holds them back until the gate is open
+ */
+class TestExtension : public dtn::routing::RoutingExtension
+{
+public:
+	TestExtension(dtn::routing::RoutingExecutor &executor)
+	 : running(0), max_running(0), violations(0), _executor(executor), _open(true) { };
+	virtual ~TestExtension() { };
+
+	void componentUp() throw () { };
+	void componentDown() throw () { };
+
+	void close()
+	{
+		ibrcommon::MutexLock l(_cond);
+		_open = false;
+	}
+
+	void open()
+	{
+		ibrcommon::MutexLock l(_cond);
+		_open = true;
+		_cond.signal(true);
+	}
+
+	/**
+	 * Wait until the given number of tasks has been processed
+	 */
+	bool awaitProcessed(const size_t count)
+	{
+		ibrcommon::MutexLock l(_cond);
+		try {
+			while (processed.size() < count) _cond.wait(WAIT_TIMEOUT);
+		} catch (const ibrcommon::Conditional::ConditionalAbortException&) {
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Wait until the given number of tasks is running
+	 */
+	bool awaitRunning(const size_t count)
+	{
+		ibrcommon::MutexLock l(_cond);
+		try {
+			while (running < count) _cond.wait(WAIT_TIMEOUT);
+		} catch (const ibrcommon::Conditional::ConditionalAbortException&) {
+			return false;
+		}
+		return true;
+	}
+
+	std::vector<std::string> processed;
+	size_t running;
+	size_t max_running;
+	size_t violations;
+
+protected:
+	void process(dtn::routing::RoutingExecutor::Task &t) throw ()
+	{
+		TestTask &task = dynamic_cast<TestTask&>(t);
+
+		{
+			ibrcommon::MutexLock l(_cond);
+
+			// exclusive tasks and tasks of the same peer must not overlap
+			if (task.isExclusive() && (running > 0)) violations++;
+			if (!task.isExclusive() && !_peers.insert(task.getPeer()).second) violations++;
+
+			running++;
+			if (running > max_running) max_running = running;
+			_cond.signal(true);
+
+			while (!_open) _cond.wait();
+		}
+
+		// give other tasks the chance to overlap
+		ibrcommon::Thread::sleep(10);
+
+		// a worker queues follow-up tasks without being blocked
+		if (task.name == "fork")
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				_executor.push(*this, new TestTask("child", task.getPeer()));
+			}
+		}
+
+		ibrcommon::MutexLock l(_cond);
+		if (!task.isExclusive()) _peers.erase(task.getPeer());
+		running--;
+		processed.push_back(task.name);
+		_cond.signal(true);
+	}
+
+private:
+	dtn::routing::RoutingExecutor &_executor;
+	ibrcommon::Conditional _cond;
+	std::set<dtn::data::EID> _peers;
+	bool _open;
+};
+
+/**
+ * Pushes a single task from a thread which is not a worker
+ */
+class TestProducer : public ibrcommon::JoinableThread
+{
+public:
+	TestProducer(dtn::routing::RoutingExecutor &executor, TestExtension &extension, TestTask *task)
+	 : done(false), _executor(executor), _extension(extension), _task(task) { };
+	virtual ~TestProducer() { };
+
+	volatile bool done;
+
+protected:
+	void run() throw ()
+	{
+		_executor.push(_extension, _task);
+		done = true;
+	}
+
+	void __cancellation() throw () { };
+
+private:
+	dtn::routing::RoutingExecutor &_executor;
+	TestExtension &_extension;
+	TestTask *_task;
+};
+
+/**
+ * Shuts down the executor while a task is running
+ */
+class TestShutdown : public ibrcommon::JoinableThread
+{
+public:
+	TestShutdown(dtn::routing::RoutingExecutor &executor)
+	 : _executor(executor) { };
+	virtual ~TestShutdown() { };
+
+protected:
+	void run() throw ()
+	{
+		_executor.shutdown();
+	}
+
+	void __cancellation() throw () { };
+
+private:
+	dtn::routing::RoutingExecutor &_executor;
+};
+
+void RoutingExecutorTest::setUp()
+{
+}
+
+void RoutingExecutorTest::tearDown()
+{
+}
+
+void RoutingExecutorTest::testLaneOrder()
+{
+	dtn::routing::RoutingExecutor executor(4);
+	TestExtension ext(executor);
+	executor.startup();
+
+	const dtn::data::EID peer("dtn://node-one");
+	const char* names[] = { "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7" };
+
+	for (int i = 0; i < 8; ++i)
+	{
+		executor.push(ext, new TestTask(names[i], peer));
+	}
+
+	CPPUNIT_ASSERT(ext.awaitProcessed(8));
+	executor.shutdown();
+
+	// the tasks of a peer are processed one after another in order
+	for (int i = 0; i < 8; ++i)
+	{
+		CPPUNIT_ASSERT_EQUAL(std::string(names[i]), ext.processed[i]);
+	}
+
+	CPPUNIT_ASSERT_EQUAL((size_t)1, ext.max_running);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, ext.violations);
+}
+
+void RoutingExecutorTest::testParallel()
+{
+	dtn::routing::RoutingExecutor executor(2);
+	TestExtension ext(executor);
+	executor.startup();
+	ext.close();
+
+	// the tasks of different peers run at the same time
+	executor.push(ext, new TestTask("a", dtn::data::EID("dtn://node-one")));
+	executor.push(ext, new TestTask("b", dtn::data::EID("dtn://node-two")));
+
+	CPPUNIT_ASSERT(ext.awaitRunning(2));
+	CPPUNIT_ASSERT_EQUAL((size_t)0, executor.size());
+
+	ext.open();
+	CPPUNIT_ASSERT(ext.awaitProcessed(2));
+	executor.shutdown();
+
+	CPPUNIT_ASSERT_EQUAL((size_t)0, ext.violations);
+}
+
+void RoutingExecutorTest::testCoalesce()
+{
+	dtn::routing::RoutingExecutor executor(1);
+	TestExtension ext(executor);
+	executor.startup();
+	ext.close();
+
+	const dtn::data::EID peer("dtn://node-one");
+
+	executor.push(ext, new TestTask("first", peer));
+	CPPUNIT_ASSERT(ext.awaitRunning(1));
+
+	// queued searches for the same peer are redundant
+	for (int i = 0; i < 5; ++i)
+	{
+		executor.push(ext, new TestTask("search", peer, true));
+	}
+
+	// the search of another peer is not
+	executor.push(ext, new TestTask("search", dtn::data::EID("dtn://node-two"), true));
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, executor.size());
+
+	ext.open();
+	CPPUNIT_ASSERT(ext.awaitProcessed(3));
+
+	// a new search is queued again once the previous one has been started
+	executor.push(ext, new TestTask("search", peer, true));
+	CPPUNIT_ASSERT(ext.awaitProcessed(4));
+
+	executor.shutdown();
+
+	CPPUNIT_ASSERT_EQUAL((size_t)4, ext.processed.size());
+}
+
+void RoutingExecutorTest::testExclusive()
+{
+	dtn::routing::RoutingExecutor executor(4);
+	TestExtension ext(executor);
+	executor.startup();
+	ext.close();
+
+	executor.push(ext, new TestTask("a", dtn::data::EID("dtn://node-one")));
+	executor.push(ext, new TestTask("b", dtn::data::EID("dtn://node-two")));
+	CPPUNIT_ASSERT(ext.awaitRunning(2));
+
+	// the exclusive task waits for the running tasks and holds back the new ones
+	executor.push(ext, new TestTask("update"));
+	executor.push(ext, new TestTask("c", dtn::data::EID("dtn://node-three")));
+	CPPUNIT_ASSERT_EQUAL((size_t)2, executor.size());
+
+	ext.open();
+	CPPUNIT_ASSERT(ext.awaitProcessed(4));
+	executor.shutdown();
+
+	CPPUNIT_ASSERT_EQUAL(std::string("update"), ext.processed[2]);
+	CPPUNIT_ASSERT_EQUAL(std::string("c"), ext.processed[3]);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, ext.violations);
+}
+
+void RoutingExecutorTest::testLimit()
+{
+	dtn::routing::RoutingExecutor executor(1, 2);
+	TestExtension ext(executor);
+	executor.startup();
+	ext.close();
+
+	const dtn::data::EID peer("dtn://node-one");
+
+	executor.push(ext, new TestTask("fork", peer));
+	CPPUNIT_ASSERT(ext.awaitRunning(1));
+
+	executor.push(ext, new TestTask("a1", peer));
+	executor.push(ext, new TestTask("a2", peer));
+	CPPUNIT_ASSERT_EQUAL((size_t)2, executor.size());
+
+	// other threads are blocked while the queue is full
+	TestProducer producer(executor, ext, new TestTask("a3", peer));
+	producer.start();
+
+	ibrcommon::Thread::sleep(50);
+	CPPUNIT_ASSERT(!producer.done);
+	CPPUNIT_ASSERT_EQUAL((size_t)2, executor.size());
+
+	// the worker queues its follow-up tasks beyond the limit
+	ext.open();
+	producer.join();
+	CPPUNIT_ASSERT(producer.done);
+
+	CPPUNIT_ASSERT(ext.awaitProcessed(7));
+	executor.shutdown();
+
+	CPPUNIT_ASSERT_EQUAL((size_t)7, ext.processed.size());
+}
+
+void RoutingExecutorTest::testPurge()
+{
+	dtn::routing::RoutingExecutor executor(1);
+	TestExtension ext1(executor);
+	TestExtension ext2(executor);
+	executor.startup();
+	ext1.close();
+
+	executor.push(ext1, new TestTask("a", dtn::data::EID("dtn://node-one")));
+	CPPUNIT_ASSERT(ext1.awaitRunning(1));
+
+	executor.push(ext1, new TestTask("b", dtn::data::EID("dtn://node-one")));
+	executor.push(ext2, new TestTask("c", dtn::data::EID("dtn://node-one")));
+	executor.push(ext2, new TestTask("d", dtn::data::EID("dtn://node-two")));
+	executor.push(ext2, new TestTask("update"));
+	CPPUNIT_ASSERT_EQUAL((size_t)4, executor.size());
+
+	// purge drops the queued tasks of one extension only
+	executor.purge(ext2);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, executor.size());
+
+	ext1.open();
+	CPPUNIT_ASSERT(ext1.awaitProcessed(2));
+
+	// queued tasks are dropped on shutdown and new tasks are not accepted
+	ext1.close();
+	executor.push(ext1, new TestTask("e", dtn::data::EID("dtn://node-one")));
+	CPPUNIT_ASSERT(ext1.awaitRunning(1));
+	executor.push(ext1, new TestTask("f", dtn::data::EID("dtn://node-one")));
+
+	TestShutdown shutdown(executor);
+	shutdown.start();
+
+	for (size_t i = 0; (executor.size() > 0) && (i < WAIT_TIMEOUT); ++i)
+	{
+		ibrcommon::Thread::sleep(1);
+	}
+
+	CPPUNIT_ASSERT_EQUAL((size_t)0, executor.size());
+
+	ext1.open();
+	shutdown.join();
+
+	executor.push(ext1, new TestTask("g", dtn::data::EID("dtn://node-one")));
+	CPPUNIT_ASSERT_EQUAL((size_t)0, executor.size());
+
+	CPPUNIT_ASSERT_EQUAL((size_t)3, ext1.processed.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, ext2.processed.size());
+}
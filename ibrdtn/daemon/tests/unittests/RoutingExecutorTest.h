@@ -0,0 +1,51 @@
+/*
+ * RoutingExecutorTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef ROUTINGEXECUTORTEST_H_
+#define ROUTINGEXECUTORTEST_H_
+
+class RoutingExecutorTest : public CppUnit::TestFixture
+{
+public:
+	void testLaneOrder();
+	void testParallel();
+	void testCoalesce();
+	void testExclusive();
+	void testLimit();
+	void testPurge();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(RoutingExecutorTest);
+	CPPUNIT_TEST(testLaneOrder);
+	CPPUNIT_TEST(testParallel);
+	CPPUNIT_TEST(testCoalesce);
+	CPPUNIT_TEST(testExclusive);
+	CPPUNIT_TEST(testLimit);
+	CPPUNIT_TEST(testPurge);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* ROUTINGEXECUTORTEST_H_ */
@@ -0,0 +1,223 @@
+/*
+ * SecurityProcessorTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "SecurityProcessorTest.h"
+#include "../tools/TestEventListener.h"
+
+#ifdef IBRDTN_SUPPORT_BSP
+#include "security/SecurityProcessor.h"
+#include "security/BundleVerifiedEvent.h"
+#include "net/ConvergenceLayer.h"
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/EID.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <sstream>
+#include <vector>
+#endif
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SecurityProcessorTest);
+
+#ifdef IBRDTN_SUPPORT_BSP
+class SecurityProcessorTestSubmitter : public ibrcommon::JoinableThread
+{
+public:
+	SecurityProcessorTestSubmitter(const dtn::data::Size count)
+	 : _count(count), accepted(0)
+	{ }
+
+	virtual ~SecurityProcessorTestSubmitter()
+	{
+		join();
+	}
+
+	void __cancellation() throw ()
+	{ }
+
+	void run() throw ()
+	{
+		const dtn::data::EID peer("dtn://peer");
+
+		for (dtn::data::Size i = 0; i < _count; ++i)
+		{
+			dtn::data::Bundle b;
+			b.source = peer;
+			b.destination = dtn::data::EID("dtn://local/test");
+
+			if (dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_VERIFY, peer, b)) accepted++;
+		}
+	}
+
+private:
+	const dtn::data::Size _count;
+
+public:
+	dtn::data::Size accepted;
+};
+
+static dtn::data::Size getStat(const std::string &key)
+{
+	dtn::net::ConvergenceLayer::stats_data data;
+	dtn::security::SecurityProcessor::getStats(data);
+
+	std::stringstream ss(data[key]);
+	dtn::data::Size ret = 0;
+	ss >> ret;
+	return ret;
+}
+
+static void waitForEvents(TestEventListener<dtn::security::BundleVerifiedEvent> &evtl, unsigned int count)
+{
+	try {
+		ibrcommon::MutexLock l(evtl.event_cond);
+		while (evtl.event_counter < count) evtl.event_cond.wait(20000);
+	} catch (const ibrcommon::Conditional::ConditionalAbortException&) {
+		CPPUNIT_FAIL("bundles not verified - timeout reached");
+	}
+}
+#endif
+
+void SecurityProcessorTest::setUp()
+{
+	_esl = new ibrtest::EventSwitchLoop();
+	_esl->start();
+}
+
+void SecurityProcessorTest::tearDown()
+{
+	_esl->stop();
+	_esl->join();
+	delete _esl;
+	_esl = NULL;
+}
+
+#ifdef IBRDTN_SUPPORT_BSP
+void SecurityProcessorTest::testSubmitStopped()
+{
+	dtn::data::Bundle b;
+	const dtn::data::EID peer("dtn://peer");
+
+	// without a running processor the caller has to process the bundle itself
+	CPPUNIT_ASSERT(!dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_VERIFY, peer, b));
+
+	dtn::security::SecurityProcessor p(2, 4);
+	p.initialize();
+	p.terminate();
+
+	CPPUNIT_ASSERT(!dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_VERIFY, peer, b));
+}
+
+void SecurityProcessorTest::testWorkerPool()
+{
+	TestEventListener<dtn::security::BundleVerifiedEvent> evtl;
+
+	dtn::security::SecurityProcessor p(4, 8);
+	p.initialize();
+
+	std::vector<SecurityProcessorTestSubmitter*> submitters;
+	for (int i = 0; i < 4; ++i)
+	{
+		SecurityProcessorTestSubmitter *s = new SecurityProcessorTestSubmitter(50);
+		submitters.push_back(s);
+		s->start();
+	}
+
+	for (std::vector<SecurityProcessorTestSubmitter*>::iterator it = submitters.begin(); it != submitters.end(); ++it)
+	{
+		(*it)->join();
+		CPPUNIT_ASSERT_EQUAL((dtn::data::Size)50, (*it)->accepted);
+		delete (*it);
+	}
+
+	// each accepted bundle is verified exactly once
+	waitForEvents(evtl, 200);
+
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)200, getStat("security|queued"));
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)0, getStat("security|failed"));
+
+	p.terminate();
+
+	CPPUNIT_ASSERT_EQUAL(200U, evtl.event_counter);
+}
+
+void SecurityProcessorTest::testBoundedQueue()
+{
+	TestEventListener<dtn::security::BundleVerifiedEvent> evtl;
+
+	// a single worker with two slots is overrun by the submitters
+	dtn::security::SecurityProcessor p(1, 2);
+	p.initialize();
+
+	std::vector<SecurityProcessorTestSubmitter*> submitters;
+	for (int i = 0; i < 4; ++i)
+	{
+		SecurityProcessorTestSubmitter *s = new SecurityProcessorTestSubmitter(50);
+		submitters.push_back(s);
+		s->start();
+	}
+
+	for (std::vector<SecurityProcessorTestSubmitter*>::iterator it = submitters.begin(); it != submitters.end(); ++it)
+	{
+		(*it)->join();
+		CPPUNIT_ASSERT_EQUAL((dtn::data::Size)50, (*it)->accepted);
+		delete (*it);
+	}
+
+	waitForEvents(evtl, 200);
+
+	// the queue never exceeds its limit, submitters were blocked instead
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)2, getStat("security|limit"));
+	CPPUNIT_ASSERT(getStat("security|max-pending") <= 2);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)200, getStat("security|queued"));
+
+	p.terminate();
+}
+
+void SecurityProcessorTest::testShutdown()
+{
+	TestEventListener<dtn::security::BundleVerifiedEvent> evtl;
+
+	dtn::security::SecurityProcessor p(1, 64);
+	p.initialize();
+
+	SecurityProcessorTestSubmitter s(64);
+	s.start();
+	s.join();
+
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)64, s.accepted);
+
+	// stop the processor while jobs are still pending
+	p.terminate();
+
+	// all accepted bundles have been processed before the workers left
+	waitForEvents(evtl, 64);
+	CPPUNIT_ASSERT_EQUAL(64U, evtl.event_counter);
+
+	// the processor does not accept new jobs
+	dtn::data::Bundle b;
+	CPPUNIT_ASSERT(!dtn::security::SecurityProcessor::submit(dtn::security::SecurityProcessor::OP_VERIFY, dtn::data::EID("dtn://peer"), b));
+}
+#else
+void SecurityProcessorTest::testSubmitStopped() { }
+void SecurityProcessorTest::testWorkerPool() { }
+void SecurityProcessorTest::testBoundedQueue() { }
+void SecurityProcessorTest::testShutdown() { }
+#endif
@@ -0,0 +1,54 @@
+/*
+ * SecurityProcessorTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <ibrdtn/ibrdtn.h>
+#include "../tools/EventSwitchLoop.h"
+
+#ifndef SECURITYPROCESSORTEST_H_
+#define SECURITYPROCESSORTEST_H_
+
+class SecurityProcessorTest : public CppUnit::TestFixture
+{
+public:
+	void testSubmitStopped();
+	void testWorkerPool();
+	void testBoundedQueue();
+	void testShutdown();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(SecurityProcessorTest);
+#ifdef IBRDTN_SUPPORT_BSP
+	CPPUNIT_TEST(testSubmitStopped);
+	CPPUNIT_TEST(testWorkerPool);
+	CPPUNIT_TEST(testBoundedQueue);
+	CPPUNIT_TEST(testShutdown);
+#endif
+	CPPUNIT_TEST_SUITE_END();
+
+private:
+	ibrtest::EventSwitchLoop *_esl;
+};
+
+#endif /* SECURITYPROCESSORTEST_H_ */
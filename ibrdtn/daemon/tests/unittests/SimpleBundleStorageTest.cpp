@@ -0,0 +1,205 @@
+/*
+ * SimpleBundleStorageTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "SimpleBundleStorageTest.h"
+#include <ibrdtn/utils/Clock.h>
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/thread/Thread.h>
+#include <fstream>
+#include <list>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SimpleBundleStorageTest);
+
+// creation time of all test bundles
+static dtn::data::Timestamp test_timestamp = 0;
+
+void SimpleBundleStorageTest::setUp()
+{
+	_path = ibrcommon::File("/tmp/bundle-simple-unittest");
+	if (_path.exists()) _path.remove(true);
+	ibrcommon::File::createDirectory(_path);
+
+	test_timestamp = dtn::utils::Clock::getTime();
+}
+
+void SimpleBundleStorageTest::tearDown()
+{
+	_path.remove(true);
+}
+
+dtn::data::Bundle SimpleBundleStorageTest::createBundle(int num)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+	b.lifetime = 3600;
+	b.timestamp = test_timestamp;
+	b.sequencenumber = num;
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	(*ref.iostream()) << "bundle-" << num << std::endl;
+	b.push_back(ref);
+
+	return b;
+}
+
+bool SimpleBundleStorageTest::waitForCount(dtn::storage::BundleStorage &storage, dtn::data::Size count)
+{
+	for (int i = 0; i < 100; ++i)
+	{
+		if (storage.count() == count) return true;
+		ibrcommon::Thread::sleep(50);
+	}
+	return false;
+}
+
+void SimpleBundleStorageTest::testSnapshot()
+{
+	dtn::storage::SimpleBundleStorage storage(_path);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 20; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	storage.terminate();
+
+	// the meta data has been written on shutdown
+	CPPUNIT_ASSERT(_path.get(".snapshot").exists());
+
+	storage.initialize();
+	storage.startup();
+
+	// the snapshot is consumed on startup
+	CPPUNIT_ASSERT(!_path.get(".snapshot").exists());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)20, storage.count());
+
+	for (int i = 0; i < 20; ++i)
+	{
+		const dtn::data::Bundle b = storage.get(createBundle(i));
+		CPPUNIT_ASSERT(b.destination == dtn::data::EID("dtn://node-two/test"));
+	}
+
+	storage.terminate();
+}
+
+void SimpleBundleStorageTest::testSnapshotValidation()
+{
+	dtn::storage::SimpleBundleStorage storage(_path);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 10; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	storage.terminate();
+
+	// keep the snapshot of the first ten bundles
+	{
+		std::ifstream in(_path.get(".snapshot").getPath().c_str(), std::ios::binary);
+		std::ofstream out("/tmp/bundle-simple-snapshot", std::ios::binary | std::ios::trunc);
+		out << in.rdbuf();
+	}
+
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 10; i < 15; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	storage.terminate();
+
+	// restore the outdated snapshot, the last five bundles are not listed
+	{
+		std::ifstream in("/tmp/bundle-simple-snapshot", std::ios::binary);
+		std::ofstream out(_path.get(".snapshot").getPath().c_str(), std::ios::binary | std::ios::trunc);
+		out << in.rdbuf();
+	}
+	ibrcommon::File("/tmp/bundle-simple-snapshot").remove();
+
+	// delete the data of one bundle
+	{
+		std::list<ibrcommon::File> dirs;
+		_path.getFiles(dirs);
+
+		bool deleted = false;
+		for (std::list<ibrcommon::File>::iterator it = dirs.begin(); !deleted && (it != dirs.end()); ++it)
+		{
+			if ((*it).isSystem() || !(*it).isDirectory()) continue;
+
+			std::list<ibrcommon::File> files;
+			(*it).getFiles(files);
+
+			for (std::list<ibrcommon::File>::iterator f = files.begin(); f != files.end(); ++f)
+			{
+				if ((*f).isSystem()) continue;
+				(*f).remove();
+				deleted = true;
+				break;
+			}
+		}
+
+		CPPUNIT_ASSERT(deleted);
+	}
+
+	storage.initialize();
+	storage.startup();
+
+	// one bundle is missing, five bundles are recovered
+	CPPUNIT_ASSERT(waitForCount(storage, 14));
+
+	storage.terminate();
+}
+
+void SimpleBundleStorageTest::testParallelRecovery()
+{
+	dtn::storage::SimpleBundleStorage storage(_path, 0, 0, 4);
+	storage.initialize();
+	storage.startup();
+
+	for (int i = 0; i < 200; ++i)
+	{
+		storage.store(createBundle(i));
+	}
+
+	storage.terminate();
+
+	// read all files without the snapshot
+	_path.get(".snapshot").remove();
+
+	storage.initialize();
+	storage.startup();
+
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Size)200, storage.count());
+
+	for (int i = 0; i < 200; i += 10)
+	{
+		CPPUNIT_ASSERT(storage.contains(createBundle(i)));
+	}
+
+	storage.terminate();
+}
@@ -0,0 +1,57 @@
+/*
+ * SimpleBundleStorageTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "storage/SimpleBundleStorage.h"
+#include <ibrdtn/data/Bundle.h>
+
+#ifndef SIMPLEBUNDLESTORAGETEST_H_
+#define SIMPLEBUNDLESTORAGETEST_H_
+
+class SimpleBundleStorageTest : public CppUnit::TestFixture
+{
+public:
+	void testSnapshot();
+	void testSnapshotValidation();
+	void testParallelRecovery();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(SimpleBundleStorageTest);
+	CPPUNIT_TEST(testSnapshot);
+	CPPUNIT_TEST(testSnapshotValidation);
+	CPPUNIT_TEST(testParallelRecovery);
+	CPPUNIT_TEST_SUITE_END();
+
+private:
+	static dtn::data::Bundle createBundle(int num);
+
+	/**
+	 * Wait until the storage contains the given number of bundles
+	 */
+	static bool waitForCount(dtn::storage::BundleStorage &storage, dtn::data::Size count);
+
+	ibrcommon::File _path;
+};
+
+#endif /* SIMPLEBUNDLESTORAGETEST_H_ */
@@ -0,0 +1,139 @@
+/*
+ * StaticRouteTableTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "config.h"
+#include "StaticRouteTableTest.h"
+#include "routing/StaticRouteTable.h"
+#include "routing/StaticEIDRoute.h"
+
+#ifdef HAVE_REGEX_H
+#include "routing/StaticRegexRoute.h"
+#endif
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StaticRouteTableTest);
+
+void StaticRouteTableTest::setUp()
+{
+}
+
+void StaticRouteTableTest::tearDown()
+{
+}
+
+void StaticRouteTableTest::testHostRoute()
+{
+	dtn::routing::StaticRouteTable table;
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw1")));
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://beta/app"), dtn::data::EID("dtn://gw2")));
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.size());
+
+	// host routes match all endpoints of the host
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://alpha/test")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://beta")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.match(dtn::data::EID("dtn://gamma/test")).size());
+
+	CPPUNIT_ASSERT(table.hasNexthop(dtn::data::EID("dtn://gw1")));
+	CPPUNIT_ASSERT(!table.hasNexthop(dtn::data::EID("dtn://gw3")));
+
+	CPPUNIT_ASSERT(table.match(dtn::data::EID("dtn://alpha/test"), dtn::data::EID("dtn://gw1")));
+	CPPUNIT_ASSERT(!table.match(dtn::data::EID("dtn://alpha/test"), dtn::data::EID("dtn://gw2")));
+}
+
+void StaticRouteTableTest::testRegexRoute()
+{
+#ifdef HAVE_REGEX_H
+	dtn::routing::StaticRouteTable table;
+	table.add(new dtn::routing::StaticRegexRoute("^dtn://region-1/.*", dtn::data::EID("dtn://gw1")));
+	table.add(new dtn::routing::StaticRegexRoute("^dtn://region-[23]/.*", dtn::data::EID("dtn://gw2")));
+	table.add(new dtn::routing::StaticRegexRoute("/telemetry$", dtn::data::EID("dtn://gw3")));
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://region-1"), dtn::data::EID("dtn://gw4")));
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.match(dtn::data::EID("dtn://region-1/node")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://region-3/node")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.match(dtn::data::EID("dtn://region-2/telemetry")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.match(dtn::data::EID("dtn://region-4/node")).size());
+
+	// a second lookup is served by the cache
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.match(dtn::data::EID("dtn://region-1/node")).size());
+
+	CPPUNIT_ASSERT(table.match(dtn::data::EID("dtn://region-2/telemetry"), dtn::data::EID("dtn://gw3")));
+	CPPUNIT_ASSERT(!table.match(dtn::data::EID("dtn://region-2/telemetry"), dtn::data::EID("dtn://gw1")));
+#endif
+}
+
+void StaticRouteTableTest::testRegexAlternation()
+{
+#ifdef HAVE_REGEX_H
+	// an alternation has no common literal prefix
+	dtn::routing::StaticRegexRoute route("^dtn://abc\\|^dtn://xyz", dtn::data::EID("dtn://gw1"));
+	CPPUNIT_ASSERT_EQUAL(std::string(""), route.getPrefix());
+
+	dtn::routing::StaticRouteTable table;
+	table.add(new dtn::routing::StaticRegexRoute("^dtn://abc\\|^dtn://xyz", dtn::data::EID("dtn://gw1")));
+	table.add(new dtn::routing::StaticRegexRoute("^dtn://abc/.*", dtn::data::EID("dtn://gw2")));
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.match(dtn::data::EID("dtn://abc/app")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://xyz/app")).size());
+	CPPUNIT_ASSERT(table.match(dtn::data::EID("dtn://xyz/app"), dtn::data::EID("dtn://gw1")));
+#endif
+}
+
+void StaticRouteTableTest::testReplaceRemove()
+{
+	dtn::routing::StaticRouteTable table;
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw1")));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://alpha/test")).size());
+
+	// adding an equal route replaces the existing one
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw1")));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://alpha/test")).size());
+
+	// cached results are invalidated on changes
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw2")));
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.match(dtn::data::EID("dtn://alpha/test")).size());
+
+	dtn::routing::StaticEIDRoute route(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw1"));
+	table.remove(route);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.size());
+	CPPUNIT_ASSERT(!table.hasNexthop(dtn::data::EID("dtn://gw1")));
+	CPPUNIT_ASSERT(table.match(dtn::data::EID("dtn://alpha/test"), dtn::data::EID("dtn://gw2")));
+
+	table.clear();
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.match(dtn::data::EID("dtn://alpha/test")).size());
+}
+
+void StaticRouteTableTest::testExpire()
+{
+	dtn::routing::StaticRouteTable table;
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://alpha"), dtn::data::EID("dtn://gw1"), 10));
+	table.add(new dtn::routing::StaticEIDRoute(dtn::data::EID("dtn://beta"), dtn::data::EID("dtn://gw1"), 20));
+
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(10), table.expire(5));
+	CPPUNIT_ASSERT_EQUAL((size_t)2, table.size());
+
+	CPPUNIT_ASSERT_EQUAL(dtn::data::Timestamp(20), table.expire(15));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.size());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, table.match(dtn::data::EID("dtn://alpha/test")).size());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, table.match(dtn::data::EID("dtn://beta/test")).size());
+}
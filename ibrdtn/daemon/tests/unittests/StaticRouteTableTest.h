@@ -0,0 +1,49 @@
+/*
+ * StaticRouteTableTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef STATICROUTETABLETEST_H_
+#define STATICROUTETABLETEST_H_
+
+class StaticRouteTableTest : public CppUnit::TestFixture
+{
+public:
+	void testHostRoute();
+	void testRegexRoute();
+	void testRegexAlternation();
+	void testReplaceRemove();
+	void testExpire();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(StaticRouteTableTest);
+	CPPUNIT_TEST(testHostRoute);
+	CPPUNIT_TEST(testRegexRoute);
+	CPPUNIT_TEST(testRegexAlternation);
+	CPPUNIT_TEST(testReplaceRemove);
+	CPPUNIT_TEST(testExpire);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* STATICROUTETABLETEST_H_ */
@@ -0,0 +1,116 @@
+/*
+ * StripeSchedulerTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "StripeSchedulerTest.h"
+#include "net/StripeScheduler.h"
+#include <ibrdtn/data/Bundle.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StripeSchedulerTest);
+
+void StripeSchedulerTest::setUp()
+{
+}
+
+void StripeSchedulerTest::tearDown()
+{
+}
+
+void StripeSchedulerTest::testDistributeEqual()
+{
+	// paths without a measurement get the same share
+	std::vector<double> throughputs(2, 0.0);
+	std::vector<dtn::data::Length> shares;
+
+	dtn::net::StripeScheduler::distribute(10001, throughputs, 100, shares);
+
+	CPPUNIT_ASSERT_EQUAL((size_t)2, shares.size());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)5000, shares[0]);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)5001, shares[1]);
+}
+
+void StripeSchedulerTest::testDistributeWeighted()
+{
+	std::vector<double> throughputs;
+	throughputs.push_back(3000.0);
+	throughputs.push_back(1000.0);
+	throughputs.push_back(0.0);
+
+	std::vector<dtn::data::Length> shares;
+	dtn::net::StripeScheduler::distribute(10300, throughputs, 100, shares);
+
+	// the unknown path is weighted with the average of 2000
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)(100 + 5000), shares[0]);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)(100 + 1666), shares[1]);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)10300, shares[0] + shares[1] + shares[2]);
+}
+
+void StripeSchedulerTest::testDistributeSmall()
+{
+	std::vector<double> throughputs;
+	throughputs.push_back(1000.0);
+	throughputs.push_back(2000.0);
+	throughputs.push_back(3000.0);
+
+	std::vector<dtn::data::Length> shares;
+	dtn::net::StripeScheduler::distribute(250, throughputs, 100, shares);
+
+	// the slowest path is dropped to keep the minimal share
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)0, shares[0]);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)120, shares[1]);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)130, shares[2]);
+}
+
+void StripeSchedulerTest::testPath()
+{
+	dtn::net::StripeScheduler scheduler;
+	refcnt_ptr<dtn::net::StripePath> path = scheduler.getPath(dtn::data::EID("dtn://node-two"), dtn::core::Node::CONN_TCPIP);
+
+	CPPUNIT_ASSERT(path == scheduler.getPath(dtn::data::EID("dtn://node-two"), dtn::core::Node::CONN_TCPIP));
+	CPPUNIT_ASSERT(!(path == scheduler.getPath(dtn::data::EID("dtn://node-two"), dtn::core::Node::CONN_UDPIP)));
+
+	// 1000 bytes in one millisecond
+	CPPUNIT_ASSERT_EQUAL(0.0, path->getThroughput());
+	path->record(1000, 1000);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1000000.0, path->getThroughput(), 1.0);
+
+	// the estimate follows new measurements smoothly
+	path->record(1000, 2000);
+	CPPUNIT_ASSERT(path->getThroughput() < 1000000.0);
+	CPPUNIT_ASSERT(path->getThroughput() > 500000.0);
+}
+
+void StripeSchedulerTest::testStripe()
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+
+	dtn::net::StripeScheduler scheduler;
+	const dtn::net::BundleTransfer job(dtn::data::EID("dtn://node-two"), dtn::data::MetaBundle::create(b));
+	const dtn::net::BundleTransfer stripe(job, 100, 200, scheduler.getPath(dtn::data::EID("dtn://node-two"), dtn::core::Node::CONN_TCPIP));
+
+	CPPUNIT_ASSERT(!job.isStripe());
+	CPPUNIT_ASSERT(stripe.isStripe());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)100, stripe.getOffset());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)200, stripe.getLength());
+	CPPUNIT_ASSERT(stripe.getBundle() == job.getBundle());
+	CPPUNIT_ASSERT(stripe.getNeighbor() == job.getNeighbor());
+}
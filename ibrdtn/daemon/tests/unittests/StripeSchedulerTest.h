@@ -0,0 +1,49 @@
+/*
+ * StripeSchedulerTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef STRIPESCHEDULERTEST_H_
+#define STRIPESCHEDULERTEST_H_
+
+class StripeSchedulerTest : public CppUnit::TestFixture
+{
+public:
+	void testDistributeEqual();
+	void testDistributeWeighted();
+	void testDistributeSmall();
+	void testPath();
+	void testStripe();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(StripeSchedulerTest);
+	CPPUNIT_TEST(testDistributeEqual);
+	CPPUNIT_TEST(testDistributeWeighted);
+	CPPUNIT_TEST(testDistributeSmall);
+	CPPUNIT_TEST(testPath);
+	CPPUNIT_TEST(testStripe);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* STRIPESCHEDULERTEST_H_ */
@@ -0,0 +1,171 @@
+/*
+ * TransmissionSchedulerTest.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "TransmissionSchedulerTest.h"
+#include "net/TransmissionScheduler.h"
+#include <ibrdtn/data/Bundle.h>
+#include <string>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TransmissionSchedulerTest);
+
+static dtn::net::BundleTransfer createTransfer(const int priority, const dtn::data::Length &payload = 0)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+	b.set(dtn::data::PrimaryBlock::PRIORITY_BIT1, priority == 0);
+	b.set(dtn::data::PrimaryBlock::PRIORITY_BIT2, priority == 1);
+
+	dtn::data::MetaBundle meta = dtn::data::MetaBundle::create(b);
+	meta.setPayloadLength(payload);
+
+	return dtn::net::BundleTransfer(dtn::data::EID("dtn://node-two"), meta);
+}
+
+void TransmissionSchedulerTest::setUp()
+{
+}
+
+void TransmissionSchedulerTest::tearDown()
+{
+}
+
+void TransmissionSchedulerTest::testClass()
+{
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_BULK, dtn::net::TransmissionScheduler::getClass(createTransfer(-1).getBundle()));
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_NORMAL, dtn::net::TransmissionScheduler::getClass(createTransfer(0).getBundle()));
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_EXPEDITED, dtn::net::TransmissionScheduler::getClass(createTransfer(1).getBundle()));
+
+	CPPUNIT_ASSERT_EQUAL(std::string("expedited"), dtn::net::TransmissionScheduler::getName(dtn::net::TransmissionScheduler::CLASS_EXPEDITED));
+}
+
+void TransmissionSchedulerTest::testFifo()
+{
+	dtn::net::TransmissionScheduler scheduler;
+
+	// jobs of the same class leave the scheduler in order
+	for (int i = 1; i <= 5; ++i)
+	{
+		scheduler.push(dtn::net::TransmissionScheduler::Job(createTransfer(0, 1000), i));
+	}
+
+	CPPUNIT_ASSERT_EQUAL((size_t)5, scheduler.size());
+
+	for (int i = 1; i <= 5; ++i)
+	{
+		CPPUNIT_ASSERT_EQUAL((dtn::data::Length)i, scheduler.pop().offset);
+	}
+
+	CPPUNIT_ASSERT_EQUAL((size_t)0, scheduler.size());
+}
+
+void TransmissionSchedulerTest::testDeficitRoundRobin()
+{
+	// a quantum of 100 bytes allows one bulk job per round
+	dtn::net::TransmissionScheduler scheduler(100);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		scheduler.push(dtn::net::TransmissionScheduler::Job(createTransfer(-1, 100)));
+		scheduler.push(dtn::net::TransmissionScheduler::Job(createTransfer(0, 100)));
+		scheduler.push(dtn::net::TransmissionScheduler::Job(createTransfer(1, 100)));
+	}
+
+	// each round sends four expedited, two normal and one bulk job
+	const dtn::net::TransmissionScheduler::CLASS round[] = {
+			dtn::net::TransmissionScheduler::CLASS_EXPEDITED,
+			dtn::net::TransmissionScheduler::CLASS_EXPEDITED,
+			dtn::net::TransmissionScheduler::CLASS_EXPEDITED,
+			dtn::net::TransmissionScheduler::CLASS_EXPEDITED,
+			dtn::net::TransmissionScheduler::CLASS_NORMAL,
+			dtn::net::TransmissionScheduler::CLASS_NORMAL,
+			dtn::net::TransmissionScheduler::CLASS_BULK
+	};
+
+	for (int r = 0; r < 2; ++r)
+	{
+		for (int i = 0; i < 7; ++i)
+		{
+			CPPUNIT_ASSERT_EQUAL(round[i], scheduler.pop().priority);
+		}
+	}
+
+	// the remaining normal and bulk jobs share the link
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_NORMAL, scheduler.pop().priority);
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_NORMAL, scheduler.pop().priority);
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_BULK, scheduler.pop().priority);
+}
+
+void TransmissionSchedulerTest::testSegments()
+{
+	dtn::net::TransmissionScheduler scheduler(1000);
+
+	// a large bulk bundle sent in segments of 1000 bytes
+	const dtn::net::BundleTransfer large = createTransfer(-1, 10000);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)1000, dtn::net::TransmissionScheduler::Job(large, 0, 1000).getCost());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)500, dtn::net::TransmissionScheduler::Job(large, 9500, 1000).getCost());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)10000, dtn::net::TransmissionScheduler::Job(large).getCost());
+
+	scheduler.push(dtn::net::TransmissionScheduler::Job(large, 0, 1000));
+
+	dtn::net::TransmissionScheduler::Job job = scheduler.pop();
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)0, job.offset);
+
+	// an expedited bundle arrives during the first segment
+	scheduler.push(dtn::net::TransmissionScheduler::Job(createTransfer(1, 1000)));
+
+	// the remaining payload is scheduled after the segment
+	scheduler.push(dtn::net::TransmissionScheduler::Job(job.transfer, job.offset + job.length, job.length));
+
+	// the expedited bundle preempts the bulk bundle
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_EXPEDITED, scheduler.pop().priority);
+
+	job = scheduler.pop();
+	CPPUNIT_ASSERT_EQUAL(dtn::net::TransmissionScheduler::CLASS_BULK, job.priority);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)1000, job.offset);
+}
+
+void TransmissionSchedulerTest::testAbort()
+{
+	dtn::net::TransmissionScheduler scheduler;
+	scheduler.abort();
+
+	CPPUNIT_ASSERT_THROW(scheduler.pop(), ibrcommon::QueueUnblockedException);
+}
+
+void TransmissionSchedulerTest::testRefused()
+{
+	dtn::net::TransmissionScheduler scheduler(1000);
+
+	const dtn::net::BundleTransfer large = createTransfer(-1, 10000);
+	scheduler.push(dtn::net::TransmissionScheduler::Job(large, 0, 1000));
+
+	dtn::net::TransmissionScheduler::Job job = scheduler.pop();
+	scheduler.push(dtn::net::TransmissionScheduler::Job(job.transfer, job.offset + job.length, job.length));
+
+	// the peer refuses the first segment
+	job.transfer.abort(dtn::net::TransferAbortedEvent::REASON_REFUSED);
+
+	// the remaining segment shares the state of the transfer and is dropped by the sender
+	job = scheduler.pop();
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)1000, job.offset);
+	CPPUNIT_ASSERT(job.transfer.isAborted());
+}
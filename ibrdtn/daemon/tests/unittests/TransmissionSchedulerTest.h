@@ -0,0 +1,51 @@
+/*
+ * TransmissionSchedulerTest.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TRANSMISSIONSCHEDULERTEST_H_
+#define TRANSMISSIONSCHEDULERTEST_H_
+
+class TransmissionSchedulerTest : public CppUnit::TestFixture
+{
+public:
+	void testClass();
+	void testFifo();
+	void testDeficitRoundRobin();
+	void testSegments();
+	void testAbort();
+	void testRefused();
+
+	void setUp();
+	void tearDown();
+
+	CPPUNIT_TEST_SUITE(TransmissionSchedulerTest);
+	CPPUNIT_TEST(testClass);
+	CPPUNIT_TEST(testFifo);
+	CPPUNIT_TEST(testDeficitRoundRobin);
+	CPPUNIT_TEST(testSegments);
+	CPPUNIT_TEST(testAbort);
+	CPPUNIT_TEST(testRefused);
+	CPPUNIT_TEST_SUITE_END();
+};
+
+#endif /* TRANSMISSIONSCHEDULERTEST_H_ */
@@ -28,6 +28,7 @@
 #include <ibrcommon/net/socketstream.h>
 #include <ibrcommon/Logger.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -74,7 +75,8 @@ namespace dtn
 				IBRCOMMON_LOGGER_TAG("Client::AsyncReceiver", error) << "IOException: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 				_client.shutdown(CONNECTION_SHUTDOWN_ERROR);
 			} catch (const dtn::InvalidDataException &ex) {
-				if (_running) {
+				// a bundle truncated by a closed stream is not an error
+				if (_running && _client.good()) {
 					IBRCOMMON_LOGGER_TAG("Client::AsyncReceiver", error) << "InvalidDataException: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 					_client.shutdown(CONNECTION_SHUTDOWN_ERROR);
 				}
@@ -84,21 +86,73 @@ namespace dtn
 			}
 		}
 
+		Client::AsyncSender::AsyncSender(Client &client)
+		 : _client(client)
+		{
+		}
+
+		Client::AsyncSender::~AsyncSender()
+		{
+		}
+
+		void Client::AsyncSender::__cancellation() throw ()
+		{
+			_client._outqueue.abort();
+		}
+
+		void Client::AsyncSender::run() throw ()
+		{
+			try {
+				while (true)
+				{
+					// wait for the next submitted bundle
+					dtn::data::Bundle b = _client._outqueue.poll();
+
+					ibrcommon::MutexLock l(_client._send_lock);
+					_client.__send(b, true);
+
+					// send further bundles without flushing the stream in between
+					dtn::data::Size batch = 1;
+					try {
+						while (batch < _client._batch_size)
+						{
+							dtn::data::Bundle next = _client._outqueue.take();
+							_client.__send(next, true);
+							batch++;
+						}
+					} catch (const ibrcommon::QueueUnblockedException&) {
+						// no more bundles queued
+					}
+
+					// one flush for the whole batch
+					_client.flush();
+				}
+			} catch (const ibrcommon::QueueUnblockedException&) {
+				// sender has been stopped
+			} catch (const std::exception &ex) {
+				IBRCOMMON_LOGGER_TAG("Client::AsyncSender", error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+				_client.shutdown(CONNECTION_SHUTDOWN_ERROR);
+			}
+		}
+
 		Client::Client(const std::string &app, const dtn::data::EID &group, ibrcommon::socketstream &stream, const COMMUNICATION_MODE mode)
-		  : StreamConnection(*this, stream), lastack(0), _stream(stream), _mode(mode), _app(app), _group(group), _receiver(*this)
+		  : StreamConnection(*this, stream), lastack(0), _stream(stream), _mode(mode), _app(app), _group(group), _receiver(*this),
+		    _sender(*this), _inflight(0), _inflight_limit(0), _batch_size(64), _aborted(false)
 		{
 		}
 
 		Client::Client(const std::string &app, ibrcommon::socketstream &stream, const COMMUNICATION_MODE mode)
-		  : StreamConnection(*this, stream), lastack(0), _stream(stream), _mode(mode), _app(app), _group(), _receiver(*this)
+		  : StreamConnection(*this, stream), lastack(0), _stream(stream), _mode(mode), _app(app), _group(), _receiver(*this),
+		    _sender(*this), _inflight(0), _inflight_limit(0), _batch_size(64), _aborted(false)
 		{
 		}
 
 		Client::~Client()
 		{
 			try {
-				// stop the receiver
+				// stop the receiver and the sender
 				_receiver.stop();
+				_sender.stop();
 			} catch (const ibrcommon::ThreadException &ex) {
 				IBRCOMMON_LOGGER_DEBUG_TAG("Client", 20) << "ThreadException in Client destructor: " << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
@@ -106,8 +160,9 @@ namespace dtn
 			// Close the stream. This releases all reading or writing threads.
 			_stream.close();
 
-			// wait until the async thread has been finished
+			// wait until the async threads have been finished
 			_receiver.join();
+			_sender.join();
 		}
 
 		void Client::connect()
@@ -151,10 +206,24 @@ namespace dtn
 			} catch (const ibrcommon::ThreadException &ex) {
 				IBRCOMMON_LOGGER_TAG("Client", error) << "failed to start Client::Receiver\n" << ex.what() << IBRCOMMON_LOGGER_ENDL;
 			}
+
+			try {
+				// run the sender for submitted bundles
+				_sender.start();
+			} catch (const ibrcommon::ThreadException &ex) {
+				IBRCOMMON_LOGGER_TAG("Client", error) << "failed to start Client::Sender\n" << ex.what() << IBRCOMMON_LOGGER_ENDL;
+			}
 		}
 
 		void Client::close()
 		{
+			try {
+				// wait until all submitted bundles are completed
+				drain();
+			} catch (const ConnectionException&) {
+				// connection is already down
+			}
+
 			// shutdown the bundle stream connection
 			shutdown(StreamConnection::CONNECTION_SHUTDOWN_SIMPLE_SHUTDOWN);
 		}
@@ -170,6 +239,27 @@ namespace dtn
 		void Client::eventConnectionDown() throw ()
 		{
 			_inqueue.abort();
+			_outqueue.abort();
+
+			std::queue<sent_entry> lost;
+
+			{
+				ibrcommon::MutexLock l(_inflight_cond);
+				_aborted = true;
+
+				// all bundles without completion are lost
+				std::swap(lost, _sent);
+
+				_inflight = 0;
+				_inflight_cond.signal(true);
+			}
+
+			// report outside of the lock, the callback may use the client
+			while (!lost.empty())
+			{
+				eventBundleCompleted(lost.front().first, false);
+				lost.pop();
+			}
 
 			try {
 				_receiver.stop();
@@ -183,6 +273,52 @@ namespace dtn
 			lastack = ack;
 		}
 
+		void Client::eventBundleRefused() throw ()
+		{
+			__completed(false);
+		}
+
+		void Client::eventBundleForwarded() throw ()
+		{
+			__completed(true);
+		}
+
+		void Client::__completed(bool accepted) throw ()
+		{
+			sent_entry e;
+
+			{
+				ibrcommon::MutexLock l(_inflight_cond);
+				if (_sent.empty()) return;
+
+				// bundles are acknowledged in the order they have been sent
+				e = _sent.front();
+				_sent.pop();
+
+				if (e.second && (_inflight > 0)) _inflight--;
+				_inflight_cond.signal(true);
+			}
+
+			// report outside of the lock, the callback may use the client
+			eventBundleCompleted(e.first, accepted);
+		}
+
+		void Client::__send(const dtn::data::Bundle &b, bool submitted)
+		{
+			// remember the bundle before the acknowledgement can arrive
+			{
+				ibrcommon::MutexLock l(_inflight_cond);
+				_sent.push(sent_entry(b, submitted));
+			}
+
+			// To send a bundle, we construct a default serializer. Such a serializer convert
+			// the bundle data to the standardized form as byte stream.
+			dtn::data::DefaultSerializer(*this) << b;
+
+			// mark the end of the bundle, but leave the flush to the caller
+			commit();
+		}
+
 		void Client::received(const dtn::data::Bundle &b)
 		{
 			// if we are in send only mode...
@@ -196,9 +332,8 @@ namespace dtn
 
 		void Client::operator<<(const dtn::data::Bundle &b)
 		{
-			// To send a bundle, we construct a default serializer. Such a serializer convert
-			// the bundle data to the standardized form as byte stream.
-			dtn::data::DefaultSerializer(*this) << b;
+			ibrcommon::MutexLock l(_send_lock);
+			__send(b, false);
 
 			// Since this method is used to serialize bundles into an StreamConnection, we need to call
 			// a flush on the StreamConnection. This signals the stream to set the bundle end flag on
@@ -206,6 +341,51 @@ namespace dtn
 			flush();
 		}
 
+		void Client::submit(const dtn::data::Bundle &b) throw (ConnectionException)
+		{
+			{
+				ibrcommon::MutexLock l(_inflight_cond);
+				while (!_aborted && (_inflight_limit > 0) && (_inflight >= _inflight_limit))
+				{
+					_inflight_cond.wait();
+				}
+
+				if (_aborted) throw ConnectionAbortedException("connection is down");
+				_inflight++;
+			}
+
+			_outqueue.push(b);
+		}
+
+		void Client::drain() throw (ConnectionException)
+		{
+			ibrcommon::MutexLock l(_inflight_cond);
+			while (!_aborted && (_inflight > 0))
+			{
+				_inflight_cond.wait();
+			}
+
+			if (_aborted && (_inflight > 0)) throw ConnectionAbortedException("connection is down");
+		}
+
+		void Client::setInflightLimit(const dtn::data::Size limit)
+		{
+			ibrcommon::MutexLock l(_inflight_cond);
+			_inflight_limit = limit;
+			_inflight_cond.signal(true);
+		}
+
+		void Client::setBatchSize(const dtn::data::Size size)
+		{
+			_batch_size = (size > 0) ? size : 1;
+		}
+
+		dtn::data::Size Client::getInflight()
+		{
+			ibrcommon::MutexLock l(_inflight_cond);
+			return _inflight;
+		}
+
 		dtn::data::Bundle Client::getBundle(const dtn::data::Timeout timeout) throw (ConnectionException)
 		{
 			try {
@@ -30,6 +30,9 @@
 #include <ibrcommon/thread/MutexLock.h>
 #include <ibrcommon/Exceptions.h>
 #include <ibrcommon/thread/Queue.h>
+#include <ibrcommon/thread/Conditional.h>
+#include "ibrdtn/data/BundleID.h"
+#include <queue>
 
 namespace dtn
 {
@@ -124,6 +127,25 @@ namespace dtn
 				bool _running;
 			};
 
+			/**
+			 * This sub-class sends the bundles submitted with submit(). Bundles
+			 * are written back-to-back and the stream is flushed once the submit
+			 * queue is empty or the batch size is reached.
+			 */
+			class AsyncSender : public ibrcommon::JoinableThread
+			{
+			public:
+				AsyncSender(Client &client);
+				virtual ~AsyncSender();
+
+			protected:
+				void run() throw ();
+				void __cancellation() throw ();
+
+			private:
+				Client &_client;
+			};
+
 		public:
 			/**
 			 * This are the communication flags.
@@ -210,21 +232,62 @@ namespace dtn
 
 			/**
 			 * The bundle refused event callback method can overloaded to handle
-			 * a bundle refused by the porresponding daemon.
+			 * a bundle refused by the porresponding daemon. If you overload this
+			 * method, you must call the super method.
 			 */
-			virtual void eventBundleRefused() throw () {};
+			virtual void eventBundleRefused() throw ();
 
 			/**
 			 * The bundle forwarded event callback method can overloaded to determine
-			 * when a bundle is forwarded to the daemon.
+			 * when a bundle is forwarded to the daemon. If you overload this
+			 * method, you must call the super method.
+			 */
+			virtual void eventBundleForwarded() throw ();
+
+			/**
+			 * The bundle completed event callback method can overloaded to determine
+			 * when a sent bundle has been accepted or refused by the daemon.
+			 * @param id The ID of the sent bundle.
+			 * @param accepted True, if the daemon has accepted the bundle.
 			 */
-			virtual void eventBundleForwarded() throw () {};
+			virtual void eventBundleCompleted(const dtn::data::BundleID&, bool) throw () {};
 
 			/**
 			 * Send a bundle to the daemon
 			 */
 			void operator<<(const dtn::data::Bundle &b);
 
+			/**
+			 * Queue a bundle for transmission and return immediately. The bundles
+			 * are sent by a separate thread and several bundles are transmitted
+			 * with one flush of the stream. This call blocks if the number of
+			 * submitted but not completed bundles reaches the in-flight limit.
+			 * @exception ConnectionAbortedException the connection is down
+			 */
+			void submit(const dtn::data::Bundle &b) throw (ConnectionException);
+
+			/**
+			 * Block until all submitted bundles are completed.
+			 * @exception ConnectionAbortedException the connection went down before
+			 */
+			void drain() throw (ConnectionException);
+
+			/**
+			 * Set the max. number of submitted bundles which are not completed yet.
+			 * Zero disables the limit.
+			 */
+			void setInflightLimit(const dtn::data::Size limit);
+
+			/**
+			 * Set the max. number of bundles sent with one flush of the stream.
+			 */
+			void setBatchSize(const dtn::data::Size size);
+
+			/**
+			 * Returns the number of submitted bundles which are not completed yet
+			 */
+			dtn::data::Size getInflight();
+
 			/**
 			 * This method is for synchronous API usage only. It blocks until a bundle
 			 * is received and return it. If the connection is closed during the get() call
@@ -270,6 +333,36 @@ namespace dtn
 
 			// the queue for incoming bundles, when used in synchronous mode
 			ibrcommon::Queue<dtn::data::Bundle> _inqueue;
+
+			/**
+			 * Remove the oldest sent bundle and announce its completion
+			 */
+			void __completed(bool accepted) throw ();
+
+			/**
+			 * Write a bundle to the stream and remember it until completion
+			 */
+			void __send(const dtn::data::Bundle &b, bool submitted);
+
+			// lock for writing bundles to the stream
+			ibrcommon::Mutex _send_lock;
+
+			// the sender thread for submitted bundles
+			Client::AsyncSender _sender;
+
+			// the queue of submitted bundles, not sent yet
+			ibrcommon::Queue<dtn::data::Bundle> _outqueue;
+
+			// sent bundles waiting for completion, flagged if they were submitted
+			typedef std::pair<dtn::data::BundleID, bool> sent_entry;
+			std::queue<sent_entry> _sent;
+
+			// protects the completion state and signals changes
+			ibrcommon::Conditional _inflight_cond;
+			dtn::data::Size _inflight;
+			dtn::data::Size _inflight_limit;
+			dtn::data::Size _batch_size;
+			bool _aborted;
 		};
 	}
 }
@@ -28,6 +28,9 @@ namespace dtn
 	{
 		const dtn::data::block_t AgeBlock::BLOCK_TYPE = 10;
 
+		// eight bytes hold an age of more than 2000 years in microseconds
+		const dtn::data::Length AgeBlock::AGE_LENGTH = 8;
+
 		dtn::data::Block* AgeBlock::Factory::create()
 		{
 			return new AgeBlock();
@@ -80,12 +83,23 @@ namespace dtn
 
 		dtn::data::Length AgeBlock::getLength() const
 		{
-			return getMicroseconds().getLength();
+			// The age grows between getLength() and serialize(), thus it is
+			// encoded with a fixed number of bytes to keep the announced length.
+			const dtn::data::Length len = getMicroseconds().getLength();
+			return (len > AGE_LENGTH) ? len : AGE_LENGTH;
 		}
 
 		std::ostream& AgeBlock::serialize(std::ostream &stream, dtn::data::Length &length) const
 		{
 			const dtn::data::Number value = getMicroseconds();
+
+			// pad the SDNV with leading zero bits
+			for (dtn::data::Length len = value.getLength(); len < AGE_LENGTH; ++len)
+			{
+				stream.put((char)0x80);
+				length++;
+			}
+
 			stream << value;
 			length += value.getLength();
 			return stream;
@@ -78,6 +78,9 @@ namespace dtn
 			void addMicroseconds(const dtn::data::Number &value);
 
 		private:
+			// minimal number of bytes of the encoded age
+			static const dtn::data::Length AGE_LENGTH;
+
 			dtn::data::Timestamp _age;
 			ibrcommon::TimeMeasurement _time;
 		};
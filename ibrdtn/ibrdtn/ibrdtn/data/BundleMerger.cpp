@@ -26,13 +26,15 @@
 #include "ibrdtn/data/Exceptions.h"
 #include <ibrcommon/thread/MutexLock.h>
 #include <ibrcommon/Logger.h>
+#include <algorithm>
+#include <vector>
 
 namespace dtn
 {
 	namespace data
 	{
 		BundleMerger::Container::Container(ibrcommon::BLOB::Reference &ref)
-		 : _bundle(), _blob(ref), _initialized(false), _hasFirstFragBlocksAdded(false), _hasLastFragBlocksAdded(false), _appdatalength(0)
+		 : _bundle(), _blob(ref), _initialized(false), _hasFirstFragBlocksAdded(false), _hasLastFragBlocksAdded(false), _covered(0), _appdatalength(0)
 		{
 		}
 
@@ -43,7 +45,22 @@ namespace dtn
 
 		bool BundleMerger::Container::isComplete()
 		{
-			return Chunk::isComplete(_appdatalength, _chunks);
+			// nothing to merge before the first fragment arrived
+			if (!_initialized) return false;
+
+			// a bundle without application data is complete with any fragment
+			if (_appdatalength == 0) return true;
+
+			// the received ranges are complete if they were merged into [0, appdatalength)
+			if (_ranges.size() != 1) return false;
+
+			const range_map::const_iterator iter = _ranges.begin();
+			return (iter->first == 0) && (iter->second == _appdatalength);
+		}
+
+		Length BundleMerger::Container::getCovered() const
+		{
+			return _covered;
 		}
 
 		Bundle& BundleMerger::Container::getBundle()
@@ -53,26 +70,108 @@ namespace dtn
 
 		bool BundleMerger::Container::contains(Length offset, Length length) const
 		{
-			// check if the offered payload is already in the chunk list
-			for (std::set<Chunk>::const_iterator iter = _chunks.begin(); iter != _chunks.end(); ++iter)
+			// get the last range starting at or before the offset
+			range_map::const_iterator iter = _ranges.upper_bound(offset);
+			if (iter == _ranges.begin()) return false;
+			--iter;
+
+			return ((offset + length) <= iter->second);
+		}
+
+		void BundleMerger::Container::add(Length offset, Length length)
+		{
+			// ignore everything beyond the application data
+			if (offset >= _appdatalength) return;
+			if (length > (_appdatalength - offset)) length = _appdatalength - offset;
+			if (length == 0) return;
+
+			Length begin = offset;
+			Length end = offset + length;
+
+			// merge with a preceding range touching the new one
+			range_map::iterator iter = _ranges.upper_bound(begin);
+			if (iter != _ranges.begin())
 			{
-				const Chunk &chunk = (*iter);
+				range_map::iterator prev = iter; --prev;
+				if (prev->second >= begin)
+				{
+					begin = prev->first;
+					if (prev->second > end) end = prev->second;
+					_covered -= (prev->second - prev->first);
+					_ranges.erase(prev);
+				}
+			}
+
+			// merge with all following ranges touching the new one
+			iter = _ranges.lower_bound(begin);
+			while ((iter != _ranges.end()) && (iter->first <= end))
+			{
+				if (iter->second > end) end = iter->second;
+				_covered -= (iter->second - iter->first);
+				_ranges.erase(iter++);
+			}
 
-				if (offset < chunk.offset) break;
+			_ranges[begin] = end;
+			_covered += (end - begin);
+		}
+
+		void BundleMerger::Container::missing(Length offset, Length length, std::list<Chunk> &gaps) const
+		{
+			Length position = offset;
+			const Length end = offset + length;
+
+			// start with the last range starting at or before the offset
+			range_map::const_iterator iter = _ranges.upper_bound(offset);
+			if (iter != _ranges.begin()) --iter;
+
+			for (; (iter != _ranges.end()) && (position < end); ++iter)
+			{
+				if (iter->second <= position) continue;
+				if (iter->first >= end) break;
 
-				if ( (offset >= chunk.offset) && (offset < (chunk.offset + chunk.length)) )
+				if (iter->first > position)
 				{
-					if ((offset + length) <= (chunk.offset + chunk.length)) return true;
+					gaps.push_back(Chunk(position, iter->first - position));
 				}
+
+				position = iter->second;
 			}
 
-			return false;
+			if (position < end)
+			{
+				gaps.push_back(Chunk(position, end - position));
+			}
 		}
 
-		void BundleMerger::Container::add(Length offset, Length length)
+		void BundleMerger::Container::presize()
 		{
-			BundleMerger::Chunk chunk(offset, length);
-			_chunks.insert(chunk);
+			if (_appdatalength == 0) return;
+
+			ibrcommon::BLOB::iostream stream = _blob.iostream();
+			if (stream.size() >= static_cast<std::streamsize>(_appdatalength)) return;
+
+			// file based streams create a sparse file if the last byte is written,
+			// other streams grow with the received payload only (see extend())
+			(*stream).seekp(static_cast<std::streamoff>(_appdatalength - 1), std::ios::beg);
+			if ((*stream).put('\0').good()) return;
+
+			(*stream).clear();
+		}
+
+		void BundleMerger::Container::extend(std::iostream &stream, Length length)
+		{
+			stream.seekp(0, std::ios::end);
+			const std::streamoff size = stream.tellp();
+			if ((size < 0) || (static_cast<Length>(size) >= length)) return;
+
+			// fill the gap in front of a payload written beyond the end of the stream
+			const std::vector<char> zeros(4096, '\0');
+			for (Length pos = static_cast<Length>(size); pos < length;)
+			{
+				const Length len = std::min(static_cast<Length>(zeros.size()), length - pos);
+				stream.write(&zeros[0], len);
+				pos += len;
+			}
 		}
 
 		BundleMerger::Container &operator<<(BundleMerger::Container &c, const dtn::data::Bundle &obj)
@@ -116,26 +215,62 @@ namespace dtn
 				c._hasLastFragBlocksAdded = false;
 
 				c._initialized = true;
+
+				// allocate the whole payload
+				c.presize();
 			}
 
-			ibrcommon::BLOB::iostream stream = c._blob.iostream();
-			(*stream).seekp(obj.fragmentoffset.get<std::streampos>());
+			// all fragments have to claim the same application data length
+			if (obj.appdatalength.get<dtn::data::Length>() != c._appdatalength)
+				throw ibrcommon::Exception("This fragment does not match the application data length of the others.");
 
 			const dtn::data::PayloadBlock &p = obj.find<dtn::data::PayloadBlock>();
+			const Length offset = obj.fragmentoffset.get<dtn::data::Length>();
+
+			// the payload must not exceed the application data
+			if ((offset > c._appdatalength) || (p.getLength() > (c._appdatalength - offset)))
+				throw ibrcommon::Exception("Fragment payload exceeds the application data length.");
+
 			const Length plength = p.getLength();
 
 			// skip write operation if chunk is already in the merged bundle
-			if (c.contains(obj.fragmentoffset.get<dtn::data::Length>(), plength)) return c;
+			if (c.contains(offset, plength)) return c;
 
-			// copy payload of the fragment into the new blob
+			// copy the parts of the payload not received yet
+			// to their final position in the new blob
 			{
+				std::list<BundleMerger::Chunk> gaps;
+				c.missing(offset, plength, gaps);
+
+				ibrcommon::BLOB::iostream stream = c._blob.iostream();
 				ibrcommon::BLOB::Reference ref = p.getBLOB();
 				ibrcommon::BLOB::iostream s = ref.iostream();
-				(*stream) << (*s).rdbuf() << std::flush;
+
+				std::vector<char> buf(0x10000);
+
+				for (std::list<BundleMerger::Chunk>::const_iterator iter = gaps.begin(); iter != gaps.end(); ++iter)
+				{
+					const BundleMerger::Chunk &gap = (*iter);
+
+					(*s).seekg(static_cast<std::streamoff>(gap.offset - offset), std::ios::beg);
+					c.extend(*stream, gap.offset);
+					(*stream).seekp(static_cast<std::streamoff>(gap.offset), std::ios::beg);
+
+					for (Length remain = gap.length; remain > 0;)
+					{
+						const Length len = std::min(static_cast<Length>(buf.size()), remain);
+						(*s).read(&buf[0], len);
+						if ((*s).gcount() != static_cast<std::streamsize>(len)) throw ibrcommon::Exception("Fragment payload is truncated.");
+						(*stream).write(&buf[0], len);
+						remain -= len;
+					}
+				}
+
+				(*stream) << std::flush;
 			}
 
 			// add the chunk to the list of chunks
-			c.add(obj.fragmentoffset.get<dtn::data::Length>(), plength);
+			c.add(offset, plength);
 
 			// check if fragment is the first one
 			// add blocks only once
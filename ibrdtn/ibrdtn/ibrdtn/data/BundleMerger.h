@@ -25,6 +25,8 @@
 #include "ibrcommon/data/BLOB.h"
 #include "ibrdtn/data/Bundle.h"
 #include <set>
+#include <map>
+#include <list>
 
 namespace dtn
 {
@@ -52,23 +54,56 @@ namespace dtn
 			public:
 				Container(ibrcommon::BLOB::Reference &ref);
 				virtual ~Container();
+
+				/**
+				 * Returns true if the received fragments cover the whole
+				 * application data. This check does not depend on the
+				 * number of fragments added.
+				 */
 				bool isComplete();
 
+				/**
+				 * Returns the number of payload bytes received so far
+				 */
+				Length getCovered() const;
+
 				Bundle& getBundle();
 
 				friend Container &operator<<(Container &c, const dtn::data::Bundle &obj);
 
 			private:
+				// maps the start of each received range to its end,
+				// adjacent and overlapping ranges are merged on insertion
+				typedef std::map<Length, Length> range_map;
+
 				bool contains(Length offset, Length length) const;
 				void add(Length offset, Length length);
 
+				/**
+				 * Returns all parts of the given range not received yet
+				 */
+				void missing(Length offset, Length length, std::list<Chunk> &gaps) const;
+
+				/**
+				 * Extend a file based BLOB to the application data length, so each
+				 * payload can be written at its final offset
+				 */
+				void presize();
+
+				/**
+				 * Fill the stream with zeros up to the given length. This is
+				 * used for streams not able to seek beyond their end.
+				 */
+				static void extend(std::iostream &stream, Length length);
+
 				dtn::data::Bundle _bundle;
 				ibrcommon::BLOB::Reference _blob;
 				bool _initialized;
 				bool _hasFirstFragBlocksAdded;
 				bool _hasLastFragBlocksAdded;
 
-				std::set<Chunk> _chunks;
+				range_map _ranges;
+				Length _covered;
 				Length _appdatalength;
 			};
 
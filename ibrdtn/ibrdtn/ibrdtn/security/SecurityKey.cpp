@@ -22,6 +22,7 @@
 #include "ibrdtn/security/SecurityKey.h"
 #include <ibrcommon/ssl/SHA256Stream.h>
 #include <ibrcommon/Logger.h>
+#include <ibrcommon/thread/MutexLock.h>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -35,12 +36,59 @@ namespace dtn
 	namespace security
 	{
 		SecurityKey::SecurityKey()
-		 : type(KEY_UNSPEC), trustlevel(NONE)
+		 : type(KEY_UNSPEC), trustlevel(NONE), _material(new Material("", KEY_UNSPEC))
+		{}
+
+		SecurityKey::SecurityKey(const SecurityKey &other)
+		 : type(other.type), reference(other.reference), lastupdate(other.lastupdate), trustlevel(other.trustlevel),
+		   file(other.file), flags(other.flags), _material(other.getMaterial())
 		{}
 
 		SecurityKey::~SecurityKey()
 		{}
 
+		SecurityKey& SecurityKey::operator=(const SecurityKey &other)
+		{
+			if (this == &other) return *this;
+
+			type = other.type;
+			reference = other.reference;
+			lastupdate = other.lastupdate;
+			trustlevel = other.trustlevel;
+			file = other.file;
+			flags = other.flags;
+
+			const refcnt_ptr<Material> m = other.getMaterial();
+
+			ibrcommon::MutexLock l(_material_lock);
+			_material = m;
+
+			return *this;
+		}
+
+		SecurityKey::Material::Material(const std::string &p, KeyType t)
+		 : path(p), type(t), has_data(false), rsa(NULL), evp(NULL)
+		{
+		}
+
+		SecurityKey::Material::~Material()
+		{
+			if (rsa != NULL) RSA_free(rsa);
+			if (evp != NULL) EVP_PKEY_free(evp);
+		}
+
+		refcnt_ptr<SecurityKey::Material> SecurityKey::getMaterial() const
+		{
+			ibrcommon::MutexLock l(_material_lock);
+
+			if ((_material->path != file.getPath()) || (_material->type != type))
+			{
+				_material = refcnt_ptr<Material>(new Material(file.getPath(), type));
+			}
+
+			return _material;
+		}
+
 		void SecurityKey::free(RSA* key)
 		{
 			RSA_free(key);
@@ -63,55 +111,71 @@ namespace dtn
 
 		const std::string SecurityKey::getData() const
 		{
-			std::ifstream stream(file.getPath().c_str(), ios::in);
-			std::stringstream ss;
+			refcnt_ptr<Material> m = getMaterial();
+			ibrcommon::MutexLock l(m->lock);
 
-			ss << stream.rdbuf();
+			if (!m->has_data)
+			{
+				std::ifstream stream(file.getPath().c_str(), ios::in);
+				std::stringstream ss;
 
-			stream.close();
+				ss << stream.rdbuf();
 
-			return ss.str();
+				stream.close();
+
+				m->data = ss.str();
+				m->has_data = true;
+			}
+
+			return m->data;
 		}
 
 		RSA* SecurityKey::getRSA() const
 		{
-			switch (type)
+			if ((type != KEY_PRIVATE) && (type != KEY_PUBLIC)) return NULL;
+
+			refcnt_ptr<Material> m = getMaterial();
+			ibrcommon::MutexLock l(m->lock);
+
+			if (m->rsa == NULL)
 			{
-			case KEY_PRIVATE:
-				return getPrivateRSA();
-			case KEY_PUBLIC:
-				return getPublicRSA();
-			default:
-				return NULL;
+				m->rsa = (type == KEY_PRIVATE) ? getPrivateRSA() : getPublicRSA();
 			}
+
+			// the caller releases its own reference
+			RSA_up_ref(m->rsa);
+			return m->rsa;
 		}
 
 		EVP_PKEY* SecurityKey::getEVP() const
 		{
-			EVP_PKEY* ret = EVP_PKEY_new();
-			FILE * pkey_file = fopen(file.getPath().c_str(), "r");
+			if ((type != KEY_PRIVATE) && (type != KEY_PUBLIC)) return NULL;
 
-			switch (type)
+			refcnt_ptr<Material> m = getMaterial();
+			ibrcommon::MutexLock l(m->lock);
+
+			if (m->evp == NULL)
 			{
-				case KEY_PRIVATE:
-				{
-					ret = PEM_read_PrivateKey(pkey_file, &ret, NULL, NULL);
-					break;
-				}
+				FILE * pkey_file = fopen(file.getPath().c_str(), "r");
+				if (!pkey_file) return NULL;
 
-				case KEY_PUBLIC:
-				{
-					ret = PEM_read_PUBKEY(pkey_file, &ret, NULL, NULL);
-					break;
-				}
+				if (type == KEY_PRIVATE)
+					m->evp = PEM_read_PrivateKey(pkey_file, NULL, NULL, NULL);
+				else
+					m->evp = PEM_read_PUBKEY(pkey_file, NULL, NULL, NULL);
 
-				default:
-					ret = NULL;
-					break;
+				fclose(pkey_file);
+
+				if (m->evp == NULL) return NULL;
 			}
 
-			fclose(pkey_file);
-			return ret;
+			// the caller releases its own reference
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+			CRYPTO_add(&m->evp->references, 1, CRYPTO_LOCK_EVP_PKEY);
+#else
+			EVP_PKEY_up_ref(m->evp);
+#endif
+			return m->evp;
 		}
 
 		const std::string SecurityKey::getFingerprint() const
@@ -119,15 +183,9 @@ namespace dtn
 			switch (type)
 			{
 				case KEY_PRIVATE:
-				{
-					RSA* rsa = getPrivateRSA();
-					std::string ret = getFingerprint(rsa);
-					free(rsa);
-					return ret;
-				}
 				case KEY_PUBLIC:
 				{
-					RSA* rsa = getPublicRSA();
+					RSA* rsa = getRSA();
 					std::string ret = getFingerprint(rsa);
 					free(rsa);
 					return ret;
@@ -27,7 +27,10 @@
 #include "ibrdtn/data/DTNTime.h"
 #include "ibrdtn/data/BundleString.h"
 #include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/Mutex.h>
+#include <ibrcommon/refcnt_ptr.h>
 #include <openssl/rsa.h>
+#include <openssl/evp.h>
 
 #include <string>
 #include <iostream>
@@ -65,8 +68,11 @@ namespace dtn
 			};
 
 			SecurityKey();
+			SecurityKey(const SecurityKey &other);
 			virtual ~SecurityKey();
 
+			SecurityKey& operator=(const SecurityKey &other);
+
 			// key type
 			KeyType type;
 
@@ -89,10 +95,22 @@ namespace dtn
 
 			ibrcommon::File getMetaFilename() const;
 
+			/**
+			 * Returns the RSA key of this key file. The key is parsed once
+			 * and shared by all copies of this object, the returned
+			 * reference has to be released with free().
+			 */
 			virtual RSA* getRSA() const;
 
+			/**
+			 * Returns the key as EVP_PKEY. Like getRSA() the key is parsed
+			 * once and the returned reference has to be released with free().
+			 */
 			virtual EVP_PKEY* getEVP() const;
 
+			/**
+			 * Returns the raw content of the key file
+			 */
 			virtual const std::string getData() const;
 
 			virtual const std::string getFingerprint() const;
@@ -152,6 +170,36 @@ namespace dtn
 		private:
 			RSA* getPublicRSA() const;
 			RSA* getPrivateRSA() const;
+
+			/**
+			 * Parsed content of a key file
+			 */
+			class Material
+			{
+			public:
+				Material(const std::string &path, KeyType type);
+				virtual ~Material();
+
+				const std::string path;
+				const KeyType type;
+
+				ibrcommon::Mutex lock;
+
+				bool has_data;
+				std::string data;
+
+				RSA* rsa;
+				EVP_PKEY* evp;
+			};
+
+			/**
+			 * Returns the material of the current key file. If the file or the
+			 * type of this key has been changed, the material is replaced.
+			 */
+			refcnt_ptr<Material> getMaterial() const;
+
+			mutable ibrcommon::Mutex _material_lock;
+			mutable refcnt_ptr<Material> _material;
 		};
 	}
 }
@@ -355,6 +355,18 @@ namespace dtn
 			return ret;
 		}
 
+		void StreamConnection::StreamBuffer::flushAck()
+		{
+			if (!get(STREAM_ACK_PENDING)) return;
+
+			// the next read will block, so send the delayed ACKs now
+			if (_stream.rdbuf()->in_avail() > 0) return;
+
+			ibrcommon::MutexLock l(_sendlock);
+			_stream.flush();
+			unset(STREAM_ACK_PENDING);
+		}
+
 		void StreamConnection::StreamBuffer::skipData(dtn::data::Length &size)
 		{
 			// a temporary buffer
@@ -420,7 +432,19 @@ namespace dtn
 						{
 							ibrcommon::MutexLock l(_sendlock);
 							if (!_stream.good()) throw StreamErrorException("stream went bad");
-							_stream << StreamDataSegment(StreamDataSegment::MSG_ACK_SEGMENT, _recv_size) << std::flush;
+							_stream << StreamDataSegment(StreamDataSegment::MSG_ACK_SEGMENT, _recv_size);
+
+							// if further segments are already received, the ACKs
+							// are sent together before waiting for more data
+							if (_stream.rdbuf()->in_avail() > 0)
+							{
+								set(STREAM_ACK_PENDING);
+							}
+							else
+							{
+								_stream.flush();
+								unset(STREAM_ACK_PENDING);
+							}
 						}
 
 						// return to idle state
@@ -438,6 +462,8 @@ namespace dtn
 						// read the segment
 						if (!_stream.good()) throw StreamErrorException("stream went bad");
 
+						flushAck();
+
 						_stream >> seg;
 					} catch (const ios_base::failure &ex) {
 						throw StreamErrorException("read error: " + std::string(ex.what()));
@@ -608,6 +634,8 @@ namespace dtn
 				try {
 					if (!_stream.good()) throw StreamErrorException("stream went bad");
 
+					flushAck();
+
 					// here receive the data
 					_stream.read(&in_buf_[0], (std::streamsize)readsize);
 
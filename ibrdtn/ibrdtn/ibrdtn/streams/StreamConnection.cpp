@@ -65,6 +65,12 @@ namespace dtn
 			_buf.reject();
 		}
 
+		void StreamConnection::commit()
+		{
+			// set the end flag on the last segment of this bundle
+			_buf.overflow(std::char_traits<char>::eof());
+		}
+
 		void StreamConnection::keepalive()
 		{
 			_buf.keepalive();
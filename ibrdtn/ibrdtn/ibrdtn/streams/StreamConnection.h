@@ -196,6 +196,12 @@ namespace dtn
 			 */
 			void reject();
 
+			/**
+			 * Mark the end of the current bundle without flushing the underlying
+			 * stream. This allows to send several bundles with one flush() call.
+			 */
+			void commit();
+
 			/**
 			 * send a keepalive
 			 */
@@ -312,11 +318,17 @@ namespace dtn
 					STREAM_ACK_SUPPORT = 1 << 8,
 					STREAM_NACK_SUPPORT = 1 << 9,
 					STREAM_SOB = 1 << 10,			// start of bundle
-					STREAM_TIMER_SUPPORT = 1 << 11
+					STREAM_TIMER_SUPPORT = 1 << 11,
+					STREAM_ACK_PENDING = 1 << 12	// ACKs written but not flushed
 				};
 
 				void skipData(dtn::data::Length &size);
 
+				/**
+				 * Flush delayed ACKs if no more received data is buffered
+				 */
+				void flushAck();
+
 				bool get(const StateBits bit) const;
 				void set(const StateBits bit);
 				void unset(const StateBits bit);
@@ -0,0 +1,199 @@
+/*
+ * TestClient.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "api/TestClient.h"
+
+#include <ibrcommon/net/socket.h>
+#include <ibrcommon/net/vsocket.h>
+#include <ibrcommon/net/socketstream.h>
+#include <ibrdtn/api/Client.h>
+#include <ibrdtn/streams/StreamConnection.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrdtn/data/Serializer.h>
+#include <ibrcommon/data/BLOB.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TestClient);
+
+void TestClient::setUp()
+{
+}
+
+void TestClient::tearDown()
+{
+}
+
+void TestClient::pipelinedSubmit()
+{
+	/**
+	 * emulates the tcpcl mode of the daemon API
+	 */
+	class testserver : public ibrcommon::JoinableThread, dtn::streams::StreamConnection::Callback
+	{
+	private:
+		ibrcommon::vsocket _sockets;
+		bool _running;
+
+	public:
+		testserver(ibrcommon::serversocket *sock)
+		: _running(true), recv_bundles(0)
+		{
+			_sockets.add(sock);
+			_sockets.up();
+		}
+
+		virtual ~testserver() {
+			_sockets.down();
+			join();
+			_sockets.destroy();
+		};
+
+		void __cancellation() throw () {
+			_running = false;
+			_sockets.down();
+		}
+
+		void eventShutdown(dtn::streams::StreamConnection::ConnectionShutdownCases) throw () {};
+		void eventTimeout() throw () {};
+		void eventError() throw () {};
+		void eventBundleRefused() throw () {};
+		void eventBundleForwarded() throw () {};
+		void eventBundleAck(const dtn::data::Length&) throw () {};
+		void eventConnectionUp(const dtn::streams::StreamContactHeader&) throw () {};
+		void eventConnectionDown() throw () {};
+
+		unsigned int recv_bundles;
+
+	protected:
+		void run() throw ()
+		{
+			ibrcommon::vaddress peeraddr;
+
+			while (_running) {
+				try {
+					ibrcommon::socketset fds;
+					_sockets.select(&fds, NULL, NULL, NULL);
+
+					for (ibrcommon::socketset::iterator iter = fds.begin(); iter != fds.end(); ++iter)
+					{
+						ibrcommon::serversocket &servsock = dynamic_cast<ibrcommon::serversocket&>(**iter);
+
+						try {
+							ibrcommon::clientsocket *sock = servsock.accept(peeraddr);
+							ibrcommon::socketstream conn(sock);
+
+							// send the API banner and wait for the protocol switch
+							std::string buffer;
+							conn << "IBR-DTN test API" << std::endl;
+							std::getline(conn, buffer);
+
+							dtn::streams::StreamConnection stream(*this, conn);
+
+							// do the handshake
+							stream.handshake(dtn::data::EID("dtn:server"), 0, dtn::streams::StreamContactHeader::REQUEST_ACKNOWLEDGMENTS);
+
+							while (conn.good())
+							{
+								dtn::data::Bundle b;
+								dtn::data::DefaultDeserializer(stream) >> b;
+								recv_bundles++;
+							}
+						} catch (const std::exception&) {
+							// connection closed
+						}
+					}
+				} catch (const ibrcommon::vsocket_interrupt&) {
+					// excepted interruption
+				} catch (const ibrcommon::socket_exception&) {
+					// unexpected socket error
+					break;
+				}
+			}
+		}
+	};
+
+	class testclient : public dtn::api::Client
+	{
+	public:
+		testclient(ibrcommon::socketstream &stream)
+		: dtn::api::Client("test", stream, dtn::api::Client::MODE_SENDONLY), accepted(0), refused(0)
+		{ }
+
+		virtual ~testclient() { }
+
+		void eventBundleCompleted(const dtn::data::BundleID&, bool ok) throw ()
+		{
+			if (ok) accepted++; else refused++;
+		}
+
+		unsigned int accepted;
+		unsigned int refused;
+	};
+
+	// create a new server bound to tcp port 1235
+	testserver srv(new ibrcommon::tcpserversocket(1235));
+
+	// start the server thread
+	srv.start();
+
+	ibrcommon::vaddress addr("::1", 1235);
+	ibrcommon::socketstream conn(new ibrcommon::tcpsocket(addr));
+
+	dtn::data::Size max_inflight = 0;
+
+	{
+		testclient cl(conn);
+		cl.connect();
+		cl.setInflightLimit(16);
+
+		ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+		(*ref.iostream()) << "Hello World";
+
+		try {
+			for (int i = 0; i < 2000; ++i)
+			{
+				dtn::data::Bundle b;
+				b.destination = dtn::data::EID("dtn://test/sink");
+				b.push_back(ref);
+				cl.submit(b);
+
+				const dtn::data::Size inflight = cl.getInflight();
+				if (inflight > max_inflight) max_inflight = inflight;
+			}
+
+			// wait until all bundles are completed
+			cl.drain();
+		} catch (const std::exception &e) {
+			CPPUNIT_FAIL(std::string("client error: ") + e.what());
+		}
+
+		CPPUNIT_ASSERT_EQUAL((dtn::data::Size)0, cl.getInflight());
+		CPPUNIT_ASSERT_EQUAL((unsigned int) 2000, cl.accepted);
+		CPPUNIT_ASSERT_EQUAL((unsigned int) 0, cl.refused);
+
+		cl.close();
+	}
+
+	srv.stop();
+	srv.join();
+
+	CPPUNIT_ASSERT(max_inflight <= 16);
+	CPPUNIT_ASSERT_EQUAL((unsigned int) 2000, srv.recv_bundles);
+}
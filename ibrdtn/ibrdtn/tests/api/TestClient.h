@@ -0,0 +1,43 @@
+/*
+ * TestClient.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TESTCLIENT_H_
+#define TESTCLIENT_H_
+
+class TestClient : public CPPUNIT_NS :: TestFixture
+{
+	CPPUNIT_TEST_SUITE (TestClient);
+	CPPUNIT_TEST (pipelinedSubmit);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp (void);
+	void tearDown (void);
+
+protected:
+	void pipelinedSubmit(void);
+};
+
+
+#endif /* TESTCLIENT_H_ */
@@ -0,0 +1,83 @@
+/*
+ * TestAgeBlock.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent
+ */
+
+#include "data/TestAgeBlock.h"
+#include <ibrdtn/data/AgeBlock.h>
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/Serializer.h>
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/thread/Thread.h>
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TestAgeBlock);
+
+void TestAgeBlock::setUp()
+{
+}
+
+void TestAgeBlock::tearDown()
+{
+}
+
+void TestAgeBlock::roundtripTest(void)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	(*ref.iostream()) << "Hello World";
+	b.push_back(ref);
+
+	dtn::data::AgeBlock &age = b.push_front<dtn::data::AgeBlock>();
+	age.setSeconds(42);
+
+	std::stringstream ss;
+	dtn::data::DefaultSerializer(ss) << b;
+
+	dtn::data::Bundle dest;
+	dtn::data::DefaultDeserializer(ss) >> dest;
+
+	// the age is restored including the time spent since the block was created
+	const dtn::data::AgeBlock &dest_age = dest.find<dtn::data::AgeBlock>();
+	CPPUNIT_ASSERT(dest_age.getMicroseconds() >= dtn::data::Number(42000000));
+	CPPUNIT_ASSERT(dest_age.getMicroseconds() < dtn::data::Number(43000000));
+	CPPUNIT_ASSERT(dest_age.getMicroseconds() <= age.getMicroseconds());
+}
+
+void TestAgeBlock::lengthTest(void)
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://node-one/test");
+	b.destination = dtn::data::EID("dtn://node-two/test");
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	(*ref.iostream()) << "Hello World";
+	b.push_back(ref);
+
+	// an age just below the next SDNV length
+	dtn::data::AgeBlock &age = b.push_front<dtn::data::AgeBlock>();
+	age.setMicroseconds((1 << 21) - 1);
+
+	std::stringstream ss;
+	dtn::data::DefaultSerializer ds(ss);
+	const dtn::data::Length announced = ds.getLength(b);
+
+	// the age grows beyond the SDNV boundary meanwhile
+	ibrcommon::Thread::sleep(10);
+
+	ds << b;
+
+	// the serialized bundle matches the length announced before
+	CPPUNIT_ASSERT_EQUAL(announced, (dtn::data::Length)ss.str().length());
+
+	dtn::data::Bundle dest;
+	dtn::data::DefaultDeserializer(ss) >> dest;
+
+	const dtn::data::AgeBlock &dest_age = dest.find<dtn::data::AgeBlock>();
+	CPPUNIT_ASSERT(dest_age.getMicroseconds() >= dtn::data::Number(1 << 21));
+}
@@ -0,0 +1,30 @@
+/*
+ * TestAgeBlock.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: agent
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifndef TESTAGEBLOCK_H_
+#define TESTAGEBLOCK_H_
+
+class TestAgeBlock : public CPPUNIT_NS :: TestFixture
+{
+	CPPUNIT_TEST_SUITE (TestAgeBlock);
+	CPPUNIT_TEST (roundtripTest);
+	CPPUNIT_TEST (lengthTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp (void);
+	void tearDown (void);
+
+protected:
+	void roundtripTest(void);
+	void lengthTest(void);
+};
+
+#endif /* TESTAGEBLOCK_H_ */
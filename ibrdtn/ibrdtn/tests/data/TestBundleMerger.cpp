@@ -0,0 +1,161 @@
+/*
+ * TestBundleMerger.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "data/TestBundleMerger.h"
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrcommon/data/BLOB.h>
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TestBundleMerger);
+
+void TestBundleMerger::setUp()
+{
+	std::stringstream ss;
+	for (int i = 0; i < 1000; ++i) ss << (char)('a' + (i % 26));
+	_data = ss.str();
+}
+
+void TestBundleMerger::tearDown()
+{
+}
+
+dtn::data::Bundle TestBundleMerger::fragment(size_t offset, size_t length) const
+{
+	dtn::data::Bundle b;
+	b.source = dtn::data::EID("dtn://test/merger");
+	b.destination = dtn::data::EID("dtn://test/destination");
+	b.timestamp = 1;
+	b.sequencenumber = 1;
+	b.set(dtn::data::PrimaryBlock::FRAGMENT, true);
+	b.appdatalength = _data.length();
+	b.fragmentoffset = offset;
+
+	ibrcommon::BLOB::Reference ref = ibrcommon::BLOB::create();
+	{
+		ibrcommon::BLOB::iostream stream = ref.iostream();
+		(*stream) << _data.substr(offset, length);
+	}
+	b.push_back(ref);
+
+	return b;
+}
+
+std::string TestBundleMerger::payload(const dtn::data::Bundle &b)
+{
+	ibrcommon::BLOB::Reference ref = b.find<dtn::data::PayloadBlock>().getBLOB();
+	ibrcommon::BLOB::iostream stream = ref.iostream();
+
+	std::stringstream ss;
+	ss << (*stream).rdbuf();
+	return ss.str();
+}
+
+void TestBundleMerger::mergeTest(void)
+{
+	dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
+
+	for (size_t offset = 0; offset < _data.length(); offset += 300)
+	{
+		CPPUNIT_ASSERT(!c.isComplete() || offset == 0);
+		c << fragment(offset, 300);
+	}
+
+	CPPUNIT_ASSERT(c.isComplete());
+	CPPUNIT_ASSERT(!c.getBundle().get(dtn::data::PrimaryBlock::FRAGMENT));
+	CPPUNIT_ASSERT_EQUAL(_data, payload(c.getBundle()));
+}
+
+void TestBundleMerger::outOfOrderTest(void)
+{
+	dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
+
+	c << fragment(900, 100);
+	c << fragment(300, 300);
+	c << fragment(600, 300);
+	CPPUNIT_ASSERT(!c.isComplete());
+
+	c << fragment(0, 300);
+	CPPUNIT_ASSERT(c.isComplete());
+	CPPUNIT_ASSERT_EQUAL(_data, payload(c.getBundle()));
+}
+
+void TestBundleMerger::overlapTest(void)
+{
+	dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
+
+	c << fragment(100, 200);
+	c << fragment(500, 200);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)400, c.getCovered());
+
+	// a fragment spanning both received ranges
+	c << fragment(50, 800);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)800, c.getCovered());
+
+	// a duplicate does not change anything
+	c << fragment(100, 200);
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)800, c.getCovered());
+
+	c << fragment(0, 100);
+	c << fragment(800, 200);
+	CPPUNIT_ASSERT(c.isComplete());
+	CPPUNIT_ASSERT_EQUAL(_data, payload(c.getBundle()));
+}
+
+void TestBundleMerger::incompleteTest(void)
+{
+	dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
+
+	c << fragment(0, 400);
+	c << fragment(401, 599);
+	CPPUNIT_ASSERT(!c.isComplete());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)999, c.getCovered());
+
+	c << fragment(400, 1);
+	CPPUNIT_ASSERT(c.isComplete());
+	CPPUNIT_ASSERT_EQUAL(_data, payload(c.getBundle()));
+}
+
+void TestBundleMerger::outOfRangeTest(void)
+{
+	dtn::data::BundleMerger::Container c = dtn::data::BundleMerger::getContainer();
+
+	// nothing received yet
+	CPPUNIT_ASSERT(!c.isComplete());
+
+	c << fragment(0, 900);
+
+	// a payload beyond the application data is rejected
+	dtn::data::Bundle b = fragment(900, 100);
+	b.fragmentoffset = 950;
+	CPPUNIT_ASSERT_THROW(c << b, ibrcommon::Exception);
+
+	// a fragment claiming another application data length is rejected
+	b = fragment(900, 100);
+	b.appdatalength = 900;
+	CPPUNIT_ASSERT_THROW(c << b, ibrcommon::Exception);
+
+	CPPUNIT_ASSERT(!c.isComplete());
+	CPPUNIT_ASSERT_EQUAL((dtn::data::Length)900, c.getCovered());
+
+	c << fragment(900, 100);
+	CPPUNIT_ASSERT(c.isComplete());
+	CPPUNIT_ASSERT_EQUAL(_data, payload(c.getBundle()));
+}
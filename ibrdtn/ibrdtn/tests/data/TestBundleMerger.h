@@ -0,0 +1,65 @@
+/*
+ * TestBundleMerger.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * Written-by: agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <ibrdtn/data/Bundle.h>
+#include <ibrdtn/data/BundleMerger.h>
+
+#ifndef TESTBUNDLEMERGER_H_
+#define TESTBUNDLEMERGER_H_
+
+class TestBundleMerger : public CPPUNIT_NS :: TestFixture
+{
+	CPPUNIT_TEST_SUITE (TestBundleMerger);
+	CPPUNIT_TEST (mergeTest);
+	CPPUNIT_TEST (outOfOrderTest);
+	CPPUNIT_TEST (overlapTest);
+	CPPUNIT_TEST (incompleteTest);
+	CPPUNIT_TEST (outOfRangeTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp (void);
+	void tearDown (void);
+
+protected:
+	void mergeTest(void);
+	void outOfOrderTest(void);
+	void overlapTest(void);
+	void incompleteTest(void);
+	void outOfRangeTest(void);
+
+private:
+	/**
+	 * Create a fragment of the test payload
+	 */
+	dtn::data::Bundle fragment(size_t offset, size_t length) const;
+
+	/**
+	 * Read the payload of a bundle into a string
+	 */
+	static std::string payload(const dtn::data::Bundle &b);
+
+	std::string _data;
+};
+
+#endif /* TESTBUNDLEMERGER_H_ */
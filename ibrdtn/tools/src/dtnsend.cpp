@@ -226,6 +226,9 @@ int main(int argc, char *argv[])
 			// stream protocol by starting the thread and sending the contact header.
 			client.connect();
 
+			// limit the number of bundles not yet accepted by the daemon
+			client.setInflightLimit(32);
+
 			// target address
 			EID addr = EID(file_destination);
 
@@ -273,8 +276,8 @@ int main(int argc, char *argv[])
 						// set the bundles priority
 						b.setPriority(dtn::data::PrimaryBlock::PRIORITY(priority));
 
-						// send the bundle
-						client << b;
+						// queue the bundle for transmission
+						client.submit(b);
 
 						if (copies > 1)
 						{
@@ -323,8 +326,8 @@ int main(int argc, char *argv[])
 						// set the bundles priority
 						b.setPriority(dtn::data::PrimaryBlock::PRIORITY(priority));
 
-						// send the bundle
-						client << b;
+						// queue the bundle for transmission
+						client.submit(b);
 
 						if (copies > 1)
 						{
@@ -333,8 +336,8 @@ int main(int argc, char *argv[])
 					}
 				}
 
-				// flush the buffers
-				client.flush();
+				// wait until all bundles are accepted by the daemon
+				client.drain();
 			} catch (const ibrcommon::IOException &ex) {
 				std::cerr << "Error while sending bundle." << std::endl;
 				std::cerr << "\t" << ex.what() << std::endl;
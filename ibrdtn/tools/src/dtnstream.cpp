@@ -28,6 +28,7 @@
 #include <ibrdtn/data/EID.h>
 #include <ibrcommon/net/socket.h>
 #include <ibrcommon/data/File.h>
+#include <ibrcommon/thread/SignalHandler.h>
 #include <iostream>
 #include <unistd.h>
 
@@ -51,14 +52,41 @@ void print_help()
 	std::cout << " -E               Request encryption on the bundle layer" << std::endl;
 	std::cout << " -S               Request signature on the bundle layer" << std::endl;
 	std::cout << " -f               Enable flow-control using Status Reports" << std::endl;
+	std::cout << " -D <ms>          Send out a chunk at latest after <ms> milliseconds" << std::endl;
 	std::cout << "" << std::endl;
 	std::cout << "* receive options *" << std::endl;
 	std::cout << " -g <group>       Join a destination group" << std::endl;
 	std::cout << " -t <seconds>     Set the timeout of the buffer" << std::endl;
 	std::cout << " -w               Wait for the bundle with seqno zero" << std::endl;
+	std::cout << " -L               Tolerate loss, skip missing chunks instead of waiting" << std::endl;
+	std::cout << " -R <chunks>      Set the size of the reorder buffer (default: 64)" << std::endl;
+	std::cout << " -v               Print latency and jitter statistics on exit" << std::endl;
 	std::cout << "" << std::endl;
 }
 
+BundleStream *_bs = NULL;
+bool _statistics = false;
+
+void print_statistics(const BundleStreamBuf::Statistics &stats)
+{
+	std::cerr << "chunks: " << stats.chunks << ", lost: " << stats.lost << ", late: " << stats.late
+			<< ", duplicates: " << stats.duplicates << ", reordered: " << stats.reordered << std::endl;
+	std::cerr << "latency min/avg/max: " << (stats.latency_min / 1000.0) << "/" << (stats.latency_avg / 1000.0)
+			<< "/" << (stats.latency_max / 1000.0) << " ms, jitter: " << (stats.jitter / 1000.0) << " ms" << std::endl;
+}
+
+void term(int)
+{
+	// the receiver does not return on its own, print the statistics here
+	if (_statistics && (_bs != NULL))
+	{
+		print_statistics(_bs->getStatistics());
+	}
+
+	std::cout << std::flush;
+	_exit(0);
+}
+
 int main(int argc, char *argv[])
 {
 	int opt = 0;
@@ -77,9 +105,12 @@ int main(int argc, char *argv[])
 	bool _bundle_group = false;
 	bool _wait_seq_zero = false;
 	bool _flow_control = false;
+	unsigned int _flush_deadline = 0;
+	bool _loss_tolerant = false;
+	size_t _reorder_window = 64;
 	ibrcommon::File _unixdomain;
 
-	while((opt = getopt(argc, argv, "hg:Gd:t:s:c:C:p:l:ESU:wf")) != -1)
+	while((opt = getopt(argc, argv, "hg:Gd:t:s:c:C:p:l:ESU:wfD:LR:v")) != -1)
 	{
 		switch (opt)
 		{
@@ -143,6 +174,22 @@ int main(int argc, char *argv[])
 			_flow_control = true;
 			break;
 
+		case 'D':
+			_flush_deadline = atoi(optarg);
+			break;
+
+		case 'L':
+			_loss_tolerant = true;
+			break;
+
+		case 'R':
+			_reorder_window = atoi(optarg);
+			break;
+
+		case 'v':
+			_statistics = true;
+			break;
+
 		default:
 			std::cout << "unknown command" << std::endl;
 			return -1;
@@ -170,6 +217,7 @@ int main(int argc, char *argv[])
 
 		// Initiate a derivated client
 		BundleStream bs(conn, _min_chunk_size, _max_chunk_size, _source, _group, _wait_seq_zero);
+		_bs = &bs;
 
 		// set flow-control as requested
 		bs.setAutoFlush(_flow_control);
@@ -177,6 +225,11 @@ int main(int argc, char *argv[])
 		// set the receive timeout
 		bs.setReceiveTimeout(_receive_timeout);
 
+		// set the latency options
+		bs.setFlushDeadline(_flush_deadline);
+		bs.setLossTolerant(_loss_tolerant);
+		bs.setReorderWindow(_reorder_window);
+
 		// Connect to the server. Actually, this function initiate the
 		// stream protocol by starting the thread and sending the contact header.
 		bs.connect();
@@ -196,6 +249,12 @@ int main(int argc, char *argv[])
 		// receiver mode
 		else
 		{
+			// create signal handler
+			ibrcommon::SignalHandler sighandler(term);
+			sighandler.handle(SIGINT);
+			sighandler.handle(SIGTERM);
+			sighandler.initialize();
+
 			std::istream stream(&bs.rdbuf());
 			std::cout << stream.rdbuf() << std::flush;
 		}
@@ -39,13 +39,18 @@
 #include "ibrcommon/thread/Mutex.h"
 #include "ibrcommon/thread/MutexLock.h"
 #include <ibrcommon/thread/SignalHandler.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/TimeMeasurement.h>
 #include <ibrcommon/Logger.h>
+#include <ibrdtn/data/AgeBlock.h>
 
 // Basic functionalities for streaming.
 #include <iostream>
 
 // A queue for bundles.
 #include <queue>
+#include <vector>
+#include <algorithm>
 
 #include <unistd.h>
 #include <fcntl.h>
@@ -53,6 +58,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <poll.h>
 
 #include <sys/ioctl.h>
 #include <sys/socket.h>
@@ -106,52 +112,302 @@ int tun_alloc(char *dev, short int flags) {
   return fd;
 }
 
-size_t throughput_data_up[5] = { 0, 0, 0, 0, 0 };
-size_t throughput_data_down[5] = { 0, 0, 0, 0, 0 };
-int throughput_pos = 0;
+/**
+ * Payloads of aggregated bundles start with this byte. A plain packet starts
+ * with the flags of the tun packet information, which never have it set.
+ * Each packet follows as 16-bit length in network byte order and its data.
+ */
+static const char AGGREGATE_MAGIC = static_cast<char>(0xff);
 
-void add_throughput_data(ssize_t amount, int updown) {
-	if (updown == 0) {
-		throughput_data_down[throughput_pos] += amount;
-	} else {
-		throughput_data_up[throughput_pos] += amount;
+/**
+ * Counts the traffic of the tunnel in five slots of 200 ms each. Printing the
+ * statistics sums up the last second and moves on to the next slot.
+ */
+class TunnelStatistics
+{
+public:
+	TunnelStatistics() : _pos(0)
+	{
+		for (int i = 0; i < 5; ++i) clear(_slots[i]);
 	}
-}
 
-void timer_display_throughput(int) {
-	float throughput_sum_up = 0;
-	float throughput_sum_down = 0;
+	virtual ~TunnelStatistics() {}
 
-	for (int i = 0; i < 5; ++i) {
-		throughput_sum_up += static_cast<float>(throughput_data_up[i]);
-		throughput_sum_down += static_cast<float>(throughput_data_down[i]);
+	void up(size_t bytes, size_t packets)
+	{
+		ibrcommon::MutexLock l(_lock);
+		Slot &s = _slots[_pos];
+		s.bytes_up += bytes;
+		s.packets_up += packets;
+		s.bundles_up++;
 	}
 
-	std::cout << "  up: " << setiosflags(ios::right) << setw(12) << setiosflags(ios::fixed) << setprecision(2) << (throughput_sum_up/1024) << " kB/s ";
-	std::cout << "  down: " << setiosflags(ios::right) << setw(12) << setiosflags(ios::fixed) << setprecision(2) << (throughput_sum_down/1024) << " kB/s\r" << std::flush;
+	void down(size_t bytes, size_t packets, double latency)
+	{
+		ibrcommon::MutexLock l(_lock);
+		Slot &s = _slots[_pos];
+		s.bytes_down += bytes;
+		s.packets_down += packets;
+		s.bundles_down++;
+
+		if (latency >= 0) {
+			s.latency_sum += latency;
+			s.latency_samples++;
+		}
+	}
 
-	throughput_pos++;
-	if (throughput_pos > 4) throughput_pos = 0;
+	void print(std::ostream &stream)
+	{
+		Slot sum;
+		clear(sum);
 
-	throughput_data_up[throughput_pos] = 0;
-	throughput_data_down[throughput_pos] = 0;
-}
+		{
+			ibrcommon::MutexLock l(_lock);
+			for (int i = 0; i < 5; ++i) {
+				const Slot &s = _slots[i];
+				sum.bytes_up += s.bytes_up;
+				sum.bytes_down += s.bytes_down;
+				sum.packets_up += s.packets_up;
+				sum.packets_down += s.packets_down;
+				sum.bundles_up += s.bundles_up;
+				sum.bundles_down += s.bundles_down;
+				sum.latency_sum += s.latency_sum;
+				sum.latency_samples += s.latency_samples;
+			}
+
+			_pos++;
+			if (_pos > 4) _pos = 0;
+			clear(_slots[_pos]);
+		}
+
+		const double ratio_up = (sum.bundles_up > 0) ? static_cast<double>(sum.packets_up) / static_cast<double>(sum.bundles_up) : 0.0;
+		const double ratio_down = (sum.bundles_down > 0) ? static_cast<double>(sum.packets_down) / static_cast<double>(sum.bundles_down) : 0.0;
+		const double latency = (sum.latency_samples > 0) ? (sum.latency_sum / static_cast<double>(sum.latency_samples)) / 1000.0 : 0.0;
+
+		stream << setiosflags(ios::right) << setiosflags(ios::fixed) << setprecision(2);
+		stream << "  up: " << setw(10) << (static_cast<double>(sum.bytes_up) / 1024) << " kB/s " << setw(8) << sum.packets_up << " pkt/s " << setw(6) << ratio_up << " pkt/bundle";
+		stream << "  down: " << setw(10) << (static_cast<double>(sum.bytes_down) / 1024) << " kB/s " << setw(8) << sum.packets_down << " pkt/s " << setw(6) << ratio_down << " pkt/bundle";
+		stream << "  latency: " << setw(8) << latency << " ms\r" << std::flush;
+	}
+
+private:
+	struct Slot
+	{
+		size_t bytes_up;
+		size_t bytes_down;
+		size_t packets_up;
+		size_t packets_down;
+		size_t bundles_up;
+		size_t bundles_down;
+		double latency_sum;
+		size_t latency_samples;
+	};
+
+	static void clear(Slot &s)
+	{
+		s.bytes_up = 0; s.bytes_down = 0;
+		s.packets_up = 0; s.packets_down = 0;
+		s.bundles_up = 0; s.bundles_down = 0;
+		s.latency_sum = 0; s.latency_samples = 0;
+	}
+
+	ibrcommon::Mutex _lock;
+	Slot _slots[5];
+	int _pos;
+};
+
+TunnelStatistics _stats;
+
+/**
+ * Prints the statistics five times per second
+ */
+class TunnelStatisticsPrinter : public ibrcommon::JoinableThread
+{
+public:
+	TunnelStatisticsPrinter() : _running(true) {}
+	virtual ~TunnelStatisticsPrinter() { join(); }
+
+protected:
+	void run() throw ()
+	{
+		while (_running) {
+			ibrcommon::Thread::sleep(200);
+			_stats.print(std::cout);
+		}
+	}
+
+	void __cancellation() throw ()
+	{
+		_running = false;
+	}
+
+private:
+	bool _running;
+};
 
 class TUN2BundleGateway : public dtn::api::Client
 {
+	/**
+	 * Reads the packets of one queue of the tun device and aggregates them
+	 * into bundles within the size and latency budget.
+	 */
+	class QueueWorker : public ibrcommon::JoinableThread
+	{
+		public:
+			QueueWorker(TUN2BundleGateway &gateway, int fd)
+			: _gateway(gateway), _fd(fd), _running(true), _packets(0)
+			{
+			}
+
+			virtual ~QueueWorker()
+			{
+				join();
+			}
+
+		protected:
+			void run() throw ()
+			{
+				char data[65536];
+
+				try {
+					while (_running)
+					{
+						int timeout = 500;
+
+						if (_packets > 0)
+						{
+							// send the aggregated packets if the latency budget is exceeded
+							_age.stop();
+							const double elapsed = _age.getMilliseconds();
+
+							if (elapsed >= static_cast<double>(_gateway._latency)) {
+								flush();
+								continue;
+							}
+
+							timeout = static_cast<int>(static_cast<double>(_gateway._latency) - elapsed) + 1;
+						}
+
+						struct pollfd pfd;
+						pfd.fd = _fd;
+						pfd.events = POLLIN;
+						pfd.revents = 0;
+
+						const int ret = ::poll(&pfd, 1, timeout);
+
+						if (ret < 0) {
+							if (errno == EINTR) continue;
+							throw ibrcommon::Exception(std::string("poll() on tun device failed: ") + strerror(errno));
+						}
+
+						// timeout
+						if (ret == 0) continue;
+
+						if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+							throw ibrcommon::Exception("tun device closed");
+						}
+
+						const ssize_t len = ::read(_fd, data, sizeof(data));
+
+						if (len <= 0) {
+							if ((len < 0) && ((errno == EINTR) || (errno == EAGAIN))) continue;
+							throw ibrcommon::Exception(std::string("read() on tun device failed: ") + strerror(errno));
+						}
+
+						// without aggregation every packet is sent as one bundle,
+						// packets exceeding the 16-bit length field are never aggregated
+						if ((_gateway._aggregate == 0) || (len > 0xffff)) {
+							if (_packets > 0) flush();
+							_gateway.send(data, len, 1);
+							continue;
+						}
+
+						// send the aggregated packets first, if this packet does not fit
+						if ((_packets > 0) && ((_batch.size() + len + 2) > _gateway._aggregate)) {
+							flush();
+						}
+
+						if (_packets == 0) {
+							_batch.push_back(AGGREGATE_MAGIC);
+							_age.start();
+						}
+
+						_batch.push_back(static_cast<char>((len >> 8) & 0xff));
+						_batch.push_back(static_cast<char>(len & 0xff));
+						_batch.insert(_batch.end(), data, data + len);
+						_packets++;
+
+						if (_batch.size() >= _gateway._aggregate) {
+							flush();
+						}
+					}
+
+					if (_packets > 0) flush();
+				} catch (const std::exception &ex) {
+					if (_running) {
+						IBRCOMMON_LOGGER_TAG("Core", error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
+
+						// the tunnel is broken without this queue
+						_gateway._failed = true;
+					}
+				}
+			}
+
+			void __cancellation() throw ()
+			{
+				_running = false;
+			}
+
+		private:
+			void flush()
+			{
+				_gateway.send(&_batch[0], _batch.size(), _packets);
+				_batch.clear();
+				_packets = 0;
+			}
+
+			TUN2BundleGateway &_gateway;
+			int _fd;
+			bool _running;
+
+			// aggregated packets, not sent yet
+			std::vector<char> _batch;
+			size_t _packets;
+			ibrcommon::TimeMeasurement _age;
+	};
+
 	public:
-		TUN2BundleGateway(const std::string &app, ibrcommon::socketstream &stream, const std::string &ptp_dev)
-		: dtn::api::Client(app, stream), _stream(stream), _fd(-1)
+		TUN2BundleGateway(const std::string &app, ibrcommon::socketstream &stream, const std::string &ptp_dev, size_t queues = 1)
+		: dtn::api::Client(app, stream), _stream(stream), _lifetime(60), _aggregate(0), _latency(0), _failed(false)
 		{
 			char tun_name[IFNAMSIZ];
 
 			strcpy(tun_name, ptp_dev.c_str());
-			_fd = tun_alloc(tun_name, IFF_TUN);  /* tun interface */
+
+			short int flags = IFF_TUN;
+#ifdef IFF_MULTI_QUEUE
+			if (queues > 1) flags |= IFF_MULTI_QUEUE;
+#else
+			queues = 1;
+#endif
+
+			// open one file descriptor per queue of the tun interface
+			for (size_t i = 0; i < queues; ++i)
+			{
+				const int fd = tun_alloc(tun_name, flags);
+
+				if (fd < 0) {
+					for (std::vector<int>::iterator it = _fds.begin(); it != _fds.end(); ++it) ::close(*it);
+					throw ibrcommon::Exception("Error: failed to open tun device");
+				}
+
+				_fds.push_back(fd);
+			}
 
 			tun_device = tun_name;
 
-			if (_fd == -1)
-				throw ibrcommon::Exception("Error: failed to open tun device");
+			// limit the number of bundles not yet accepted by the daemon
+			setInflightLimit(256);
 
 			// connect the API
 			this->connect();
@@ -162,64 +418,117 @@ class TUN2BundleGateway : public dtn::api::Client
 		 */
 		virtual ~TUN2BundleGateway()
 		{
+			for (std::vector<QueueWorker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+			{
+				delete (*it);
+			}
+
 			// Close the tcp connection.
 			_stream.close();
 		};
 
+		/**
+		 * Start one worker per queue of the tun device
+		 * @param endpoint Destination of the bundles
+		 * @param lifetime Lifetime of each bundle
+		 * @param aggregate Max. payload size of aggregated bundles, zero disables the aggregation
+		 * @param latency Max. time in milliseconds a packet is held back for aggregation
+		 */
+		void start(const dtn::data::EID &endpoint, unsigned int lifetime, size_t aggregate, unsigned int latency)
+		{
+			_endpoint = endpoint;
+			_lifetime = lifetime;
+			_aggregate = aggregate;
+			_latency = latency;
+
+			for (std::vector<int>::iterator it = _fds.begin(); it != _fds.end(); ++it)
+			{
+				QueueWorker *w = new QueueWorker(*this, *it);
+				_workers.push_back(w);
+				w->start();
+			}
+		}
+
 		void shutdown() {
-			if (_fd < 0) return;
+			if (_fds.empty()) return;
+
+			// stop the workers
+			for (std::vector<QueueWorker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+			{
+				(*it)->stop();
+				(*it)->join();
+			}
 
 			// close client connection
 			this->close();
 
-			// close socket
-			::close(_fd);
-			_fd = -1;
+			// close the queues
+			for (std::vector<int>::iterator it = _fds.begin(); it != _fds.end(); ++it) ::close(*it);
+			_fds.clear();
 		}
 
-		void process(const dtn::data::EID &endpoint, unsigned int lifetime = 60) {
-			if (_fd == -1) throw ibrcommon::Exception("Tunnel closed.");
-
-			char data[65536];
-			ssize_t ret = ::read(_fd, data, sizeof(data));
+		const std::string& getDeviceName() const
+		{
+			return tun_device;
+		}
 
-			if (ret == -1) {
-				throw ibrcommon::Exception("Error: failed to read from tun device");
-			}
+		size_t getQueues() const
+		{
+			return _fds.size();
+		}
 
-			add_throughput_data(ret, 1);
+		/**
+		 * Returns true if one of the workers stopped due to an error
+		 */
+		bool hasFailed() const
+		{
+			return _failed;
+		}
 
+	private:
+		void send(const char *data, size_t length, size_t packets)
+		{
 			// create a blob
 			ibrcommon::BLOB::Reference blob = ibrcommon::BLOB::create();
 
 			// add the data
-			blob.iostream()->write(data, ret);
+			blob.iostream()->write(data, length);
 
 			// create a new bundle
 			dtn::data::Bundle b;
 
-			b.destination = endpoint;
+			b.destination = _endpoint;
 			b.push_back(blob);
-			b.lifetime = lifetime;
+			b.lifetime = _lifetime;
 
-			// transmit the packet
-			(*this) << b;
-			flush();
-		}
+			// the age tells the receiver the end-to-end latency
+			b.push_back<dtn::data::AgeBlock>();
 
-		const std::string& getDeviceName() const
-		{
-			return tun_device;
+			// queue the bundle for transmission
+			submit(b);
+
+			_stats.up(length, packets);
 		}
 
-	private:
 		ibrcommon::socketstream &_stream;
 
-		// file descriptor for the tun device
-		int _fd;
+		// file descriptors for the queues of the tun device
+		std::vector<int> _fds;
+		std::vector<QueueWorker*> _workers;
 
 		std::string tun_device;
 
+		dtn::data::EID _endpoint;
+		unsigned int _lifetime;
+		size_t _aggregate;
+		unsigned int _latency;
+
+		// set by a worker which stopped due to an error
+		bool _failed;
+
+		// buffer for received payloads
+		std::vector<char> _rx_buf;
+
 		/**
 		 * In this API bundles are received asynchronous. To receive bundles it is necessary
 		 * to overload the Client::received()-method. This will be call on a incoming bundles
@@ -227,31 +536,76 @@ class TUN2BundleGateway : public dtn::api::Client
 		 */
 		void received(const dtn::data::Bundle &b)
 		{
+			if (_fds.empty()) return;
+
+			double latency = -1;
+			try {
+				latency = b.find<dtn::data::AgeBlock>().getMicroseconds().get<double>();
+			} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { }
+
 			ibrcommon::BLOB::Reference ref = b.find<dtn::data::PayloadBlock>().getBLOB();
-			ibrcommon::BLOB::iostream stream = ref.iostream();
-			char data[65536];
-			stream->read(data, sizeof(data));
-			size_t ret = stream->gcount();
+			size_t ret = 0;
+
+			{
+				ibrcommon::BLOB::iostream stream = ref.iostream();
+				_rx_buf.resize(std::max(static_cast<size_t>(ref.size()), static_cast<size_t>(1)));
+				stream->read(&_rx_buf[0], _rx_buf.size());
+				ret = stream->gcount();
+			}
 
-			if (::write(_fd, data, ret) < 0)
+			if (ret == 0) return;
+
+			// distribute the packets of a bundle to the queues
+			const int fd = _fds[b.sequencenumber.get<size_t>() % _fds.size()];
+
+			if (_rx_buf[0] != AGGREGATE_MAGIC)
+			{
+				// plain packet
+				if (::write(fd, &_rx_buf[0], ret) < 0)
+				{
+					IBRCOMMON_LOGGER_TAG("Core", error) << "Error while writing" << IBRCOMMON_LOGGER_ENDL;
+				}
+
+				_stats.down(ret, 1, latency);
+				return;
+			}
+
+			// The tun device takes exactly one packet per write call. Write
+			// the packets directly out of the received payload.
+			size_t packets = 0;
+			size_t pos = 1;
+
+			while ((pos + 2) <= ret)
 			{
-				IBRCOMMON_LOGGER_TAG("Core", error) << "Error while writing" << IBRCOMMON_LOGGER_ENDL;
+				const size_t len = (static_cast<unsigned char>(_rx_buf[pos]) << 8) | static_cast<unsigned char>(_rx_buf[pos + 1]);
+				pos += 2;
+
+				if ((pos + len) > ret) {
+					IBRCOMMON_LOGGER_TAG("Core", warning) << "Truncated aggregated bundle" << IBRCOMMON_LOGGER_ENDL;
+					break;
+				}
+
+				if (::write(fd, &_rx_buf[pos], len) < 0)
+				{
+					IBRCOMMON_LOGGER_TAG("Core", error) << "Error while writing" << IBRCOMMON_LOGGER_ENDL;
+				}
+
+				pos += len;
+				packets++;
 			}
 
-			add_throughput_data(ret, 0);
+			_stats.down(ret, packets, latency);
 		}
 };
 
 bool m_running = true;
-TUN2BundleGateway *_gateway = NULL;
 
 void term(int signal)
 {
+	// the main loop shuts down the gateway
 	if (signal >= 1)
 	{
 		m_running = false;
-		if (_gateway != NULL)
-			_gateway->shutdown();
 	}
 }
 
@@ -265,7 +619,12 @@ void print_help(const char *argv0)
 	std::cout << " -d <dev>         Virtual network device to create (default: tun0)" << std::endl;
 	std::cout << " -s <name>        Application suffix of the local endpoint (default: tunnel)" << std::endl;
 	std::cout << " -l <seconds>     Lifetime of each packet (default: 60)" << std::endl;
-	std::cout << " -t               Show throughput" << std::endl;
+	std::cout << " -t               Show statistics (throughput, packets/s, latency and" << std::endl;
+	std::cout << "                  packets per bundle)" << std::endl;
+	std::cout << " -q <queues>      Number of queues of the tun device (default: 1)" << std::endl;
+	std::cout << " -a <bytes>       Aggregate packets into bundles up to this size" << std::endl;
+	std::cout << "                  (default: 0, one packet per bundle)" << std::endl;
+	std::cout << " -L <ms>          Max. time a packet waits for aggregation (default: 5)" << std::endl;
 #ifdef HAVE_LIBDAEMON
 	std::cout << " -D               Daemonize the process" << std::endl;
 	std::cout << " -k               Stop the running daemon" << std::endl;
@@ -294,6 +653,9 @@ int main(int argc, char *argv[])
 	bool stop_daemon = false;
 	std::string pidfile;
 	bool throughput = false;
+	size_t queues = 1;
+	size_t aggregate = 0;
+	unsigned int latency = 5;
 
 	// catch process signals
 	ibrcommon::SignalHandler sighandler(term);
@@ -302,9 +664,9 @@ int main(int argc, char *argv[])
 	sighandler.handle(SIGQUIT);
 
 #ifdef HAVE_LIBDAEMON
-	while ((c = getopt (argc, argv, "td:s:l:hDkp:")) != -1)
+	while ((c = getopt (argc, argv, "td:s:l:q:a:L:hDkp:")) != -1)
 #else
-	while ((c = getopt (argc, argv, "td:s:l:h")) != -1)
+	while ((c = getopt (argc, argv, "td:s:l:q:a:L:h")) != -1)
 #endif
 	switch (c)
 	{
@@ -338,6 +700,19 @@ int main(int argc, char *argv[])
 			lifetime = atoi(optarg);
 			break;
 
+		case 'q':
+			queues = atoi(optarg);
+			if (queues < 1) queues = 1;
+			break;
+
+		case 'a':
+			aggregate = atoi(optarg);
+			break;
+
+		case 'L':
+			latency = atoi(optarg);
+			break;
+
 		default:
 			print_help(argv[0]);
 			return 1;
@@ -504,8 +879,7 @@ int main(int argc, char *argv[])
 
 	try {
 		// set-up tun2bundle gateway
-		TUN2BundleGateway gateway(app_name, conn, ptp_dev);
-		_gateway = &gateway;
+		TUN2BundleGateway gateway(app_name, conn, ptp_dev, queues);
 
 		IBRCOMMON_LOGGER_TAG("Core", info) << "Local:  " << app_name << IBRCOMMON_LOGGER_ENDL;
 		IBRCOMMON_LOGGER_TAG("Core", info) << "Peer:   " << endpoint << IBRCOMMON_LOGGER_ENDL;
@@ -516,42 +890,37 @@ int main(int argc, char *argv[])
 		IBRCOMMON_LOGGER_TAG("Core", notice) << "# sudo ip addr add 10.0.0.1/24 dev " << gateway.getDeviceName() << IBRCOMMON_LOGGER_ENDL;
 		IBRCOMMON_LOGGER_TAG("Core", notice) << IBRCOMMON_LOGGER_ENDL;
 
-		timer_t timerid;
-		struct sigevent sev;
+		if (gateway.getQueues() > 1) {
+			IBRCOMMON_LOGGER_TAG("Core", info) << "Queues: " << gateway.getQueues() << IBRCOMMON_LOGGER_ENDL;
+		}
 
-		if (!daemonize && throughput) {
-			// enable throughput timer
-			signal(SIGRTMIN, timer_display_throughput);
+		// print the statistics
+		TunnelStatisticsPrinter printer;
+		if (!daemonize && throughput) printer.start();
 
-			sev.sigev_notify = SIGEV_SIGNAL;
-			sev.sigev_signo = SIGRTMIN;
-			sev.sigev_value.sival_ptr = &timerid;
+		// start the workers for the queues of the tun device
+		gateway.start(dtn::data::EID(endpoint), lifetime, aggregate, latency);
 
-			// create a timer
-			timer_create(CLOCK_MONOTONIC, &sev, &timerid);
+		bool failed = false;
 
-			// arm the timer
-			struct itimerspec its;
-			size_t freq_nanosecs = 200000000;
-			its.it_value.tv_sec = freq_nanosecs / 1000000000;;
-			its.it_value.tv_nsec = freq_nanosecs % 1000000000;
-			its.it_interval.tv_sec = its.it_value.tv_sec;
-			its.it_interval.tv_nsec = its.it_value.tv_nsec;
+		while (m_running)
+		{
+			ibrcommon::Thread::sleep(500);
 
-			if (timer_settime(timerid, 0, &its, NULL) == -1) {
-				IBRCOMMON_LOGGER_TAG("Core", error) << "Timer set failed." << IBRCOMMON_LOGGER_ENDL;
+			// shut down if a worker failed
+			if (gateway.hasFailed()) {
+				m_running = false;
+				failed = true;
 			}
 		}
 
-		// destination
-		dtn::data::EID eid(endpoint);
+		printer.stop();
+		gateway.shutdown();
 
-		while (m_running)
-		{
-			gateway.process(eid, lifetime);
+		if (failed) {
+			IBRCOMMON_LOGGER_TAG("Core", error) << "Tunnel stopped due to an error" << IBRCOMMON_LOGGER_ENDL;
+			return -1;
 		}
-
-		gateway.shutdown();
 	} catch (const ibrcommon::Exception &ex) {
 		if (m_running) {
 			IBRCOMMON_LOGGER_TAG("Core", error) << ex.what() << IBRCOMMON_LOGGER_ENDL;
@@ -24,7 +24,10 @@
 
 BundleStream::BundleStream(ibrcommon::socketstream &stream, size_t min_chunk_size, size_t max_chunk_size, const std::string &app, const dtn::data::EID &group, bool wait_seq_zero)
  : dtn::api::Client(app, group, stream), _stream(stream), _buf(*this, _chunk, min_chunk_size, max_chunk_size, wait_seq_zero), _auto_flush(false)
-{}
+{
+	// limit the number of chunks not yet accepted by the daemon
+	setInflightLimit(8);
+}
 
 BundleStream::~BundleStream() {}
 
@@ -49,6 +52,26 @@ void BundleStream::setReceiveTimeout(unsigned int timeout)
 	_buf.setReceiveTimeout(timeout);
 }
 
+void BundleStream::setFlushDeadline(unsigned int ms)
+{
+	_buf.setFlushDeadline(ms);
+}
+
+void BundleStream::setLossTolerant(bool val)
+{
+	_buf.setLossTolerant(val);
+}
+
+void BundleStream::setReorderWindow(size_t chunks)
+{
+	_buf.setReorderWindow(chunks);
+}
+
+BundleStreamBuf::Statistics BundleStream::getStatistics()
+{
+	return _buf.getStatistics();
+}
+
 void BundleStream::received(const dtn::data::Bundle &b)
 {
 	// check if the received bundle contains an administrative record
@@ -68,8 +91,8 @@ void BundleStream::received(const dtn::data::Bundle &b)
 				// store the received ack
 				_last_delivery_ack = report.bundleid;
 
-				// flush the buffer
-				_buf.flush();
+				// flush the buffer, without blocking the receiver
+				_buf.requestFlush();
 			}
 
 			return;
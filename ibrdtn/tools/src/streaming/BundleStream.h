@@ -51,6 +51,26 @@ public:
 	 */
 	void setReceiveTimeout(unsigned int timeout);
 
+	/**
+	 * Send out a chunk at latest after the given number of milliseconds
+	 */
+	void setFlushDeadline(unsigned int ms);
+
+	/**
+	 * Skip missing chunks instead of waiting for them
+	 */
+	void setLossTolerant(bool val);
+
+	/**
+	 * Set the size of the reorder buffer in chunks
+	 */
+	void setReorderWindow(size_t chunks);
+
+	/**
+	 * Returns the latency and jitter statistics of the received chunks
+	 */
+	BundleStreamBuf::Statistics getStatistics();
+
 protected:
 	/**
 	 * @see dtn::api::Client::received()
@@ -21,20 +21,38 @@
 
 #include "streaming/BundleStreamBuf.h"
 #include <ibrdtn/data/StreamBlock.h>
-#include <ibrcommon/TimeMeasurement.h>
+#include <ibrdtn/data/AgeBlock.h>
+#include <ibrdtn/data/PayloadBlock.h>
+#include <ibrcommon/thread/MutexLock.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+const size_t BundleStreamBuf::MAX_REORDER_WINDOW = 65536;
 
 BundleStreamBuf::BundleStreamBuf(dtn::api::Client &client, StreamBundle &chunk, size_t min_buffer, size_t max_buffer, bool wait_seq_zero)
  : _in_buf(min_buffer), _out_buf(min_buffer), _client(client), _chunk(chunk),
-   _min_buf_size(min_buffer), _max_buf_size(max_buffer), _chunk_offset(0), _in_seq(0),
-   _streaming(wait_seq_zero), _request_ack(false), _flush_request(false), _receive_timeout(0)
+   _min_buf_size(min_buffer), _max_buf_size(max_buffer), _chunk_target(min_buffer),
+   _flush_deadline(0), _timer(*this), _timer_started(false),
+   _chunks(64, NULL), _chunks_count(0), _current(NULL), _chunk_offset(0), _in_seq(0), _highest_seq(0),
+   _streaming(wait_seq_zero), _request_ack(false), _flush_request(false), _loss_tolerant(false), _receive_timeout(0)
 {
 	// Initialize get pointer.  This should be zero so that underflow is called upon first read.
 	setg(0, 0, 0);
-	setp(&_in_buf[0], &_in_buf[__get_next_buffer_size() - 1]);
+	setp(&_in_buf[0], &_in_buf[0] + _in_buf.size() - 1);
 }
 
 BundleStreamBuf::~BundleStreamBuf()
 {
+	_timer.stop();
+	_timer.join();
+
+	for (std::vector<Chunk*>::iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		delete (*it);
+	}
+
+	delete _current;
 }
 
 /**
@@ -43,7 +61,7 @@ BundleStreamBuf::~BundleStreamBuf()
 void BundleStreamBuf::flush()
 {
 	// lock the data structures
-	ibrcommon::MutexLock l(_chunks_cond);
+	ibrcommon::MutexLock l(_out_cond);
 
 	if (_chunk.size() == 0) {
 		_flush_request = true;
@@ -53,11 +71,64 @@ void BundleStreamBuf::flush()
 	__flush();
 }
 
+void BundleStreamBuf::requestFlush()
+{
+	ibrcommon::MutexLock l(_out_cond);
+	_flush_request = true;
+	_out_cond.signal(true);
+
+	__start_timer();
+}
+
 void BundleStreamBuf::setReceiveTimeout(dtn::data::Timeout timeout)
 {
 	_receive_timeout = timeout;
 }
 
+void BundleStreamBuf::setFlushDeadline(dtn::data::Timeout ms)
+{
+	ibrcommon::MutexLock l(_out_cond);
+	_flush_deadline = ms;
+	_out_cond.signal(true);
+
+	if (ms > 0) __start_timer();
+}
+
+void BundleStreamBuf::setLossTolerant(bool val)
+{
+	ibrcommon::MutexLock l(_chunks_cond);
+	_loss_tolerant = val;
+	_chunks_cond.signal(true);
+}
+
+void BundleStreamBuf::setReorderWindow(size_t chunks)
+{
+	ibrcommon::MutexLock l(_chunks_cond);
+	if (chunks == 0) chunks = 1;
+	if (chunks > MAX_REORDER_WINDOW) chunks = MAX_REORDER_WINDOW;
+
+	// the buffer can not shrink below the number of buffered sequence numbers
+	if ((_chunks_count > 0) && (chunks < (_highest_seq - _in_seq).get<size_t>() + 1)) return;
+
+	__resize(chunks);
+}
+
+BundleStreamBuf::Statistics BundleStreamBuf::getStatistics()
+{
+	ibrcommon::MutexLock l(_chunks_cond);
+	return _stats;
+}
+
+void BundleStreamBuf::__start_timer()
+{
+	if (_timer_started) return;
+
+	try {
+		_timer.start();
+		_timer_started = true;
+	} catch (const ibrcommon::ThreadException&) { }
+}
+
 void BundleStreamBuf::__flush()
 {
 	// request delivery acks
@@ -66,22 +137,71 @@ void BundleStreamBuf::__flush()
 		_chunk.reportto = dtn::data::EID("api:me");
 	}
 
-	// send the current chunk and clear it
-	_client << _chunk; _client.flush();
-	_chunk.clear();
+	// Adapt the chunk size to the load. If the daemon has not accepted the
+	// previous chunks yet, larger chunks reduce the per-bundle overhead. If
+	// it keeps up, smaller chunks reduce the latency.
+	const dtn::data::Size inflight = _client.getInflight();
+	if (inflight > 1)
+	{
+		_chunk_target = std::min(_chunk_target * 2, _max_buf_size);
+	}
+	else if ((inflight == 0) && (_chunk_target > _min_buf_size))
+	{
+		_chunk_target = std::max(_chunk_target / 2, _min_buf_size);
+	}
 
+	// hand over the current chunk, its payload is not copied
+	const dtn::data::Bundle b = _chunk;
+	_chunk.clear();
 	_flush_request = false;
+
+	// Do not hold the chunk lock while the submission blocks. The send lock
+	// keeps the chunks in order of their sequence numbers.
+	_send_lock.enter();
+	_out_cond.leave();
+
+	try {
+		_client.submit(b);
+	} catch (...) {
+		_send_lock.leave();
+		_out_cond.enter();
+		throw;
+	}
+
+	_send_lock.leave();
+	_out_cond.enter();
 }
 
-size_t BundleStreamBuf::__get_next_buffer_size() const
+void BundleStreamBuf::__append(const char *data, size_t length)
 {
-	if ((_chunk.size() + _min_buf_size) <= _max_buf_size)
+	while (length > 0)
 	{
-		return _min_buf_size;
+		// start the deadline with the first byte of a chunk
+		if (_chunk.size() == 0)
+		{
+			_chunk_age.start();
+			_out_cond.signal(true);
+		}
+
+		// fill the chunk up to the current chunk size
+		const size_t space = (_chunk_target > _chunk.size()) ? (_chunk_target - _chunk.size()) : 0;
+		const size_t len = std::min(space, length);
+
+		// copy data into the bundles payload
+		if (len > 0) _chunk.append(data, len);
+		data += len;
+		length -= len;
+
+		// if size exceeds chunk limit, send it
+		if (_chunk.size() >= _chunk_target)
+		{
+			__flush();
+		}
 	}
-	else
+
+	if (_flush_request && (_chunk.size() > 0))
 	{
-		return _max_buf_size - _chunk.size();
+		__flush();
 	}
 }
 
@@ -98,8 +218,12 @@ int BundleStreamBuf::sync()
 
 void BundleStreamBuf::setRequestAck(bool val)
 {
+	ibrcommon::MutexLock l(_out_cond);
 	_request_ack = val;
 	_flush_request = val;
+
+	// flushes requested by status reports are done by the timer
+	if (val) __start_timer();
 }
 
 std::char_traits<char>::int_type BundleStreamBuf::overflow(std::char_traits<char>::int_type c)
@@ -119,147 +243,413 @@ std::char_traits<char>::int_type BundleStreamBuf::overflow(std::char_traits<char
 	}
 
 	// lock the data structures
-	ibrcommon::MutexLock l(_chunks_cond);
+	ibrcommon::MutexLock l(_out_cond);
+
+	// mark the buffer as free
+	setp(&_in_buf[0], &_in_buf[0] + _in_buf.size() - 1);
 
 	// copy data into the bundles payload
-	_chunk.append(&_in_buf[0], iend - ibegin);
+	__append(ibegin, iend - ibegin);
 
-	// mark the buffer as free
-	setp(&_in_buf[0], &_in_buf[__get_next_buffer_size() - 1]);
+	return std::char_traits<char>::not_eof(c);
+}
 
-	// if size exceeds chunk limit, send it
-	if ((_chunk.size() >= _max_buf_size) || _flush_request)
+std::streamsize BundleStreamBuf::xsputn(const char *s, std::streamsize n)
+{
+	// lock the data structures
+	ibrcommon::MutexLock l(_out_cond);
+
+	// data in the put area goes first
+	if (pptr() > pbase())
 	{
-		__flush();
+		const size_t pending = pptr() - pbase();
+		setp(&_in_buf[0], &_in_buf[0] + _in_buf.size() - 1);
+		__append(&_in_buf[0], pending);
 	}
 
-	return std::char_traits<char>::not_eof(c);
+	// append the data directly to the payload without buffering it
+	__append(s, n);
+
+	return n;
 }
 
 void BundleStreamBuf::received(const dtn::data::Bundle &b)
 {
+	Chunk *c = NULL;
+
 	try {
 		// get the stream block of the bundle - drop bundles without it
-		const StreamBlock &block = b.find<StreamBlock>();
+		c = new Chunk(b);
+	} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) {
+		return;
+	}
+
+	// lock the data structures
+	ibrcommon::MutexLock l(_chunks_cond);
 
-		// lock the data structures
-		ibrcommon::MutexLock l(_chunks_cond);
+	// start with the first received chunk if we do not wait for seqno zero
+	if (!_streaming)
+	{
+		_in_seq = c->_seq;
+		_highest_seq = c->_seq;
+		_streaming = true;
+	}
 
-		// check if the sequencenumber is already received
-		if (_in_seq < block.getSequenceNumber()) return;
+	// check if the sequencenumber is already passed
+	if (c->_seq < _in_seq)
+	{
+		_stats.late++;
+		delete c;
+		return;
+	}
 
-		// insert the received chunk into the chunk set
-		_chunks.insert(Chunk(b));
+	const size_t offset = (c->_seq - _in_seq).get<size_t>();
 
-		// unblock reading processes
-		_chunks_cond.signal(true);
-	} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { }
+	if (offset >= _chunks.size())
+	{
+		if (!_loss_tolerant && (offset < MAX_REORDER_WINDOW))
+		{
+			// grow the reorder buffer to the next power of two
+			size_t size = _chunks.size();
+			while (size <= offset) size <<= 1;
+			__resize((size < MAX_REORDER_WINDOW) ? size : MAX_REORDER_WINDOW);
+		}
+		else
+		{
+			// move the window forward and skip the chunks outside of it,
+			// a lossless stream does this only if the gap exceeds the maximum
+			__slide(c->_seq - dtn::data::Number(_chunks.size() - 1));
+		}
+	}
+
+	Chunk *&slot = _chunks[__index(c->_seq)];
+
+	if (slot != NULL)
+	{
+		_stats.duplicates++;
+		delete c;
+		return;
+	}
+
+	if (c->_seq < _highest_seq) _stats.reordered++;
+	else _highest_seq = c->_seq;
+
+	// insert the received chunk into the reorder buffer
+	slot = c;
+	_chunks_count++;
+
+	// unblock reading processes
+	_chunks_cond.signal(true);
 }
 
-std::char_traits<char>::int_type BundleStreamBuf::underflow()
+size_t BundleStreamBuf::__index(const dtn::data::Number &seq) const
 {
-	ibrcommon::MutexLock l(_chunks_cond);
+	return seq.get<size_t>() % _chunks.size();
+}
+
+void BundleStreamBuf::__slide(const dtn::data::Number &base)
+{
+	if (!(_in_seq < base)) return;
+
+	const dtn::data::Number gap = base - _in_seq;
 
-	return __underflow();
+	if (gap < dtn::data::Number(_chunks.size()))
+	{
+		// drop the buffered chunks in front of the new start
+		for (; _in_seq < base; _in_seq++)
+		{
+			Chunk *&slot = _chunks[__index(_in_seq)];
+			if (slot == NULL) continue;
+
+			delete slot;
+			slot = NULL;
+			_chunks_count--;
+		}
+	}
+	else
+	{
+		// the gap covers the whole buffer, drop all chunks
+		for (std::vector<Chunk*>::iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+		{
+			delete (*it);
+			(*it) = NULL;
+		}
+
+		_chunks_count = 0;
+		_in_seq = base;
+	}
+
+	_stats.lost += gap.get<size_t>();
+}
+
+void BundleStreamBuf::__resize(size_t size)
+{
+	std::vector<Chunk*> chunks(size, NULL);
+
+	for (std::vector<Chunk*>::iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		if ((*it) == NULL) continue;
+		chunks[(*it)->_seq.get<size_t>() % size] = (*it);
+	}
+
+	_chunks.swap(chunks);
 }
 
-std::char_traits<char>::int_type BundleStreamBuf::__underflow()
+void BundleStreamBuf::__skip()
 {
-	// receive chunks until the next sequence number is received
-	while (_chunks.empty())
+	while (_chunks[__index(_in_seq)] == NULL)
 	{
-		// wait for the next bundle
-		_chunks_cond.wait();
+		_stats.lost++;
+		_in_seq++;
 	}
+}
 
+void BundleStreamBuf::__next_chunk()
+{
 	ibrcommon::TimeMeasurement tm;
 	tm.start();
 
 	// while not the right sequence number received -> wait
-	while ((_in_seq != (*_chunks.begin())._seq))
+	while (true)
 	{
-		try {
-			// wait for the next bundle
-			_chunks_cond.wait(1000);
-		} catch (const ibrcommon::Conditional::ConditionalAbortException&) { };
+		Chunk *&slot = _chunks[__index(_in_seq)];
 
-		tm.stop();
-		if (((_receive_timeout > 0) && (tm.getSeconds() > _receive_timeout)) || !_streaming)
+		if (_streaming && (slot != NULL))
 		{
-			// skip the missing bundles and proceed with the last received one
-			_in_seq = (*_chunks.begin())._seq;
-
-			// set streaming to active
-			_streaming = true;
+			_current = slot;
+			slot = NULL;
+			_chunks_count--;
+			_in_seq++;
+
+			// the age of the chunk on play out is the end-to-end latency
+			_stats.chunks++;
+			if (_current->_has_age)
+			{
+				_current->_received.stop();
+				_stats.add(_current->_age.get<double>() + _current->_received.getMicroseconds());
+			}
+			return;
 		}
-	}
 
-	// get the first chunk in the buffer
-	const Chunk &c = (*_chunks.begin());
+		if (_chunks_count > 0)
+		{
+			tm.stop();
+
+			if (_loss_tolerant && ((_receive_timeout == 0) || (static_cast<dtn::data::Timeout>(tm.getSeconds()) >= _receive_timeout)))
+			{
+				// skip the missing chunks and proceed with the next available one
+				__skip();
+				continue;
+			}
+
+			if (!_loss_tolerant && (_receive_timeout > 0) && (static_cast<dtn::data::Timeout>(tm.getSeconds()) > _receive_timeout))
+			{
+				// skip the missing bundles and proceed with the next received one
+				__skip();
+				continue;
+			}
+		}
 
-	dtn::data::Bundle b = c._bundle;
-	ibrcommon::BLOB::Reference r = b.find<dtn::data::PayloadBlock>().getBLOB();
+		try {
+			// wait for the next bundle
+			_chunks_cond.wait((_chunks_count > 0) ? 100 : 0);
+		} catch (const ibrcommon::Conditional::ConditionalAbortException&) { };
+	}
+}
 
-	// get stream lock
-	ibrcommon::BLOB::iostream stream = r.iostream();
+std::streamsize BundleStreamBuf::__read(char *s, std::streamsize n)
+{
+	while (true)
+	{
+		if (_current == NULL) __next_chunk();
 
-	// jump to the offset position
-	(*stream).seekg(_chunk_offset, ios::beg);
+		const size_t size = _current->_payload.size();
 
-	// copy the data of the last received bundle into the buffer
-	(*stream).read(&_out_buf[0], _out_buf.size());
+		if (_chunk_offset < size)
+		{
+			const size_t len = std::min(static_cast<size_t>(n), size - _chunk_offset);
 
-	// get the read bytes
-	size_t bytes = (*stream).gcount();
+			// get stream lock
+			ibrcommon::BLOB::iostream stream = _current->_payload.iostream();
 
-	if ((*stream).eof())
-	{
-		// delete the last chunk
-		_chunks.erase(c);
+			// jump to the offset position
+			(*stream).seekg(_chunk_offset, ios::beg);
 
-		// reset the chunk offset
-		_chunk_offset = 0;
+			// copy the data of the current chunk into the buffer
+			(*stream).read(s, len);
 
-		// increment sequence number
-		_in_seq++;
+			// get the read bytes
+			const size_t bytes = (*stream).gcount();
 
-		// if no more bytes are read, get the next bundle -> call underflow() recursive
-		if (bytes == 0)
-		{
-			return __underflow();
+			if (bytes > 0)
+			{
+				_chunk_offset += bytes;
+				return bytes;
+			}
 		}
+
+		// delete the finished chunk and proceed with the next one
+		delete _current;
+		_current = NULL;
+		_chunk_offset = 0;
 	}
-	else
+}
+
+std::char_traits<char>::int_type BundleStreamBuf::underflow()
+{
+	if (gptr() < egptr())
 	{
-		// increment the chunk offset
-		_chunk_offset += bytes;
+		return std::char_traits<char>::to_int_type(*gptr());
 	}
 
+	ibrcommon::MutexLock l(_chunks_cond);
+
+	const std::streamsize bytes = __read(&_out_buf[0], _out_buf.size());
+
 	// Since the input buffer content is now valid (or is new)
 	// the get pointer should be initialized (or reset).
 	setg(&_out_buf[0], &_out_buf[0], &_out_buf[0] + bytes);
 
-	return std::char_traits<char>::not_eof(_out_buf[0]);
+	return std::char_traits<char>::to_int_type(_out_buf[0]);
+}
+
+std::streamsize BundleStreamBuf::xsgetn(char *s, std::streamsize n)
+{
+	std::streamsize ret = 0;
+
+	while (ret < n)
+	{
+		// serve buffered data first
+		const std::streamsize avail = egptr() - gptr();
+		if (avail > 0)
+		{
+			const std::streamsize len = std::min(avail, n - ret);
+			::memcpy(s + ret, gptr(), len);
+			gbump(static_cast<int>(len));
+			ret += len;
+			continue;
+		}
+
+		if ((n - ret) >= static_cast<std::streamsize>(_out_buf.size()))
+		{
+			// read large requests directly into the target buffer
+			ibrcommon::MutexLock l(_chunks_cond);
+			ret += __read(s + ret, n - ret);
+		}
+		else
+		{
+			underflow();
+		}
+	}
+
+	return ret;
 }
 
 BundleStreamBuf::Chunk::Chunk(const dtn::data::Bundle &b)
- : _bundle(b), _seq(0)
+ : _seq(0), _payload(b.find<dtn::data::PayloadBlock>().getBLOB()), _age(0), _has_age(false)
 {
 	// get the stream block of the bundle - drop bundles without it
-	const StreamBlock &block = b.find<StreamBlock>();
+	const dtn::data::StreamBlock &block = b.find<dtn::data::StreamBlock>();
 	_seq = block.getSequenceNumber();
+
+	try {
+		_age = b.find<dtn::data::AgeBlock>().getMicroseconds();
+		_has_age = true;
+	} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { }
+
+	_received.start();
 }
 
 BundleStreamBuf::Chunk::~Chunk()
 {
 }
 
-bool BundleStreamBuf::Chunk::operator==(const Chunk& other) const
+BundleStreamBuf::FlushTimer::FlushTimer(BundleStreamBuf &buf)
+ : _buf(buf), _running(true)
+{
+}
+
+BundleStreamBuf::FlushTimer::~FlushTimer()
+{
+}
+
+void BundleStreamBuf::FlushTimer::__cancellation() throw ()
+{
+	ibrcommon::MutexLock l(_buf._out_cond);
+	_running = false;
+	_buf._out_cond.abort();
+}
+
+void BundleStreamBuf::FlushTimer::run() throw ()
+{
+	try {
+		ibrcommon::MutexLock l(_buf._out_cond);
+
+		while (_running)
+		{
+			if (_buf._chunk.size() == 0)
+			{
+				_buf._out_cond.wait();
+				continue;
+			}
+
+			if (_buf._flush_request)
+			{
+				_buf.__flush();
+				continue;
+			}
+
+			if (_buf._flush_deadline == 0)
+			{
+				_buf._out_cond.wait();
+				continue;
+			}
+
+			_buf._chunk_age.stop();
+			const double age = _buf._chunk_age.getMilliseconds();
+
+			if (age >= static_cast<double>(_buf._flush_deadline))
+			{
+				_buf.__flush();
+				continue;
+			}
+
+			try {
+				_buf._out_cond.wait(static_cast<size_t>(std::ceil(_buf._flush_deadline - age)));
+			} catch (const ibrcommon::Conditional::ConditionalAbortException &ex) {
+				if (ex.reason == ibrcommon::Conditional::ConditionalAbortException::COND_ABORT) throw;
+			}
+		}
+	} catch (const ibrcommon::Conditional::ConditionalAbortException&) {
+		// timer has been stopped
+	} catch (const std::exception&) {
+		// connection is down
+	}
+}
+
+BundleStreamBuf::Statistics::Statistics()
+ : chunks(0), lost(0), late(0), duplicates(0), reordered(0),
+   latency_min(0), latency_max(0), latency_avg(0), jitter(0), _samples(0), _last_latency(0)
+{
+}
+
+BundleStreamBuf::Statistics::~Statistics()
 {
-	return (_seq == other._seq);
 }
 
-bool BundleStreamBuf::Chunk::operator<(const Chunk& other) const
+void BundleStreamBuf::Statistics::add(double latency)
 {
-	return (_seq < other._seq);
+	if ((_samples == 0) || (latency < latency_min)) latency_min = latency;
+	if ((_samples == 0) || (latency > latency_max)) latency_max = latency;
+
+	_samples++;
+	latency_avg += (latency - latency_avg) / static_cast<double>(_samples);
+
+	// interarrival jitter as defined in RFC 3550
+	if (_samples > 1)
+	{
+		jitter += (std::fabs(latency - _last_latency) - jitter) / 16.0;
+	}
+
+	_last_latency = latency;
 }
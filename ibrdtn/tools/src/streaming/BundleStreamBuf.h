@@ -23,8 +23,11 @@
 #include <ibrdtn/api/Client.h>
 #include <ibrdtn/data/Number.h>
 #include <ibrdtn/data/Bundle.h>
+#include <ibrcommon/data/BLOB.h>
+#include <ibrcommon/thread/Thread.h>
+#include <ibrcommon/thread/Conditional.h>
+#include <ibrcommon/TimeMeasurement.h>
 #include <iostream>
-#include <set>
 #include <vector>
 
 #ifndef BUNDLESTREAMBUF_H_
@@ -33,6 +36,45 @@
 class BundleStreamBuf : public std::basic_streambuf<char, std::char_traits<char> >
 {
 public:
+	/**
+	 * Statistics about the received chunks
+	 */
+	class Statistics
+	{
+	public:
+		Statistics();
+		virtual ~Statistics();
+
+		// number of chunks played out
+		dtn::data::Size chunks;
+
+		// number of chunks skipped, because they did not arrive in time
+		dtn::data::Size lost;
+
+		// number of chunks received after their sequence number has been passed
+		dtn::data::Size late;
+
+		// number of chunks received twice
+		dtn::data::Size duplicates;
+
+		// number of chunks received out of order
+		dtn::data::Size reordered;
+
+		// end-to-end latency in microseconds (age of the chunk on play out)
+		double latency_min;
+		double latency_max;
+		double latency_avg;
+
+		// inter-arrival jitter in microseconds as defined in RFC 3550
+		double jitter;
+
+		void add(double latency);
+
+	private:
+		dtn::data::Size _samples;
+		double _last_latency;
+	};
+
 	BundleStreamBuf(dtn::api::Client &client, StreamBundle &chunk, size_t min_buffer, size_t max_buffer, bool wait_seq_zero = false);
 	virtual ~BundleStreamBuf();
 
@@ -46,6 +88,12 @@ public:
 	 */
 	void flush();
 
+	/**
+	 * Send out the buffered bundle from the flush timer. In contrast to flush()
+	 * this call does not block and is safe to use from the receiver thread.
+	 */
+	void requestFlush();
+
 	/**
 	 * Request Acks for the chunks
 	 */
@@ -56,15 +104,41 @@ public:
 	 */
 	void setReceiveTimeout(dtn::data::Timeout timeout);
 
+	/**
+	 * Send out a chunk at latest after the given number of milliseconds,
+	 * even if it has not reached the current chunk size. Zero disables
+	 * the deadline.
+	 */
+	void setFlushDeadline(dtn::data::Timeout ms);
+
+	/**
+	 * Skip missing chunks instead of waiting for them. A missing chunk is
+	 * skipped as soon as a later chunk is available, or if the reorder
+	 * window is exceeded.
+	 */
+	void setLossTolerant(bool val);
+
+	/**
+	 * Set the number of chunks the reorder buffer can hold. In lossless mode
+	 * the buffer grows beyond this size if necessary, up to MAX_REORDER_WINDOW
+	 * chunks.
+	 */
+	void setReorderWindow(size_t chunks);
+
+	/**
+	 * Returns a copy of the receiver statistics
+	 */
+	Statistics getStatistics();
+
 protected:
 	virtual int sync();
 	virtual std::char_traits<char>::int_type overflow(std::char_traits<char>::int_type = std::char_traits<char>::eof());
+	virtual std::streamsize xsputn(const char *s, std::streamsize n);
 	virtual std::char_traits<char>::int_type underflow();
-	std::char_traits<char>::int_type __underflow();
+	virtual std::streamsize xsgetn(char *s, std::streamsize n);
 
 	void __flush();
-
-	size_t __get_next_buffer_size() const;
+	void __append(const char *data, size_t length);
 
 private:
 	class Chunk
@@ -73,13 +147,77 @@ private:
 		Chunk(const dtn::data::Bundle &b);
 		virtual ~Chunk();
 
-		bool operator==(const Chunk& other) const;
-		bool operator<(const Chunk& other) const;
-
-		dtn::data::Bundle _bundle;
 		dtn::data::Number _seq;
+
+		// reference to the payload, the data itself is never copied
+		ibrcommon::BLOB::Reference _payload;
+
+		// age of the chunk on reception in microseconds
+		dtn::data::Number _age;
+		bool _has_age;
+
+		// time elapsed since the reception
+		ibrcommon::TimeMeasurement _received;
 	};
 
+	/**
+	 * Sends out the current chunk when its deadline is reached
+	 */
+	class FlushTimer : public ibrcommon::JoinableThread
+	{
+	public:
+		FlushTimer(BundleStreamBuf &buf);
+		virtual ~FlushTimer();
+
+	protected:
+		void run() throw ();
+		void __cancellation() throw ();
+
+	private:
+		BundleStreamBuf &_buf;
+		bool _running;
+	};
+
+	/**
+	 * Wait until the chunk with the next sequence number is available
+	 * and make it the current chunk
+	 */
+	void __next_chunk();
+
+	/**
+	 * Read data of the current chunk
+	 */
+	std::streamsize __read(char *s, std::streamsize n);
+
+	/**
+	 * Skip all sequence numbers up to the next available chunk
+	 */
+	void __skip();
+
+	/**
+	 * Move the start of the reorder buffer forward to the given sequence
+	 * number and count the skipped sequence numbers as lost
+	 */
+	void __slide(const dtn::data::Number &base);
+
+	/**
+	 * Resize the reorder buffer
+	 */
+	void __resize(size_t size);
+
+	// upper bound of the reorder buffer size
+	static const size_t MAX_REORDER_WINDOW;
+
+	/**
+	 * Returns the position of a sequence number in the reorder buffer
+	 */
+	size_t __index(const dtn::data::Number &seq) const;
+
+	/**
+	 * Start the flush timer if not already running
+	 */
+	void __start_timer();
+
 	// Input buffer
 	std::vector<char> _in_buf;
 	// Output buffer
@@ -94,16 +232,38 @@ private:
 	// maximum buffer size
 	size_t _max_buf_size;
 
+	// current chunk size, between the minimum and the maximum
+	size_t _chunk_target;
+
+	// protects the outgoing chunk
+	ibrcommon::Conditional _out_cond;
+	dtn::data::Timeout _flush_deadline;
+	ibrcommon::TimeMeasurement _chunk_age;
+	FlushTimer _timer;
+	bool _timer_started;
+
+	// serializes the submission of chunks
+	ibrcommon::Mutex _send_lock;
+
+	// reorder buffer, indexed by the sequence number modulo its size
 	ibrcommon::Conditional _chunks_cond;
-	std::set<Chunk> _chunks;
+	std::vector<Chunk*> _chunks;
+	size_t _chunks_count;
+
+	// the chunk currently read
+	Chunk *_current;
 	size_t _chunk_offset;
 
 	dtn::data::Number _in_seq;
+	dtn::data::Number _highest_seq;
 	bool _streaming;
 	bool _request_ack;
 	bool _flush_request;
+	bool _loss_tolerant;
 
 	dtn::data::Timeout _receive_timeout;
+
+	Statistics _stats;
 };
 
 #endif /* BUNDLESTREAMBUF_H_ */
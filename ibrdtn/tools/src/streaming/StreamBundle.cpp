@@ -21,6 +21,7 @@
 
 #include "streaming/StreamBundle.h"
 #include <ibrdtn/data/StreamBlock.h>
+#include <ibrdtn/data/AgeBlock.h>
 
 StreamBundle::StreamBundle()
  : _ref(ibrcommon::BLOB::create())
@@ -42,6 +43,12 @@ StreamBundle::~StreamBundle()
 
 void StreamBundle::append(const char* data, size_t length)
 {
+	// the age of the chunk starts with its first byte
+	if ((_ref.size() == 0) && (find(dtn::data::AgeBlock::BLOCK_TYPE) == end()))
+	{
+		push_back<dtn::data::AgeBlock>();
+	}
+
 	ibrcommon::BLOB::iostream stream = _ref.iostream();
 	(*stream).seekp(0, ios::end);
 	(*stream).write(data, length);
@@ -49,14 +56,26 @@ void StreamBundle::append(const char* data, size_t length)
 
 void StreamBundle::clear()
 {
-	ibrcommon::BLOB::iostream stream = _ref.iostream();
-	stream.clear();
+	// The blocks of this chunk may still be referenced by bundles queued for
+	// transmission. Instead of modifying them, replace them with new blocks.
+	dtn::data::Number seq = 0;
 
-	// increment the sequence number
 	try {
-		dtn::data::StreamBlock &block = find<dtn::data::StreamBlock>();
-		block.setSequenceNumber(block.getSequenceNumber() + 1);
+		seq = find<dtn::data::StreamBlock>().getSequenceNumber() + 1;
 	} catch (const dtn::data::Bundle::NoSuchBlockFoundException&) { };
+
+	dtn::data::Bundle::clear();
+
+	// increment the sequence number
+	dtn::data::StreamBlock &block = push_front<dtn::data::StreamBlock>();
+	block.setSequenceNumber(seq);
+
+	// create a new payload
+	_ref = ibrcommon::BLOB::create();
+	push_back(_ref);
+
+	// assign a new bundle id to the next chunk
+	relabel();
 }
 
 size_t StreamBundle::size()
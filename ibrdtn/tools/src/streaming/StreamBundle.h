@@ -38,7 +38,9 @@ public:
 	void append(const char* data, size_t length);
 
 	/**
-	 * deletes the hole payload of the bundle
+	 * Start the next chunk with an empty payload and the next sequence number.
+	 * The payload of the previous chunk is not touched, since it may still be
+	 * referenced by a bundle queued for transmission.
 	 */
 	void clear();
 